@@ -0,0 +1,240 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_BINARY_H
+#  define __STUMPLESS_PRIVATE_BINARY_H
+
+#  include <stddef.h>
+#  include <stumpless/binary.h>
+#  include <stumpless/config.h>
+#  include <stumpless/entry.h>
+#  include "private/config/wrapper/thread_safety.h"
+#  include "private/strbuilder.h"
+#  include "private/target.h"
+
+/** The number of names that a dictionary can hold. */
+#  define BINARY_DICTIONARY_SIZE 256
+
+/** The longest name that is added to a dictionary. */
+#  define BINARY_MAX_NAME_LENGTH STUMPLESS_MAX_APP_NAME_LENGTH
+
+/** The number of slots in the hash index of an encoder dictionary. */
+#  define BINARY_INDEX_SIZE ( BINARY_DICTIONARY_SIZE * 2 )
+
+/**
+ * The number of records written before the dictionary is reset, so that a
+ * decoder that missed a record can recover.
+ */
+#  define BINARY_RESET_INTERVAL 256
+
+/** Set in the flags of every record. */
+#  define BINARY_FLAG_MARKER 0x80
+
+/** The dictionary is cleared before the record is decoded. */
+#  define BINARY_FLAG_RESET 0x01
+
+/** The record includes a timestamp. */
+#  define BINARY_FLAG_TIMESTAMP 0x02
+
+/**
+ * Names assigned an id in the order they first appeared in a stream of
+ * records, since the last reset.
+ */
+struct binary_dictionary {
+/** The names, which are not NULL-terminated. */
+  char names[BINARY_DICTIONARY_SIZE][BINARY_MAX_NAME_LENGTH];
+/** The length of each name. */
+  size_t lengths[BINARY_DICTIONARY_SIZE];
+/** The number of names in the dictionary. */
+  size_t count;
+};
+
+/**
+ * The state of the binary format for a single target.
+ */
+struct binary_encoder {
+/** The names written to the target since the last reset. */
+  struct binary_dictionary dictionary;
+/** Open addressed hash index of the dictionary, holding each id plus one. */
+  unsigned short index[BINARY_INDEX_SIZE];
+/** The number of records encoded since the last reset. */
+  size_t records_since_reset;
+/** Holds the body of a record while it is encoded. */
+  struct strbuilder *body;
+#  ifdef STUMPLESS_THREAD_SAFETY_SUPPORTED
+/**
+ * Held from the time a record is encoded until it has been written, so that
+ * records are written in the same order as the dictionary was built.
+ */
+  config_mutex_t mutex;
+#  endif
+};
+
+/**
+ * The state of a decoder, which mirrors the dictionary of the encoder that
+ * wrote the records.
+ */
+struct stumpless_binary_decoder {
+/** The names read since the last reset. */
+  struct binary_dictionary dictionary;
+/** Holds the decoded message. */
+  struct strbuilder *output;
+};
+
+/**
+ * Appends a binary record for an entry to a strbuilder. The entry and the
+ * encoder must both be locked by the caller.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe. The caller must hold the lock of the
+ * encoder, which should not be released until the record has been written.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @param builder The strbuilder to append the record to.
+ *
+ * @param entry The entry to encode.
+ *
+ * @param header A copy of the header of the target the entry is encoded for.
+ *
+ * @param pid The process id from get_header_pid.
+ *
+ * @param timestamp The RFC 5424 timestamp of the entry.
+ *
+ * @param timestamp_size The number of characters in the timestamp.
+ *
+ * @return The strbuilder with the record appended, or NULL if memory could not
+ * be allocated for it.
+ */
+struct strbuilder *
+append_binary_record( struct strbuilder *builder,
+                      const struct stumpless_entry *entry,
+                      const struct target_header *header,
+                      int pid,
+                      const char *timestamp,
+                      size_t timestamp_size );
+
+/**
+ * Destroys an encoder.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the encoder must not be in use.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @param encoder The encoder to destroy. May be NULL.
+ */
+void
+destroy_binary_encoder( struct binary_encoder *encoder );
+
+/**
+ * Locks an encoder, if there is one.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @param encoder The encoder to lock. May be NULL, in which case nothing is
+ * done.
+ */
+void
+lock_binary_encoder( struct binary_encoder *encoder );
+
+/**
+ * Creates a new encoder with an empty dictionary.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @return The new encoder, or NULL if memory could not be allocated for it.
+ */
+struct binary_encoder *
+new_binary_encoder( void );
+
+/**
+ * Makes the next record written by an encoder reset the dictionary.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. The lock of the encoder is used.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @param encoder The encoder to reset.
+ */
+void
+reset_binary_encoder( struct binary_encoder *encoder );
+
+/**
+ * Unlocks an encoder locked with lock_binary_encoder. If the records encoded
+ * while it was locked could not be written, then the next record will reset
+ * the dictionary, as a decoder will not have seen the names they added.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @param encoder The encoder to unlock. May be NULL, in which case nothing is
+ * done.
+ *
+ * @param result The result of writing the records, negative if any of them
+ * could not be written.
+ */
+void
+unlock_binary_encoder( struct binary_encoder *encoder, int result );
+
+#endif /* __STUMPLESS_PRIVATE_BINARY_H */
@@ -20,6 +20,7 @@
 #  define __STUMPLESS_PRIVATE_CONFIG_FALLBACK_H
 
 #include <stddef.h>
+#include <stdint.h>
 
 /**
  * Creates a copy of a NULL terminated wide character string in UTF-8 multibyte
@@ -55,6 +56,28 @@ fallback_gethostname( char *buffer, size_t namelen );
 size_t
 fallback_getpagesize( void );
 
+/**
+ * Gets the current time in nanoseconds, for use where a monotonic clock is not
+ * available. This is based on the calendar time and only has a resolution of
+ * one second.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @return The current time in nanoseconds.
+ */
+uint64_t
+fallback_get_monotonic_ns( void );
+
 int
 fallback_getpid( void );
 
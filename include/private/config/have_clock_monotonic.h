@@ -0,0 +1,51 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * Functionality to read a monotonic clock, based on clock_gettime.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_CONFIG_HAVE_CLOCK_MONOTONIC_H
+#  define __STUMPLESS_PRIVATE_CONFIG_HAVE_CLOCK_MONOTONIC_H
+
+#  include <stdint.h>
+
+/**
+ * Gets the current value of the monotonic clock, in nanoseconds. The value has
+ * no meaning on its own and is only useful for measuring elapsed time.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers, as clock_gettime is
+ * async signal safe.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @return The current monotonic time in nanoseconds, or 0 if it could not be
+ * read.
+ */
+uint64_t
+clock_monotonic_get_monotonic_ns( void );
+
+#endif /* __STUMPLESS_PRIVATE_CONFIG_HAVE_CLOCK_MONOTONIC_H */
@@ -21,6 +21,10 @@
 
 #  include <stdatomic.h>
 #  include <stdbool.h>
+#  include <stdint.h>
+
+void
+stdatomic_add_u64( atomic_uint_least64_t *u, uint64_t value );
 
 bool
 stdatomic_compare_exchange_bool( atomic_bool *b,
@@ -32,16 +36,27 @@ stdatomic_compare_exchange_ptr( atomic_uintptr_t *p,
                                 const void *expected,
                                 const void *replacement );
 
+bool
+stdatomic_compare_exchange_u64( atomic_uint_least64_t *u,
+                                uint64_t expected,
+                                uint64_t replacement );
+
 bool
 stdatomic_read_bool( atomic_bool *b );
 
 void *
 stdatomic_read_ptr( atomic_uintptr_t *p );
 
+uint64_t
+stdatomic_read_u64( atomic_uint_least64_t *u );
+
 void
 stdatomic_write_bool( atomic_bool *b, bool replacement );
 
 void
 stdatomic_write_ptr( atomic_uintptr_t *p, void *replacement );
 
+void
+stdatomic_write_u64( atomic_uint_least64_t *u, uint64_t replacement );
+
 #endif /* __STUMPLESS_PRIVATE_CONFIG_HAVE_STDATOMIC_H */
@@ -19,6 +19,7 @@
 #ifndef __STUMPLESS_PRIVATE_CONFIG_HAVE_SYS_SOCKET_H
 #  define __STUMPLESS_PRIVATE_CONFIG_HAVE_SYS_SOCKET_H
 
+#  include <stdbool.h>
 #  include <stddef.h>
 #  include "private/target/network.h"
 
@@ -52,6 +53,34 @@ sys_socket_reopen_udp4_target( struct network_target *target );
 struct network_target *
 sys_socket_reopen_udp6_target( struct network_target *target );
 
+/**
+ * Closes the connection of a network target if it is open and connects it
+ * again. Unlike the reopen functions, this also connects targets whose
+ * connection has already been closed, for example after the remote end shut
+ * it down or a partial send timed out. Any frames held in the spill queue of
+ * a TCP target are sent once it is connected.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers as some targets make
+ * use of non-reentrant locks to coordinate access.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of locks that may be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The network target to reconnect.
+ *
+ * @return The reconnected target, or NULL if it could not be connected. If
+ * an error is encountered, an error code is set appropriately.
+ */
+struct network_target *
+sys_socket_reconnect_network_target( struct network_target *target );
+
 /**
  * Send a message to a TCP-based network target.
  *
@@ -74,13 +103,19 @@ sys_socket_reopen_udp6_target( struct network_target *target );
  *
  * @param msg_size The size of the message, in bytes.
  *
+ * @param spill Whether the message may be held in the spill queue of the
+ * target if it cannot be sent. This is only used if automatic reconnection is
+ * enabled, and should be false if the caller can send the message to another
+ * destination instead.
+ *
  * @return A positive value if no error was encountered, -1 otherwise. If an
  * error is encountered, an error code is set appropriately.
  */
 int
 sys_socket_sendto_tcp_target( struct network_target *target,
                               const char *msg,
-                              size_t msg_size );
+                              size_t msg_size,
+                              bool spill );
 
 /**
  * Send a message to a UDP-based network target.
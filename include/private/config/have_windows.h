@@ -23,6 +23,10 @@
 
 #  include <stdbool.h>
 #  include <stddef.h>
+#  include <stdint.h>
+
+void
+windows_add_u64( LONG64 volatile *u, uint64_t value );
 
 bool
 windows_compare_exchange_bool( LONG volatile *b,
@@ -34,6 +38,11 @@ windows_compare_exchange_ptr( PVOID volatile *p,
                               const void *expected,
                               PVOID replacement );
 
+bool
+windows_compare_exchange_u64( LONG64 volatile *u,
+                              uint64_t expected,
+                              uint64_t replacement );
+
 /**
  * Creates a copy of a NULL terminated multibyte string in wide string format.
  *
@@ -100,13 +109,40 @@ windows_getpagesize( void );
 int
 windows_getpid( void );
 
+/**
+ * Gets the current value of the performance counter, in nanoseconds. The value
+ * has no meaning on its own and is only useful for measuring elapsed time.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @return The current monotonic time in nanoseconds.
+ */
+uint64_t
+windows_get_monotonic_ns( void );
+
 void
 windows_init_mutex( LPCRITICAL_SECTION mutex );
 
 void
 windows_lock_mutex( const CRITICAL_SECTION *mutex );
 
+uint64_t
+windows_read_u64( LONG64 volatile *u );
+
 void
 windows_unlock_mutex( const CRITICAL_SECTION *mutex );
 
+void
+windows_write_u64( LONG64 volatile *u, uint64_t replacement );
+
 #endif /* __STUMPLESS_PRIVATE_CONFIG_HAVE_WINDOWS_H */
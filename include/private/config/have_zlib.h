@@ -0,0 +1,106 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_CONFIG_HAVE_ZLIB_H
+#  define __STUMPLESS_PRIVATE_CONFIG_HAVE_ZLIB_H
+
+#  include <stdbool.h>
+#  include <stddef.h>
+#  include <stdio.h>
+#  include <zlib.h>
+
+/** The size of the buffer that compressed data is written from. */
+#  define COMPRESSOR_OUTPUT_SIZE 16384
+
+/**
+ * The number of uncompressed bytes in each frame of a compressed file target
+ * unless it is changed with stumpless_set_compressed_file_frame_size.
+ */
+#  define DEFAULT_COMPRESSED_FRAME_SIZE 65536
+
+/**
+ * The state of a compressed file target. Each frame is written as a complete
+ * gzip member, so that the file can be read up to the last finished frame.
+ */
+struct file_compressor {
+/** The zlib stream for the current frame. */
+  z_stream stream;
+/** The number of uncompressed bytes after which a frame is finished. */
+  size_t frame_size;
+/** The number of uncompressed bytes in the current frame. */
+  size_t frame_length;
+/** Holds compressed data before it is written to the file. */
+  unsigned char output[COMPRESSOR_OUTPUT_SIZE];
+};
+
+/**
+ * Compresses messages into the current frame of a compressed file target,
+ * finishing the frame once it reaches the frame size.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe. The caller must hold the stream mutex of
+ * the file target.
+ *
+ * **Async Signal Safety: AS-Unsafe**
+ * This function is not safe to call from signal handlers, as the stream may be
+ * left in an inconsistent state.
+ *
+ * **Async Cancel Safety: AC-Unsafe**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, as the stream may be left in an inconsistent state.
+ *
+ * @param compressor The compressor of the target.
+ *
+ * @param file The file to write compressed data to.
+ *
+ * @param msg The messages to compress.
+ *
+ * @param msg_length The number of bytes in msg.
+ *
+ * @return true if the messages were compressed and any finished frame was
+ * written, false otherwise.
+ */
+bool
+zlib_compress_to_file( struct file_compressor *compressor,
+                       FILE *file,
+                       const char *msg,
+                       size_t msg_length );
+
+/**
+ * Finishes the current frame of a compressed file target and frees the
+ * compressor.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the target must not be in use.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @param compressor The compressor to destroy. May be NULL.
+ *
+ * @param file The file to write the rest of the frame to.
+ */
+void
+zlib_destroy_file_compressor( struct file_compressor *compressor, FILE *file );
+
+#endif /* __STUMPLESS_PRIVATE_CONFIG_HAVE_ZLIB_H */
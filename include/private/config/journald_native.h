@@ -0,0 +1,156 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_CONFIG_JOURNALD_NATIVE_H
+#  define __STUMPLESS_PRIVATE_CONFIG_JOURNALD_NATIVE_H
+
+#  include <stddef.h>
+#  include <sys/uio.h>
+
+/** The socket that journald listens for native protocol datagrams on. */
+#  define JOURNALD_NATIVE_DEFAULT_SOCKET "/run/systemd/journal/socket"
+
+/**
+ * Encodes a set of journald fields into a native protocol datagram and adds it
+ * to the calling thread's pending datagrams. Nothing is sent until
+ * journald_native_flush is called.
+ *
+ * Each field must be of the form NAME=value. Values that contain a newline are
+ * written using the binary-safe form of the protocol, with an explicit little
+ * endian 64 bit length.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe, as pending datagrams are stored per thread.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param fields The fields of the entry.
+ *
+ * @param field_count The number of fields in the fields array.
+ *
+ * @return 0 if the datagram was added, or a negative errno value if it could
+ * not be.
+ */
+int
+journald_native_append( const struct iovec *fields, int field_count );
+
+/**
+ * Discards any datagrams pending in the calling thread.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ */
+void
+journald_native_discard( void );
+
+/**
+ * Sends all datagrams pending in the calling thread to the journald socket.
+ * Where sendmmsg is available all datagrams are sent with a single call. A
+ * datagram that cannot be sent does not keep the ones after it from being
+ * sent.
+ *
+ * **Thread Safety: MT-Safe race:path**
+ * This function is thread safe as long as the socket path is not changed
+ * during the call. Each thread uses its own socket.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param results An array with an element for each pending datagram, in the
+ * order that they were appended. The element of each datagram that could not
+ * be sent is set to its negative errno value, and the others are not changed.
+ * This may be NULL if the individual results are not needed.
+ *
+ * @return 0 if all datagrams were sent, or a negative errno value if one could
+ * not be. Datagrams that could not be sent are discarded.
+ */
+int
+journald_native_flush( int *results );
+
+/**
+ * Frees the per-thread resources used by the native protocol, including the
+ * thread's socket.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @since release v3.1.0
+ */
+void
+journald_native_free_thread( void );
+
+/**
+ * Sends a single set of journald fields to the journald socket. This is a
+ * drop-in replacement for sd_journal_sendv.
+ *
+ * **Thread Safety: MT-Safe race:path**
+ * This function is thread safe as long as the socket path is not changed
+ * during the call.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param fields The fields of the entry.
+ *
+ * @param field_count The number of fields in the fields array.
+ *
+ * @return 0 if the entry was sent, or a negative errno value if it was not.
+ */
+int
+journald_native_sendv( const struct iovec *fields, int field_count );
+
+#endif /* __STUMPLESS_PRIVATE_CONFIG_JOURNALD_NATIVE_H */
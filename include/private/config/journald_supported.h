@@ -64,4 +64,72 @@ journald_init_journald_element( struct stumpless_element *element );
 void
 journald_init_journald_param( struct stumpless_param *param );
 
+/**
+ * Clears the cached journald field prefix of a param that has been added to
+ * an element, as the prefix depends on the name of the element.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe, as the param is locked while it is reset.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * a non-reentrant lock to coordinate access to the param.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param param The param to reset.
+ */
+void
+journald_reset_added_param( struct stumpless_param *param );
+
+/**
+ * Clears the cached journald field name of an element, as well as the cached
+ * field prefixes of each of its params. This must be called whenever the name
+ * of the element changes.
+ *
+ * **Thread Safety: MT-Safe race:element**
+ * This function is thread safe, assuming that the element is already locked
+ * by the caller. Each param is locked while it is reset.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * a non-reentrant lock to coordinate access to the params.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of locks that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param element The element to reset.
+ */
+void
+journald_reset_journald_element( struct stumpless_element *element );
+
+/**
+ * Clears the cached journald field prefix of a param. This must be called
+ * whenever the name of the param changes or it is added to an element.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe; it should only be used on params that
+ * are already locked by the caller.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param param The param to reset.
+ */
+void
+journald_reset_journald_param( struct stumpless_param *param );
+
 #endif /* __STUMPLESS_PRIVATE_CONFIG_JOURNALD_SUPPORTED_H */
@@ -20,6 +20,7 @@
 #  define __STUMPLESS_PRIVATE_CONFIG_THREAD_SAFETY_UNSUPPORTED_H
 
 #  include <stdbool.h>
+#  include <stdint.h>
 #  include "private/config/wrapper/thread_safety.h"
 
 bool
@@ -32,4 +33,9 @@ no_thread_safety_compare_exchange_ptr( config_atomic_ptr_t *p,
                                        const void *expected,
                                        void *replacement );
 
+bool
+no_thread_safety_compare_exchange_u64( config_atomic_u64_t *u,
+                                       uint64_t expected,
+                                       uint64_t replacement );
+
 #endif /* __STUMPLESS_PRIVATE_CONFIG_THREAD_SAFETY_UNSUPPORTED_H */
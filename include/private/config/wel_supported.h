@@ -114,6 +114,33 @@ struct wel_data {
 #  endif
 };
 
+/**
+ * Creates a new wide character string from the message of the entry, using
+ * the message length rather than a NULL terminator, as borrowed messages do
+ * not have one. An entry without a message gives an empty string.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate the read of the
+ * entry with other accesses and modifications.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate access and the use of memory management
+ * functions to create the copy.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @param entry The entry to copy the message from.
+ *
+ * @return a copy of the message as a NULL terminated wide character string,
+ * or NULL if an error is encountered.
+ */
+LPWSTR
+copy_entry_message_to_lpwstr( const struct stumpless_entry *entry );
+
 /**
  * Creates a new wide character string from the param value.
  *
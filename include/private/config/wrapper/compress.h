@@ -0,0 +1,36 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_CONFIG_WRAPPER_COMPRESS_H
+#  define __STUMPLESS_PRIVATE_CONFIG_WRAPPER_COMPRESS_H
+
+#  include <stumpless/config.h>
+
+/* definitions of the compression of file targets */
+#  ifdef STUMPLESS_COMPRESSED_FILE_TARGETS_SUPPORTED
+#    include "private/config/have_zlib.h"
+#    define config_compress_to_file zlib_compress_to_file
+#    define config_destroy_file_compressor zlib_destroy_file_compressor
+#  else
+#    include <stdbool.h>
+#    define config_compress_to_file( COMPRESSOR, FILE, MSG, MSG_LENGTH ) \
+( false )
+#    define config_destroy_file_compressor( COMPRESSOR, FILE ) ( ( void ) 0 )
+#  endif
+
+#endif /* __STUMPLESS_PRIVATE_CONFIG_WRAPPER_COMPRESS_H */
@@ -0,0 +1,40 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * A wrapper for reading a monotonic clock.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_CONFIG_WRAPPER_GET_MONOTONIC_TIME_H
+#  define __STUMPLESS_PRIVATE_CONFIG_WRAPPER_GET_MONOTONIC_TIME_H
+
+#  include "private/config.h"
+
+/* definition of config_get_monotonic_ns */
+#  ifdef HAVE_CLOCK_MONOTONIC
+#    include "private/config/have_clock_monotonic.h"
+#    define config_get_monotonic_ns clock_monotonic_get_monotonic_ns
+#  elif HAVE_WINDOWS_H
+#    include "private/config/have_windows.h"
+#    define config_get_monotonic_ns windows_get_monotonic_ns
+#  else
+#    include "private/config/fallback.h"
+#    define config_get_monotonic_ns fallback_get_monotonic_ns
+#  endif
+
+#endif /* __STUMPLESS_PRIVATE_CONFIG_WRAPPER_GET_MONOTONIC_TIME_H */
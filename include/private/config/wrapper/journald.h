@@ -29,6 +29,11 @@
 #    define config_init_journald_element journald_init_journald_element
 #    define config_init_journald_param journald_init_journald_param
 #    define config_journald_free_thread journald_free_thread
+#    define config_reset_added_journald_param journald_reset_added_param
+#    define config_reset_journald_element journald_reset_journald_element
+#    define config_reset_journald_param journald_reset_journald_param
+#    define config_send_entries_to_journald_target \
+send_entries_to_journald_target
 #    define config_send_entry_to_journald_target send_entry_to_journald_target
 #  else
 #    include "private/target.h"
@@ -36,6 +41,11 @@
 #    define config_init_journald_element( ELEMENT ) ( ( void ) 0 )
 #    define config_init_journald_param( PARAM ) ( ( void ) 0 )
 #    define config_journald_free_thread(  ) ( ( void ) 0 )
+#    define config_reset_added_journald_param( PARAM ) ( ( void ) 0 )
+#    define config_reset_journald_element( ELEMENT ) ( ( void ) 0 )
+#    define config_reset_journald_param( PARAM ) ( ( void ) 0 )
+#    define config_send_entries_to_journald_target \
+send_entries_to_unsupported_target
 #    define config_send_entry_to_journald_target send_entry_to_unsupported_target
 #  endif
 
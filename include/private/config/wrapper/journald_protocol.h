@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_CONFIG_WRAPPER_JOURNALD_PROTOCOL_H
+#  define __STUMPLESS_PRIVATE_CONFIG_WRAPPER_JOURNALD_PROTOCOL_H
+
+#  include <stumpless/config.h>
+
+/* definitions of the functions used to send fields to journald */
+#  ifdef STUMPLESS_JOURNALD_NATIVE_PROTOCOL_SUPPORTED
+#    include "private/config/journald_native.h"
+#    define config_journald_append journald_native_append
+#    define config_journald_discard journald_native_discard
+#    define config_journald_flush journald_native_flush
+#    define config_journald_protocol_free_thread journald_native_free_thread
+#    define config_journald_sendv journald_native_sendv
+#  else
+// keeps systemd from showing stumpless itself as the source of the entries
+#    define SD_JOURNAL_SUPPRESS_LOCATION 1
+#    include <systemd/sd-journal.h>
+#    define config_journald_append sd_journal_sendv
+#    define config_journald_discard(  ) ( ( void ) 0 )
+// each entry is sent as it is appended, so there is nothing left to flush
+#    define config_journald_flush( RESULTS ) ( 0 )
+#    define config_journald_protocol_free_thread(  ) ( ( void ) 0 )
+#    define config_journald_sendv sd_journal_sendv
+#  endif
+
+#endif /* __STUMPLESS_PRIVATE_CONFIG_WRAPPER_JOURNALD_PROTOCOL_H */
@@ -47,6 +47,7 @@
 #  define config_open_tcp6_target sys_socket_open_tcp6_target
 #  define config_open_udp4_target sys_socket_open_udp4_target
 #  define config_open_udp6_target sys_socket_open_udp6_target
+#  define config_reconnect_network_target sys_socket_reconnect_network_target
 #  define config_reopen_tcp4_target sys_socket_reopen_tcp4_target
 #  define config_reopen_tcp6_target sys_socket_reopen_tcp6_target
 #  define config_reopen_udp4_target sys_socket_reopen_udp4_target
@@ -75,6 +76,7 @@
 #  define config_open_tcp6_target winsock2_open_tcp6_target
 #  define config_open_udp4_target winsock2_open_udp4_target
 #  define config_open_udp6_target winsock2_open_udp6_target
+#  define config_reconnect_network_target winsock2_reconnect_network_target
 #  define config_reopen_tcp4_target winsock2_reopen_tcp4_target
 #  define config_reopen_tcp6_target winsock2_reopen_tcp6_target
 #  define config_reopen_udp4_target winsock2_reopen_udp4_target
@@ -105,7 +107,8 @@
 #  define config_network_free_all() ( ( void ) 0 )
 #  define config_network_target_is_open unsupported_target_is_open
 #  define config_open_network_target open_unsupported_target
-#  define config_sendto_network_target sendto_unsupported_target
+#  define config_sendto_network_target( TARGET, MSG, MSG_LENGTH, PRIVAL ) \
+sendto_unsupported_target( ( TARGET ), ( MSG ), ( MSG_LENGTH ) )
 #endif
 
 #endif /* __STUMPLESS_PRIVATE_CONFIG_WRAPPER_NETWORK_SUPPORTED_H */
@@ -0,0 +1,47 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * A wrapper for firing probes, which compile to nothing unless the library is
+ * built with probes enabled.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_CONFIG_WRAPPER_PROBE_H
+#  define __STUMPLESS_PRIVATE_CONFIG_WRAPPER_PROBE_H
+
+#  include <stumpless/config.h>
+#  include "private/config.h"
+
+/* definition of config_probe */
+#  ifdef STUMPLESS_PROBES_SUPPORTED
+#    include "private/probe.h"
+#    ifdef HAVE_SYS_SDT_H
+#      include <sys/sdt.h>
+#      define config_probe( PROBE )                                            \
+do {                                                                           \
+  DTRACE_PROBE( stumpless, PROBE );                                            \
+  fire_probe( STUMPLESS_PROBE_##PROBE );                                       \
+} while( 0 )
+#    else
+#      define config_probe( PROBE ) fire_probe( STUMPLESS_PROBE_##PROBE )
+#    endif
+#  else
+#    define config_probe( PROBE ) ( ( void ) 0 )
+#  endif
+
+#endif /* __STUMPLESS_PRIVATE_CONFIG_WRAPPER_PROBE_H */
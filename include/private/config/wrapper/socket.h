@@ -27,10 +27,12 @@
 #    include "private/target/socket.h"
 #    define config_close_socket_target stumpless_close_socket_target
 #    define config_sendto_socket_target sendto_socket_target
+#    define config_sendto_socket_target_batch sendto_socket_target_batch
 #  else
 #    include "private/target.h"
 #    define config_close_socket_target close_unsupported_target
 #    define config_sendto_socket_target sendto_unsupported_target
+#    define config_sendto_socket_target_batch sendto_batch_to_unsupported_target
 #  endif
 
 #  ifdef SUPPORT_ABSTRACT_SOCKET_NAMES
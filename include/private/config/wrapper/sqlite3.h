@@ -26,10 +26,13 @@
 #  include "private/target/sqlite3.h"
 #  define config_close_sqlite3_target_and_db                                   \
 stumpless_close_sqlite3_target_and_db
+#  define config_send_entries_to_sqlite3_target send_entries_to_sqlite3_target
 #  define config_send_entry_to_sqlite3_target send_entry_to_sqlite3_target
 #else
 #  include "private/target.h"
 #  define config_close_sqlite3_target_and_db close_unsupported_target
+#  define config_send_entries_to_sqlite3_target \
+send_entries_to_unsupported_target
 #  define config_send_entry_to_sqlite3_target send_entry_to_unsupported_target
 #endif
 
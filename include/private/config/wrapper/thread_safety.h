@@ -21,14 +21,17 @@
 
 #  include <stdbool.h>
 #  include <stddef.h>
+#  include <stdint.h>
 #  include <stumpless/config.h>
 #  include "private/config.h"
 
 #  ifndef STUMPLESS_THREAD_SAFETY_SUPPORTED
 typedef bool config_atomic_bool_t;
 typedef void * config_atomic_ptr_t;
+typedef uint64_t config_atomic_u64_t;
 #    define CONFIG_THREAD_LOCAL_STORAGE
 #    include "private/config/thread_safety_unsupported.h"
+#    define config_add_u64( U, VALUE ) *( U ) += ( VALUE )
 #    define config_assign_cached_mutex( MUTEX ) ( ( void ) 0 )
 #    define config_atomic_bool_false false
 #    define config_atomic_bool_true true
@@ -36,6 +39,7 @@ typedef void * config_atomic_ptr_t;
 #    define config_check_mutex_valid( MUTEX ) ( true )
 #    define config_compare_exchange_bool no_thread_safety_compare_exchange_bool
 #    define config_compare_exchange_ptr no_thread_safety_compare_exchange_ptr
+#    define config_compare_exchange_u64 no_thread_safety_compare_exchange_u64
 #    define config_destroy_mutex( MUTEX ) ( ( void ) 0 )
 #    define config_destroy_cached_mutex( MUTEX ) ( ( void ) 0 )
 #    define config_init_mutex( MUTEX ) ( ( void ) 0 )
@@ -43,21 +47,25 @@ typedef void * config_atomic_ptr_t;
 #    define CONFIG_MUTEX_T_SIZE 0
 #    define config_read_bool( B ) *( B )
 #    define config_read_ptr( P ) *( P )
+#    define config_read_u64( U ) *( U )
 #    define config_thread_safety_free_all(  ) ( ( void ) 0 )
 #    define config_unlock_mutex( MUTEX ) ( ( void ) 0 )
 #    define config_write_bool( B, REPLACEMENT ) *( B ) = ( REPLACEMENT )
 #    define config_write_ptr( P, REPLACEMENT ) *( P ) = ( REPLACEMENT )
+#    define config_write_u64( U, REPLACEMENT ) *( U ) = ( REPLACEMENT )
 #  elif defined HAVE_PTHREAD_H && defined HAVE_STDATOMIC_H
 #    include <pthread.h>
 #    include <stdatomic.h>
 #    include <stdint.h>
 typedef atomic_bool config_atomic_bool_t;
 typedef atomic_uintptr_t config_atomic_ptr_t;
+typedef atomic_uint_least64_t config_atomic_u64_t;
 typedef pthread_mutex_t config_mutex_t;
 #    define CONFIG_THREAD_LOCAL_STORAGE __thread
 #    include "private/config/have_pthread.h"
 #    include "private/config/have_stdatomic.h"
 #    include "private/config/thread_safety_supported.h"
+#    define config_add_u64 stdatomic_add_u64
 #    define config_assign_cached_mutex( MUTEX ) \
 ( MUTEX = thread_safety_new_mutex(  ) )
 #    define config_atomic_bool_false false
@@ -66,6 +74,7 @@ typedef pthread_mutex_t config_mutex_t;
 #    define config_check_mutex_valid( MUTEX ) ( MUTEX != NULL )
 #    define config_compare_exchange_bool stdatomic_compare_exchange_bool
 #    define config_compare_exchange_ptr stdatomic_compare_exchange_ptr
+#    define config_compare_exchange_u64 stdatomic_compare_exchange_u64
 #    define config_destroy_cached_mutex( MUTEX ) \
 ( thread_safety_destroy_mutex( MUTEX ) )
 #    define config_destroy_mutex pthread_destroy_mutex
@@ -74,18 +83,22 @@ typedef pthread_mutex_t config_mutex_t;
 #    define CONFIG_MUTEX_T_SIZE sizeof( config_mutex_t )
 #    define config_read_bool stdatomic_read_bool
 #    define config_read_ptr stdatomic_read_ptr
+#    define config_read_u64 stdatomic_read_u64
 #    define config_thread_safety_free_all thread_safety_free_all
 #    define config_unlock_mutex pthread_unlock_mutex
 #    define config_write_bool stdatomic_write_bool
 #    define config_write_ptr stdatomic_write_ptr
+#    define config_write_u64 stdatomic_write_u64
 #  elif defined HAVE_WINDOWS_H
 #    include "private/config/have_windows.h"
 #    include "private/windows_wrapper.h"
 typedef LONG volatile config_atomic_bool_t;
 typedef PVOID volatile config_atomic_ptr_t;
+typedef LONG64 volatile config_atomic_u64_t;
 typedef CRITICAL_SECTION config_mutex_t;
 #    include "private/config/thread_safety_supported.h"
 #    define CONFIG_THREAD_LOCAL_STORAGE __declspec( thread )
+#    define config_add_u64 windows_add_u64
 #    define config_assign_cached_mutex( MUTEX ) \
 ( MUTEX = thread_safety_new_mutex(  ) )
 #    define config_atomic_bool_false false
@@ -94,6 +107,7 @@ typedef CRITICAL_SECTION config_mutex_t;
 #    define config_check_mutex_valid( MUTEX ) ( MUTEX != NULL )
 #    define config_compare_exchange_bool windows_compare_exchange_bool
 #    define config_compare_exchange_ptr windows_compare_exchange_ptr
+#    define config_compare_exchange_u64 windows_compare_exchange_u64
 #    define config_destroy_cached_mutex( MUTEX ) \
 ( thread_safety_destroy_mutex( MUTEX ) )
 #    define config_destroy_mutex windows_destroy_mutex
@@ -102,10 +116,12 @@ typedef CRITICAL_SECTION config_mutex_t;
 #    define CONFIG_MUTEX_T_SIZE sizeof( config_mutex_t )
 #    define config_read_bool( B ) *( B )
 #    define config_read_ptr( P ) *( P )
+#    define config_read_u64 windows_read_u64
 #    define config_thread_safety_free_all thread_safety_free_all
 #    define config_unlock_mutex windows_unlock_mutex
 #    define config_write_bool( B, REPLACEMENT ) *( B ) = ( REPLACEMENT )
 #    define config_write_ptr( P, REPLACEMENT ) *( P ) = ( REPLACEMENT )
+#    define config_write_u64 windows_write_u64
 #  endif
 
 #endif /* __STUMPLESS_PRIVATE_CONFIG_WRAPPER_THREAD_SAFETY_H */
@@ -44,6 +44,35 @@ struct stumpless_param *
 locked_get_param_by_index( const struct stumpless_element *element,
                            size_t index );
 
+/**
+ * Adds a param to an element by reloading the first param kept past the end of
+ * its params array, reusing the memory of its value if it is large enough.
+ * The element must have a kept param, and must be locked.
+ *
+ * @param element The element to add the param to.
+ *
+ * @param name The name of the param, which is checked before it is used.
+ *
+ * @param value The value of the param, which is checked before it is used.
+ *
+ * @return The element, if no error is encountered. If an error is encountered,
+ * then NULL is returned and an error code is set appropriately.
+ */
+struct stumpless_element *
+locked_reuse_param( struct stumpless_element *element,
+                    const char *name,
+                    const char *value );
+
+/**
+ * Removes all params from an element so that it can be reused. Params created
+ * by the element are kept past the end of its params array, and all others are
+ * dropped from it without being destroyed. The element must be locked.
+ *
+ * @param element The element to reset.
+ */
+void
+locked_reset_element( struct stumpless_element *element );
+
 /**
  * Destroys the provided element, without performing a NULL check.
  *
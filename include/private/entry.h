@@ -46,6 +46,23 @@
 void
 entry_free_all( void );
 
+/**
+ * Destroys the entries in the entry pool of the current thread.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe as it only operates on thread-local resources.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of the
+ * memory deallocation function and the destruction of locks.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, as the memory deallocation function may not be AC-Safe itself.
+ */
+void
+entry_free_thread( void );
+
 /**
  * Locks the mutex within the entry.
  *
@@ -93,6 +110,27 @@ struct stumpless_entry *
 locked_add_element( struct stumpless_entry *entry,
                     struct stumpless_element *element );
 
+/**
+ * Clears an entry for reuse as described in stumpless_reset_entry, without
+ * changing the current error so that it may be used on failure paths. The
+ * entry must be locked.
+ *
+ * @param entry The entry to reset.
+ */
+void
+locked_reset_entry( struct stumpless_entry *entry );
+
+/**
+ * Removes all elements from an entry so that they can be reused, as done by
+ * stumpless_reset_entry. Elements created by the entry are reset and kept past
+ * the end of its elements array, and all others are dropped from it without
+ * being changed. The entry must be locked.
+ *
+ * @param entry The entry to reset the elements of.
+ */
+void
+locked_reset_elements( struct stumpless_entry *entry );
+
 /**
  * Retrieves an element by index from a Stumpless entry, assuming external thread safety management.
  *
@@ -0,0 +1,278 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_FILTER_H
+#  define __STUMPLESS_PRIVATE_FILTER_H
+
+#  include <stdbool.h>
+#  include <stddef.h>
+#  include <stdint.h>
+#  include <stumpless/filter.h>
+#  include <stumpless/target.h>
+#  include "private/config/wrapper/thread_safety.h"
+
+/**
+ * The number of targets that each thread tracks duplicate entries for at
+ * once. If a thread uses the duplicate filter with more targets than this, the
+ * least recently used target is forgotten along with its repeat count.
+ */
+#  define DEDUP_THREAD_SLOT_COUNT 4
+
+/**
+ * The message of the entry sent in place of repeated entries suppressed by
+ * the duplicate filter, with the number of repeats as an unsigned long long.
+ */
+#  define DEDUP_SUMMARY_MESSAGE "last message repeated %llu times"
+
+/**
+ * The number of buckets that msgids are hashed into when a rate limit is
+ * kept per msgid. Msgids that share a bucket also share a limit.
+ */
+#  define RATE_LIMIT_MSGID_BUCKET_COUNT 64
+
+/**
+ * The message of the entry sent in place of entries suppressed by a rate
+ * limit, with the number of suppressed entries as an unsigned long long.
+ */
+#  define RATE_LIMIT_SUMMARY_MESSAGE "%llu entries were suppressed by the rate limit"
+
+/**
+ * The state of a single rate limit. Each limit is tracked as the theoretical
+ * arrival time of the next entry, which allows a token bucket to be updated
+ * with a single compare and exchange.
+ */
+struct rate_limit_bucket {
+/** The time at which the entry limit will be fully replenished. */
+  config_atomic_u64_t entry_tat;
+/** The time at which the byte limit will be fully replenished. */
+  config_atomic_u64_t byte_tat;
+};
+
+/**
+ * The rate limit of a target, used by stumpless_rate_limit_filter.
+ */
+struct rate_limit {
+/** The time that each entry costs, in nanoseconds. Zero means no limit. */
+  uint64_t entry_interval;
+/** The time that each byte costs, in nanoseconds. Zero means no limit. */
+  uint64_t byte_interval;
+/** What the limits are kept separately for. */
+  enum stumpless_rate_limit_key key;
+/** The number of entries suppressed since the last summary was sent. */
+  config_atomic_u64_t suppressed;
+/**
+ * The limits. Only the first is used for a per target limit, and only the
+ * first eight for a per severity limit.
+ */
+  struct rate_limit_bucket buckets[RATE_LIMIT_MSGID_BUCKET_COUNT];
+};
+
+/**
+ * The duplicate filter configuration of a target, used by
+ * stumpless_dedup_filter.
+ */
+struct dedup {
+/**
+ * A number unique to this configuration, used to find the per-thread state
+ * that belongs to it.
+ */
+  uint64_t serial;
+/**
+ * The time in nanoseconds after which a repeated entry is passed again. Zero
+ * means that repeated entries are suppressed for as long as they repeat.
+ */
+  uint64_t window;
+};
+
+/**
+ * The state that a thread keeps for the duplicate filter of a single target.
+ */
+struct dedup_slot {
+/** The serial of the configuration this slot belongs to, or 0 if unused. */
+  uint64_t serial;
+/** When this slot was last used, relative to the other slots. */
+  uint64_t last_used;
+/** Whether an entry has passed the filter since the slot was claimed. */
+  bool seen;
+/** The hash of the last entry that passed the filter. */
+  uint64_t hash;
+/** The prival of the last entry that passed the filter. */
+  int prival;
+/** When the last entry passed the filter. */
+  uint64_t first_seen;
+/** The number of times the last entry has been repeated since it passed. */
+  uint64_t repeats;
+/** The number of repeats that have not been reported in a summary yet. */
+  uint64_t pending;
+/** The prival of the entry that the pending repeats are of. */
+  int pending_prival;
+};
+
+/**
+ * The kinds of filter stages, in the order that they are evaluated. Cheaper
+ * checks come first so that entries are dropped as early as possible.
+ */
+enum filter_stage_type {
+  FILTER_STAGE_SEVERITY,
+  FILTER_STAGE_APP_NAME,
+  FILTER_STAGE_ELEMENT,
+  FILTER_STAGE_FUNCTION
+};
+
+/**
+ * A single stage of the filter pipeline of a target.
+ */
+struct filter_stage {
+/** The kind of check that this stage does. */
+  enum filter_stage_type type;
+/** The severities passed by a severity stage, as a mask. */
+  int severity_mask;
+/** The app name or element name checked for, as a NULL-terminated string. */
+  char *name;
+/** The length of name, not including the NULL terminator. */
+  size_t name_length;
+/** The filter called by a function stage. */
+  stumpless_filter_func_t filter;
+/** The number of entries that have passed this stage. */
+  config_atomic_u64_t passed;
+/** The number of entries that have been dropped by this stage. */
+  config_atomic_u64_t dropped;
+};
+
+/**
+ * The filter pipeline of a target, evaluated after the filter of the target.
+ */
+struct filter_stages {
+/** The stages, in the order they are evaluated. */
+  struct filter_stage **stages;
+/** The number of stages. */
+  size_t count;
+};
+
+/**
+ * The sampling configuration of a target, used by stumpless_sample_filter.
+ */
+struct sample {
+/**
+ * One in how many entries of each severity are kept. Zero and one both mean
+ * that all entries are kept.
+ */
+  unsigned rates[8];
+/**
+ * The name of the element holding the param that entries are sampled by, or
+ * NULL if entries are sampled randomly.
+ */
+  char *element_name;
+/** The number of characters in element_name. */
+  size_t element_name_length;
+/** The name of the param that entries are sampled by. */
+  char *param_name;
+/** The number of characters in param_name. */
+  size_t param_name_length;
+};
+
+void
+destroy_dedup( const struct stumpless_target *target );
+
+void
+destroy_filter_stages( const struct stumpless_target *target );
+
+void
+destroy_rate_limit( const struct stumpless_target *target );
+
+void
+destroy_sample( const struct stumpless_target *target );
+
+/**
+ * Checks an entry against each stage of the filter pipeline of a target, in
+ * order, and stops at the first stage that drops it.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. Mutexes are used to read the fields of the
+ * entry, and the stage counters are updated atomically.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to read the entry.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @param target The target that the entry is being sent to.
+ *
+ * @param entry The entry to check.
+ *
+ * @return true if the entry passes every stage, or if the target has no
+ * stages, and false otherwise.
+ */
+bool
+run_filter_stages( const struct stumpless_target *target,
+                   const struct stumpless_entry *entry );
+
+/**
+ * Gets the number of repeated entries suppressed by the duplicate filter of a
+ * target in the current thread that have not been summarized yet, and resets
+ * it to zero.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe, as repeat counts are kept per thread.
+ *
+ * **Async Signal Safety: AS-Unsafe**
+ * This function is not safe to call from signal handlers, as it may change the
+ * per-thread state of an interrupted filter call.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @param target The target to get the count of.
+ *
+ * @param prival Set to the prival of the repeated entry if the count is not
+ * zero.
+ *
+ * @return The number of repeated entries. If the target does not have a
+ * duplicate filter configured, then this is always zero.
+ */
+uint64_t
+take_repeated_entry_count( const struct stumpless_target *target, int *prival );
+
+/**
+ * Gets the number of entries suppressed by the rate limit of a target since
+ * this was last called, and resets it to zero.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. An atomic compare and exchange is used to
+ * reset the count.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @param target The target to get the count of.
+ *
+ * @return The number of suppressed entries. If the target does not have a rate
+ * limit, then this is always zero.
+ */
+uint64_t
+take_suppressed_entry_count( const struct stumpless_target *target );
+
+#endif /* __STUMPLESS_PRIVATE_FILTER_H */
@@ -22,10 +22,12 @@
 #  include <stumpless/entry.h>
 #  include <stumpless/target.h>
 #  include "private/strbuilder.h"
+#  include "private/target.h"
 
 #  define RFC_5424_FULL_DATE_BUFFER_SIZE 11
 #  define RFC_5424_FULL_TIME_BUFFER_SIZE 10
 #  define RFC_5424_MAX_PRI_LENGTH 5
+#  define RFC_5424_MAX_PRIVAL 191
 #  define RFC_5424_MAX_TIMESTAMP_LENGTH 32
 #  define RFC_5424_TIME_SECFRAC_BUFFER_SIZE 8
 #  define RFC_5424_TIMESTAMP_BUFFER_SIZE 33
@@ -33,15 +35,58 @@
 
 #  define RFC_5424_NILVALUE '-'
 
+/**
+ * Appends a formatted entry to a strbuilder, followed by a newline. The entry
+ * is written in the format of the given header.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to ensure that the entry does
+ * not change while it is being read.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to prevent changes during the read.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled due to the use of a lock that could be left locked.
+ *
+ * @param builder The strbuilder to append the entry to. If this is NULL, then
+ * NULL is returned.
+ *
+ * @param entry The entry to format.
+ *
+ * @param header A copy of the header of the target the entry is formatted
+ * for, from read_target_header.
+ *
+ * @param pid The process id from get_header_pid.
+ *
+ * @param prival If this is not NULL, then it is set to the prival of the entry
+ * as it was formatted, so that targets can use it without locking the entry
+ * again.
+ *
+ * @return The strbuilder with the formatted entry appended, or NULL if memory
+ * could not be allocated for it.
+ */
+struct strbuilder *
+append_formatted_entry( struct strbuilder *builder,
+                        const struct stumpless_entry *entry,
+                        const struct target_header *header,
+                        int pid,
+                        int *prival );
+
 /**
  * Creates a new strbuilder with the formatted message.
  *
  * A newline is added to the end of the message - it is up to functions that use
  * this to decide whether they want to include this newline or not.
  *
+ * The hostname, app name, and procid are copied from the pre-rendered header of
+ * the target if the entry does not override any of them.
+ *
  * **Thread Safety: MT-Safe**
- * This function is thread safe. A mutex is used to ensure that the entry does
- * not change while it is being read.
+ * This function is thread safe. Mutexes are used to ensure that the entry and
+ * the header of the target do not change while they are being read.
  *
  * **Async Signal Safety: AS-Unsafe lock**
  * This function is not safe to call from signal handlers due to the use of a
@@ -53,6 +98,8 @@
  *
  * @param entry The entry to format.
  *
+ * @param target The target the entry is being formatted for.
+ *
  * @return A strbuilder with the formatted version of the entry, with a newline
  * character added to the end.
  */
@@ -60,4 +107,25 @@ struct strbuilder *
 format_entry( const struct stumpless_entry *entry,
               const struct stumpless_target *target );
 
+/**
+ * Gets the process id to use with a copy of the header of a target. This is
+ * only looked up if the header includes a process id.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @param header A copy of the header of a target.
+ *
+ * @return The current process id, or 0 if the header does not use it.
+ */
+int
+get_header_pid( const struct target_header *header );
+
 #endif /* __STUMPLESS_PRIVATE_FORMATTER_H */
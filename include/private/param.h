@@ -25,6 +25,45 @@
 void
 lock_param( const struct stumpless_param *param );
 
+/**
+ * Replaces the name and value of a param that is already loaded. The existing
+ * value is reused if the param owns it and it is large enough, and is
+ * replaced with a larger copy otherwise. No validation is performed.
+ *
+ * **Thread Safety: MT-Safe race:name race:value**
+ * This function is thread safe, assuming that the name and value are not
+ * changed by other threads during execution. A mutex is used to coordinate
+ * changes to the param.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock and memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @param param The param to reload.
+ *
+ * @param name The new name of the param.
+ *
+ * @param name_length The length of the name in bytes.
+ *
+ * @param value The new value of the param.
+ *
+ * @param value_length The length of the value in bytes.
+ *
+ * @return The reloaded param, if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+struct stumpless_param *
+reload_param( struct stumpless_param *param,
+              const char *name,
+              size_t name_length,
+              const char *value,
+              size_t value_length );
+
 /**
  * Does the same as stumpless_load_param, but without performing any validation
  * or NULL checks.
@@ -54,6 +93,9 @@ lock_param( const struct stumpless_param *param );
  * over the lifetime of the param, and must be valid until
  * `stumpless_unload_param` is called on this loaded param.
  *
+ * @param value_length The length of the value in bytes, not including any NULL
+ * terminator.
+ *
  * @return A pointer to the loaded param, if no error is encountered. If an
  * error is encountered, then NULL is returned and an error code is set
  * appropriately.
@@ -62,7 +104,48 @@ struct stumpless_param *
 unchecked_load_param( struct stumpless_param *param,
                       const char *name,
                       size_t name_length,
-                      const char *value );
+                      const char *value,
+                      size_t value_length );
+
+/**
+ * Does the same as unchecked_load_param, but stores the value pointer in the
+ * param instead of copying it. The value is not freed when the param is
+ * unloaded.
+ *
+ * **Thread Safety: MT-Safe race:param race:name**
+ * This function is thread safe, assuming that the param and name are not
+ * changed by other threads during execution.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * mutex initialization routine.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a mutex initialization routine.
+ *
+ * @param param The struct to load with the given values.
+ *
+ * @param name The name of the param.
+ *
+ * @param name_length The length of the name in bytes, not including the NULL
+ * terminator.
+ *
+ * @param value The value of the param. This must remain valid until the value
+ * is replaced or the param is unloaded or destroyed.
+ *
+ * @param value_length The length of the value in bytes.
+ *
+ * @return A pointer to the loaded param, if no error is encountered. If an
+ * error is encountered, then NULL is returned and an error code is set
+ * appropriately.
+ */
+struct stumpless_param *
+unchecked_load_param_borrowed( struct stumpless_param *param,
+                               const char *name,
+                               size_t name_length,
+                               const char *value,
+                               size_t value_length );
 
 void
 unlock_param( const struct stumpless_param *param );
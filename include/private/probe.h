@@ -0,0 +1,44 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STUMPLESS_PRIVATE_PROBE_H
+#  define __STUMPLESS_PRIVATE_PROBE_H
+
+#  include <stumpless/probe.h>
+
+/**
+ * Calls the probe hook with the given probe, if one is set.
+ *
+ * **Thread Safety: MT-Safe race:hook**
+ * This function is thread safe, as long as the hook is not changed at the same
+ * time. The hook itself must also be thread safe.
+ *
+ * **Async Signal Safety: AS-Unsafe**
+ * This function is not safe to call from signal handlers, as the hook may not
+ * be.
+ *
+ * **Async Cancel Safety: AC-Unsafe**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, as the hook may not be.
+ *
+ * @param probe The probe that was reached.
+ */
+void
+fire_probe( enum stumpless_probe probe );
+
+#endif /* __STUMPLESS_PRIVATE_PROBE_H */
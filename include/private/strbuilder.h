@@ -34,6 +34,37 @@ strbuilder_append_buffer( struct strbuilder *builder,
 struct strbuilder *
 strbuilder_append_char( struct strbuilder *builder, char c );
 
+/**
+ * Appends a param value, escaping the '"', '\\', and ']' characters as
+ * required by RFC 5424. Runs of characters that do not need to be escaped are
+ * appended together.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is not thread safe.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the potential
+ * use of memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the potential use of memory management functions.
+ *
+ * @param builder The strbuilder to append the value to.
+ *
+ * @param value The param value to append. This does not need to be NULL
+ * terminated.
+ *
+ * @param length The length of value in bytes.
+ *
+ * @return The modified builder if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+struct strbuilder *
+strbuilder_append_escaped_param_value( struct strbuilder *builder,
+                                       const char *value,
+                                       size_t length );
+
 /**
  * Appends an int value. The value is assumed to be greater than or equal to
  * zero. If it is negative, a negative sign is NOT included in the sequence of
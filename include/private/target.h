@@ -20,9 +20,73 @@
 #  define __STUMPLESS_PRIVATE_TARGET_H
 
 #  include <stddef.h>
+#  include <stdint.h>
 #  include <stumpless/entry.h>
+#  include <stumpless/format.h>
 #  include <stumpless/target.h>
 #  include "private/config.h"
+#  include "private/config/wrapper/thread_safety.h"
+
+/**
+ * The counters of a target, reported by stumpless_get_target_stats.
+ */
+struct target_stats {
+  config_atomic_u64_t entries_accepted;
+  config_atomic_u64_t entries_filtered;
+  config_atomic_u64_t entries_sent;
+  config_atomic_u64_t entries_failed;
+  config_atomic_u64_t bytes_written;
+  config_atomic_u64_t latency_counts[STUMPLESS_LATENCY_BUCKET_COUNT];
+/**
+ * Whether the latency of each send is recorded in latency_counts. This is off
+ * by default so that the clock is not read for every entry.
+ */
+  config_atomic_bool_t latency_enabled;
+};
+
+/**
+ * The maximum length of a pre-rendered header segment: a hostname, an app
+ * name, a process id, and the space after each.
+ */
+#  define TARGET_HEADER_MAX_LENGTH \
+( STUMPLESS_MAX_HOSTNAME_LENGTH + STUMPLESS_MAX_APP_NAME_LENGTH + 16 )
+
+struct binary_encoder;
+
+/**
+ * The part of the header of a formatted entry that follows the timestamp,
+ * rendered ahead of time from the settings of a target. It is rebuilt each
+ * time one of these settings changes, so that entries using the defaults can
+ * copy it instead of formatting each field.
+ *
+ * The hostname and app name are not stored apart from the segment, so that
+ * only the rendered part of it needs to be copied when the header is read.
+ */
+struct target_header {
+/**
+ * The number of characters in the hostname of the system at the time the
+ * header was rendered, which starts the segment.
+ */
+  size_t hostname_length;
+/**
+ * The number of characters in the default app name of the target, which
+ * follows the hostname and a space in the segment.
+ */
+  size_t app_name_length;
+/** The process id, or 0 if the PID option was not set on the target. */
+  int pid;
+/** The `HOSTNAME APP-NAME PROCID ` segment. */
+  char segment[TARGET_HEADER_MAX_LENGTH];
+/** The number of characters in the segment. */
+  size_t segment_length;
+/** The format that entries are written in. */
+  enum stumpless_format format;
+/**
+ * The state of the binary format, or NULL if the format has never been used
+ * by the target. This is kept until the target is destroyed.
+ */
+  struct binary_encoder *binary_encoder;
+};
 
 void
 destroy_target( const struct stumpless_target *target );
@@ -37,6 +101,51 @@ COLD_FUNCTION
 struct stumpless_target *
 open_unsupported_target( struct stumpless_target *target );
 
+/**
+ * Copies the pre-rendered header of a target. Only the rendered part of the
+ * segment is copied.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. The target is locked while the header is
+ * copied.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled due to the use of a lock that could be left locked.
+ *
+ * @param target The target to read the header of.
+ *
+ * @param header The structure to copy the header into.
+ */
+void
+read_target_header( const struct stumpless_target *target,
+                    struct target_header *header );
+
+/**
+ * Renders the header of a target from its current settings and the hostname
+ * and process id of the system. The target must be locked by the caller.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe unless the caller holds the lock on the
+ * target.
+ *
+ * **Async Signal Safety: AS-Unsafe**
+ * This function is not safe to call from signal handlers as the header may be
+ * left partially rendered.
+ *
+ * **Async Cancel Safety: AC-Unsafe**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled as the header may be left partially rendered.
+ *
+ * @param target The target to render the header of.
+ */
+void
+render_target_header( struct stumpless_target *target );
+
 /**
  * Ignores all parameters and raises a target unsupported error.
  *
@@ -69,11 +178,26 @@ send_entry_and_msg_to_unsupported_target( const struct stumpless_target *target,
                                           const char *msg,
                                           size_t msg_size );
 
+COLD_FUNCTION
+int
+send_entries_to_unsupported_target( const struct stumpless_target *target,
+                                    const struct stumpless_entry * const *entries,
+                                    size_t entry_count,
+                                    int *results );
+
 COLD_FUNCTION
 int
 send_entry_to_unsupported_target( const struct stumpless_target *target,
                                   const struct stumpless_entry *entry );
 
+COLD_FUNCTION
+int
+sendto_batch_to_unsupported_target( const struct stumpless_target *target,
+                                    const char *msgs,
+                                    const size_t *ends,
+                                    size_t count,
+                                    int *results );
+
 COLD_FUNCTION
 int
 sendto_unsupported_target( const struct stumpless_target *target,
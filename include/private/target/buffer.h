@@ -61,4 +61,28 @@ sendto_buffer_target( struct buffer_target *target,
                       const char *msg,
                       size_t msg_length );
 
+/**
+ * Writes a batch of formatted messages to a buffer target while holding the
+ * buffer_mutex once. Each message is stored separately, as if it had been sent
+ * on its own.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. The buffer_mutex is used to coordinate updates
+ * to the buffer and its positions.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ */
+int
+sendto_buffer_target_batch( struct buffer_target *target,
+                            const char *msgs,
+                            const size_t *ends,
+                            size_t count,
+                            int *results );
+
 #endif /* __STUMPLESS_PRIVATE_TARGET_BUFFER_H */
@@ -25,16 +25,23 @@
 #  include <stumpless/target.h>
 #  include "private/config/wrapper/thread_safety.h"
 
+struct file_compressor;
+
 /**
  * Internal representation of a file target.
  */
 struct file_target {
 /** A stream for the file this target writes to. */
   FILE *stream;
+/**
+ * The compression state of the target, or NULL if messages are written to the
+ * file as they are.
+ */
+  struct file_compressor *compressor;
 #ifdef STUMPLESS_THREAD_SAFETY_SUPPORTED
 /**
- * Protects stream. This mutex must be locked by a thread before it can write
- * to the stream.
+ * Protects stream and compressor. This mutex must be locked by a thread before
+ * it can write to the stream.
  */
   config_mutex_t stream_mutex;
 #endif
@@ -46,8 +53,17 @@ destroy_file_target( struct file_target *target );
 struct stumpless_target *
 file_open_default_target( void );
 
+/**
+ * Creates a file target that writes messages to the file as they are.
+ *
+ * @param filename The name of the file to open.
+ *
+ * @param mode The mode to pass to fopen, which should append to the file.
+ *
+ * @return The new file target, or NULL if an error is encountered.
+ */
 struct file_target *
-new_file_target( const char *filename );
+new_file_target( const char *filename, const char *mode );
 
 /**
  * **Thread Safety: MT-Safe**
@@ -67,4 +83,27 @@ sendto_file_target( struct file_target *target,
                     const char *msg,
                     size_t msg_length );
 
+/**
+ * Writes a batch of formatted messages to a file target with a single call to
+ * fwrite.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. The stream_mutex is used to coordinate updates
+ * to the logged file.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate file writes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ */
+int
+sendto_file_target_batch( struct file_target *target,
+                          const char *msgs,
+                          const size_t *ends,
+                          size_t count,
+                          int *results );
+
 #endif /* __STUMPLESS_PRIVATE_TARGET_FILE_H */
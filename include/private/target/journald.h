@@ -19,8 +19,11 @@
 #ifndef __STUMPLESS_PRIVATE_TARGET_JOURNALD_H
 #  define __STUMPLESS_PRIVATE_TARGET_JOURNALD_H
 
+#  include <stdbool.h>
 #  include <stddef.h>
+#  include <stumpless/element.h>
 #  include <stumpless/entry.h>
+#  include <stumpless/param.h>
 #  include <stumpless/target.h>
 
 /**
@@ -112,6 +115,57 @@ init_fixed_fields( void );
 void
 journald_free_thread( void );
 
+/**
+ * Loads the cached journald field name of an element, including the trailing
+ * '=' character, building it first if it is not yet cached. This is only
+ * valid for elements using the default journald namer.
+ *
+ * **Thread Safety: MT-Safe race:element**
+ * This function is thread safe, assuming that the element is already locked
+ * by the caller.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param element The element to load the field name of.
+ *
+ * @return The length of the cached field name.
+ */
+size_t
+load_element_field( struct stumpless_element *element );
+
+/**
+ * Loads all of the fields for an entry into the per-thread fields buffer,
+ * including the timestamp and pid fields.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe as it locks the entry and operates only on the
+ * active thread's resources.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions and non-reentrant locks.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions and locks that may
+ * not be released if a thread is cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to load the fields from.
+ *
+ * @return The number of fields loaded, or 0 if an error was encountered.
+ */
+size_t
+load_entry_fields( const struct stumpless_entry *entry );
+
 /**
  * Loads the facility field according to an entry's facility.
  *
@@ -203,6 +257,35 @@ load_message( const struct stumpless_entry *entry );
 void
 load_msgid( const struct stumpless_entry *entry );
 
+/**
+ * Loads the cached journald field prefix of a param, of the form
+ * ELEMENT_PARAM=, building it first if it is not yet cached for the given
+ * element. This is only valid when both the element and param use the default
+ * journald namers.
+ *
+ * **Thread Safety: MT-Safe race:element race:param**
+ * This function is thread safe, assuming that the element and param are
+ * already locked by the caller.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param element The element that the param is part of.
+ *
+ * @param param The param to load the prefix of.
+ *
+ * @return The length of the cached prefix.
+ */
+size_t
+load_param_prefix( struct stumpless_element *element,
+                   struct stumpless_param *param );
+
 /**
  * Loads the pid field with the current pid.
  *
@@ -291,6 +374,43 @@ load_sd_fields( const struct stumpless_entry *entry );
 size_t
 load_timestamp( void );
 
+/**
+ * Sends a group of entries to the given target. When the native protocol is
+ * used, all of the entries are encoded before any are sent so that they can
+ * be written with as few system calls as possible.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Unsafe**
+ * Logging to journald targets is not signal safe due to the use of a
+ * thread-local buffer.
+ *
+ * **Async Cancel Safety: AC-Unsafe**
+ * Logging to journald targets is not async cancellation safe as it relies on
+ * functions which are not documented as such.
+ *
+ * @since release v3.1.0
+ *
+ * @param target Where to send the entries.
+ *
+ * @param entries The entries to log.
+ *
+ * @param entry_count The number of entries in the entries array.
+ *
+ * @param results Set to the result of sending each entry. As the entries are
+ * sent together, these are all the same as the return value.
+ *
+ * @return 0 if all entries were sent, a negative errno value if the entries
+ * could not be sent to journald, or -1 if an error is encountered before they
+ * are sent.
+ */
+int
+send_entries_to_journald_target( const struct stumpless_target *target,
+                                 const struct stumpless_entry * const *entries,
+                                 size_t entry_count,
+                                 int *results );
+
 /**
  * Sends the given entry to the given target.
  *
@@ -339,4 +459,52 @@ send_entry_to_journald_target( const struct stumpless_target *target,
 void
 set_field_bases( void );
 
+/**
+ * Checks whether an element uses the default journald namer, and can
+ * therefore use its cached field name.
+ *
+ * **Thread Safety: MT-Safe race:element**
+ * This function is thread safe, assuming that the element is already locked
+ * by the caller.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param element The element to check.
+ *
+ * @return true if the element uses the default namer, false otherwise.
+ */
+bool
+uses_default_element_namer( const struct stumpless_element *element );
+
+/**
+ * Checks whether a param uses the default journald namer, and can therefore
+ * use its cached field prefix if its element does as well.
+ *
+ * **Thread Safety: MT-Safe race:param**
+ * This function is thread safe, assuming that the param is already locked
+ * by the caller.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param param The param to check.
+ *
+ * @return true if the param uses the default namer, false otherwise.
+ */
+bool
+uses_default_param_namer( const struct stumpless_param *param );
+
 #endif /* __STUMPLESS_PRIVATE_TARGET_JOURNALD_H */
@@ -20,7 +20,9 @@
 #  define __STUMPLESS_PRIVATE_TARGET_NETWORK_H
 
 
+#  include <stdbool.h>
 #  include <stddef.h>
+#  include <stdint.h>
 #  include <stumpless/config.h>
 #  include <stumpless/target.h>
 #  include <stumpless/target/network.h>
@@ -34,6 +36,55 @@ struct network_target {
   size_t max_msg_size;
   const char *port;
   config_socket_handle_t handle;
+/**
+ * The initial delay before trying to reconnect a TCP target that has lost its
+ * connection, in milliseconds. Automatic reconnection is disabled if this is
+ * zero.
+ */
+  unsigned reconnect_min_delay;
+/** The maximum delay between reconnection attempts, in milliseconds. */
+  unsigned reconnect_max_delay;
+/** The delay to use after the next failed reconnection attempt. */
+  unsigned reconnect_delay;
+/** The monotonic time before which no reconnection is attempted. */
+  uint64_t next_reconnect;
+/**
+ * Frames that are held while the connection is down, to be sent as soon as it
+ * is restored. This is only used if reconnection is enabled.
+ */
+  char *spill_buffer;
+/** The maximum number of bytes that the spill buffer may hold. */
+  size_t spill_size;
+/** The number of bytes currently held in the spill buffer. */
+  size_t spill_used;
+/**
+ * The longest time to wait for a TCP socket to accept more of a frame, in
+ * milliseconds. Sends wait indefinitely if this is zero.
+ */
+  unsigned send_timeout;
+/**
+ * Additional connections to the same destination that entries are spread
+ * across. These share the destination and port of this target, and are NULL
+ * if only one connection is used.
+ */
+  struct network_target **connections;
+/** The total number of connections, including this one. */
+  size_t connection_count;
+/**
+ * Additional collectors that entries are spread across according to the
+ * balance policy. Each one is a complete network target of its own, and this
+ * is NULL if only one destination is used.
+ */
+  struct network_target **destinations;
+/** The number of additional destinations, not including this one. */
+  size_t destination_count;
+/** How entries are spread across this and the additional destinations. */
+  enum stumpless_network_balance_policy balance_policy;
+/**
+ * The monotonic time before which this destination is skipped after a failed
+ * send, or zero if it is healthy.
+ */
+  uint64_t unhealthy_until;
 #ifdef STUMPLESS_THREAD_SAFETY_SUPPORTED
 /**
  * A mutex to coordinate updates and writes to this target's socket. While the
@@ -59,9 +110,21 @@ lock_network_target( const struct network_target *target );
 void
 network_free_all( void );
 
+void
+network_target_connection_failed( struct network_target *target );
+
+void
+network_target_connection_restored( struct network_target *target );
+
 int
 network_target_is_open( const struct stumpless_target *target );
 
+bool
+network_target_reconnect_due( const struct network_target *target );
+
+bool
+network_target_reconnect_enabled( const struct network_target *target );
+
 struct network_target *
 new_network_target( enum stumpless_network_protocol network,
                     enum stumpless_transport_protocol transport );
@@ -74,10 +137,33 @@ open_new_network_target( const char *destination,
                          enum stumpless_network_protocol network,
                          enum stumpless_transport_protocol transport );
 
+/**
+ * Sends a formatted message to a network target, spreading it across the
+ * destinations of the target according to its balance policy if there are
+ * more than one.
+ *
+ * @param target The network target to send the message to.
+ *
+ * @param msg The message to send, including a trailing newline.
+ *
+ * @param msg_length The length of the message, including the newline.
+ *
+ * @param prival The prival of the entry the message was formatted from, used
+ * by balance policies that pick a destination based on the entry.
+ *
+ * @return A positive value if no error was encountered, -1 otherwise. If an
+ * error is encountered, an error code is set appropriately.
+ */
 int
 sendto_network_target( struct network_target *target,
                        const char *msg,
-                       size_t msg_length );
+                       size_t msg_length,
+                       int prival );
+
+int
+spill_network_frame( struct network_target *target,
+                     const char *frame,
+                     size_t frame_length );
 
 void
 unlock_network_target( const struct network_target *target );
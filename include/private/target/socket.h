@@ -42,4 +42,11 @@ sendto_socket_target( const struct socket_target *target,
                       const char *msg,
                       size_t msg_length );
 
+int
+sendto_socket_target_batch( const struct socket_target *target,
+                            const char *msgs,
+                            const size_t *ends,
+                            size_t count,
+                            int *results );
+
 #endif /* __STUMPLESS_PRIVATE_TARGET_SOCKET_H */
@@ -128,4 +128,41 @@ int
 send_entry_to_sqlite3_target( const struct stumpless_target *target,
                               const struct stumpless_entry *entry );
 
+/**
+ * Sends a group of entries to a database target within a single transaction.
+ * If a transaction cannot be started, for example because one is already open
+ * on the connection, the entries are still inserted one at a time.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. The db_mutex is held while all of the entries
+ * are inserted.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate database access.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The SQLite3 target to send the entries to.
+ *
+ * @param entries The entries to send to the database.
+ *
+ * @param entry_count The number of entries in the entries array.
+ *
+ * @param results Set to the result of inserting each entry.
+ *
+ * @return A value greater than or equal to zero if every entry was inserted.
+ * If an error was encountered then a negative value is returned and an error
+ * code is set appropriately.
+ */
+int
+send_entries_to_sqlite3_target( const struct stumpless_target *target,
+                                const struct stumpless_entry * const *entries,
+                                size_t entry_count,
+                                int *results );
+
 #endif /* __STUMPLESS_PRIVATE_TARGET_SQLITE3_H */
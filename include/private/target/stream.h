@@ -25,6 +25,16 @@
 #  include <stumpless/entry.h>
 #  include "private/config/wrapper/thread_safety.h"
 
+/** The maximum size of a severity escape code, including the NULL character. */
+#  define STREAM_TARGET_ESCAPE_CODE_SIZE 32
+
+/** The ANSI escape code written after a colored message. */
+#  define STREAM_TARGET_RESET_CODE "\33[0m"
+
+/** The length of STREAM_TARGET_RESET_CODE, without the NULL character. */
+#  define STREAM_TARGET_RESET_CODE_LENGTH \
+( sizeof( STREAM_TARGET_RESET_CODE ) - 1 )
+
 /**
  * Internal representation of a stream target.
  */
@@ -32,11 +42,23 @@ struct stream_target {
 /** The stream this target writes to. */
   FILE *stream;
 /** ANSI colors for different severities (when using ansi terminal) */
-  char escape_codes[8][32];
+  char escape_codes[8][STREAM_TARGET_ESCAPE_CODE_SIZE];
+/**
+ * The length of each of the escape codes, computed when they are set. A length
+ * of zero means that messages of that severity are not colored.
+ */
+  size_t escape_code_lengths[8];
+/**
+ * Holds a colored message so that it can be written in a single call. This is
+ * only grown as needed, and is reused for each colored message.
+ */
+  char *line_buffer;
+/** The size of line_buffer. */
+  size_t line_buffer_size;
 #  ifdef STUMPLESS_THREAD_SAFETY_SUPPORTED
 /**
- * Protects stream. This mutex must be locked by a thread before it can write
- * to the stream.
+ * Protects stream, the escape codes, and line_buffer. This mutex must be
+ * locked by a thread before it can write to the stream or update colors.
  */
   config_mutex_t stream_mutex;
 #  endif
@@ -49,6 +71,14 @@ struct stream_target *
 new_stream_target( FILE *stream );
 
 /**
+ * Sends a formatted message to a stream target. If an escape code is set for
+ * the severity of the message, then the message is surrounded by the escape
+ * code and the reset code and written in a single call.
+ *
+ * The severity is passed in by the caller, as read when the entry was
+ * formatted, so that colors do not depend on the output format and the entry
+ * does not need to be locked again.
+ *
  * **Thread Safety: MT-Safe**
  * This function is thread safe. The stream_mutex is used to coordinate updates
  * to the stream.
@@ -60,11 +90,59 @@ new_stream_target( FILE *stream );
  * **Async Cancel Safety: AC-Unsafe lock**
  * This function is not safe to call from threads that may be asynchronously
  * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @param target The stream target to write to.
+ *
+ * @param msg The formatted message.
+ *
+ * @param msg_length The length of the message.
+ *
+ * @param severity The severity of the entry the message was formatted from.
  */
 int
 sendto_stream_target( struct stream_target *target,
                       const char *msg,
                       size_t msg_length,
-		      const struct stumpless_entry *entry );
+                      int severity );
+
+/**
+ * Writes a batch of formatted messages to a stream target while holding the
+ * stream_mutex once. Consecutive messages without color escape codes are
+ * written with a single call to fwrite.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. The stream_mutex is used to coordinate updates
+ * to the stream.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate writes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @param target The stream target to write to.
+ *
+ * @param msgs The messages of the batch, one after another.
+ *
+ * @param ends The offset just past the end of each message in msgs.
+ *
+ * @param severities The severity of the entry each message was formatted from.
+ *
+ * @param count The number of messages in the batch.
+ *
+ * @param results Set to the result of sending each message.
+ *
+ * @return A non-negative value if every message was written, or -1 if any of
+ * them could not be.
+ */
+int
+sendto_stream_target_batch( struct stream_target *target,
+                            const char *msgs,
+                            const size_t *ends,
+                            const int *severities,
+                            size_t count,
+                            int *results );
 
 #endif /* __STUMPLESS_PRIVATE_TARGET_STREAM_H */
@@ -94,6 +94,21 @@ if( unlikely( ( ARG_NAME)  == NULL ) ) {                                       \
 bool
 validate_app_name( const char *str, size_t *length );
 
+/**
+ * Checks a app name of a known length for validity, in the same way as
+ * validate_app_name but without scanning for a NULL terminator.
+ *
+ * @param str The app name to validate. This does not need to be NULL
+ * terminated.
+ *
+ * @param length The length of the app name in bytes.
+ *
+ * @return True if the app name is valid. If the app name is not valid then
+ * false is returned and an appropriate error is raised.
+ */
+bool
+validate_app_name_buf( const char *str, size_t length );
+
 /**
  * Checks the length of app name.
  *
@@ -124,6 +139,21 @@ validate_app_name_length( const char *app_name, size_t *length );
 bool
 validate_element_name( const char *str, size_t *length );
 
+/**
+ * Checks a element name of a known length for validity, in the same way as
+ * validate_element_name but without scanning for a NULL terminator.
+ *
+ * @param str The element name to validate. This does not need to be NULL
+ * terminated.
+ *
+ * @param length The length of the element name in bytes.
+ *
+ * @return True if the element name is valid. If the element name is not valid
+ * then false is returned and an appropriate error is raised.
+ */
+bool
+validate_element_name_buf( const char *str, size_t length );
+
 /**
  * Checks that the passed in element name is of valid length
  *
@@ -153,6 +183,21 @@ validate_element_name_length( const char *str, size_t *length );
 bool
 validate_hostname( const char *hostname, size_t *length );
 
+/**
+ * Checks a hostname of a known length for validity, in the same way as
+ * validate_hostname but without scanning for a NULL terminator.
+ *
+ * @param hostname The hostname to validate. This does not need to be NULL
+ * terminated.
+ *
+ * @param length The length of the hostname in bytes.
+ *
+ * @return True if the hostname is valid. If the hostname is not valid then
+ * false is returned and an appropriate error is raised.
+ */
+bool
+validate_hostname_buf( const char *hostname, size_t length );
+
 /**
  * Checks the length of a hostname.
  *
@@ -182,6 +227,21 @@ validate_hostname_length( const char *hostname, size_t *length );
 bool
 validate_msgid( const char *str, size_t *length );
 
+/**
+ * Checks a msgid of a known length for validity, in the same way as
+ * validate_msgid but without scanning for a NULL terminator.
+ *
+ * @param str The msgid to validate. This does not need to be NULL
+ * terminated.
+ *
+ * @param length The length of the msgid in bytes.
+ *
+ * @return True if the msgid is valid. If the msgid is not valid then
+ * false is returned and an appropriate error is raised.
+ */
+bool
+validate_msgid_buf( const char *str, size_t length );
+
 /**
  * Checks the char length of msgid.
  *
@@ -225,6 +285,21 @@ validate_name_chars( const char *str, size_t length );
 bool
 validate_param_name( const char *str, size_t *length );
 
+/**
+ * Checks a param name of a known length for validity, in the same way as
+ * validate_param_name but without scanning for a NULL terminator.
+ *
+ * @param str The param name to validate. This does not need to be NULL
+ * terminated.
+ *
+ * @param length The length of the param name in bytes.
+ *
+ * @return True if the param name is valid. If the param name is not valid then
+ * false is returned and an appropriate error is raised.
+ */
+bool
+validate_param_name_buf( const char *str, size_t length );
+
 /**
  * Checks that the passed in param name is of valid length.
  *
@@ -281,6 +356,21 @@ validate_printable_ascii( const char *str, size_t length );
 bool
 validate_procid( const char *procid, size_t *length );
 
+/**
+ * Checks a procid of a known length for validity, in the same way as
+ * validate_procid but without scanning for a NULL terminator.
+ *
+ * @param procid The procid to validate. This does not need to be NULL
+ * terminated.
+ *
+ * @param length The length of the procid in bytes.
+ *
+ * @return True if the procid is valid. If the procid is not valid then
+ * false is returned and an appropriate error is raised.
+ */
+bool
+validate_procid_buf( const char *procid, size_t length );
+
 /**
  * Checks the char length of procid.
  *
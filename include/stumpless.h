@@ -175,12 +175,14 @@
 #ifndef __STUMPLESS_H
 #define __STUMPLESS_H
 
+#include <stumpless/binary.h>
 #include <stumpless/config.h>
 #include <stumpless/element.h>
 #include <stumpless/entry.h>
 #include <stumpless/error.h>
 #include <stumpless/facility.h>
 #include <stumpless/filter.h>
+#include <stumpless/format.h>
 #include <stumpless/generator.h>
 #include <stumpless/id.h>
 #include <stumpless/level/alert.h>
@@ -196,7 +198,9 @@
 #include <stumpless/memory.h>
 #include <stumpless/option.h>
 #include <stumpless/param.h>
+#include <stumpless/parse.h>
 #include <stumpless/prival.h>
+#include <stumpless/probe.h>
 #include <stumpless/severity.h>
 #include <stumpless/target.h>
 #include <stumpless/target/buffer.h>
@@ -204,6 +208,7 @@
 #include <stumpless/target/function.h>
 #include <stumpless/target/sqlite3.h>
 #include <stumpless/target/stream.h>
+#include <stumpless/template.h>
 #include <stumpless/version.h>
 
 #ifdef STUMPLESS_CHAIN_TARGETS_SUPPORTED
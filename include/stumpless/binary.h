@@ -0,0 +1,165 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * Decoding of entries written in the binary format.
+ *
+ * Targets write the binary format once STUMPLESS_FORMAT_BINARY is passed to
+ * stumpless_set_target_format. Each entry is written as a record made up of
+ * the length of the record body, the body, and a newline. All integers are
+ * written as little endian base 128 varints of the value plus one, so that a
+ * record never contains a zero byte. The body holds the following, in order:
+ *
+ *  - A flags byte, with the high bit always set. The lowest bit is set if the
+ *    dictionary is reset before the record, and the next bit is set if a
+ *    timestamp is present.
+ *  - The prival.
+ *  - The timestamp as nanoseconds since the Unix epoch, if present.
+ *  - The hostname, app name, procid, and msgid. The procid is a string, and
+ *    the others are names.
+ *  - The number of elements, and for each element its name and the number of
+ *    params, followed by the name and value string of each param.
+ *  - The message string.
+ *
+ * A string is its length followed by its characters. A name is an integer
+ * which is odd if the name was seen before, in which case the integer divided
+ * by two is the index of the name in the dictionary. Otherwise the integer
+ * divided by two is the length of the name, and the characters follow. Names
+ * that are no longer than STUMPLESS_MAX_APP_NAME_LENGTH are added to the
+ * dictionary when they are first seen, until it has 256 names.
+ *
+ * The dictionary is reset in the first record written after the format is
+ * set, every 256 records, when it is full, and after a record could not be
+ * written. A decoder that starts in the middle of a stream or misses a record
+ * will fail to decode records until the next reset.
+ *
+ * @since release v3.1.0
+ */
+
+#ifndef __STUMPLESS_BINARY_H
+#  define __STUMPLESS_BINARY_H
+
+#  include <stddef.h>
+#  include <stumpless/config.h>
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif
+
+/**
+ * Converts a stream of binary records back into RFC 5424 messages.
+ *
+ * @since release v3.1.0
+ */
+struct stumpless_binary_decoder;
+
+/**
+ * Decodes the next binary record in a buffer into an RFC 5424 message.
+ *
+ * The records must be passed to the decoder in the order they were written,
+ * as names are taken from the dictionary built by earlier records.
+ *
+ * The trailing newline of a record may also be a NULL character, so that
+ * records read from a buffer target with stumpless_read_buffer can be decoded
+ * by passing the returned size.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the decoder is not locked while it is
+ * used. A decoder should not be shared between threads.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param decoder The decoder to use.
+ *
+ * @param data The data to decode, starting at the beginning of a record.
+ *
+ * @param size The number of bytes in data.
+ *
+ * @param consumed Set to the number of bytes that were used. This is the size
+ * of the record if it was decoded or is not valid, and zero if data does not
+ * hold a complete record yet.
+ *
+ * @return The decoded message, without a trailing newline. This is valid until
+ * the next call with the same decoder, and must not be freed by the caller. If
+ * the record is not complete, then NULL is returned without an error. If an
+ * error is encountered, then NULL is returned and an error code is set
+ * appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+const char *
+stumpless_decode_binary_record( struct stumpless_binary_decoder *decoder,
+                                const char *data,
+                                size_t size,
+                                size_t *consumed );
+
+/**
+ * Destroys a decoder.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the decoder must not be in use.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param decoder The decoder to destroy. If this is NULL, then nothing is done.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+void
+stumpless_destroy_binary_decoder( const struct stumpless_binary_decoder *decoder );
+
+/**
+ * Creates a decoder for a stream of binary records.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @return The new decoder, or NULL if an error is encountered.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_binary_decoder *
+stumpless_new_binary_decoder( void );
+
+#  ifdef __cplusplus
+}                               /* extern "C" */
+#  endif
+#endif                          /* __STUMPLESS_BINARY_H */
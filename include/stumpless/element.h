@@ -125,11 +125,44 @@ struct stumpless_element {
   struct stumpless_param **params;
 /** The number of params in the array. */
   size_t param_count;
+/**
+ * The number of params held in the params array. Params past param_count are
+ * kept after the entry holding this element is reset with
+ * stumpless_reset_entry, and are reused by stumpless_add_new_param. Only params
+ * created by this element are kept: params added with stumpless_add_param are
+ * left to the caller.
+ *
+ * @since release v3.1.0
+ */
+  size_t param_capacity;
+/**
+ * The entry that created this element, for example with
+ * stumpless_add_new_element, or NULL if the element was created by the caller.
+ * Only elements created by an entry are kept for reuse when it is reset.
+ *
+ * @since release v3.1.0
+ */
+  const struct stumpless_entry *owner;
 #ifdef STUMPLESS_JOURNALD_TARGETS_SUPPORTED
 /**
  * Gets the name to use for the journald field corresponding to this element.
  */
   stumpless_element_namer_func_t get_journald_name;
+/**
+ * The journald field name for this element produced by the default namer,
+ * including the trailing '=' character. This is filled in the first time the
+ * element is sent to a journald target and reset when the element is renamed.
+ *
+ * @since release v3.1.0
+ */
+  char journald_field[STUMPLESS_MAX_ELEMENT_NAME_LENGTH + 1];
+/**
+ * The number of characters in journald_field, or 0 if it has not been filled
+ * in.
+ *
+ * @since release v3.1.0
+ */
+  size_t journald_field_length;
 #endif
 #ifdef STUMPLESS_THREAD_SAFETY_SUPPORTED
 /**
@@ -296,6 +329,11 @@ stumpless_destroy_element_and_contents( const struct stumpless_element *e );
  * Destroys an element, freeing any allocated memory. Associated params are left
  * untouched, and must be destroyed separately.
  *
+ * Params that the element kept for reuse after the entry holding it was reset
+ * are no longer associated with it, and are destroyed as well. Params still in
+ * the element are left to the caller, and are no longer considered to be
+ * created by it.
+ *
  * **Thread Safety: MT-Unsafe**
  * This function is not thread safe as it destroys resources that other threads
  * would use if they tried to reference this struct.
@@ -760,6 +798,37 @@ STUMPLESS_PUBLIC_FUNCTION
 struct stumpless_element *
 stumpless_new_element( const char *name );
 
+/**
+ * Creates a new element with a name given as a buffer with a length instead
+ * of a NULL terminated string.
+ *
+ * **Thread Safety: MT-Safe race:name**
+ * This function is thread safe, of course assuming that name is not changed
+ * by other threads during execution.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions to create the new element.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param name The name of the new element. This does not need to be NULL
+ * terminated. Valid names have printable ASCII characters except '=', ']',
+ * and '"' and are at most 32 characters long.
+ *
+ * @param name_length The length of name in bytes.
+ *
+ * @return The created element, if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_element *
+stumpless_new_element_buf( const char *name, size_t name_length );
+
 /**
  * Sets the name of the given element.
  *
@@ -792,6 +861,42 @@ struct stumpless_element *
 stumpless_set_element_name( struct stumpless_element *element,
                             const char *name );
 
+/**
+ * Sets the name of the given element to a buffer of a given length, instead of
+ * a NULL terminated string.
+ *
+ * **Thread Safety: MT-Safe race:name**
+ * This function is thread safe, assuming that the name is not changed by other
+ * threads during execution. A mutex is used to coordinate changes to the
+ * element with other accesses and modifications.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate access.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param element The element to set the name of.
+ *
+ * @param name The new name of the element. This does not need to be NULL
+ * terminated. Valid names have printable ASCII characters except '=', ']',
+ * and '"' and are at most 32 characters long.
+ *
+ * @param name_length The length of name in bytes.
+ *
+ * @return The modified element, if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_element *
+stumpless_set_element_name_buf( struct stumpless_element *element,
+                                const char *name,
+                                size_t name_length );
+
 /**
  * Puts the param at the given index in the given element.
  *
@@ -45,6 +45,13 @@
 /** The maximum length of a msgid, as specified by RFC 5424. */
 #  define STUMPLESS_MAX_MSGID_LENGTH 32
 
+/**
+ * The maximum length of a timestamp, as allowed by RFC 5424.
+ *
+ * @since release v3.1.0
+ */
+#  define STUMPLESS_MAX_TIMESTAMP_LENGTH 32
+
 #  ifdef __cplusplus
 extern "C" {
 #  endif
@@ -86,6 +93,22 @@ struct stumpless_entry {
  * @since release v2.1.0
  */
   size_t hostname_length;
+/**
+ * The timestamp of this entry, as a NULL-terminated string. This is set when
+ * the entry is loaded from a message with stumpless_load_entry_from_rfc_5424,
+ * so that the time of the original event is kept when it is forwarded.
+ *
+ * @since release v3.1.0
+ */
+  char timestamp[STUMPLESS_MAX_TIMESTAMP_LENGTH + 1];
+/**
+ * The length of the timestamp of this entry (in bytes), without a NULL
+ * terminator. If this is zero, then the time that the entry is sent will be
+ * used.
+ *
+ * @since release v3.1.0
+ */
+  size_t timestamp_length;
 /**
  * The prival of this entry. This is a combination of the facility and severity
  * of the event, combined using a bitwise or.
@@ -96,12 +119,21 @@ struct stumpless_entry {
 /** The length of the app name, without the NULL terminator. */
   size_t app_name_length;
 /**
- * The message of this entry, as a NULL-terminated string. This may be NULL
- * if the entry does not have a message set.
+ * The message of this entry, as a NULL-terminated string unless it was
+ * borrowed as described in message_borrowed. This may be NULL if the entry
+ * does not have a message set.
  */
   char *message;
 /** The length of the message in bytes, without the NULL terminator. */
   size_t message_length;
+/**
+ * True if message points to memory owned by the caller, as set by
+ * stumpless_set_entry_message_borrowed. Borrowed messages are not freed along
+ * with the entry, and are not necessarily NULL terminated.
+ *
+ * @since release v3.1.0
+ */
+  bool message_borrowed;
 /** The message id of this entry, as a NULL-terminated string. */
   char msgid[STUMPLESS_MAX_MSGID_LENGTH + 1];
 /** The length of the message id, without the NULL terminator. */
@@ -110,6 +142,16 @@ struct stumpless_entry {
   struct stumpless_element **elements;
 /** The number of elements in this entry. */
   size_t element_count;
+/**
+ * The number of elements held in the elements array. Elements past
+ * element_count are kept after the entry is reset with stumpless_reset_entry,
+ * and are reused by stumpless_add_new_element. Only elements created by this
+ * entry are kept: elements added with stumpless_add_element are left to the
+ * caller.
+ *
+ * @since release v3.1.0
+ */
+  size_t element_capacity;
 #  ifdef STUMPLESS_WINDOWS_EVENT_LOG_TARGETS_SUPPORTED
 /** A pointer to a wel_data structure. */
   void *wel_data;
@@ -321,6 +363,11 @@ stumpless_destroy_entry_and_contents( const struct stumpless_entry *entry );
  * Destroys an entry, freeing any allocated memory. Associated elements and
  * params are left untouched, and must be destroyed separately.
  *
+ * Elements that the entry kept for reuse after a call to stumpless_reset_entry
+ * or stumpless_load_entry_from_rfc_5424 are no longer associated with it, and
+ * are destroyed along with their params. Elements still in the entry are left
+ * to the caller, and are no longer considered to be created by it.
+ *
  * **Thread Safety: MT-Unsafe**
  * This function is not thread safe as it destroys resources that other threads
  * would use if they tried to reference this struct.
@@ -1093,6 +1140,148 @@ stumpless_new_entry_str( enum stumpless_facility facility,
                          const char *msgid,
                          const char *message );
 
+/**
+ * Creates a new entry with the given characteristics, reusing an entry from
+ * the entry pool of the current thread if one is available.
+ *
+ * Entries in the pool have been reset with stumpless_reset_entry, so they keep
+ * the memory for their elements and params. Adding elements and params to a
+ * pooled entry that it held before it was released reuses this memory instead
+ * of allocating it again. If the pool is empty, then this is the same as
+ * calling stumpless_new_entry_str.
+ *
+ * Entries created with this function should be returned to the pool with
+ * stumpless_release_pooled_entry when they are no longer needed, though they
+ * may also be destroyed with stumpless_destroy_entry_and_contents.
+ *
+ * **Thread Safety: MT-Safe race:app_name race:msgid race:message**
+ * This function is thread safe, of course assuming that the string arguments
+ * are not changed by other threads during execution. The entry pool is
+ * specific to each thread, so no locks are needed to take an entry from it.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions to create the new entry as well as the use of
+ * locks to change a pooled entry.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions and locks that
+ * could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param facility The facility code of the event this entry describes. This
+ * should be a \c STUMPLESS_FACILITY value.
+ *
+ * @param severity The severity code of the event this entry describes. This
+ * should be a \c STUMPLESS_SEVERITY value.
+ *
+ * @param app_name The app_name of the entry. If this is NULL, then it will be
+ * blank in the entry (a single '-' character).
+ *
+ * @param msgid The message id of the entry. If this is NULL, then it will be
+ * blank in the entry (a single '-' character).
+ *
+ * @param message The message in the entry. If this is NULL, then it will be
+ * blank in the entry (no characters). This must be a valid UTF-8 string in
+ * shortest form.
+ *
+ * @return The created entry if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_new_pooled_entry_str( enum stumpless_facility facility,
+                                enum stumpless_severity severity,
+                                const char *app_name,
+                                const char *msgid,
+                                const char *message );
+
+/**
+ * Returns an entry to the entry pool of the current thread so that it can be
+ * reused by stumpless_new_pooled_entry_str.
+ *
+ * The entry is reset with stumpless_reset_entry before it is added to the
+ * pool. If the pool is already full, then the entry is destroyed along with
+ * its contents instead. Any entry may be released this way, not only ones
+ * created with stumpless_new_pooled_entry_str, as long as no other references
+ * to it or its elements and params remain in use.
+ *
+ * The entries left in the pool are destroyed by stumpless_free_thread and
+ * stumpless_free_all.
+ *
+ * **Thread Safety: MT-Safe race:entry**
+ * This function is thread safe, assuming that the entry is not used by other
+ * threads after it is released.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions and locks.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions and locks that
+ * could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to release. If this is NULL, then nothing is done.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+void
+stumpless_release_pooled_entry( struct stumpless_entry *entry );
+
+/**
+ * Clears an entry so that it can be reused, without releasing the memory that
+ * it holds.
+ *
+ * After this call the entry has no elements, the app name and msgid are blank
+ * (a single '-' character), and the message is empty. The hostname and procid
+ * are cleared so that they are detected again when the entry is logged. The
+ * facility and severity are not changed.
+ *
+ * The elements and params that were created by the entry, for example with
+ * stumpless_add_new_element or stumpless_add_new_param_to_entry, are not
+ * destroyed. Instead they are kept past the end of the entry's elements, and
+ * are reused by later calls to stumpless_add_new_element,
+ * stumpless_add_new_param, and stumpless_add_new_param_to_entry, and when a
+ * message is loaded into the entry with stumpless_load_entry_from_rfc_5424.
+ * Because of this, pointers to elements and params that were retrieved from the
+ * entry must not be used after it is reset. The kept elements and params are
+ * destroyed along with the entry by either stumpless_destroy_entry_and_contents
+ * or stumpless_destroy_entry_only.
+ *
+ * Elements added to the entry with stumpless_add_element and params added with
+ * stumpless_add_param are not kept. They are removed from the entry or element
+ * that held them and are otherwise left untouched, so that they may still be
+ * used elsewhere and must be destroyed by the caller as before.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. Mutexes are used to coordinate the changes to
+ * the entry and its elements.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of the
+ * memory deallocation function to release the message as well as the use of
+ * locks.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of the memory deallocation function and locks that
+ * could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to reset.
+ *
+ * @return The reset entry if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_reset_entry( struct stumpless_entry *entry );
+
 /**
  * Puts the element at the given index in the given entry.
  *
@@ -1171,6 +1360,44 @@ struct stumpless_entry *
 stumpless_set_entry_app_name( struct stumpless_entry *entry,
                               const char *app_name );
 
+/**
+ * Sets the app name of an entry to a buffer of a given length, instead of a
+ * NULL terminated string. The app name is checked in the same way as in
+ * stumpless_set_entry_app_name.
+ *
+ * **Thread Safety: MT-Safe race:app_name**
+ * This function is thread safe, of course assuming that the app name is not
+ * changed by any other threads during execution. A mutex is used to coordinate
+ * changes to the entry while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to modify.
+ *
+ * @param app_name The new app name of the entry. This does not need to be NULL
+ * terminated. If this is NULL, then a single '-' character will be used, as
+ * specified as the NILVALUE in RFC 5424.
+ *
+ * @param app_name_length The length of app_name in bytes. This is ignored if
+ * app_name is NULL.
+ *
+ * @return The modified entry if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_set_entry_app_name_buf( struct stumpless_entry *entry,
+                                  const char *app_name,
+                                  size_t app_name_length );
+
 /**
  * Sets the facility of an entry.
  *
@@ -1234,6 +1461,43 @@ struct stumpless_entry *
 stumpless_set_entry_hostname( struct stumpless_entry *entry,
                               const char *hostname );
 
+/**
+ * Sets the hostname of an entry to a buffer of a given length, instead of a
+ * NULL terminated string. The hostname is checked in the same way as in
+ * stumpless_set_entry_hostname.
+ *
+ * **Thread Safety: MT-Safe race:hostname**
+ * This function is thread safe, of course assuming that the hostname is not
+ * changed by any other threads during execution. A mutex is used to coordinate
+ * changes to the entry while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to modify.
+ *
+ * @param hostname The new hostname of the entry. This does not need to be NULL
+ * terminated. If this is NULL, then the hostname of the machine will be used.
+ *
+ * @param hostname_length The length of hostname in bytes. This is ignored if
+ * hostname is NULL.
+ *
+ * @return The modified entry if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_set_entry_hostname_buf( struct stumpless_entry *entry,
+                                  const char *hostname,
+                                  size_t hostname_length );
+
 /**
  * Sets the message of a given entry.
  *
@@ -1311,6 +1575,91 @@ struct stumpless_entry *
 stumpless_set_entry_message_str( struct stumpless_entry *entry,
                                  const char *message );
 
+/**
+ * Sets the message of an entry to a buffer of a given length, instead of a
+ * NULL terminated string. This avoids scanning messages whose length the
+ * caller already knows.
+ *
+ * **Thread Safety: MT-Safe race:message**
+ * This function is thread safe, of course assuming that the message is not
+ * changed by any other threads during execution. A mutex is used to coordinate
+ * changes to the entry while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create the new message and free the old one.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to modify.
+ *
+ * @param message The new message of the entry. This does not need to be NULL
+ * terminated. If this is NULL, then it will be blank in the entry (no
+ * characters). This must be a valid UTF-8 string in shortest form.
+ *
+ * @param message_length The length of message in bytes. This is ignored if
+ * message is NULL.
+ *
+ * @return The modified entry if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_set_entry_message_buf( struct stumpless_entry *entry,
+                                 const char *message,
+                                 size_t message_length );
+
+/**
+ * Sets the message of an entry to a reference to the given buffer, instead of
+ * a copy of it. This avoids an allocation and a copy of the message for callers
+ * that keep the message alive until the entry has been logged.
+ *
+ * The buffer will not be freed when the message is replaced or the entry is
+ * destroyed. Copies of the entry made with stumpless_copy_entry own a copy of
+ * the message.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate changes to the
+ * entry while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to free the old message.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to modify.
+ *
+ * @param message The new message of the entry. This does not need to be NULL
+ * terminated, except when the entry is sent to a Windows Event Log target. It
+ * must stay valid and unchanged until the message is replaced or the entry is
+ * destroyed, and until the entry has been logged. If this is NULL, then it will
+ * be blank in the entry (no characters).
+ *
+ * @param message_length The length of message in bytes. This is ignored if
+ * message is NULL.
+ *
+ * @return The modified entry if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_set_entry_message_borrowed( struct stumpless_entry *entry,
+                                      const char *message,
+                                      size_t message_length );
+
 /**
  * Sets the message of a given entry.
  *
@@ -1381,6 +1730,44 @@ struct stumpless_entry *
 stumpless_set_entry_msgid( struct stumpless_entry *entry,
                            const char *msgid );
 
+/**
+ * Sets the msgid of an entry to a buffer of a given length, instead of a
+ * NULL terminated string. The msgid is checked in the same way as in
+ * stumpless_set_entry_msgid.
+ *
+ * **Thread Safety: MT-Safe race:msgid**
+ * This function is thread safe, of course assuming that the msgid is not
+ * changed by any other threads during execution. A mutex is used to coordinate
+ * changes to the entry while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to modify.
+ *
+ * @param msgid The new msgid of the entry. This does not need to be NULL
+ * terminated. If this is NULL, then a single '-' character will be used, as
+ * specified as the NILVALUE in RFC 5424.
+ *
+ * @param msgid_length The length of msgid in bytes. This is ignored if msgid is
+ * NULL.
+ *
+ * @return The modified entry if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_set_entry_msgid_buf( struct stumpless_entry *entry,
+                               const char *msgid,
+                               size_t msgid_length );
+
 /**
  * Puts the param in the element at the given index of an entry.
  *
@@ -1610,6 +1997,43 @@ STUMPLESS_PUBLIC_FUNCTION
 struct stumpless_entry *
 stumpless_set_entry_procid( struct stumpless_entry *entry, const char *procid );
 
+/**
+ * Sets the procid of an entry to a buffer of a given length, instead of a
+ * NULL terminated string. The procid is checked in the same way as in
+ * stumpless_set_entry_procid.
+ *
+ * **Thread Safety: MT-Safe race:procid**
+ * This function is thread safe, of course assuming that the procid is not
+ * changed by any other threads during execution. A mutex is used to coordinate
+ * changes to the entry while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to modify.
+ *
+ * @param procid The new procid of the entry. This does not need to be NULL
+ * terminated. If this is NULL, then the process id will be used.
+ *
+ * @param procid_length The length of procid in bytes. This is ignored if procid
+ * is NULL.
+ *
+ * @return The modified entry if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_set_entry_procid_buf( struct stumpless_entry *entry,
+                                const char *procid,
+                                size_t procid_length );
+
 /**
  * Sets the severity of an entry.
  *
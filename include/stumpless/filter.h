@@ -27,14 +27,342 @@
 #  define __STUMPLESS_FILTER_H
 
 #  include <stdbool.h>
+#  include <stddef.h>
 #  include <stumpless/config.h>
 #  include <stumpless/entry.h>
+#  include <stumpless/severity.h>
 #  include <stumpless/target.h>
 
 #  ifdef __cplusplus
 extern "C" {
 #  endif
 
+/**
+ * What the rate limit of a target is kept separately for.
+ *
+ * @since release v3.1.0
+ */
+enum stumpless_rate_limit_key {
+/** A single limit is shared by all entries sent to the target. */
+  STUMPLESS_RATE_LIMIT_PER_TARGET,
+/** Each severity has its own limit. */
+  STUMPLESS_RATE_LIMIT_PER_SEVERITY,
+/**
+ * Each msgid has its own limit. Msgids are hashed into a fixed number of
+ * limits, so a few msgids may end up sharing one.
+ */
+  STUMPLESS_RATE_LIMIT_PER_MSGID
+};
+
+/**
+ * Adds a stage to the filter pipeline of a target that passes entries with the
+ * given app name.
+ *
+ * The filter pipeline is evaluated after the filter of the target, and is
+ * ordered by the cost of each stage rather than the order they were added in:
+ * severity stages are evaluated first, then app name stages, then element
+ * stages, and finally function stages. Evaluation stops at the first stage
+ * that drops an entry.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the pipeline is changed without
+ * synchronizing with entries that are being filtered by it. Stages should be
+ * added before the target is used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create the stage.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to add the stage to.
+ *
+ * @param app_name The app name that entries must have to pass, as a
+ * NULL-terminated string.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_add_app_name_filter_stage( struct stumpless_target *target,
+                                     const char *app_name );
+
+/**
+ * Adds a stage to the filter pipeline of a target that passes entries that
+ * have an element with the given name.
+ *
+ * See stumpless_add_app_name_filter_stage for the order that stages are
+ * evaluated in.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the pipeline is changed without
+ * synchronizing with entries that are being filtered by it. Stages should be
+ * added before the target is used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create the stage.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to add the stage to.
+ *
+ * @param element_name The name of the element that entries must have to pass,
+ * as a NULL-terminated string. This must be a valid element name, as it is for
+ * stumpless_new_element.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_add_element_filter_stage( struct stumpless_target *target,
+                                    const char *element_name );
+
+/**
+ * Adds a stage to the filter pipeline of a target that passes entries for
+ * which the given filter returns true.
+ *
+ * This allows filters such as stumpless_rate_limit_filter and
+ * stumpless_sample_filter to be combined with each other and with custom
+ * filters, in which case the filter of the target can be left as
+ * stumpless_mask_filter. See stumpless_add_app_name_filter_stage for the order
+ * that stages are evaluated in. Function stages are evaluated in the order
+ * they were added.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the pipeline is changed without
+ * synchronizing with entries that are being filtered by it. Stages should be
+ * added before the target is used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create the stage.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to add the stage to.
+ *
+ * @param filter The filter to call for each entry.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_add_filter_stage( struct stumpless_target *target,
+                            stumpless_filter_func_t filter );
+
+/**
+ * Adds a stage to the filter pipeline of a target that passes entries with a
+ * severity in the given range.
+ *
+ * See stumpless_add_app_name_filter_stage for the order that stages are
+ * evaluated in.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the pipeline is changed without
+ * synchronizing with entries that are being filtered by it. Stages should be
+ * added before the target is used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create the stage.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to add the stage to.
+ *
+ * @param most_severe The most severe severity that is passed.
+ *
+ * @param least_severe The least severe severity that is passed. This must not
+ * be more severe than most_severe.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately. An invalid
+ * severity error is raised if either severity is invalid or if least_severe is
+ * more severe than most_severe.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_add_severity_filter_stage( struct stumpless_target *target,
+                                     enum stumpless_severity most_severe,
+                                     enum stumpless_severity least_severe );
+
+/**
+ * Removes all stages from the filter pipeline of a target.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the stages are destroyed while other
+ * threads may be using them.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to destroy the stages.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to remove the stages from.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_clear_filter_stages( struct stumpless_target *target );
+
+/**
+ * Suppresses entries that are identical to the last entry that passed, and
+ * passes them again with a summary of the repeats once a different entry is
+ * logged.
+ *
+ * Duplicate suppression is set up with stumpless_set_target_dedup_window. If
+ * the target does not have it set up, then this filter is equivalent to
+ * stumpless_mask_filter. Entries are also checked against the mask of the
+ * target before the duplicate check, so that this filter can replace the
+ * default one without losing the mask.
+ *
+ * Entries are compared by a hash of their prival, app name, msgid, and
+ * message. Structured data and timestamps are not compared.
+ *
+ * Duplicate suppression is per thread. The last entry is tracked separately
+ * in each thread, so that the filter does not need to synchronize with other
+ * threads: identical entries from different threads are not collapsed into
+ * each other, and an entry from one thread does not end the repeats of
+ * another.
+ *
+ * When an entry passes the filter after repeats were suppressed, it is
+ * preceded by a summary entry with the prival of the repeated entry stating
+ * how many times it was repeated. The summary is only sent when the next
+ * entry that passes is added from the same thread, and there is no separate
+ * flush: if the thread does not log again before it exits or the target is
+ * closed, then the count of its last repeats is lost. Callers that need every
+ * count should log a final entry from each thread before it stops logging to
+ * the target.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. Mutexes are used to read the mask of the
+ * target and the fields of the entry, and all other state is kept per thread.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * non-reentrant locks to read the target and entry.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of locks that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target that the entry will be sent to if it passes.
+ *
+ * @param entry The entry that is being submitted to the target.
+ *
+ * @return true if the entry passes the mask and is not a repeat of the last
+ * entry, false otherwise.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+bool
+stumpless_dedup_filter( const struct stumpless_target *target,
+                        const struct stumpless_entry *entry );
+
+/**
+ * Gets the number of stages in the filter pipeline of a target.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate with changes to
+ * the pipeline.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate access.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to get the stage count of.
+ *
+ * @return The number of stages. If an error is encountered, then zero is
+ * returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+size_t
+stumpless_get_filter_stage_count( const struct stumpless_target *target );
+
+/**
+ * Gets the number of entries that have passed and been dropped by a stage of
+ * the filter pipeline of a target.
+ *
+ * Stages are indexed in the order they are evaluated in. Entries dropped by an
+ * earlier stage, or by the filter of the target, are not counted by later
+ * stages.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate with changes to
+ * the pipeline, and the counters are read atomically.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate access.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to get the counters of.
+ *
+ * @param index The index of the stage.
+ *
+ * @param passed Set to the number of entries that passed the stage.
+ *
+ * @param dropped Set to the number of entries that were dropped by the stage.
+ *
+ * @return The target if no error is encountered. In the event of an error,
+ * NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+const struct stumpless_target *
+stumpless_get_filter_stage_stats( const struct stumpless_target *target,
+                                  size_t index,
+                                  size_t *passed,
+                                  size_t *dropped );
+
 /**
  * Compares the severity of the entry to the current mask of the target, and
  * only passes the entry if the mask bit corresponding to the severity is set.
@@ -65,6 +393,260 @@ bool
 stumpless_mask_filter( const struct stumpless_target *target,
                        const struct stumpless_entry *entry );
 
+/**
+ * Passes entries until the rate limit of the target is reached, and then
+ * suppresses them until the limit has been replenished.
+ *
+ * The rate limit of a target is set with stumpless_set_target_rate_limit. If
+ * the target does not have one, then this filter is equivalent to
+ * stumpless_mask_filter. Entries are also checked against the mask of the
+ * target before the rate limit, so that this filter can replace the default
+ * one without losing the mask.
+ *
+ * The limit is a token bucket that allows bursts of up to one second's worth
+ * of entries and bytes. Only the message of each entry counts towards the byte
+ * limit. Once entries have been suppressed, the next entry that passes is
+ * preceded by a summary entry with a notice severity giving the number of
+ * entries that were suppressed.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. The rate limit is updated with an atomic
+ * compare and exchange, and mutexes are used to read the mask of the target
+ * and the fields of the entry.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * non-reentrant locks to read the target and entry.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of locks that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target that the entry will be sent to if it passes.
+ *
+ * @param entry The entry that is being submitted to the target.
+ *
+ * @return true if the entry passes the mask and is within the rate limit of
+ * the target, false otherwise.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+bool
+stumpless_rate_limit_filter( const struct stumpless_target *target,
+                             const struct stumpless_entry *entry );
+
+/**
+ * Keeps one in every N entries of each severity, where N is the rate set
+ * for the severity with stumpless_set_target_sample_rate.
+ *
+ * Entries with a severity of warning or more severe are always kept, as are
+ * entries with a severity that does not have a rate set. If the target does
+ * not have sampling set up, then this filter is equivalent to
+ * stumpless_mask_filter. Entries are also checked against the mask of the
+ * target before they are sampled, so that this filter can replace the default
+ * one without losing the mask.
+ *
+ * By default entries are sampled randomly. If a key has been set with
+ * stumpless_set_target_sample_key, then entries that have the key param are
+ * sampled by a hash of its value instead, so that either all or none of the
+ * entries with a given value are kept. This can be used to keep every entry
+ * of a sampled request, for example by using a trace id as the key.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. Mutexes are used to read the mask of the
+ * target and the fields of the entry, and the random state is kept per
+ * thread.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * non-reentrant locks to read the target and entry.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of locks that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target that the entry will be sent to if it passes.
+ *
+ * @param entry The entry that is being submitted to the target.
+ *
+ * @return true if the entry passes the mask and is sampled, false otherwise.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+bool
+stumpless_sample_filter( const struct stumpless_target *target,
+                         const struct stumpless_entry *entry );
+
+/**
+ * Sets up the duplicate suppression used by stumpless_dedup_filter for a
+ * target.
+ *
+ * This does not change the filter of the target, which must be set to
+ * stumpless_dedup_filter with stumpless_set_target_filter for duplicates to be
+ * suppressed. Calling this again resets the repeat counts of all threads.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the previous configuration is destroyed
+ * while other threads may be using it. It should be called before the target
+ * is used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create the new configuration.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to set up duplicate suppression for.
+ *
+ * @param window The time in milliseconds after which a repeated entry is
+ * passed again along with a summary of its repeats, so that an entry repeated
+ * indefinitely is still logged periodically. As with the summary for a
+ * different entry, this only happens when the entry is next repeated on the
+ * same thread after the window has passed. Zero means that repeats are
+ * suppressed until a different entry is logged.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_target_dedup_window( struct stumpless_target *target,
+                                   unsigned window );
+
+/**
+ * Sets the rate limit used by stumpless_rate_limit_filter for a target.
+ *
+ * This does not change the filter of the target, which must be set to
+ * stumpless_rate_limit_filter with stumpless_set_target_filter for the limit to
+ * have any effect. Setting a new limit resets the state of the previous one.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the previous limit is destroyed while
+ * other threads may be using it. It should be called before the target is
+ * used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create the new limit.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to set the rate limit of.
+ *
+ * @param entries_per_second The number of entries that may pass each second.
+ * Zero means that the number of entries is not limited.
+ *
+ * @param bytes_per_second The number of message bytes that may pass each
+ * second. Zero means that the number of bytes is not limited.
+ *
+ * @param key What the limit is kept separately for.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_target_rate_limit( struct stumpless_target *target,
+                                 size_t entries_per_second,
+                                 size_t bytes_per_second,
+                                 enum stumpless_rate_limit_key key );
+
+/**
+ * Sets the param that stumpless_sample_filter samples entries of a target by.
+ *
+ * Entries that have the param are kept or dropped based on a hash of its
+ * value, so that the decision is the same for all entries with the same
+ * value. Entries without the param are still sampled randomly.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the previous key is destroyed while
+ * other threads may be using it. It should be called before the target is
+ * used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to store the names.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to set the sampling key of.
+ *
+ * @param element_name The name of the element holding the key param, as a
+ * NULL-terminated string. If this is NULL, then the key is removed and all
+ * entries are sampled randomly.
+ *
+ * @param param_name The name of the key param, as a NULL-terminated string.
+ * This is ignored if element_name is NULL.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_target_sample_key( struct stumpless_target *target,
+                                 const char *element_name,
+                                 const char *param_name );
+
+/**
+ * Sets how many entries of a severity stumpless_sample_filter keeps for a
+ * target.
+ *
+ * Rates set for a severity of warning or more severe have no effect, as these
+ * entries are always kept.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the rate is changed without
+ * synchronizing with filters that may be reading it. It should be called
+ * before the target is used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to set up sampling the first time it is called.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to set the sample rate of.
+ *
+ * @param severity The severity to set the rate for.
+ *
+ * @param rate One in how many entries of the severity are kept. Zero and one
+ * both keep every entry.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_target_sample_rate( struct stumpless_target *target,
+                                  enum stumpless_severity severity,
+                                  unsigned rate );
+
 #  ifdef __cplusplus
 } /* extern "C" */
 #  endif
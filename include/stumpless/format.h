@@ -0,0 +1,96 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * Output formats that targets can write entries in.
+ *
+ * The format of a target is set with stumpless_set_target_format, and is only
+ * used by targets that write formatted entries: buffer, file, network, socket,
+ * and stream targets. Other target types ignore it.
+ *
+ * @since release v3.1.0
+ */
+
+#ifndef __STUMPLESS_FORMAT_H
+#  define __STUMPLESS_FORMAT_H
+
+#  include <stumpless/config.h>
+#  include <stumpless/generator.h>
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif
+
+/**
+ * A macro function that runs the provided action once for each format,
+ * providing the symbol and value. The action must take two arguments, the
+ * first being the symbol name of the format, and the second the numeric value
+ * of the format.
+ *
+ * @since release v3.1.0
+ */
+#  define STUMPLESS_FOREACH_FORMAT( ACTION )\
+/* RFC 5424 syslog messages, the default for all targets */\
+ACTION( STUMPLESS_FORMAT_RFC_5424, 0 )\
+/* BSD syslog messages as described in RFC 3164, without structured data */\
+ACTION( STUMPLESS_FORMAT_RFC_3164, 1 )\
+/* one JSON object per line, with structured data as nested objects */\
+ACTION( STUMPLESS_FORMAT_JSON_LINES, 2 )\
+/* space separated key=value pairs, one entry per line */\
+ACTION( STUMPLESS_FORMAT_LOGFMT, 3 )\
+/* length prefixed binary records, described in stumpless/binary.h */\
+ACTION( STUMPLESS_FORMAT_BINARY, 4 )
+
+/**
+ * The formats that entries can be written in.
+ *
+ * @since release v3.1.0
+ */
+enum stumpless_format {
+  STUMPLESS_FOREACH_FORMAT( STUMPLESS_GENERATE_ENUM )
+};
+
+/**
+ * Gets the string representation of the given format.
+ *
+ * This is a string literal that should not be modified or freed by the caller.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param format The format to get the string from.
+ *
+ * @return The string representation of the given format.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+const char *
+stumpless_get_format_string( enum stumpless_format format );
+
+#  ifdef __cplusplus
+}                               /* extern "C" */
+#  endif
+#endif                          /* __STUMPLESS_FORMAT_H */
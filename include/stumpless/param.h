@@ -23,6 +23,7 @@
 #ifndef __STUMPLESS_PARAM_H
 #  define __STUMPLESS_PARAM_H
 
+#  include <stdbool.h>
 #  include <stddef.h>
 #  include <stumpless/config.h>
 #  include <stumpless/entry.h>
@@ -30,6 +31,18 @@
 /** The maximum length of a parameter name, as specified by RFC 5424. */
 #  define STUMPLESS_MAX_PARAM_NAME_LENGTH 32
 
+#  ifdef STUMPLESS_JOURNALD_TARGETS_SUPPORTED
+/**
+ * The maximum length of a cached journald field prefix for a param. This is of
+ * the form ELEMENT_PARAM=, and RFC 5424 limits element names to the same
+ * length as param names.
+ *
+ * @since release v3.1.0
+ */
+#    define STUMPLESS_MAX_PARAM_JOURNALD_PREFIX_LENGTH \
+  ( ( 2 * STUMPLESS_MAX_PARAM_NAME_LENGTH ) + 2 )
+#  endif
+
 #  ifdef __cplusplus
 extern "C" {
 #  endif
@@ -37,6 +50,9 @@ extern "C" {
 // this is required due to the circular dependency with the entry header.
 struct stumpless_entry;
 
+// this is required due to the circular dependency with the element header.
+struct stumpless_element;
+
 #ifdef STUMPLESS_JOURNALD_TARGETS_SUPPORTED
 /**
  * Gets the name to use for the journald field corresponding to this param.
@@ -115,7 +131,8 @@ struct stumpless_param {
  * and ']' (ABNF %d93) MUST be escaped by placing a backslash character '\'
  * directly before them.
  *
- * Unlike the name field, value will always be NULL-terminated. This is done to
+ * Unlike the name field, value will always be NULL-terminated, unless it was
+ * borrowed from the caller as described in value_borrowed. This is done to
  * support their use for wel insertion strings.
  *
  * If you need to access the value, use the stumpless_(g|s)et_param_value
@@ -125,9 +142,48 @@ struct stumpless_param {
   char *value;
 /** The number of characters in value (not including the NULL character). */
   size_t value_length;
+/**
+ * True if value points to memory owned by the caller, as set by
+ * stumpless_new_param_borrowed or stumpless_set_param_value_borrowed. Borrowed
+ * values are not freed along with the param, and are not necessarily NULL
+ * terminated.
+ *
+ * @since release v3.1.0
+ */
+  bool value_borrowed;
+/**
+ * The element that created this param, for example with
+ * stumpless_add_new_param, or NULL if the param was created by the caller.
+ * Only params created by an element are kept for reuse when it is reset.
+ *
+ * @since release v3.1.0
+ */
+  const struct stumpless_element *owner;
 #  ifdef STUMPLESS_JOURNALD_TARGETS_SUPPORTED
 /** Gets the name to use for the journald field corresponding to this param. */
   stumpless_param_namer_func_t get_journald_name;
+/**
+ * The journald field prefix for this param produced by the default namers,
+ * including the trailing '=' character. This is filled in the first time the
+ * param is sent to a journald target and reset when the param or its element
+ * is renamed.
+ *
+ * @since release v3.1.0
+ */
+  char journald_prefix[STUMPLESS_MAX_PARAM_JOURNALD_PREFIX_LENGTH];
+/**
+ * The number of characters in journald_prefix, or 0 if it has not been
+ * filled in.
+ *
+ * @since release v3.1.0
+ */
+  size_t journald_prefix_length;
+/**
+ * The element that journald_prefix was built for.
+ *
+ * @since release v3.1.0
+ */
+  const struct stumpless_element *journald_prefix_element;
 #  endif
 #  ifdef STUMPLESS_THREAD_SAFETY_SUPPORTED
 /**
@@ -328,6 +384,100 @@ STUMPLESS_PUBLIC_FUNCTION
 struct stumpless_param *
 stumpless_new_param( const char *name, const char *value );
 
+/**
+ * Creates a new param with the given name and value, each given as a buffer
+ * with a length instead of a NULL terminated string. This avoids scanning
+ * strings whose length the caller already knows, for example fields taken
+ * from a larger received message.
+ *
+ * The name and value are checked in the same way as in stumpless_new_param.
+ *
+ * **Thread Safety: MT-Safe race:name race:value**
+ * This function is thread safe, of course assuming that name and value are not
+ * changed by other threads during execution.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions to create the new param as well as the use of
+ * a mutex initialization routine.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions and a mutex
+ * initialization routine.
+ *
+ * @since release v3.1.0
+ *
+ * @param name The name of the new param. This does not need to be NULL
+ * terminated. Restricted to printable ASCII characters different from '=',
+ * ']' and '"'.
+ *
+ * @param name_length The length of name in bytes.
+ *
+ * @param value The value of the new param. This does not need to be NULL
+ * terminated. The value must be a UTF-8 string.
+ *
+ * @param value_length The length of value in bytes.
+ *
+ * @return The created param, if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_param *
+stumpless_new_param_buf( const char *name,
+                         size_t name_length,
+                         const char *value,
+                         size_t value_length );
+
+/**
+ * Creates a new param with the given name and value, storing a reference to
+ * the value instead of copying it. This avoids an allocation and a copy of the
+ * value for callers that keep the value alive themselves, for example when
+ * logging fields of a request that outlives the call to stumpless_add_entry.
+ *
+ * The name is copied into the param as usual, and both the name and value are
+ * checked in the same way as in stumpless_new_param_buf. The value will not be
+ * freed when the param is destroyed.
+ *
+ * **Thread Safety: MT-Safe race:name**
+ * This function is thread safe, of course assuming that name is not changed by
+ * other threads during execution.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions to create the new param as well as the use of
+ * a mutex initialization routine.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions and a mutex
+ * initialization routine.
+ *
+ * @since release v3.1.0
+ *
+ * @param name The name of the new param. This does not need to be NULL
+ * terminated. Restricted to printable ASCII characters different from '=',
+ * ']' and '"'.
+ *
+ * @param name_length The length of name in bytes.
+ *
+ * @param value The value of the new param. This does not need to be NULL
+ * terminated, and must be a UTF-8 string. It must stay valid and unchanged
+ * until the value of the param is replaced or the param is destroyed, and
+ * until any entry it is in has been logged.
+ *
+ * @param value_length The length of value in bytes.
+ *
+ * @return The created param, if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_param *
+stumpless_new_param_borrowed( const char *name,
+                              size_t name_length,
+                              const char *value,
+                              size_t value_length );
+
 /**
  * Creates a new param given a string by parsing the string and calling stumpless_new_param.
  *
@@ -386,6 +536,41 @@ STUMPLESS_PUBLIC_FUNCTION
 struct stumpless_param *
 stumpless_set_param_name( struct stumpless_param *param, const char *name );
 
+/**
+ * Sets the name of the given param to a buffer of a given length, instead of
+ * a NULL terminated string.
+ *
+ * **Thread Safety: MT-Safe race:name**
+ * This function is thread safe, assuming that the name is not changed by other
+ * threads during execution. A mutex is used to coordinate changes to the param
+ * while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param param The param to set the name of.
+ *
+ * @param name The new name of param. This does not need to be NULL terminated.
+ * Restricted to printable ASCII characters different from '=', ']' and '"'.
+ *
+ * @param name_length The length of name in bytes.
+ *
+ * @return The modified param, if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_param *
+stumpless_set_param_name_buf( struct stumpless_param *param,
+                              const char *name,
+                              size_t name_length );
+
 /**
  * Sets the value of the given param.
  *
@@ -416,6 +601,83 @@ STUMPLESS_PUBLIC_FUNCTION
 struct stumpless_param *
 stumpless_set_param_value( struct stumpless_param *param, const char *value );
 
+/**
+ * Sets the value of the given param to a buffer of a given length, instead of
+ * a NULL terminated string.
+ *
+ * **Thread Safety: MT-Safe race:value**
+ * This function is thread safe, assuming that the value is not changed by
+ * other threads during execution. A mutex is used to coordinate changes to the
+ * param while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create the new value and free the old one.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param param The param to set the value of.
+ *
+ * @param value The new value of param. This does not need to be NULL
+ * terminated. The value must be a UTF-8 string.
+ *
+ * @param value_length The length of value in bytes.
+ *
+ * @return The modified param, if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_param *
+stumpless_set_param_value_buf( struct stumpless_param *param,
+                               const char *value,
+                               size_t value_length );
+
+/**
+ * Sets the value of the given param to a reference to the given buffer,
+ * instead of a copy of it. The buffer will not be freed when the value is
+ * replaced or the param is destroyed.
+ *
+ * **Thread Safety: MT-Safe race:value**
+ * This function is thread safe, assuming that the value is not changed by
+ * other threads during execution. A mutex is used to coordinate changes to the
+ * param while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to free the old value.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param param The param to set the value of.
+ *
+ * @param value The new value of param. This does not need to be NULL
+ * terminated, and must be a UTF-8 string. It must stay valid and unchanged
+ * until the value of the param is replaced or the param is destroyed, and
+ * until any entry it is in has been logged.
+ *
+ * @param value_length The length of value in bytes.
+ *
+ * @return The modified param, if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_param *
+stumpless_set_param_value_borrowed( struct stumpless_param *param,
+                                    const char *value,
+                                    size_t value_length );
+
 
 /**
  * Returns the name and the value from param as a formatted string.
@@ -0,0 +1,112 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * Parsing of received RFC 5424 messages into entries.
+ *
+ * @since release v3.1.0
+ */
+
+#ifndef __STUMPLESS_PARSE_H
+#  define __STUMPLESS_PARSE_H
+
+#  include <stddef.h>
+#  include <stumpless/config.h>
+#  include <stumpless/entry.h>
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif
+
+/**
+ * Loads an entry with the contents of an RFC 5424 message, so that messages
+ * received from other processes can be sent to targets as entries.
+ *
+ * The message is checked against the syntax of RFC 5424 as it is read, without
+ * copying it first. The prival, hostname, app name, procid, and msgid are
+ * taken from the header, along with the timestamp which is then used in place
+ * of the current time when the entry is sent. A NILVALUE in the timestamp,
+ * hostname, app name, procid, or msgid is kept as a '-' rather than replaced
+ * with the current time or the defaults of a target. Escaped
+ * characters in param values are unescaped, and a byte order mark at the start
+ * of the MSG is removed after the rest of the MSG is checked to be valid UTF-8.
+ * A MSG without a byte order mark may hold any bytes.
+ *
+ * The timestamp of the message is also returned to the caller, as a pointer
+ * into the message.
+ *
+ * The memory already held by the entry is reused: the message buffer and the
+ * values of params are only reallocated if they need to grow, elements and
+ * params created by the entry are loaded in place of the existing ones, and
+ * any that are left over are kept for reuse as they are by
+ * stumpless_reset_entry. This means that parsing a stream of similar messages
+ * into the same entry does not allocate memory once the entry has grown to fit
+ * them. Elements and params that the caller added to the entry are removed
+ * from it first and are not changed.
+ *
+ * The message should not include any trailing newline or other framing, as it
+ * would be treated as part of the MSG.
+ *
+ * **Thread Safety: MT-Safe race:message**
+ * This function is thread safe, of course assuming that the message is not
+ * changed by other threads during execution. A mutex is used to coordinate
+ * changes to the entry with other accesses to it.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to resize the message and params.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param entry The entry to load.
+ *
+ * @param message The RFC 5424 message to parse. This does not need to be NULL
+ * terminated.
+ *
+ * @param message_length The number of bytes in message.
+ *
+ * @param timestamp If this is not NULL, then it is set to the start of the
+ * timestamp within the message, or to NULL if the timestamp is a NILVALUE.
+ *
+ * @param timestamp_length If this is not NULL, then it is set to the length
+ * of the timestamp in bytes, or to zero if the timestamp is a NILVALUE.
+ *
+ * @return The loaded entry, if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ * If the header of the message is invalid then the entry is not changed.
+ * Otherwise, an entry that fails to load is reset as it would be by
+ * stumpless_reset_entry, so that no part of the invalid message is left in it.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_load_entry_from_rfc_5424( struct stumpless_entry *entry,
+                                    const char *message,
+                                    size_t message_length,
+                                    const char **timestamp,
+                                    size_t *timestamp_length );
+
+#  ifdef __cplusplus
+}                               /* extern "C" */
+#  endif
+#endif                          /* __STUMPLESS_PARSE_H */
@@ -0,0 +1,189 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * Probes fired at the stages of adding an entry to a target, for use in
+ * profiling the overhead of the library.
+ *
+ * Probes are only fired if the library was built with the `ENABLE_PROBES`
+ * option, in which case STUMPLESS_PROBES_SUPPORTED is defined. Otherwise the
+ * probe points are compiled out entirely, and a hook set with
+ * stumpless_set_probe_hook will never be called.
+ *
+ * If `sys/sdt.h` is available when the library is built with probes, each
+ * probe is also a USDT probe in the `stumpless` provider, named the same as
+ * the probe with the `STUMPLESS_PROBE_` prefix removed. These can be traced
+ * without any changes to the application, for example with
+ * `bpftrace -e 'usdt:libstumpless.so:stumpless:FORMAT_START { ... }'`.
+ *
+ * @since release v3.1.0
+ */
+
+#ifndef __STUMPLESS_PROBE_H
+#  define __STUMPLESS_PROBE_H
+
+#  include <stumpless/config.h>
+#  include <stumpless/generator.h>
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif
+
+/**
+ * A macro function that runs the provided action once for each probe,
+ * providing the symbol and value. The action must take two arguments, the
+ * first being the symbol name of the probe, and the second the numeric value
+ * of the probe.
+ *
+ * Probes are listed in the order they are fired while adding an entry. Not all
+ * probes are fired for all targets: formatting is skipped for targets that do
+ * not format entries, and only buffer, file, network, socket, and stream
+ * targets fire the lock and write probes. Socket targets do not lock while
+ * sending and so only fire the write probes, and network targets with several
+ * destinations fire them once for each destination that a send is attempted
+ * on.
+ *
+ * @since release v3.1.0
+ */
+#  define STUMPLESS_FOREACH_PROBE( ACTION )\
+/* the target filter and filter stages are about to run */\
+ACTION( STUMPLESS_PROBE_FILTER_START, 0 )\
+/* the filter and filter stages have run, whether or not the entry passed */\
+ACTION( STUMPLESS_PROBE_FILTER_END, 1 )\
+/* the entry is about to be formatted */\
+ACTION( STUMPLESS_PROBE_FORMAT_START, 2 )\
+/* the timestamp of the entry is about to be taken */\
+ACTION( STUMPLESS_PROBE_TIMESTAMP_START, 3 )\
+/* the timestamp of the entry has been taken */\
+ACTION( STUMPLESS_PROBE_TIMESTAMP_END, 4 )\
+/* the entry has been formatted */\
+ACTION( STUMPLESS_PROBE_FORMAT_END, 5 )\
+/* the entry is about to be sent to the target */\
+ACTION( STUMPLESS_PROBE_SEND_START, 6 )\
+/* the lock on the underlying target has been acquired */\
+ACTION( STUMPLESS_PROBE_LOCK_ACQUIRED, 7 )\
+/* the formatted entry is about to be written */\
+ACTION( STUMPLESS_PROBE_WRITE_START, 8 )\
+/* the formatted entry has been written */\
+ACTION( STUMPLESS_PROBE_WRITE_END, 9 )\
+/* the entry has been sent to the target */\
+ACTION( STUMPLESS_PROBE_SEND_END, 10 )
+
+/**
+ * The points in adding an entry where a probe may be fired.
+ *
+ * @since release v3.1.0
+ */
+enum stumpless_probe {
+  STUMPLESS_FOREACH_PROBE( STUMPLESS_GENERATE_ENUM )
+};
+
+/**
+ * A function called each time a probe is fired.
+ *
+ * Hooks are called in the thread adding the entry, in the middle of the
+ * operation, and possibly while a lock on the target is held. They should do
+ * as little as possible, for example recording a timestamp along with the
+ * probe, and must not call any stumpless functions.
+ *
+ * @since release v3.1.0
+ */
+typedef void ( *stumpless_probe_hook_func_t )( enum stumpless_probe probe );
+
+/**
+ * Gets the function called each time a probe is fired.
+ *
+ * **Thread Safety: MT-Safe race:hook**
+ * This function is thread safe, as long as the hook is not changed by another
+ * thread at the same time.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @return The current probe hook, or NULL if there is none.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+stumpless_probe_hook_func_t
+stumpless_get_probe_hook( void );
+
+/**
+ * Gets the string representation of the given probe.
+ *
+ * This is a string literal that should not be modified or freed by the caller.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param probe The probe to get the string from.
+ *
+ * @return The string representation of the given probe.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+const char *
+stumpless_get_probe_string( enum stumpless_probe probe );
+
+/**
+ * Sets the function called each time a probe is fired. The hook is shared by
+ * all targets and threads.
+ *
+ * The hook is only called if the library was built with probes enabled. Use
+ * STUMPLESS_PROBES_SUPPORTED to check for this at compile time.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe as the assignment is not atomic, and other
+ * threads may be firing probes at the same time. The hook should be set before
+ * starting multiple threads that log.
+ *
+ * **Async Signal Safety: AS-Unsafe**
+ * This function is not safe to call from signal handlers for the same reason
+ * as it is not thread safe.
+ *
+ * **Async Cancel Safety: AC-Unsafe**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, as the assignment is not guaranteed to be atomic.
+ *
+ * @since release v3.1.0
+ *
+ * @param hook The function to call each time a probe is fired. This may be
+ * NULL, in which case fired probes are ignored.
+ *
+ * @return The new probe hook.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+stumpless_probe_hook_func_t
+stumpless_set_probe_hook( stumpless_probe_hook_func_t hook );
+
+#  ifdef __cplusplus
+}                               /* extern "C" */
+#  endif
+#endif                          /* __STUMPLESS_PROBE_H */
@@ -33,6 +33,7 @@
 #include <stdio.h>
 #include <stumpless/config.h>
 #include <stumpless/entry.h>
+#include <stumpless/format.h>
 #include <stumpless/id.h>
 #include <stumpless/generator.h>
 
@@ -134,6 +135,54 @@ typedef bool ( *stumpless_filter_func_t )(
   const struct stumpless_target *target,
   const struct stumpless_entry *entry );
 
+/**
+ * The number of buckets in the latency histogram of a target.
+ *
+ * The first four buckets hold latencies of 0 to 3 nanoseconds. After these,
+ * each power of two is split into four buckets of equal width, and the last
+ * bucket also holds every latency too large for the others. The smallest
+ * latency that falls into a bucket can be retrieved with
+ * stumpless_get_latency_bucket_min.
+ *
+ * @since release v3.1.0
+ */
+#define STUMPLESS_LATENCY_BUCKET_COUNT 128
+
+/**
+ * The counters that a target keeps about the entries sent to it.
+ *
+ * @since release v3.1.0
+ */
+struct stumpless_target_stats {
+/** The number of entries passed to stumpless_add_entry for the target. */
+  size_t entries_accepted;
+/** The number of entries dropped by the filter or filter pipeline. */
+  size_t entries_filtered;
+/**
+ * The number of entries sent to the target successfully, including summary
+ * entries generated by filters.
+ */
+  size_t entries_sent;
+/** The number of entries that could not be sent due to an error. */
+  size_t entries_failed;
+/**
+ * The number of formatted bytes sent successfully. Entries sent to targets
+ * that do not format them, such as journald and function targets, do not
+ * count towards this.
+ */
+  size_t bytes_written;
+/**
+ * A histogram of the time taken to send each entry, in nanoseconds. See
+ * STUMPLESS_LATENCY_BUCKET_COUNT for the ranges of the buckets.
+ *
+ * The latency covers reading the header settings of the target, formatting
+ * the entry, and writing it to the target. Filters are not included. This is
+ * only recorded for targets that have it enabled with
+ * stumpless_set_target_latency_histogram, and is all zeros otherwise.
+ */
+  size_t latency_counts[STUMPLESS_LATENCY_BUCKET_COUNT];
+};
+
 /**
  * A target that log entries can be sent to.
  */
@@ -177,6 +226,12 @@ struct stumpless_target {
   char default_msgid[STUMPLESS_MAX_MSGID_LENGTH];
 /** The number of characters in the default msgid. */
   size_t default_msgid_length;
+/**
+ * The format that entries are written in by this target.
+ *
+ * @since release v3.1.0
+ */
+  enum stumpless_format format;
 /** The log mask for the target. Used by the default target filter. */
   int mask;
 /**
@@ -188,6 +243,47 @@ struct stumpless_target {
  * @since release v2.1.0
  */
   stumpless_filter_func_t filter;
+/**
+ * The state of the rate limit used by stumpless_rate_limit_filter, or NULL if
+ * no rate limit has been set on this target.
+ *
+ * @since release v3.1.0
+ */
+  void *rate_limit;
+/**
+ * The configuration used by stumpless_dedup_filter, or NULL if duplicate
+ * suppression has not been set up on this target.
+ *
+ * @since release v3.1.0
+ */
+  void *dedup;
+/**
+ * The configuration used by stumpless_sample_filter, or NULL if sampling has
+ * not been set up on this target.
+ *
+ * @since release v3.1.0
+ */
+  void *sample;
+/**
+ * The filter pipeline of the target, evaluated after filter. NULL if no
+ * stages have been added.
+ *
+ * @since release v3.1.0
+ */
+  void *filter_stages;
+/**
+ * The counters reported by stumpless_get_target_stats.
+ *
+ * @since release v3.1.0
+ */
+  void *stats;
+/**
+ * The pre-rendered hostname, app name, and procid used when formatting
+ * entries that use the defaults of this target.
+ *
+ * @since release v3.1.0
+ */
+  void *header;
 #ifdef STUMPLESS_THREAD_SAFETY_SUPPORTED
 /**
  * A pointer to a mutex which protects all target fields. The exact type of
@@ -197,6 +293,59 @@ struct stumpless_target {
 #endif
 };
 
+/**
+ * Adds a group of entries to a given target. This has the same result as
+ * calling stumpless_add_entry with each of the entries in order, but target
+ * types that support it are handed all of the entries at once.
+ *
+ * Buffer, file, socket, and stream targets format all of the entries into a
+ * single buffer and write it while holding their lock once, using a single
+ * `fwrite` for file targets and `sendmmsg` for socket targets where it is
+ * available. SQLite3 targets insert all of the entries in one transaction,
+ * and journald targets using the native protocol send them together. Other
+ * target types send each entry in turn.
+ *
+ * Each entry is still checked against the filters of the target, and any
+ * summary of suppressed entries is sent before the group.
+ *
+ * **Thread Safety: MT-Safe env locale**
+ * This function is thread safe, in the same way as stumpless_add_entry.
+ * Entries from other threads will not be interleaved with the group for
+ * target types that write the entries at once.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers as some targets make
+ * use of non-reentrant locks to coordinate access, and memory is allocated to
+ * hold the formatted entries.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of locks in some targets that could be left locked
+ * and the use of memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to send the entries to.
+ *
+ * @param entries The entries to send to the target.
+ *
+ * @param entry_count The number of entries in the entries array.
+ *
+ * @param results If this is not NULL, it is set to the result that
+ * stumpless_add_entry would have returned for each entry. It must have room
+ * for entry_count results.
+ *
+ * @return A non-negative value if every entry was sent or filtered without an
+ * error. If an error is encountered with any of the entries, then a negative
+ * value is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+int
+stumpless_add_entries( struct stumpless_target *target,
+                       const struct stumpless_entry * const *entries,
+                       size_t entry_count,
+                       int *results );
+
 /**
  * Adds an entry into a given target. This is the primary logging function of
  * stumpless; all other logging functions call this one after performing any
@@ -589,6 +738,31 @@ STUMPLESS_PUBLIC_FUNCTION
 struct stumpless_target *
 stumpless_get_default_target( void );
 
+/**
+ * Gets the smallest latency in nanoseconds that is counted in a bucket of the
+ * latency histogram of a target.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param index The index of the bucket. Must be less than
+ * STUMPLESS_LATENCY_BUCKET_COUNT.
+ *
+ * @return The smallest latency in the bucket.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+unsigned long long
+stumpless_get_latency_bucket_min( size_t index );
+
 /**
  * Gets a given option of a target.
  *
@@ -710,6 +884,33 @@ STUMPLESS_PUBLIC_FUNCTION
 stumpless_filter_func_t
 stumpless_get_target_filter( const struct stumpless_target *target );
 
+/**
+ * Gets the format that a target writes entries in.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate changes to the
+ * target while it is being read.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate the read of the target.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to get the format from.
+ *
+ * @return The current format of the target. If an error is encountered, then
+ * STUMPLESS_FORMAT_RFC_5424 is returned and an error code is set
+ * appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+enum stumpless_format
+stumpless_get_target_format( const struct stumpless_target *target );
+
 /**
  * Gets the log mask of a target.
  *
@@ -770,6 +971,37 @@ STUMPLESS_PUBLIC_FUNCTION
 const char *
 stumpless_get_target_name( const struct stumpless_target *target );
 
+/**
+ * Gets the counters of a target.
+ *
+ * The counters are updated without locks as entries are sent, and are read
+ * individually, so a snapshot taken while entries are being sent may be
+ * slightly inconsistent between counters.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. Each counter is read atomically.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to get the counters of.
+ *
+ * @param stats The structure to write the counters into.
+ *
+ * @return The target if no error is encountered. If an error is encountered,
+ * then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+const struct stumpless_target *
+stumpless_get_target_stats( const struct stumpless_target *target,
+                            struct stumpless_target_stats *stats );
+
 /**
  * Opens a target that has already been created and configured.
  *
@@ -803,6 +1035,32 @@ STUMPLESS_PUBLIC_FUNCTION
 struct stumpless_target *
 stumpless_open_target( struct stumpless_target *target );
 
+/**
+ * Resets all of the counters of a target to zero.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. Each counter is reset atomically, but entries
+ * sent while the reset is in progress may be counted in some counters and not
+ * in others.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to reset the counters of.
+ *
+ * @return The target if no error is encountered. If an error is encountered,
+ * then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_reset_target_stats( struct stumpless_target *target );
+
 /**
  * Sets the console stream to write logs to.
  *
@@ -1004,6 +1262,89 @@ struct stumpless_target *
 stumpless_set_target_filter( struct stumpless_target *target,
                              stumpless_filter_func_t filter );
 
+/**
+ * Sets the format that a target writes entries in. Targets write RFC 5424
+ * messages until this is called.
+ *
+ * The format is used by buffer, file, network, socket, and stream targets.
+ * Other target types have a format of their own, and ignore this setting.
+ *
+ * RFC 3164 messages do not include the structured data of entries. JSON Lines
+ * entries are written as a single object, with the structured data as an
+ * object holding one object for each element, and logfmt entries write each
+ * param as a key of the form `element.param`. Fields with a nil value are
+ * left out of JSON Lines and logfmt entries.
+ *
+ * The binary format is described in stumpless/binary.h. Setting it starts a
+ * new dictionary of names, even if the target already used the binary format.
+ *
+ * Note that network targets using the UDP protocol may need a larger maximum
+ * message size for the JSON Lines format, as it is more verbose. Datagrams
+ * that are lost will also keep a decoder from reading binary records until the
+ * next dictionary reset.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate changes to the
+ * target while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes, and the use of memory management
+ * functions to create the state of the binary format.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked and the use
+ * of memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to modify.
+ *
+ * @param format The format to write entries in.
+ *
+ * @return The modified target if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_target_format( struct stumpless_target *target,
+                             enum stumpless_format format );
+
+/**
+ * Enables or disables the send latency histogram of a target, reported in the
+ * latency_counts of stumpless_get_target_stats.
+ *
+ * The histogram is disabled by default, as it requires reading a monotonic
+ * clock twice for each entry sent. The other counters of the target are kept
+ * either way. Disabling the histogram leaves the counts that were already
+ * recorded in place, which can be cleared with stumpless_reset_target_stats.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. The setting is changed atomically, though
+ * entries being sent while it changes may or may not be recorded.
+ *
+ * **Async Signal Safety: AS-Safe**
+ * This function is safe to call from signal handlers.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The target to modify.
+ *
+ * @param enabled true to record the latency of each send, false to stop.
+ *
+ * @return The modified target if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_target_latency_histogram( struct stumpless_target *target,
+                                        bool enabled );
+
 /**
  * Sets the log mask of a target.
  *
@@ -20,6 +20,13 @@
  * File targets allow logs to be sent to a specified file. Files are created
  * as needed, and logs are appended to any existing contents.
  *
+ * In builds with zlib, file targets can also compress logs into gzip files
+ * as they are written. These are opened with
+ * stumpless_open_compressed_file_target and closed with
+ * stumpless_close_file_target like any other file target. If
+ * STUMPLESS_COMPRESSED_FILE_TARGETS_SUPPORTED is not defined, then compressed
+ * file targets cannot be opened.
+ *
  * **Thread Safety: MT-Safe**
  * Logging to file targets is thread safe. A mutex is used to coordinate
  * writes to the file.
@@ -36,6 +43,7 @@
 #ifndef __STUMPLESS_TARGET_FILE_H
 #  define __STUMPLESS_TARGET_FILE_H
 
+#  include <stddef.h>
 #  include <stumpless/config.h>
 #  include <stumpless/target.h>
 
@@ -99,6 +107,109 @@ STUMPLESS_PUBLIC_FUNCTION
 struct stumpless_target *
 stumpless_open_file_target( const char *name );
 
+/**
+ * Finishes the current frame of a compressed file target, so that all of the
+ * entries sent to it so far can be read from the file.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate the write with
+ * other writes to the file.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate file writes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The compressed file target to flush.
+ *
+ * @return The flushed target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_flush_compressed_file_target( struct stumpless_target *target );
+
+/**
+ * Opens a file target that compresses logs into a gzip file.
+ *
+ * Entries are compressed into frames, each of which is written to the file as
+ * a complete gzip member once it holds the frame size of uncompressed data,
+ * which is 64 KiB unless changed with
+ * stumpless_set_compressed_file_frame_size. A file holding several members is
+ * still a valid gzip file, and can be read with standard tools such as `zcat`.
+ * If the process ends without closing the target, at most the entries in the
+ * unfinished frame are lost.
+ *
+ * Entries are compressed on the thread that adds them, while the lock of the
+ * file is held.
+ *
+ * **Thread Safety: MT-Safe race:name**
+ * This function is thread safe, of course assuming that name is not modified by
+ * any other threads during execution.
+ *
+ * **Async Signal Safety: AS-Unsafe heap**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory allocation functions.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, as the memory allocation function may not be AC-Safe itself.
+ *
+ * @since release v3.1.0
+ *
+ * @param name The name of the logging target, as well as the name of the file
+ * to open. This should normally end in `.gz`.
+ *
+ * @param level The zlib compression level, from 0 for no compression to 9 for
+ * the best compression, or -1 for the zlib default.
+ *
+ * @return The opened target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_open_compressed_file_target( const char *name, int level );
+
+/**
+ * Sets the amount of uncompressed data that is held in each frame of a
+ * compressed file target. Smaller frames lose less data if the process ends
+ * without closing the target, but compress less. A frame size of zero writes
+ * each entry as a frame of its own.
+ *
+ * The new size is used once the next entry is written.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate the change with
+ * writes to the file.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The compressed file target to modify.
+ *
+ * @param frame_size The number of uncompressed bytes after which a frame is
+ * written.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_compressed_file_frame_size( struct stumpless_target *target,
+                                          size_t frame_size );
+
 #  ifdef __cplusplus
 }                               /* extern "C" */
 #  endif
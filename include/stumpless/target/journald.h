@@ -196,6 +196,40 @@ STUMPLESS_PUBLIC_FUNCTION
 struct stumpless_target *
 stumpless_open_journald_target( const char *name );
 
+#  ifdef STUMPLESS_JOURNALD_NATIVE_PROTOCOL_SUPPORTED
+/**
+ * Sets the path of the socket that journald targets send entries to. This is
+ * only available when the built-in native protocol implementation is used in
+ * place of libsystemd, and is mostly useful for testing or for sending entries
+ * to a journald instance listening somewhere other than the default socket,
+ * which is /run/systemd/journal/socket.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the path is shared by all threads
+ * without any synchronization. It should be called before any journald
+ * targets are used.
+ *
+ * **Async Signal Safety: AS-Unsafe**
+ * This function is not safe to call from signal handlers, as it may modify the
+ * path while an entry is being sent.
+ *
+ * **Async Cancel Safety: AC-Safe**
+ * This function is safe to call from threads that may be asynchronously
+ * cancelled.
+ *
+ * @since release v3.1.0
+ *
+ * @param path The path of the journald socket, as a NULL-terminated string. If
+ * this is NULL then the default socket path is restored.
+ *
+ * @return The path that was set if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+const char *
+stumpless_set_journald_socket_path( const char *path );
+#  endif
+
 #  ifdef __cplusplus
 }                               /* extern "C" */
 #  endif
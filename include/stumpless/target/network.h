@@ -62,6 +62,15 @@
  */
 #define STUMPLESS_DEFAULT_UDP_MAX_MESSAGE_SIZE 1472
 
+/**
+ * The number of milliseconds that a destination of a network target is
+ * skipped for after it fails to send an entry, if the target has more than one
+ * destination.
+ *
+ * @since release v3.1.0
+ */
+#define STUMPLESS_NETWORK_DESTINATION_RETRY_DELAY 5000
+
 #  ifdef __cplusplus
 extern "C" {
 #  endif
@@ -82,6 +91,83 @@ enum stumpless_transport_protocol {
   STUMPLESS_UDP_TRANSPORT_PROTOCOL  /**< UDP, RFC 768 */
 };
 
+/**
+ * Policies for spreading entries across the destinations of a network target
+ * that has more than one.
+ *
+ * Regardless of the policy, a destination that fails to send an entry is
+ * skipped for a while, and the entry is sent to the next destination instead.
+ *
+ * @since release v3.1.0
+ */
+enum stumpless_network_balance_policy {
+/** Send to the first healthy destination, in the order they were added. */
+  STUMPLESS_NETWORK_BALANCE_FAILOVER,
+/** Cycle through the healthy destinations. */
+  STUMPLESS_NETWORK_BALANCE_ROUND_ROBIN,
+/** Send all entries with the same facility to the same destination. */
+  STUMPLESS_NETWORK_BALANCE_FACILITY_HASH
+};
+
+/**
+ * Adds another collector to a network target.
+ *
+ * Entries sent to a target with more than one destination are spread across
+ * them according to the balance policy of the target, which can be changed
+ * with stumpless_set_network_balance_policy. The destination originally given
+ * to the target is always the first one, followed by the added ones in the
+ * order they were added.
+ *
+ * A destination that fails to send an entry is marked as unhealthy and skipped
+ * for the next \c STUMPLESS_NETWORK_DESTINATION_RETRY_DELAY milliseconds,
+ * with the entry being sent to the next healthy destination instead. Once the
+ * delay has passed, the destination is re-opened and tried again. If every
+ * destination is unhealthy, then the entry is sent to the one that the policy
+ * would normally choose.
+ *
+ * The transport port, maximum UDP message size, and transport protocol of
+ * the added destination are the same as the target. The TCP reconnection,
+ * spill queue, and connection count settings only apply to the original
+ * destination.
+ *
+ * If the target is open, then the new destination is opened before this
+ * function returns. A failure to open it is not treated as an error; instead
+ * the destination starts out as unhealthy.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as the list of destinations may be
+ * resized while other threads are sending entries to it. It should be called
+ * before the target is used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create the new destination.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The network target to add the destination to.
+ *
+ * @param destination The destination to add, as a hostname or IP address. The
+ * string is copied by the function.
+ *
+ * @param port The transport port of the destination. The string is copied by
+ * the function. If this is NULL, then the current port of the target is used.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_add_network_destination( struct stumpless_target *target,
+                                   const char *destination,
+                                   const char *port );
+
 /**
  * Closes a network target.
  *
@@ -580,6 +666,222 @@ struct stumpless_target *
 stumpless_set_destination( struct stumpless_target *target,
                            const char *destination );
 
+/**
+ * Sets how a network target spreads entries across its destinations.
+ *
+ * This has no effect unless destinations have been added to the target with
+ * stumpless_add_network_destination. Targets start out with the
+ * \c STUMPLESS_NETWORK_BALANCE_FAILOVER policy.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate changes to the
+ * target while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The network target to be modified.
+ *
+ * @param policy The new balance policy of the target.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_network_balance_policy( struct stumpless_target *target,
+                                      enum stumpless_network_balance_policy policy );
+
+/**
+ * Sets the number of connections that a TCP network target spreads its
+ * messages across.
+ *
+ * By default a TCP target uses a single connection, which means that all
+ * threads logging to it take turns writing to the same socket. Raising the
+ * connection count opens additional connections to the same destination, and
+ * each thread cycles through them as it sends messages. This reduces
+ * contention between threads at the cost of messages from different
+ * connections possibly arriving out of order at the receiver.
+ *
+ * The connections share the destination, port, reconnect backoff, and spill
+ * queue size of the target. Each connection has its own spill queue.
+ *
+ * If the target is open, the new connections are opened before this function
+ * returns. If the target is paused, they are opened along with the target when
+ * stumpless_open_target is called.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe, as connections may be destroyed while
+ * other threads are sending messages on them. It should be called before the
+ * target is used by multiple threads.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to create and destroy connections.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The TCP network target to be modified.
+ *
+ * @param count The number of connections to use. A count of zero is treated
+ * as one.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_tcp_connection_count( struct stumpless_target *target,
+                                    size_t count );
+
+/**
+ * Enables automatic reconnection of a TCP network target.
+ *
+ * Once enabled, a dropped connection is re-established on the next send
+ * instead of failing every send after it. If the reconnect attempt fails, then
+ * further attempts are held off for a delay that starts at min_delay and
+ * doubles after each failure until it reaches max_delay. Messages sent while
+ * the connection is down are held in the spill queue if one has been
+ * configured with stumpless_set_tcp_spill_queue_size, and are sent ahead of
+ * new messages once the connection is back.
+ *
+ * Automatic reconnection is disabled by default, and can be disabled again by
+ * passing a min_delay of zero.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate changes to the
+ * target while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The TCP network target to be modified.
+ *
+ * @param min_delay The delay in milliseconds after the first failed reconnect
+ * attempt. Zero disables automatic reconnection.
+ *
+ * @param max_delay The longest delay in milliseconds between reconnect
+ * attempts. If this is less than min_delay, then min_delay is used instead.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_tcp_reconnect_backoff( struct stumpless_target *target,
+                                     unsigned min_delay,
+                                     unsigned max_delay );
+
+/**
+ * Sets how long a TCP network target waits for its connection to accept more
+ * of a message before the send fails.
+ *
+ * Messages are written to the socket without blocking. If the socket cannot
+ * take all of a message at once, for example because the receiver is reading
+ * slowly, then the rest is written as space frees up, waiting at most this
+ * long each time. When the timeout passes a \c STUMPLESS_SOCKET_SEND_FAILURE
+ * error is raised with a code of ETIMEDOUT. If part of the message had already
+ * been sent, then the connection is also closed so that the next message does
+ * not continue a partial one, and it is reopened if automatic reconnection is
+ * enabled.
+ *
+ * The timeout applies to each connection and destination of the target,
+ * including those added later with stumpless_set_tcp_connection_count and
+ * stumpless_add_network_destination.
+ *
+ * Sends wait indefinitely by default, and can be made to do so again by
+ * passing a timeout of zero. The timeout only has an effect on platforms
+ * using sys/socket.h.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate changes to the
+ * target while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The TCP network target to be modified.
+ *
+ * @param timeout The longest time in milliseconds to wait for the connection
+ * to accept more of a message. Zero waits indefinitely.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_tcp_send_timeout( struct stumpless_target *target,
+                                unsigned timeout );
+
+/**
+ * Sets the size of the queue that holds messages for a TCP network target
+ * while its connection is down.
+ *
+ * This only has an effect if automatic reconnection has been enabled with
+ * stumpless_set_tcp_reconnect_backoff. Messages that do not fit into the
+ * queue fail with a \c STUMPLESS_NETWORK_CLOSED error, as they would without
+ * automatic reconnection. If the queue is shrunk below the size of the
+ * messages it currently holds, then those messages are discarded.
+ *
+ * The queue is empty by default. Memory for it is only allocated once a
+ * message needs to be held.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate changes to the
+ * target while it is being modified.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the use of a
+ * non-reentrant lock to coordinate changes and the use of memory management
+ * functions to resize the queue.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of a lock that could be left locked as well as
+ * memory management functions.
+ *
+ * @since release v3.1.0
+ *
+ * @param target The TCP network target to be modified.
+ *
+ * @param size The size of the queue in bytes, including the framing of each
+ * message.
+ *
+ * @return The modified target if no error is encountered. In the event of an
+ * error, NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_target *
+stumpless_set_tcp_spill_queue_size( struct stumpless_target *target,
+                                    size_t size );
+
 /**
  * Sets the transport port number of a network target.
  *
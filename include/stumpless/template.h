@@ -0,0 +1,159 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/** @file
+ * Entry templates, for creating many entries that share the same layout.
+ *
+ * A template is compiled once from a prototype entry, and holds its own copy
+ * of the prototype's header fields, elements, params, and message. Entries
+ * created from the template have the same layout, but instead of copying the
+ * param values and message they reference the ones held by the template. Only
+ * the fields that are changed on an entry after it is created are copied into
+ * it, using the usual entry, element, and param setters.
+ *
+ * Entries created from a template are ordinary entries, and can be logged to
+ * any target and destroyed with stumpless_destroy_entry_and_contents. The
+ * template must not be destroyed until all of the entries created from it
+ * have been destroyed.
+ *
+ * Because of this, each entry still has its own element and param structures,
+ * each with its own mutex. Their pointers can be retrieved and changed through
+ * the usual functions, so they cannot be shared with the template or with
+ * other entries. Creating an entry from a template saves the copying and
+ * checking of the param values and message, but not these allocations.
+ *
+ * @since release v3.1.0
+ */
+
+#ifndef __STUMPLESS_TEMPLATE_H
+#  define __STUMPLESS_TEMPLATE_H
+
+#  include <stumpless/config.h>
+#  include <stumpless/entry.h>
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif
+
+/**
+ * A compiled prototype entry that new entries can be created from.
+ *
+ * @since release v3.1.0
+ */
+struct stumpless_entry_template;
+
+/**
+ * Destroys an entry template.
+ *
+ * Entries created from the template reference its param values and message,
+ * so they must all be destroyed before the template is.
+ *
+ * **Thread Safety: MT-Unsafe**
+ * This function is not thread safe as it destroys resources that other threads
+ * would use if they tried to reference this template.
+ *
+ * **Async Signal Safety: AS-Unsafe lock heap**
+ * This function is not safe to call from signal handlers due to the destruction
+ * of a lock that may be in use as well as the use of the memory deallocation
+ * function to release memory.
+ *
+ * **Async Cancel Safety: AC-Unsafe lock heap**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, as the cleanup of the lock may not be completed, and the memory
+ * deallocation function may not be AC-Safe itself.
+ *
+ * @since release v3.1.0
+ *
+ * @param tmpl The template to destroy. If this is NULL, then nothing is done.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+void
+stumpless_destroy_entry_template( const struct stumpless_entry_template *tmpl );
+
+/**
+ * Creates a new entry with the layout of a template.
+ *
+ * The new entry has the same facility, severity, app name, msgid, hostname,
+ * procid, elements, and params as the prototype the template was compiled
+ * from. The param values and message of the new entry reference those held by
+ * the template instead of being copied, and are not checked again as they
+ * were checked when the prototype was built. Setting a param value or the
+ * message of the entry replaces the reference with a copy as usual.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. Templates are not modified after they are
+ * compiled, so any number of threads may create entries from the same
+ * template at once.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions to create the new entry as well as the use of
+ * mutex initialization routines.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions and mutex
+ * initialization routines.
+ *
+ * @since release v3.1.0
+ *
+ * @param tmpl The template to create the entry from.
+ *
+ * @return The new entry if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry *
+stumpless_new_entry_from_template( const struct stumpless_entry_template *tmpl );
+
+/**
+ * Compiles a template from a prototype entry.
+ *
+ * The template holds its own copy of the prototype, so the prototype may be
+ * changed or destroyed after this call without affecting the template or the
+ * entries created from it.
+ *
+ * **Thread Safety: MT-Safe**
+ * This function is thread safe. A mutex is used to coordinate reads of the
+ * prototype with other accesses and modifications.
+ *
+ * **Async Signal Safety: AS-Unsafe heap lock**
+ * This function is not safe to call from signal handlers due to the use of
+ * memory management functions to create the template as well as the use of
+ * locks to read the prototype.
+ *
+ * **Async Cancel Safety: AC-Unsafe heap lock**
+ * This function is not safe to call from threads that may be asynchronously
+ * cancelled, due to the use of memory management functions and locks that
+ * could be left locked.
+ *
+ * @since release v3.1.0
+ *
+ * @param prototype The entry to compile into a template.
+ *
+ * @return The new template if no error is encountered. If an error is
+ * encountered, then NULL is returned and an error code is set appropriately.
+ */
+STUMPLESS_PUBLIC_FUNCTION
+struct stumpless_entry_template *
+stumpless_new_entry_template( const struct stumpless_entry *prototype );
+
+#  ifdef __cplusplus
+}                               /* extern "C" */
+#  endif
+#endif                          /* __STUMPLESS_TEMPLATE_H */
@@ -0,0 +1,79 @@
+/* SPDX-License-Identifier: Apache-2.0 */
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifndef __STUMPLESS_TEST_HELPER_SCALING_HPP
+#  define __STUMPLESS_TEST_HELPER_SCALING_HPP
+
+#  include <benchmark/benchmark.h>
+#  include <stumpless.h>
+
+/**
+ * The largest number of threads that scaling benchmarks are run with. This
+ * matches the thread count of the thread safety tests.
+ */
+#  define SCALING_MAX_THREADS 16
+
+/**
+ * Registers a scaling benchmark for each thread count from one up to
+ * SCALING_MAX_THREADS, doubling each time. Wall clock time is used as the
+ * threads run in parallel.
+ *
+ * SETUP and TEARDOWN are run once for each thread count, before the threads
+ * are started and after they have all finished. Shared state such as the
+ * target and the memory counter must be set up and torn down in these rather
+ * than in the benchmark function, where other threads could read it while
+ * the first thread is still changing it.
+ */
+#  define SCALING_BENCHMARK( FUNC, SETUP, TEARDOWN )                           \
+BENCHMARK( FUNC )->Setup( SETUP )->Teardown( TEARDOWN )                        \
+                 ->ThreadRange( 1, SCALING_MAX_THREADS )->UseRealTime(  )
+
+/**
+ * Adds an entry to the target once per iteration of the benchmark in the
+ * calling thread, and reports the following for the thread:
+ *
+ *  - items_per_second: entries added per second, summed over all threads
+ *  - p50LatencyNs and p99LatencyNs: percentiles of the time taken by each
+ *    call to stumpless_add_entry, averaged over all threads
+ *  - AllocsPerEntry: calls to the allocation functions made per entry
+ *
+ * Each thread uses its own entry, so that the entry lock does not add to the
+ * contention on the target. The target must have been opened by the setup
+ * function of the benchmark, and the memory functions set there with
+ * init_scaling_memory_counter for allocations to be counted.
+ *
+ * stumpless_free_thread is called once the benchmark loop finishes.
+ */
+void
+add_entries_and_measure( benchmark::State &state,
+                         struct stumpless_target *target );
+
+/**
+ * Restores the default memory functions.
+ */
+void
+finalize_scaling_memory_counter( void );
+
+/**
+ * Sets the memory functions used by stumpless to ones that count the calls to
+ * malloc and realloc in each thread.
+ */
+void
+init_scaling_memory_counter( void );
+
+#endif /* __STUMPLESS_TEST_HELPER_SCALING_HPP */
@@ -0,0 +1,874 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stumpless/binary.h>
+#include <stumpless/element.h>
+#include <stumpless/entry.h>
+#include <stumpless/param.h>
+#include "private/binary.h"
+#include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/thread_safety.h"
+#include "private/error.h"
+#include "private/formatter.h"
+#include "private/inthelper.h"
+#include "private/memory.h"
+#include "private/strbuilder.h"
+#include "private/target.h"
+#include "private/validate.h"
+
+/** The most bytes that a 64 bit varint can take. */
+#define MAX_VARINT_SIZE 10
+
+/** The number of nanoseconds in a second. */
+#define NANOS_PER_SECOND 1000000000ULL
+
+/** The result of reading the length of a record. */
+enum length_result {
+  LENGTH_READ,
+  LENGTH_INCOMPLETE,
+  LENGTH_INVALID
+};
+
+/**
+ * Appends an integer as a varint of the value plus one, which never includes
+ * a zero byte.
+ */
+static
+struct strbuilder *
+append_varint( struct strbuilder *builder, uint64_t value ) {
+  char bytes[MAX_VARINT_SIZE];
+  size_t count = 0;
+
+  value++;
+  while( value >= 0x80 ) {
+    bytes[count++] = ( char ) ( ( value & 0x7f ) | 0x80 );
+    value >>= 7;
+  }
+  bytes[count++] = ( char ) value;
+
+  return strbuilder_append_buffer( builder, bytes, count );
+}
+
+static
+struct strbuilder *
+append_string( struct strbuilder *builder, const char *str, size_t length ) {
+  builder = append_varint( builder, length );
+  return strbuilder_append_buffer( builder, str, length );
+}
+
+static
+uint32_t
+hash_name( const char *name, size_t length ) {
+  uint32_t hash = 2166136261U;
+  size_t i;
+
+  for( i = 0; i < length; i++ ) {
+    hash ^= ( unsigned char ) name[i];
+    hash *= 16777619U;
+  }
+
+  return hash;
+}
+
+/**
+ * Adds a name to the end of a dictionary, if it is short enough and there is
+ * room for it. Encoders and decoders must make the same choice here.
+ *
+ * @return The id of the new name, or -1 if it was not added.
+ */
+static
+int
+add_to_dictionary( struct binary_dictionary *dictionary,
+                   const char *name,
+                   size_t length ) {
+  size_t id;
+
+  if( length > BINARY_MAX_NAME_LENGTH
+      || dictionary->count == BINARY_DICTIONARY_SIZE ) {
+    return -1;
+  }
+
+  id = dictionary->count++;
+  memcpy( dictionary->names[id], name, length );
+  dictionary->lengths[id] = length;
+
+  return ( int ) id;
+}
+
+static
+void
+clear_encoder_dictionary( struct binary_encoder *encoder ) {
+  encoder->dictionary.count = 0;
+  memset( encoder->index, 0, sizeof( encoder->index ) );
+}
+
+/**
+ * Appends a name, as a reference to the dictionary if it has been written
+ * since the last reset and in full otherwise.
+ */
+static
+struct strbuilder *
+append_name( struct strbuilder *builder,
+             struct binary_encoder *encoder,
+             const char *name,
+             size_t length ) {
+  struct binary_dictionary *dictionary = &encoder->dictionary;
+  size_t slot;
+  size_t id;
+  int new_id;
+
+  slot = hash_name( name, length ) % BINARY_INDEX_SIZE;
+  while( encoder->index[slot] != 0 ) {
+    id = encoder->index[slot] - 1;
+    if( dictionary->lengths[id] == length
+        && memcmp( dictionary->names[id], name, length ) == 0 ) {
+      return append_varint( builder, ( ( uint64_t ) id << 1 ) | 1 );
+    }
+
+    slot = ( slot + 1 ) % BINARY_INDEX_SIZE;
+  }
+
+  new_id = add_to_dictionary( dictionary, name, length );
+  if( new_id != -1 ) {
+    encoder->index[slot] = ( unsigned short ) ( new_id + 1 );
+  }
+
+  builder = append_varint( builder, ( uint64_t ) length << 1 );
+  return strbuilder_append_buffer( builder, name, length );
+}
+
+static
+bool
+parse_digits( const char *str, size_t count, uint64_t *value ) {
+  size_t i;
+
+  *value = 0;
+  for( i = 0; i < count; i++ ) {
+    if( str[i] < '0' || str[i] > '9' ) {
+      return false;
+    }
+
+    *value = *value * 10 + ( uint64_t ) ( str[i] - '0' );
+  }
+
+  return true;
+}
+
+/**
+ * Gets the number of days from the Unix epoch to a date in the proleptic
+ * Gregorian calendar, for years of 1970 and later.
+ */
+static
+uint64_t
+days_from_civil( uint64_t year, uint64_t month, uint64_t day ) {
+  uint64_t era;
+  uint64_t year_of_era;
+  uint64_t day_of_year;
+  uint64_t day_of_era;
+
+  if( month <= 2 ) {
+    year--;
+  }
+
+  era = year / 400;
+  year_of_era = year - era * 400;
+  day_of_year = ( 153 * ( month > 2 ? month - 3 : month + 9 ) + 2 ) / 5
+                + day - 1;
+  day_of_era = year_of_era * 365 + year_of_era / 4 - year_of_era / 100
+               + day_of_year;
+
+  return era * 146097 + day_of_era - 719468;
+}
+
+/**
+ * Converts an RFC 5424 timestamp of the form YYYY-MM-DDThh:mm:ss.ffffffZ to
+ * nanoseconds since the Unix epoch. Timestamps with a numeric offset such as
+ * +02:00 in place of the Z, as relayed messages may have, are converted to UTC.
+ */
+static
+bool
+parse_timestamp( const char *timestamp, size_t size, uint64_t *nanos ) {
+  uint64_t year;
+  uint64_t month;
+  uint64_t day;
+  uint64_t hour;
+  uint64_t minute;
+  uint64_t second;
+  uint64_t fraction = 0;
+  uint64_t scale = NANOS_PER_SECOND;
+  uint64_t offset_hour;
+  uint64_t offset_minute;
+  uint64_t offset = 0;
+  bool offset_is_negative = false;
+  size_t zone;
+  size_t i;
+
+  if( size < 20 ) {
+    return false;
+  }
+
+  if( timestamp[size - 1] == 'Z' ) {
+    zone = size - 1;
+
+  } else if( size >= 25
+             && ( timestamp[size - 6] == '+' || timestamp[size - 6] == '-' )
+             && timestamp[size - 3] == ':'
+             && parse_digits( timestamp + size - 5, 2, &offset_hour )
+             && parse_digits( timestamp + size - 2, 2, &offset_minute ) ) {
+    zone = size - 6;
+    offset = ( offset_hour * 60 + offset_minute ) * 60;
+    offset_is_negative = timestamp[zone] == '-';
+
+  } else {
+    return false;
+  }
+
+  if( zone < 19
+      || timestamp[4] != '-' || timestamp[7] != '-' || timestamp[10] != 'T'
+      || timestamp[13] != ':' || timestamp[16] != ':'
+      || !parse_digits( timestamp, 4, &year )
+      || !parse_digits( timestamp + 5, 2, &month )
+      || !parse_digits( timestamp + 8, 2, &day )
+      || !parse_digits( timestamp + 11, 2, &hour )
+      || !parse_digits( timestamp + 14, 2, &minute )
+      || !parse_digits( timestamp + 17, 2, &second )
+      || year < 1970 || month < 1 || month > 12 ) {
+    return false;
+  }
+
+  if( timestamp[19] == '.' ) {
+    for( i = 20; i < zone && scale > 1; i++ ) {
+      if( timestamp[i] < '0' || timestamp[i] > '9' ) {
+        return false;
+      }
+
+      scale /= 10;
+      fraction += ( uint64_t ) ( timestamp[i] - '0' ) * scale;
+    }
+  }
+
+  *nanos = ( ( days_from_civil( year, month, day ) * 24 + hour ) * 60
+             + minute ) * 60 + second;
+
+  // the local time is ahead of UTC by a positive offset
+  if( offset_is_negative ) {
+    *nanos += offset;
+  } else if( *nanos >= offset ) {
+    *nanos -= offset;
+  } else {
+    return false;
+  }
+
+  *nanos = *nanos * NANOS_PER_SECOND + fraction;
+  return true;
+}
+
+/**
+ * Appends the decimal digits of a value, padded with zeros to a width.
+ */
+static
+struct strbuilder *
+append_padded( struct strbuilder *builder, uint64_t value, size_t width ) {
+  char digits[20];
+  size_t count = 0;
+
+  do {
+    digits[count++] = ( char ) ( '0' + value % 10 );
+    value /= 10;
+  } while( value != 0 && count < sizeof( digits ) );
+
+  while( width > count ) {
+    builder = strbuilder_append_char( builder, '0' );
+    width--;
+  }
+
+  while( count > 0 ) {
+    builder = strbuilder_append_char( builder, digits[--count] );
+  }
+
+  return builder;
+}
+
+/**
+ * Appends nanoseconds since the Unix epoch as an RFC 5424 timestamp with
+ * microsecond precision, the same as the formatter writes.
+ */
+static
+struct strbuilder *
+append_timestamp( struct strbuilder *builder, uint64_t nanos ) {
+  uint64_t seconds = nanos / NANOS_PER_SECOND;
+  uint64_t days = seconds / 86400;
+  uint64_t day_seconds = seconds % 86400;
+  uint64_t era;
+  uint64_t day_of_era;
+  uint64_t year_of_era;
+  uint64_t day_of_year;
+  uint64_t shifted_month;
+  uint64_t year;
+  uint64_t month;
+  uint64_t day;
+
+  days += 719468;
+  era = days / 146097;
+  day_of_era = days - era * 146097;
+  year_of_era = ( day_of_era - day_of_era / 1460 + day_of_era / 36524
+                  - day_of_era / 146096 ) / 365;
+  day_of_year = day_of_era
+                - ( 365 * year_of_era + year_of_era / 4 - year_of_era / 100 );
+  shifted_month = ( 5 * day_of_year + 2 ) / 153;
+  day = day_of_year - ( 153 * shifted_month + 2 ) / 5 + 1;
+  month = shifted_month < 10 ? shifted_month + 3 : shifted_month - 9;
+  year = year_of_era + era * 400 + ( month <= 2 ? 1 : 0 );
+
+  builder = append_padded( builder, year, 4 );
+  builder = strbuilder_append_char( builder, '-' );
+  builder = append_padded( builder, month, 2 );
+  builder = strbuilder_append_char( builder, '-' );
+  builder = append_padded( builder, day, 2 );
+  builder = strbuilder_append_char( builder, 'T' );
+  builder = append_padded( builder, day_seconds / 3600, 2 );
+  builder = strbuilder_append_char( builder, ':' );
+  builder = append_padded( builder, ( day_seconds / 60 ) % 60, 2 );
+  builder = strbuilder_append_char( builder, ':' );
+  builder = append_padded( builder, day_seconds % 60, 2 );
+  builder = strbuilder_append_char( builder, '.' );
+  builder = append_padded( builder, ( nanos % NANOS_PER_SECOND ) / 1000, 6 );
+  return strbuilder_append_char( builder, 'Z' );
+}
+
+/**
+ * Reads a varint written by append_varint.
+ *
+ * @return true if a valid varint was read before the end of the data.
+ */
+static
+bool
+read_varint( const char **position, const char *end, uint64_t *value ) {
+  uint64_t result = 0;
+  unsigned shift = 0;
+  unsigned char current;
+
+  do {
+    if( *position == end || shift > 63 ) {
+      return false;
+    }
+
+    current = ( unsigned char ) *( ( *position )++ );
+    result |= ( uint64_t ) ( current & 0x7f ) << shift;
+    shift += 7;
+  } while( current & 0x80 );
+
+  if( result == 0 ) {
+    return false;
+  }
+
+  *value = result - 1;
+  return true;
+}
+
+static
+bool
+read_string( const char **position,
+             const char *end,
+             const char **str,
+             size_t *length ) {
+  uint64_t value;
+
+  if( !read_varint( position, end, &value )
+      || value > ( uint64_t ) ( end - *position ) ) {
+    return false;
+  }
+
+  *str = *position;
+  *length = ( size_t ) value;
+  *position += value;
+  return true;
+}
+
+static
+bool
+read_name( const char **position,
+           const char *end,
+           struct binary_dictionary *dictionary,
+           const char **name,
+           size_t *length ) {
+  uint64_t value;
+  uint64_t id;
+
+  if( !read_varint( position, end, &value ) ) {
+    return false;
+  }
+
+  if( value & 1 ) {
+    id = value >> 1;
+    if( id >= dictionary->count ) {
+      return false;
+    }
+
+    *name = dictionary->names[id];
+    *length = dictionary->lengths[id];
+    return true;
+  }
+
+  value >>= 1;
+  if( value > ( uint64_t ) ( end - *position ) ) {
+    return false;
+  }
+
+  *name = *position;
+  *length = ( size_t ) value;
+  *position += value;
+  add_to_dictionary( dictionary, *name, *length );
+  return true;
+}
+
+/**
+ * Reads a name and appends it to the output of a decoder.
+ */
+static
+bool
+decode_name( struct stumpless_binary_decoder *decoder,
+             const char **position,
+             const char *end ) {
+  const char *name;
+  size_t length;
+
+  if( !read_name( position, end, &decoder->dictionary, &name, &length ) ) {
+    return false;
+  }
+
+  decoder->output = strbuilder_append_buffer( decoder->output, name, length );
+  return true;
+}
+
+/**
+ * Decodes the body of a record into the output of a decoder.
+ *
+ * @return true if the body was valid.
+ */
+static
+bool
+decode_body( struct stumpless_binary_decoder *decoder,
+             const char *position,
+             const char *end ) {
+  unsigned char flags;
+  uint64_t value;
+  uint64_t element_count;
+  uint64_t param_count;
+  const char *str;
+  size_t length;
+
+  if( position == end ) {
+    return false;
+  }
+
+  flags = ( unsigned char ) *( position++ );
+  if( !( flags & BINARY_FLAG_MARKER ) ) {
+    return false;
+  }
+
+  if( flags & BINARY_FLAG_RESET ) {
+    decoder->dictionary.count = 0;
+  }
+
+  if( !read_varint( &position, end, &value ) ) {
+    return false;
+  }
+
+  if( value > RFC_5424_MAX_PRIVAL ) {
+    return false;
+  }
+
+  decoder->output = strbuilder_append_char( decoder->output, '<' );
+  decoder->output = strbuilder_append_positive_int( decoder->output,
+                                                    ( int ) value );
+  decoder->output = strbuilder_append_string( decoder->output, ">1 " );
+
+  if( flags & BINARY_FLAG_TIMESTAMP ) {
+    if( !read_varint( &position, end, &value ) ) {
+      return false;
+    }
+
+    decoder->output = append_timestamp( decoder->output, value );
+  } else {
+    decoder->output = strbuilder_append_char( decoder->output,
+                                              RFC_5424_NILVALUE );
+  }
+
+  decoder->output = strbuilder_append_char( decoder->output, ' ' );
+  if( !decode_name( decoder, &position, end ) ) {
+    return false;
+  }
+
+  decoder->output = strbuilder_append_char( decoder->output, ' ' );
+  if( !decode_name( decoder, &position, end ) ) {
+    return false;
+  }
+
+  if( !read_string( &position, end, &str, &length ) ) {
+    return false;
+  }
+  decoder->output = strbuilder_append_char( decoder->output, ' ' );
+  decoder->output = strbuilder_append_buffer( decoder->output, str, length );
+
+  decoder->output = strbuilder_append_char( decoder->output, ' ' );
+  if( !decode_name( decoder, &position, end ) ) {
+    return false;
+  }
+
+  decoder->output = strbuilder_append_char( decoder->output, ' ' );
+  if( !read_varint( &position, end, &element_count ) ) {
+    return false;
+  }
+
+  if( element_count == 0 ) {
+    decoder->output = strbuilder_append_char( decoder->output,
+                                              RFC_5424_NILVALUE );
+  }
+
+  for( ; element_count > 0; element_count-- ) {
+    decoder->output = strbuilder_append_char( decoder->output, '[' );
+    if( !decode_name( decoder, &position, end )
+        || !read_varint( &position, end, &param_count ) ) {
+      return false;
+    }
+
+    for( ; param_count > 0; param_count-- ) {
+      decoder->output = strbuilder_append_char( decoder->output, ' ' );
+      if( !decode_name( decoder, &position, end )
+          || !read_string( &position, end, &str, &length ) ) {
+        return false;
+      }
+
+      decoder->output = strbuilder_append_string( decoder->output, "=\"" );
+      decoder->output = strbuilder_append_escaped_param_value( decoder->output,
+                                                               str,
+                                                               length );
+      decoder->output = strbuilder_append_char( decoder->output, '"' );
+    }
+
+    decoder->output = strbuilder_append_char( decoder->output, ']' );
+  }
+
+  if( !read_string( &position, end, &str, &length ) || position != end ) {
+    return false;
+  }
+
+  if( length > 0 ) {
+    decoder->output = strbuilder_append_char( decoder->output, ' ' );
+    decoder->output = strbuilder_append_buffer( decoder->output, str, length );
+  }
+
+  return true;
+}
+
+/**
+ * Reads the length at the start of a record.
+ */
+static
+enum length_result
+read_record_length( const char *data,
+                    size_t size,
+                    size_t *prefix_size,
+                    uint64_t *body_size ) {
+  const char *position = data;
+  const char *end = data + size;
+  size_t i;
+
+  if( read_varint( &position, end, body_size ) ) {
+    *prefix_size = position - data;
+    return LENGTH_READ;
+  }
+
+  // a varint that runs off the end of the data may just be incomplete
+  for( i = 0; i < size; i++ ) {
+    if( !( data[i] & 0x80 ) ) {
+      return LENGTH_INVALID;
+    }
+  }
+
+  return size < MAX_VARINT_SIZE ? LENGTH_INCOMPLETE : LENGTH_INVALID;
+}
+
+/* public definitions */
+
+const char *
+stumpless_decode_binary_record( struct stumpless_binary_decoder *decoder,
+                                const char *data,
+                                size_t size,
+                                size_t *consumed ) {
+  enum length_result length_result;
+  size_t prefix_size = 0;
+  uint64_t body_size = 0;
+  size_t record_size;
+  char terminator;
+  struct strbuilder *output;
+  bool valid;
+
+  VALIDATE_ARG_NOT_NULL( decoder );
+  VALIDATE_ARG_NOT_NULL( data );
+  VALIDATE_ARG_NOT_NULL( consumed );
+
+  *consumed = 0;
+
+  length_result = read_record_length( data, size, &prefix_size, &body_size );
+  if( length_result == LENGTH_INCOMPLETE ) {
+    clear_error(  );
+    return NULL;
+  }
+
+  if( length_result == LENGTH_INVALID ) {
+    *consumed = size;
+    raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "binary record" ) );
+    return NULL;
+  }
+
+  if( body_size >= size - prefix_size ) {
+    clear_error(  );
+    return NULL;
+  }
+
+  record_size = prefix_size + ( size_t ) body_size + 1;
+  *consumed = record_size;
+
+  terminator = data[record_size - 1];
+  output = strbuilder_reset( decoder->output );
+  valid = ( terminator == '\n' || terminator == '\0' )
+            && decode_body( decoder,
+                            data + prefix_size,
+                            data + prefix_size + body_size );
+  decoder->output = strbuilder_append_char( decoder->output, '\0' );
+
+  // the output is kept so that it is not lost if an append fails
+  if( !decoder->output ) {
+    decoder->output = output;
+    return NULL;
+  }
+
+  if( !valid ) {
+    raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "binary record" ) );
+    return NULL;
+  }
+
+  clear_error(  );
+  return strbuilder_get_buffer( decoder->output, &record_size );
+}
+
+void
+stumpless_destroy_binary_decoder( const struct stumpless_binary_decoder *decoder ) {
+  if( !decoder ) {
+    return;
+  }
+
+  strbuilder_destroy( decoder->output );
+  free_mem( decoder );
+}
+
+struct stumpless_binary_decoder *
+stumpless_new_binary_decoder( void ) {
+  struct stumpless_binary_decoder *decoder;
+
+  decoder = alloc_mem( sizeof( *decoder ) );
+  if( !decoder ) {
+    return NULL;
+  }
+
+  decoder->output = strbuilder_new(  );
+  if( !decoder->output ) {
+    free_mem( decoder );
+    return NULL;
+  }
+
+  decoder->dictionary.count = 0;
+
+  clear_error(  );
+  return decoder;
+}
+
+/* private definitions */
+
+struct strbuilder *
+append_binary_record( struct strbuilder *builder,
+                      const struct stumpless_entry *entry,
+                      const struct target_header *header,
+                      int pid,
+                      const char *timestamp,
+                      size_t timestamp_size ) {
+  struct binary_encoder *encoder = header->binary_encoder;
+  struct strbuilder *body;
+  const struct stumpless_element *element;
+  const struct stumpless_param *param;
+  char digits[MAX_INT_SIZE];
+  size_t digit_count;
+  const char *body_buffer;
+  size_t body_size;
+  uint64_t nanos = 0;
+  unsigned char flags = BINARY_FLAG_MARKER;
+  size_t i;
+  size_t j;
+
+  if( encoder->records_since_reset == 0
+      || encoder->records_since_reset >= BINARY_RESET_INTERVAL
+      || encoder->dictionary.count == BINARY_DICTIONARY_SIZE ) {
+    clear_encoder_dictionary( encoder );
+    encoder->records_since_reset = 0;
+    flags |= BINARY_FLAG_RESET;
+  }
+  encoder->records_since_reset++;
+
+  // a NILVALUE timestamp, as a relayed message may have, is written as a
+  // record without a timestamp, which is decoded back into a NILVALUE
+  if( !( timestamp_size == 1 && timestamp[0] == RFC_5424_NILVALUE )
+      && parse_timestamp( timestamp, timestamp_size, &nanos ) ) {
+    flags |= BINARY_FLAG_TIMESTAMP;
+  }
+
+  // the body builder is kept so that it is not lost if an append fails
+  body = strbuilder_reset( encoder->body );
+  body = strbuilder_append_char( body, ( char ) flags );
+  body = append_varint( body, ( uint64_t ) entry->prival );
+  if( flags & BINARY_FLAG_TIMESTAMP ) {
+    body = append_varint( body, nanos );
+  }
+
+  if( entry->hostname_length > 0 ) {
+    body = append_name( body,
+                        encoder,
+                        entry->hostname,
+                        entry->hostname_length );
+  } else {
+    body = append_name( body,
+                        encoder,
+                        header->segment,
+                        header->hostname_length );
+  }
+
+  body = append_name( body, encoder, entry->app_name, entry->app_name_length );
+
+  if( header->pid == 0 ) {
+    body = append_string( body, "-", 1 );
+  } else if( entry->procid_length > 0 ) {
+    body = append_string( body, entry->procid, entry->procid_length );
+  } else {
+    digit_count = 0;
+    do {
+      digits[digit_count++] = ( char ) ( '0' + pid % 10 );
+      pid /= 10;
+    } while( pid > 0 && digit_count < sizeof( digits ) );
+
+    body = append_varint( body, digit_count );
+    while( digit_count > 0 ) {
+      body = strbuilder_append_char( body, digits[--digit_count] );
+    }
+  }
+
+  body = append_name( body, encoder, entry->msgid, entry->msgid_length );
+
+  body = append_varint( body, entry->element_count );
+  for( i = 0; i < entry->element_count; i++ ) {
+    element = entry->elements[i];
+    body = append_name( body, encoder, element->name, element->name_length );
+
+    body = append_varint( body, element->param_count );
+    for( j = 0; j < element->param_count; j++ ) {
+      param = element->params[j];
+      body = append_name( body, encoder, param->name, param->name_length );
+      body = append_string( body, param->value, param->value_length );
+    }
+  }
+
+  if( entry->message_length > 0 ) {
+    body = append_string( body, entry->message, entry->message_length );
+  } else {
+    body = append_varint( body, 0 );
+  }
+
+  if( !body ) {
+    // the names added to the dictionary will never be written
+    encoder->records_since_reset = 0;
+    return NULL;
+  }
+
+  body_buffer = strbuilder_get_buffer( body, &body_size );
+  builder = append_varint( builder, body_size );
+  return strbuilder_append_buffer( builder, body_buffer, body_size );
+}
+
+void
+destroy_binary_encoder( struct binary_encoder *encoder ) {
+  if( !encoder ) {
+    return;
+  }
+
+  config_destroy_mutex( &encoder->mutex );
+  strbuilder_destroy( encoder->body );
+  free_mem( encoder );
+}
+
+void
+lock_binary_encoder( struct binary_encoder *encoder ) {
+  if( encoder ) {
+    config_lock_mutex( &encoder->mutex );
+  }
+}
+
+struct binary_encoder *
+new_binary_encoder( void ) {
+  struct binary_encoder *encoder;
+
+  encoder = alloc_mem( sizeof( *encoder ) );
+  if( !encoder ) {
+    return NULL;
+  }
+
+  encoder->body = strbuilder_new(  );
+  if( !encoder->body ) {
+    free_mem( encoder );
+    return NULL;
+  }
+
+  config_init_mutex( &encoder->mutex );
+  clear_encoder_dictionary( encoder );
+  encoder->records_since_reset = 0;
+
+  return encoder;
+}
+
+void
+reset_binary_encoder( struct binary_encoder *encoder ) {
+  config_lock_mutex( &encoder->mutex );
+  encoder->records_since_reset = 0;
+  config_unlock_mutex( &encoder->mutex );
+}
+
+void
+unlock_binary_encoder( struct binary_encoder *encoder, int result ) {
+  if( !encoder ) {
+    return;
+  }
+
+  if( result < 0 ) {
+    encoder->records_since_reset = 0;
+  }
+
+  config_unlock_mutex( &encoder->mutex );
+}
@@ -0,0 +1,42 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <stumpless/target.h>
+#include <stumpless/target/file.h>
+#include "private/config/wrapper/locale.h"
+#include "private/error.h"
+
+struct stumpless_target *
+stumpless_flush_compressed_file_target( struct stumpless_target *target ) {
+  raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+  return NULL;
+}
+
+struct stumpless_target *
+stumpless_open_compressed_file_target( const char *name, int level ) {
+  raise_target_unsupported( L10N_OPEN_UNSUPPORTED_TARGET_ERROR_MESSAGE );
+  return NULL;
+}
+
+struct stumpless_target *
+stumpless_set_compressed_file_frame_size( struct stumpless_target *target,
+                                          size_t frame_size ) {
+  raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+  return NULL;
+}
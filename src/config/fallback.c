@@ -19,8 +19,10 @@
 #include <errno.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdlib.h>
 #include <stumpless/config.h>
+#include <time.h>
 #include "private/config/fallback.h"
 #include "private/config/wrapper/locale.h"
 #include "private/config/wrapper/thread_safety.h"
@@ -104,6 +106,11 @@ fallback_getpagesize( void ) {
   return STUMPLESS_FALLBACK_PAGESIZE;
 }
 
+uint64_t
+fallback_get_monotonic_ns( void ) {
+  return ( uint64_t ) time( NULL ) * 1000000000;
+}
+
 int
 fallback_getpid( void ) {
   return 0;
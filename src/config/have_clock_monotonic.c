@@ -0,0 +1,32 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdint.h>
+#include <time.h>
+#include "private/config/have_clock_monotonic.h"
+
+uint64_t
+clock_monotonic_get_monotonic_ns( void ) {
+  struct timespec now;
+
+  if( clock_gettime( CLOCK_MONOTONIC, &now ) != 0 ) {
+    return 0;
+  }
+
+  return ( ( uint64_t ) now.tv_sec * 1000000000 ) + ( uint64_t ) now.tv_nsec;
+}
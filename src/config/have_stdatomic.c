@@ -21,6 +21,11 @@
 #include <stdint.h>
 #include "private/config/have_stdatomic.h"
 
+void
+stdatomic_add_u64( atomic_uint_least64_t *u, uint64_t value ) {
+  atomic_fetch_add( u, value );
+}
+
 bool
 stdatomic_compare_exchange_bool( atomic_bool *b,
                                  bool expected,
@@ -39,6 +44,15 @@ stdatomic_compare_exchange_ptr( atomic_uintptr_t *p,
                                          ( uintptr_t ) replacement );
 }
 
+bool
+stdatomic_compare_exchange_u64( atomic_uint_least64_t *u,
+                                uint64_t expected,
+                                uint64_t replacement ) {
+  uint_least64_t expected_uint = expected;
+
+  return atomic_compare_exchange_strong( u, &expected_uint, replacement );
+}
+
 bool
 stdatomic_read_bool( atomic_bool *b ) {
   return ( bool ) atomic_load( b );
@@ -49,6 +63,11 @@ stdatomic_read_ptr( atomic_uintptr_t *p ) {
   return ( void * ) atomic_load( p );
 }
 
+uint64_t
+stdatomic_read_u64( atomic_uint_least64_t *u ) {
+  return ( uint64_t ) atomic_load( u );
+}
+
 void
 stdatomic_write_bool( atomic_bool *b, bool replacement ) {
   atomic_store( b, replacement );
@@ -58,3 +77,8 @@ void
 stdatomic_write_ptr( atomic_uintptr_t *p, void *replacement ) {
   atomic_store( p, ( uintptr_t ) replacement );
 }
+
+void
+stdatomic_write_u64( atomic_uint_least64_t *u, uint64_t replacement ) {
+  atomic_store( u, replacement );
+}
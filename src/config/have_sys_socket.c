@@ -19,6 +19,9 @@
 #include "private/config/have_sys_socket.h"
 
 #include <errno.h>
+#include <limits.h>
+#include <poll.h>
+#include <stdbool.h>
 #include <stddef.h>
 #include <sys/socket.h>
 #include <sys/types.h>
@@ -26,6 +29,7 @@
 #include "private/config.h"
 #include "private/config/wrapper/locale.h"
 #include "private/config/wrapper/int_connect.h"
+#include "private/config/wrapper/probe.h"
 #include "private/config/wrapper/thread_safety.h"
 #include "private/error.h"
 #include "private/target/network.h"
@@ -177,46 +181,250 @@ sys_socket_reopen_udp6_target( struct network_target *target ) {
   return target;
 }
 
+/**
+ * Waits until the socket of a TCP target can accept more data, or until the
+ * send timeout of the target passes.
+ *
+ * @return true if the socket is ready for writing or has an error that the
+ * next send will report, false if the timeout passed.
+ */
+static
+bool
+wait_for_tcp_writable( const struct network_target *target ) {
+  struct pollfd poll_handle;
+  int timeout;
+  int poll_result;
+
+  if( target->send_timeout == 0 ) {
+    timeout = -1;
+  } else if( target->send_timeout > INT_MAX ) {
+    timeout = INT_MAX;
+  } else {
+    timeout = ( int ) target->send_timeout;
+  }
+
+  poll_handle.fd = target->handle;
+  poll_handle.events = POLLOUT;
+
+  do {
+    poll_result = poll( &poll_handle, 1, timeout );
+  } while( poll_result == -1 && errno == EINTR );
+
+  return poll_result != 0;
+}
+
+/**
+ * Sends a buffer over a TCP connection. The network target mutex must be held
+ * by the caller.
+ *
+ * Each send is made without blocking, resuming from the first unsent byte
+ * after a partial write and waiting for the socket with poll when its send
+ * buffer is full. If the send timeout passes with part of the buffer already
+ * sent, then the connection is closed, as the rest of the stream would
+ * otherwise be misframed.
+ *
+ * @return 1 if the buffer was sent, or -1 if an error was encountered.
+ */
+static
 int
-sys_socket_sendto_tcp_target( struct network_target *target,
-                              const char *msg,
-                              size_t msg_size ) {
+send_tcp_buffer( struct network_target *target,
+                 const char *msg,
+                 size_t msg_size ) {
   ssize_t recv_result;
   char recv_buffer[1];
   ssize_t send_result;
   size_t sent_bytes = 0;
-  int result = 1;
 
-  lock_network_target( target );
+  // check to see if the remote end has sent a FIN
+  recv_result = recv( target->handle, recv_buffer, 1, MSG_DONTWAIT );
+  if( recv_result == 0 ){
+    raise_network_closed( L10N_NETWORK_CLOSED_ERROR_MESSAGE );
+    close( target->handle );
+    target->handle = -1;
+    return -1;
+  }
 
-  // loop in case our send is interrupted
   while( sent_bytes < msg_size ) {
-    // check to see if the remote end has sent a FIN
-    recv_result = recv( target->handle, recv_buffer, 1, MSG_DONTWAIT );
-    if( recv_result == 0 ){
-      raise_network_closed( L10N_NETWORK_CLOSED_ERROR_MESSAGE );
+    send_result = send( target->handle,
+                        msg + sent_bytes,
+                        msg_size - sent_bytes,
+                        MSG_NOSIGNAL | MSG_DONTWAIT );
+
+    if( send_result != -1 ) {
+      sent_bytes += send_result;
+      continue;
+    }
+
+    if( errno == EINTR ) {
+      continue;
+    }
+
+    if( errno == EAGAIN || errno == EWOULDBLOCK ) {
+      if( wait_for_tcp_writable( target ) ) {
+        continue;
+      }
+
+      errno = ETIMEDOUT;
+    }
+
+    raise_socket_send_failure( L10N_SEND_SYS_SOCKET_FAILED_ERROR_MESSAGE,
+                               errno,
+                               L10N_ERRNO_ERROR_CODE_TYPE );
+
+    if( sent_bytes > 0 ) {
       close( target->handle );
       target->handle = -1;
-      result = -1;
-      break;
     }
 
-    send_result = send( target->handle,
-                        msg,
-                        msg_size - sent_bytes,
-                        MSG_NOSIGNAL );
+    return -1;
+  }
+
+  return 1;
+}
+
+/**
+ * Attempts to re-establish a dropped TCP connection, sending any frames that
+ * were spilled while it was down. The network target mutex must be held by
+ * the caller.
+ *
+ * @return true if the connection is usable, false if it is still down.
+ */
+static
+bool
+reconnect_tcp_target( struct network_target *target ) {
+  int domain;
+
+  if( target->network == STUMPLESS_IPV4_NETWORK_PROTOCOL ) {
+    domain = AF_INET;
+  } else { // STUMPLESS_IPV6_NETWORK_PROTOCOL
+    domain = AF_INET6;
+  }
+
+  target->handle = config_int_connect( target->destination,
+                                       target->port,
+                                       domain,
+                                       SOCK_STREAM,
+                                       0 );
+  if( target->handle == -1 ) {
+    network_target_connection_failed( target );
+    return false;
+  }
+
+  network_target_connection_restored( target );
+
+  if( target->spill_used > 0 ) {
+    if( send_tcp_buffer( target,
+                         target->spill_buffer,
+                         target->spill_used ) != 1 ) {
+      if( target->handle != -1 ) {
+        close( target->handle );
+        target->handle = -1;
+      }
 
-    if( unlikely( send_result == -1 ) ){
-      raise_socket_send_failure( L10N_SEND_SYS_SOCKET_FAILED_ERROR_MESSAGE,
-                                 errno,
-                                 L10N_ERRNO_ERROR_CODE_TYPE );
-      result = -1;
+      network_target_connection_failed( target );
+      return false;
+    }
+
+    target->spill_used = 0;
+  }
+
+  return true;
+}
+
+/**
+ * Sends a frame on a target with automatic reconnection enabled. A dropped
+ * connection is retried right away if the backoff allows it, and if the frame
+ * still cannot be sent it is held in the spill queue for the next reconnect,
+ * unless spilling is not allowed. The network target mutex must be held by
+ * the caller.
+ */
+static
+int
+send_tcp_buffer_reconnecting( struct network_target *target,
+                              const char *msg,
+                              size_t msg_size,
+                              bool spill ) {
+  int attempt;
+
+  for( attempt = 0; attempt < 2; attempt++ ) {
+    if( target->handle == -1
+        && ( !network_target_reconnect_due( target )
+             || !reconnect_tcp_target( target ) ) ) {
       break;
     }
 
-    sent_bytes += send_result;
+    if( send_tcp_buffer( target, msg, msg_size ) == 1 ) {
+      // an earlier attempt may have failed before the reconnect
+      clear_error(  );
+      return 1;
+    }
+
+    if( target->handle != -1 ) {
+      close( target->handle );
+      target->handle = -1;
+    }
+  }
+
+  if( !spill ) {
+    raise_network_closed( L10N_NETWORK_CLOSED_ERROR_MESSAGE );
+    return -1;
+  }
+
+  return spill_network_frame( target, msg, msg_size );
+}
+
+struct network_target *
+sys_socket_reconnect_network_target( struct network_target *target ) {
+  int domain;
+  bool connected;
+
+  lock_network_target( target );
+
+  if( sys_socket_network_target_is_open( target ) ) {
+    close( target->handle );
+    target->handle = -1;
+  }
+
+  if( target->transport == STUMPLESS_TCP_TRANSPORT_PROTOCOL ) {
+    connected = reconnect_tcp_target( target );
+
+  } else { // STUMPLESS_UDP_TRANSPORT_PROTOCOL
+    if( target->network == STUMPLESS_IPV4_NETWORK_PROTOCOL ) {
+      domain = AF_INET;
+    } else { // STUMPLESS_IPV6_NETWORK_PROTOCOL
+      domain = AF_INET6;
+    }
+
+    target->handle = config_int_connect( target->destination,
+                                         target->port,
+                                         domain,
+                                         SOCK_DGRAM,
+                                         0 );
+    connected = target->handle != -1;
+  }
+
+  unlock_network_target( target );
+  return connected ? target : NULL;
+}
+
+int
+sys_socket_sendto_tcp_target( struct network_target *target,
+                              const char *msg,
+                              size_t msg_size,
+                              bool spill ) {
+  int result;
+
+  lock_network_target( target );
+  config_probe( LOCK_ACQUIRED );
+  config_probe( WRITE_START );
+
+  if( network_target_reconnect_enabled( target ) ) {
+    result = send_tcp_buffer_reconnecting( target, msg, msg_size, spill );
+  } else {
+    result = send_tcp_buffer( target, msg, msg_size );
   }
 
+  config_probe( WRITE_END );
   unlock_network_target( target );
   return result;
 }
@@ -228,10 +436,13 @@ sys_socket_sendto_udp_target( const struct network_target *target,
   ssize_t send_result;
 
   lock_network_target( target );
+  config_probe( LOCK_ACQUIRED );
+  config_probe( WRITE_START );
   send_result = send( target->handle,
                       msg,
                       msg_size,
                       MSG_NOSIGNAL );
+  config_probe( WRITE_END );
 
   if( unlikely( send_result == -1 ) ){
     unlock_network_target( target );
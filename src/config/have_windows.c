@@ -18,6 +18,7 @@
 
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include "private/config/have_windows.h"
 #include "private/config/wrapper/locale.h"
 #include "private/error.h"
@@ -25,6 +26,11 @@
 #include "private/memory.h"
 #include "private/windows_wrapper.h"
 
+void
+windows_add_u64( LONG64 volatile *u, uint64_t value ) {
+  InterlockedExchangeAdd64( u, ( LONG64 ) value );
+}
+
 bool
 windows_compare_exchange_bool( LONG volatile *b,
                                LONG expected,
@@ -47,6 +53,18 @@ windows_compare_exchange_ptr( PVOID volatile *p,
   return initial == expected;
 }
 
+bool
+windows_compare_exchange_u64( LONG64 volatile *u,
+                              uint64_t expected,
+                              uint64_t replacement ) {
+  LONG64 initial;
+
+  initial = InterlockedCompareExchange64( u,
+                                          ( LONG64 ) replacement,
+                                          ( LONG64 ) expected );
+  return initial == ( LONG64 ) expected;
+}
+
 LPWSTR
 windows_copy_cstring_to_lpwstr( LPCSTR str, int *copy_length ) {
   int needed_wchar_length;
@@ -177,6 +195,19 @@ windows_getpagesize( void ) {
   return ( size_t ) info.dwPageSize;
 }
 
+uint64_t
+windows_get_monotonic_ns( void ) {
+  LARGE_INTEGER counter;
+  LARGE_INTEGER frequency;
+
+  QueryPerformanceCounter( &counter );
+  QueryPerformanceFrequency( &frequency );
+
+  return ( ( uint64_t ) counter.QuadPart / frequency.QuadPart ) * 1000000000
+         + ( ( ( uint64_t ) counter.QuadPart % frequency.QuadPart )
+             * 1000000000 ) / frequency.QuadPart;
+}
+
 int
 windows_getpid( void ) {
   return ( int ) ( GetCurrentProcessId(  ) );
@@ -192,7 +223,18 @@ windows_lock_mutex( const CRITICAL_SECTION *mutex ) {
   EnterCriticalSection( ( LPCRITICAL_SECTION ) mutex );
 }
 
+uint64_t
+windows_read_u64( LONG64 volatile *u ) {
+  // 64 bit loads are not atomic on 32 bit builds, so an exchange is used
+  return ( uint64_t ) InterlockedCompareExchange64( u, 0, 0 );
+}
+
 void
 windows_unlock_mutex( const CRITICAL_SECTION *mutex ) {
   LeaveCriticalSection( ( LPCRITICAL_SECTION ) mutex );
 }
+
+void
+windows_write_u64( LONG64 volatile *u, uint64_t replacement ) {
+  InterlockedExchange64( u, ( LONG64 ) replacement );
+}
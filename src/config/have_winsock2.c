@@ -24,6 +24,7 @@
 #include <winsock2.h>
 #include "private/config/have_winsock2.h"
 #include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/probe.h"
 #include "private/config/wrapper/thread_safety.h"
 #include "private/error.h"
 #include "private/inthelper.h"
@@ -310,26 +311,33 @@ winsock2_reopen_udp6_target( struct network_target *target ) {
   return target;
 }
 
+/**
+ * Sends a buffer over a TCP connection. The network target mutex must be held
+ * by the caller.
+ *
+ * @return 1 if the buffer was sent, or -1 if an error was encountered.
+ */
+static
 int
-winsock2_sendto_tcp_target( const struct network_target *target,
-                            const char *msg,
-                            size_t msg_size ) {
+send_tcp_buffer( const struct network_target *target,
+                 const char *msg,
+                 size_t msg_size ) {
   int send_result;
   size_t sent_bytes = 0;
   int remaining_size;
 
-  lock_network_target( target );
-
   while( sent_bytes < msg_size ) {
     // sys/socket.h network targets can check for a FIN message using recv
     // winsock doesn't provide MSG_DONTWAIT, making this strategy not viable
     // using non-blocking connections is one potential solution to this problem
 
     remaining_size = cap_size_t_to_int( msg_size - sent_bytes );
-    send_result = send( target->handle, msg, remaining_size, 0 );
+    send_result = send( target->handle,
+                        msg + sent_bytes,
+                        remaining_size,
+                        0 );
 
     if( send_result == SOCKET_ERROR ) {
-      unlock_network_target( target );
       raise_socket_send_failure( L10N_SEND_WIN_SOCKET_FAILED_ERROR_MESSAGE,
                                  WSAGetLastError(  ),
                                  L10N_WSAGETLASTERROR_ERROR_CODE_TYPE );
@@ -339,10 +347,151 @@ winsock2_sendto_tcp_target( const struct network_target *target,
     sent_bytes += send_result;
   }
 
-  unlock_network_target( target );
   return 1;
 }
 
+/**
+ * Attempts to re-establish a dropped TCP connection, sending any frames that
+ * were spilled while it was down. The network target mutex must be held by
+ * the caller.
+ *
+ * @return true if the connection is usable, false if it is still down.
+ */
+static
+bool
+reconnect_tcp_target( struct network_target *target ) {
+  int af;
+
+  if( target->network == STUMPLESS_IPV4_NETWORK_PROTOCOL ) {
+    af = AF_INET;
+  } else { // STUMPLESS_IPV6_NETWORK_PROTOCOL
+    af = AF_INET6;
+  }
+
+  target->handle = winsock_open_socket( target->destination,
+                                        target->port,
+                                        af,
+                                        SOCK_STREAM,
+                                        IPPROTO_TCP );
+  if( target->handle == INVALID_SOCKET ) {
+    network_target_connection_failed( target );
+    return false;
+  }
+
+  network_target_connection_restored( target );
+
+  if( target->spill_used > 0 ) {
+    if( send_tcp_buffer( target,
+                         target->spill_buffer,
+                         target->spill_used ) != 1 ) {
+      closesocket( target->handle );
+      target->handle = INVALID_SOCKET;
+      network_target_connection_failed( target );
+      return false;
+    }
+
+    target->spill_used = 0;
+  }
+
+  return true;
+}
+
+/**
+ * Sends a frame on a target with automatic reconnection enabled. A dropped
+ * connection is retried right away if the backoff allows it, and if the frame
+ * still cannot be sent it is held in the spill queue for the next reconnect,
+ * unless spilling is not allowed. The network target mutex must be held by
+ * the caller.
+ */
+static
+int
+send_tcp_buffer_reconnecting( struct network_target *target,
+                              const char *msg,
+                              size_t msg_size,
+                              bool spill ) {
+  int attempt;
+
+  for( attempt = 0; attempt < 2; attempt++ ) {
+    if( target->handle == INVALID_SOCKET
+        && ( !network_target_reconnect_due( target )
+             || !reconnect_tcp_target( target ) ) ) {
+      break;
+    }
+
+    if( send_tcp_buffer( target, msg, msg_size ) == 1 ) {
+      // an earlier attempt may have failed before the reconnect
+      clear_error(  );
+      return 1;
+    }
+
+    closesocket( target->handle );
+    target->handle = INVALID_SOCKET;
+  }
+
+  if( !spill ) {
+    raise_network_closed( L10N_NETWORK_CLOSED_ERROR_MESSAGE );
+    return -1;
+  }
+
+  return spill_network_frame( target, msg, msg_size );
+}
+
+struct network_target *
+winsock2_reconnect_network_target( struct network_target *target ) {
+  int af;
+  bool connected;
+
+  lock_network_target( target );
+
+  if( winsock2_network_target_is_open( target ) ) {
+    closesocket( target->handle );
+    target->handle = INVALID_SOCKET;
+  }
+
+  if( target->transport == STUMPLESS_TCP_TRANSPORT_PROTOCOL ) {
+    connected = reconnect_tcp_target( target );
+
+  } else { // STUMPLESS_UDP_TRANSPORT_PROTOCOL
+    if( target->network == STUMPLESS_IPV4_NETWORK_PROTOCOL ) {
+      af = AF_INET;
+    } else { // STUMPLESS_IPV6_NETWORK_PROTOCOL
+      af = AF_INET6;
+    }
+
+    target->handle = winsock_open_socket( target->destination,
+                                          target->port,
+                                          af,
+                                          SOCK_DGRAM,
+                                          IPPROTO_UDP );
+    connected = target->handle != INVALID_SOCKET;
+  }
+
+  unlock_network_target( target );
+  return connected ? target : NULL;
+}
+
+int
+winsock2_sendto_tcp_target( struct network_target *target,
+                            const char *msg,
+                            size_t msg_size,
+                            bool spill ) {
+  int result;
+
+  lock_network_target( target );
+  config_probe( LOCK_ACQUIRED );
+  config_probe( WRITE_START );
+
+  if( network_target_reconnect_enabled( target ) ) {
+    result = send_tcp_buffer_reconnecting( target, msg, msg_size, spill );
+  } else {
+    result = send_tcp_buffer( target, msg, msg_size );
+  }
+
+  config_probe( WRITE_END );
+  unlock_network_target( target );
+  return result;
+}
+
 int
 winsock2_sendto_udp_target( const struct network_target *target,
                             const char *msg,
@@ -350,10 +499,13 @@ winsock2_sendto_udp_target( const struct network_target *target,
   int send_result;
 
   lock_network_target( target );
+  config_probe( LOCK_ACQUIRED );
+  config_probe( WRITE_START );
   send_result = send( target->handle,
                       msg,
                       cap_size_t_to_int( msg_size ),
                       0 );
+  config_probe( WRITE_END );
   unlock_network_target( target );
 
   if( send_result == SOCKET_ERROR ) {
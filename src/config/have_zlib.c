@@ -0,0 +1,332 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <limits.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdio.h>
+#include <stumpless/target.h>
+#include <stumpless/target/file.h>
+#include <zlib.h>
+#include "private/config/have_zlib.h"
+#include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/thread_safety.h"
+#include "private/error.h"
+#include "private/memory.h"
+#include "private/target.h"
+#include "private/target/file.h"
+#include "private/validate.h"
+
+/**
+ * Adds 16 to the default window bits so that zlib writes gzip headers and
+ * trailers instead of zlib ones.
+ */
+#define GZIP_WINDOW_BITS ( 15 + 16 )
+
+/** The default memory level used by zlib. */
+#define GZIP_MEMORY_LEVEL 8
+
+/**
+ * Allocates memory for zlib with the stumpless allocation functions, so that
+ * custom allocators and memory counters see it.
+ */
+static
+voidpf
+alloc_zlib_mem( voidpf opaque, uInt items, uInt size ) {
+  ( void ) opaque;
+
+  return alloc_mem( ( size_t ) items * size );
+}
+
+static
+void
+free_zlib_mem( voidpf opaque, voidpf address ) {
+  ( void ) opaque;
+
+  free_mem( address );
+}
+
+/**
+ * Writes the compressed data in the output buffer to the file and empties the
+ * buffer.
+ */
+static
+bool
+write_output( struct file_compressor *compressor, FILE *file ) {
+  size_t length;
+  size_t fwrite_result;
+
+  length = COMPRESSOR_OUTPUT_SIZE - compressor->stream.avail_out;
+  compressor->stream.next_out = compressor->output;
+  compressor->stream.avail_out = COMPRESSOR_OUTPUT_SIZE;
+
+  if( length == 0 ) {
+    return true;
+  }
+
+  fwrite_result = fwrite( compressor->output, 1, length, file );
+  return fwrite_result == length;
+}
+
+/**
+ * Runs deflate until all of the input has been consumed, writing the output
+ * buffer each time it fills. If flush is Z_FINISH, this continues until the
+ * end of the gzip member has been produced.
+ */
+static
+bool
+run_deflate( struct file_compressor *compressor, FILE *file, int flush ) {
+  int result;
+
+  do {
+    result = deflate( &compressor->stream, flush );
+    if( result == Z_STREAM_ERROR ) {
+      return false;
+    }
+
+    if( compressor->stream.avail_out == 0
+        && !write_output( compressor, file ) ) {
+      return false;
+    }
+  } while( compressor->stream.avail_in > 0
+           || ( flush == Z_FINISH && result != Z_STREAM_END ) );
+
+  return true;
+}
+
+/**
+ * Starts a new frame, discarding anything left of the current one.
+ */
+static
+void
+reset_frame( struct file_compressor *compressor ) {
+  deflateReset( &compressor->stream );
+  compressor->stream.next_out = compressor->output;
+  compressor->stream.avail_out = COMPRESSOR_OUTPUT_SIZE;
+  compressor->frame_length = 0;
+}
+
+/**
+ * Finishes the current frame as a complete gzip member, writes it, and
+ * flushes the file so that the frame survives a crash of the process.
+ */
+static
+bool
+end_frame( struct file_compressor *compressor, FILE *file ) {
+  bool success;
+
+  if( compressor->frame_length == 0 ) {
+    return true;
+  }
+
+  success = run_deflate( compressor, file, Z_FINISH )
+              && write_output( compressor, file )
+              && fflush( file ) == 0;
+
+  reset_frame( compressor );
+  return success;
+}
+
+/**
+ * Gets the file target of a compressed file target, raising an error if it is
+ * not one.
+ */
+static
+struct file_target *
+get_compressed_file_target( const struct stumpless_target *target ) {
+  struct file_target *file_target;
+
+  if( target->type != STUMPLESS_FILE_TARGET ) {
+    raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+    return NULL;
+  }
+
+  file_target = target->id;
+  if( !file_target->compressor ) {
+    raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+    return NULL;
+  }
+
+  return file_target;
+}
+
+static
+struct file_compressor *
+new_file_compressor( int level ) {
+  struct file_compressor *compressor;
+  int result;
+
+  compressor = alloc_mem( sizeof( *compressor ) );
+  if( !compressor ) {
+    return NULL;
+  }
+
+  compressor->stream.zalloc = alloc_zlib_mem;
+  compressor->stream.zfree = free_zlib_mem;
+  compressor->stream.opaque = Z_NULL;
+  result = deflateInit2( &compressor->stream,
+                         level,
+                         Z_DEFLATED,
+                         GZIP_WINDOW_BITS,
+                         GZIP_MEMORY_LEVEL,
+                         Z_DEFAULT_STRATEGY );
+  if( result != Z_OK ) {
+    free_mem( compressor );
+    raise_memory_allocation_failure(  );
+    return NULL;
+  }
+
+  compressor->stream.next_out = compressor->output;
+  compressor->stream.avail_out = COMPRESSOR_OUTPUT_SIZE;
+  compressor->frame_size = DEFAULT_COMPRESSED_FRAME_SIZE;
+  compressor->frame_length = 0;
+
+  return compressor;
+}
+
+/* public definitions */
+
+struct stumpless_target *
+stumpless_flush_compressed_file_target( struct stumpless_target *target ) {
+  struct file_target *file_target;
+  bool success;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  file_target = get_compressed_file_target( target );
+  if( !file_target ) {
+    return NULL;
+  }
+
+  config_lock_mutex( &file_target->stream_mutex );
+  success = end_frame( file_target->compressor, file_target->stream );
+  config_unlock_mutex( &file_target->stream_mutex );
+
+  if( !success ) {
+    raise_file_write_failure(  );
+    return NULL;
+  }
+
+  clear_error(  );
+  return target;
+}
+
+struct stumpless_target *
+stumpless_open_compressed_file_target( const char *name, int level ) {
+  struct stumpless_target *target;
+  struct file_target *file_target;
+
+  VALIDATE_ARG_NOT_NULL( name );
+
+  if( level < Z_DEFAULT_COMPRESSION || level > Z_BEST_COMPRESSION ) {
+    raise_index_out_of_bounds(
+      L10N_INVALID_INDEX_ERROR_MESSAGE( "compression level" ),
+      level
+    );
+    return NULL;
+  }
+
+  target = new_target( STUMPLESS_FILE_TARGET, name );
+  if( !target ) {
+    goto fail;
+  }
+
+  // binary mode keeps compressed data from being translated on Windows
+  file_target = new_file_target( name, "ab" );
+  if( !file_target ) {
+    goto fail_id;
+  }
+
+  file_target->compressor = new_file_compressor( level );
+  if( !file_target->compressor ) {
+    goto fail_compressor;
+  }
+
+  target->id = file_target;
+  stumpless_set_current_target( target );
+  return target;
+
+fail_compressor:
+  destroy_file_target( file_target );
+fail_id:
+  destroy_target( target );
+fail:
+  return NULL;
+}
+
+struct stumpless_target *
+stumpless_set_compressed_file_frame_size( struct stumpless_target *target,
+                                          size_t frame_size ) {
+  struct file_target *file_target;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  file_target = get_compressed_file_target( target );
+  if( !file_target ) {
+    return NULL;
+  }
+
+  config_lock_mutex( &file_target->stream_mutex );
+  file_target->compressor->frame_size = frame_size;
+  config_unlock_mutex( &file_target->stream_mutex );
+
+  clear_error(  );
+  return target;
+}
+
+/* private definitions */
+
+bool
+zlib_compress_to_file( struct file_compressor *compressor,
+                       FILE *file,
+                       const char *msg,
+                       size_t msg_length ) {
+  size_t remaining = msg_length;
+  uInt chunk_length;
+
+  compressor->stream.next_in = ( Bytef * ) msg;
+  while( remaining > 0 ) {
+    chunk_length = remaining > UINT_MAX ? UINT_MAX : ( uInt ) remaining;
+    compressor->stream.avail_in = chunk_length;
+    if( !run_deflate( compressor, file, Z_NO_FLUSH ) ) {
+      // the frame is already damaged, so the next one starts fresh
+      reset_frame( compressor );
+      return false;
+    }
+
+    remaining -= chunk_length;
+  }
+
+  compressor->frame_length += msg_length;
+  if( compressor->frame_length >= compressor->frame_size ) {
+    return end_frame( compressor, file );
+  }
+
+  return true;
+}
+
+void
+zlib_destroy_file_compressor( struct file_compressor *compressor, FILE *file ) {
+  if( !compressor ) {
+    return;
+  }
+
+  end_frame( compressor, file );
+  deflateEnd( &compressor->stream );
+  free_mem( compressor );
+}
@@ -0,0 +1,397 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include "private/config.h"
+
+#ifdef HAVE_SENDMMSG
+// needed for the declaration of sendmmsg
+#  define _GNU_SOURCE
+#endif
+
+#include <errno.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+#include <stumpless/target/journald.h>
+#include <sys/socket.h>
+#include <sys/uio.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "private/config/journald_native.h"
+#include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/thread_safety.h"
+#include "private/error.h"
+#include "private/memory.h"
+
+/** The size of the little endian length used for binary field values. */
+#define BINARY_LENGTH_SIZE 8
+
+/**
+ * The send buffer size requested for the socket, so that large entries
+ * are not rejected. This matches what libsystemd asks for.
+ */
+#define NATIVE_SOCKET_SEND_BUFFER_SIZE ( 8 * 1024 * 1024 )
+
+/* global static variables */
+static struct sockaddr_un journald_address = {
+  .sun_family = AF_UNIX,
+  .sun_path = JOURNALD_NATIVE_DEFAULT_SOCKET
+};
+
+/* per-thread static variables */
+static CONFIG_THREAD_LOCAL_STORAGE int native_socket = -1;
+static CONFIG_THREAD_LOCAL_STORAGE char *datagram_buffer = NULL;
+static CONFIG_THREAD_LOCAL_STORAGE size_t datagram_buffer_size = 0;
+static CONFIG_THREAD_LOCAL_STORAGE size_t *datagram_ends = NULL;
+static CONFIG_THREAD_LOCAL_STORAGE size_t datagram_ends_length = 0;
+static CONFIG_THREAD_LOCAL_STORAGE size_t datagram_count = 0;
+#ifdef HAVE_SENDMMSG
+static CONFIG_THREAD_LOCAL_STORAGE struct mmsghdr *messages = NULL;
+static CONFIG_THREAD_LOCAL_STORAGE struct iovec *message_vecs = NULL;
+static CONFIG_THREAD_LOCAL_STORAGE size_t messages_length = 0;
+#endif
+
+/**
+ * Opens the socket for the current thread if it has not been opened yet.
+ *
+ * @return The socket, or -1 if it could not be opened.
+ */
+static
+int
+get_native_socket( void ) {
+  int send_buffer_size = NATIVE_SOCKET_SEND_BUFFER_SIZE;
+
+  if( native_socket == -1 ) {
+    native_socket = socket( AF_UNIX, SOCK_DGRAM, 0 );
+    if( native_socket != -1 ) {
+      // a failure here only limits the size of entries that can be sent
+      setsockopt( native_socket,
+                  SOL_SOCKET,
+                  SO_SNDBUF,
+                  &send_buffer_size,
+                  sizeof( send_buffer_size ) );
+    }
+  }
+
+  return native_socket;
+}
+
+/**
+ * Checks whether a field value must be written in the binary-safe form.
+ */
+static
+int
+needs_binary_form( const char *value, size_t value_length ) {
+  return memchr( value, '\n', value_length ) != NULL;
+}
+
+#ifdef HAVE_SENDMMSG
+
+/**
+ * Sends all pending datagrams with as few sendmmsg calls as possible. A
+ * datagram that cannot be sent is skipped so that the rest are still sent.
+ *
+ * @return 0 on success, or the negative errno value of the last datagram that
+ * could not be sent.
+ */
+static
+int
+send_pending_datagrams( int handle, int *results ) {
+  struct mmsghdr *new_messages;
+  struct iovec *new_message_vecs;
+  size_t start = 0;
+  size_t sent = 0;
+  size_t i;
+  int sent_count;
+  int result = 0;
+
+  if( messages_length < datagram_count ) {
+    new_messages = realloc_mem( messages,
+                                sizeof( *messages ) * datagram_count );
+    if( !new_messages ) {
+      return -ENOMEM;
+    }
+    messages = new_messages;
+
+    new_message_vecs = realloc_mem( message_vecs,
+                                    sizeof( *message_vecs ) * datagram_count );
+    if( !new_message_vecs ) {
+      return -ENOMEM;
+    }
+    message_vecs = new_message_vecs;
+
+    messages_length = datagram_count;
+  }
+
+  for( i = 0; i < datagram_count; i++ ) {
+    message_vecs[i].iov_base = datagram_buffer + start;
+    message_vecs[i].iov_len = datagram_ends[i] - start;
+    start = datagram_ends[i];
+
+    memset( &messages[i], 0, sizeof( messages[i] ) );
+    messages[i].msg_hdr.msg_name = &journald_address;
+    messages[i].msg_hdr.msg_namelen = sizeof( journald_address );
+    messages[i].msg_hdr.msg_iov = &message_vecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  while( sent < datagram_count ) {
+    sent_count = sendmmsg( handle, messages + sent, datagram_count - sent, 0 );
+    if( sent_count == -1 ) {
+      if( errno == EINTR ) {
+        continue;
+      }
+
+      // sendmmsg only fails outright when the first datagram is not sent
+      result = -errno;
+      if( results ) {
+        results[sent] = result;
+      }
+      sent++;
+      continue;
+    }
+
+    sent += sent_count;
+  }
+
+  return result;
+}
+
+#else
+
+/**
+ * Sends all pending datagrams one at a time. A datagram that cannot be sent is
+ * skipped so that the rest are still sent.
+ *
+ * @return 0 on success, or the negative errno value of the last datagram that
+ * could not be sent.
+ */
+static
+int
+send_pending_datagrams( int handle, int *results ) {
+  size_t start = 0;
+  size_t i = 0;
+  ssize_t sendto_result;
+  int result = 0;
+
+  while( i < datagram_count ) {
+    sendto_result = sendto( handle,
+                            datagram_buffer + start,
+                            datagram_ends[i] - start,
+                            0,
+                            ( struct sockaddr * ) &journald_address,
+                            sizeof( journald_address ) );
+    if( sendto_result == -1 ) {
+      if( errno == EINTR ) {
+        continue;
+      }
+
+      result = -errno;
+      if( results ) {
+        results[i] = result;
+      }
+    }
+
+    start = datagram_ends[i++];
+  }
+
+  return result;
+}
+
+#endif
+
+int
+journald_native_append( const struct iovec *fields, int field_count ) {
+  size_t start;
+  size_t size_needed = 0;
+  int i;
+  const char *field;
+  const char *value;
+  size_t name_length;
+  size_t value_length;
+  size_t new_size;
+  char *new_buffer;
+  size_t *new_ends;
+  char *pos;
+  int byte;
+
+  for( i = 0; i < field_count; i++ ) {
+    field = fields[i].iov_base;
+    value = memchr( field, '=', fields[i].iov_len );
+    if( !value ) {
+      return -EINVAL;
+    }
+
+    value++;
+    value_length = fields[i].iov_len - ( value - field );
+    if( needs_binary_form( value, value_length ) ) {
+      size_needed += BINARY_LENGTH_SIZE + 1;
+    } else {
+      size_needed += 1;
+    }
+
+    size_needed += fields[i].iov_len;
+  }
+
+  if( datagram_count == datagram_ends_length ) {
+    new_size = datagram_ends_length == 0 ? 8 : datagram_ends_length * 2;
+    new_ends = realloc_mem( datagram_ends, sizeof( *datagram_ends ) * new_size );
+    if( !new_ends ) {
+      return -ENOMEM;
+    }
+
+    datagram_ends = new_ends;
+    datagram_ends_length = new_size;
+  }
+
+  start = datagram_count == 0 ? 0 : datagram_ends[datagram_count - 1];
+  if( start + size_needed > datagram_buffer_size ) {
+    new_size = datagram_buffer_size * 2;
+    if( new_size < start + size_needed ) {
+      new_size = start + size_needed;
+    }
+
+    new_buffer = realloc_mem( datagram_buffer, new_size );
+    if( !new_buffer ) {
+      return -ENOMEM;
+    }
+
+    datagram_buffer = new_buffer;
+    datagram_buffer_size = new_size;
+  }
+
+  pos = datagram_buffer + start;
+  for( i = 0; i < field_count; i++ ) {
+    field = fields[i].iov_base;
+    value = ( const char * ) memchr( field, '=', fields[i].iov_len ) + 1;
+    name_length = value - field - 1;
+    value_length = fields[i].iov_len - name_length - 1;
+
+    if( needs_binary_form( value, value_length ) ) {
+      memcpy( pos, field, name_length );
+      pos += name_length;
+      *( pos++ ) = '\n';
+
+      for( byte = 0; byte < BINARY_LENGTH_SIZE; byte++ ) {
+        *( pos++ ) = ( char ) ( ( ( uint64_t ) value_length >> ( byte * 8 ) )
+                                & 0xff );
+      }
+
+      memcpy( pos, value, value_length );
+      pos += value_length;
+
+    } else {
+      memcpy( pos, field, fields[i].iov_len );
+      pos += fields[i].iov_len;
+    }
+
+    *( pos++ ) = '\n';
+  }
+
+  datagram_ends[datagram_count++] = pos - datagram_buffer;
+  return 0;
+}
+
+void
+journald_native_discard( void ) {
+  datagram_count = 0;
+}
+
+int
+journald_native_flush( int *results ) {
+  int handle;
+  int result;
+  size_t i;
+
+  if( datagram_count == 0 ) {
+    return 0;
+  }
+
+  handle = get_native_socket(  );
+  if( handle == -1 ) {
+    result = -errno;
+    for( i = 0; results && i < datagram_count; i++ ) {
+      results[i] = result;
+    }
+
+  } else {
+    result = send_pending_datagrams( handle, results );
+  }
+
+  datagram_count = 0;
+  return result;
+}
+
+void
+journald_native_free_thread( void ) {
+  if( native_socket != -1 ) {
+    close( native_socket );
+    native_socket = -1;
+  }
+
+  free_mem( datagram_buffer );
+  datagram_buffer = NULL;
+  datagram_buffer_size = 0;
+
+  free_mem( datagram_ends );
+  datagram_ends = NULL;
+  datagram_ends_length = 0;
+  datagram_count = 0;
+
+#ifdef HAVE_SENDMMSG
+  free_mem( messages );
+  messages = NULL;
+  free_mem( message_vecs );
+  message_vecs = NULL;
+  messages_length = 0;
+#endif
+}
+
+int
+journald_native_sendv( const struct iovec *fields, int field_count ) {
+  int result;
+
+  result = journald_native_append( fields, field_count );
+  if( result != 0 ) {
+    return result;
+  }
+
+  return journald_native_flush( NULL );
+}
+
+const char *
+stumpless_set_journald_socket_path( const char *path ) {
+  size_t path_length;
+
+  if( !path ) {
+    path = JOURNALD_NATIVE_DEFAULT_SOCKET;
+  }
+
+  path_length = strlen( path );
+  if( path_length >= sizeof( journald_address.sun_path ) ) {
+    raise_argument_too_big( L10N_STRING_TOO_LONG_ERROR_MESSAGE,
+                            path_length,
+                            L10N_STRING_LENGTH_ERROR_CODE_TYPE );
+    return NULL;
+  }
+
+  memcpy( journald_address.sun_path, path, path_length + 1 );
+
+  clear_error(  );
+  return path;
+}
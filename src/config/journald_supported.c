@@ -82,9 +82,35 @@ stumpless_set_param_journald_namer( struct stumpless_param *param,
 void
 journald_init_journald_element( struct stumpless_element *element ) {
   element->get_journald_name = stumpless_flatten_element_name;
+  element->journald_field_length = 0;
 }
 
 void
 journald_init_journald_param( struct stumpless_param *param ) {
   param->get_journald_name = stumpless_flatten_param_name;
+  journald_reset_journald_param( param );
+}
+
+void
+journald_reset_added_param( struct stumpless_param *param ) {
+  lock_param( param );
+  journald_reset_journald_param( param );
+  unlock_param( param );
+}
+
+void
+journald_reset_journald_element( struct stumpless_element *element ) {
+  size_t i;
+
+  element->journald_field_length = 0;
+
+  for( i = 0; i < element->param_count; i++ ) {
+    journald_reset_added_param( element->params[i] );
+  }
+}
+
+void
+journald_reset_journald_param( struct stumpless_param *param ) {
+  param->journald_prefix_length = 0;
+  param->journald_prefix_element = NULL;
 }
@@ -17,6 +17,7 @@
  */
 
 #include <stdbool.h>
+#include <stdint.h>
 #include "private/config/thread_safety_unsupported.h"
 #include "private/config/wrapper/thread_safety.h"
 
@@ -43,3 +44,15 @@ no_thread_safety_compare_exchange_ptr( config_atomic_ptr_t *p,
     return false;
   }
 }
+
+bool
+no_thread_safety_compare_exchange_u64( config_atomic_u64_t *u,
+                                       uint64_t expected,
+                                       uint64_t replacement ) {
+  if( *u == expected ) {
+    *u = replacement;
+    return true;
+  } else {
+    return false;
+  }
+}
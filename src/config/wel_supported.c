@@ -1873,6 +1873,70 @@ fail:
 
 /* private definitions */
 
+LPWSTR
+copy_entry_message_to_lpwstr( const struct stumpless_entry *entry ) {
+  LPWSTR str_copy;
+  int needed_wchar_length;
+  size_t needed_wchar_count;
+  int message_length_int;
+  int conversion_result;
+
+  lock_entry( entry );
+  if( entry->message_length == 0 ) {
+    unlock_entry( entry );
+    str_copy = alloc_mem( sizeof( WCHAR ) );
+    if( str_copy ) {
+      str_copy[0] = L'\0';
+    }
+    return str_copy;
+  }
+
+  message_length_int = cap_size_t_to_int( entry->message_length );
+
+  needed_wchar_length = MultiByteToWideChar( CP_UTF8,
+                                             MB_ERR_INVALID_CHARS |
+                                               MB_PRECOMPOSED,
+                                             entry->message,
+                                             message_length_int,
+                                             NULL,
+                                             0 );
+
+  if( needed_wchar_length == 0 ) {
+    raise_mb_conversion_failure( GetLastError(  ) );
+    goto fail;
+  }
+
+  needed_wchar_count = ( ( size_t ) needed_wchar_length ) + 1;
+  str_copy = alloc_array( needed_wchar_count, sizeof( WCHAR ) );
+  if( !str_copy ) {
+    goto fail;
+  }
+
+  conversion_result = MultiByteToWideChar( CP_UTF8,
+                                           MB_ERR_INVALID_CHARS |
+                                             MB_PRECOMPOSED,
+                                           entry->message,
+                                           message_length_int,
+                                           str_copy,
+                                           needed_wchar_length );
+
+  if( conversion_result == 0 ) {
+    raise_mb_conversion_failure( GetLastError(  ) );
+    goto fail_second_conversion;
+  }
+
+  unlock_entry( entry );
+  str_copy[needed_wchar_length] = L'\0';
+
+  return str_copy;
+
+fail_second_conversion:
+  free_mem( str_copy );
+fail:
+  unlock_entry( entry );
+  return NULL;
+}
+
 LPCWSTR
 copy_param_value_to_lpwstr( const struct stumpless_param *param ) {
   LPWSTR str_copy;
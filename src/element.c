@@ -38,11 +38,22 @@ stumpless_add_new_param( struct stumpless_element *element,
   struct stumpless_param *new_param;
   struct stumpless_element *result;
 
+  VALIDATE_ARG_NOT_NULL( element );
+
+  lock_element( element );
+  if( element->param_count < element->param_capacity ) {
+    result = locked_reuse_param( element, param_name, param_value );
+    unlock_element( element );
+    return result;
+  }
+  unlock_element( element );
+
   new_param = stumpless_new_param( param_name, param_value );
   if( !new_param ) {
     return NULL;
   }
 
+  new_param->owner = element;
   result = stumpless_add_param( element, new_param );
 
   if( !result ) {
@@ -64,18 +75,28 @@ stumpless_add_param( struct stumpless_element *element,
 
   lock_element( element );
 
-  old_params_size = sizeof( param ) * element->param_count;
-  new_params_size = old_params_size + sizeof( param );
+  if( element->param_count < element->param_capacity ) {
+    stumpless_destroy_param( element->params[element->param_count] );
 
-  new_params = realloc_mem( element->params, new_params_size );
-  if( !new_params ) {
-    unlock_element( element );
-    return NULL;
+  } else {
+    old_params_size = sizeof( param ) * element->param_count;
+    new_params_size = old_params_size + sizeof( param );
+
+    new_params = realloc_mem( element->params, new_params_size );
+    if( !new_params ) {
+      unlock_element( element );
+      return NULL;
+    }
+
+    element->params = new_params;
+    element->param_capacity++;
   }
 
-  new_params[element->param_count] = param;
+  element->params[element->param_count] = param;
   element->param_count++;
-  element->params = new_params;
+
+  config_reset_added_journald_param( param );
+
   unlock_element( element );
 
   clear_error(  );
@@ -105,8 +126,10 @@ stumpless_copy_element( const struct stumpless_element *element ) {
       goto fail_param_copy;
     }
 
+    param_copy->owner = copy;
     copy->params[i] = param_copy;
     copy->param_count++;
+    copy->param_capacity++;
   }
 
   unlock_element( element );
@@ -139,7 +162,7 @@ stumpless_destroy_element_and_contents( const struct stumpless_element *e ) {
     return;
   }
 
-  for( i = 0; i < e->param_count; i++ ) {
+  for( i = 0; i < e->param_capacity; i++ ) {
     stumpless_destroy_param( e->params[i] );
   }
 
@@ -148,10 +171,21 @@ stumpless_destroy_element_and_contents( const struct stumpless_element *e ) {
 
 void
 stumpless_destroy_element_only( const struct stumpless_element *element ) {
+  size_t i;
+
   if( !element ) {
     return;
   }
 
+  for( i = 0; i < element->param_count; i++ ) {
+    element->params[i]->owner = NULL;
+  }
+
+  // params kept for reuse are no longer reachable by the caller
+  for( ; i < element->param_capacity; i++ ) {
+    stumpless_destroy_param( element->params[i] );
+  }
+
   unchecked_destroy_element( element );
 }
 
@@ -479,13 +513,19 @@ stumpless_load_element( struct stumpless_element *element, const char *name ) {
 
 struct stumpless_element *
 stumpless_new_element( const char *name ) {
-  size_t name_length;
+  VALIDATE_ARG_NOT_NULL( name );
+
+  return stumpless_new_element_buf( name, strlen( name ) );
+}
+
+struct stumpless_element *
+stumpless_new_element_buf( const char *name, size_t name_length ) {
   struct stumpless_element *element;
   struct stumpless_element *result;
 
   VALIDATE_ARG_NOT_NULL( name );
 
-  if( unlikely( !validate_element_name( name, &name_length ) ) ) {
+  if( unlikely( !validate_element_name_buf( name, name_length ) ) ) {
     return NULL;
   }
 
@@ -507,12 +547,20 @@ stumpless_new_element( const char *name ) {
 struct stumpless_element *
 stumpless_set_element_name( struct stumpless_element *element,
                             const char *name ) {
-  size_t name_length;
+  VALIDATE_ARG_NOT_NULL( element );
+  VALIDATE_ARG_NOT_NULL( name );
 
+  return stumpless_set_element_name_buf( element, name, strlen( name ) );
+}
+
+struct stumpless_element *
+stumpless_set_element_name_buf( struct stumpless_element *element,
+                                const char *name,
+                                size_t name_length ) {
   VALIDATE_ARG_NOT_NULL( element );
   VALIDATE_ARG_NOT_NULL( name );
 
-  if( unlikely( !validate_element_name( name, &name_length ) ) ) {
+  if( unlikely( !validate_element_name_buf( name, name_length ) ) ) {
     goto fail;
   }
 
@@ -520,6 +568,7 @@ stumpless_set_element_name( struct stumpless_element *element,
   element->name_length = name_length;
   memcpy( element->name, name, name_length );
   element->name[name_length] = '\0';
+  config_reset_journald_element( element );
   unlock_element( element );
 
   clear_error(  );
@@ -545,7 +594,12 @@ stumpless_set_param( struct stumpless_element *element,
     return NULL;
   }
 
+  // the replaced param is now left to the caller
+  element->params[index]->owner = NULL;
   element->params[index] = param;
+
+  config_reset_added_journald_param( param );
+
   unlock_element( element );
 
   clear_error(  );
@@ -615,7 +669,7 @@ stumpless_unload_element_and_contents( const struct stumpless_element *e ) {
     return;
   }
 
-  for( i = 0; i < e->param_count; i++ ) {
+  for( i = 0; i < e->param_capacity; i++ ) {
     stumpless_unload_param( e->params[i] );
   }
 
@@ -649,6 +703,60 @@ locked_get_param_by_index( const struct stumpless_element *element,
   return element->params[index];
 }
 
+struct stumpless_element *
+locked_reuse_param( struct stumpless_element *element,
+                    const char *name,
+                    const char *value ) {
+  size_t name_length;
+  size_t value_length;
+  struct stumpless_param *param;
+
+  VALIDATE_ARG_NOT_NULL( name );
+  VALIDATE_ARG_NOT_NULL( value );
+
+  if( unlikely( !validate_param_name( name, &name_length ) ) ) {
+    return NULL;
+  }
+
+  value_length = strlen( value );
+  if( unlikely( !validate_param_value( value, value_length ) ) ) {
+    return NULL;
+  }
+
+  param = element->params[element->param_count];
+  if( !reload_param( param, name, name_length, value, value_length ) ) {
+    return NULL;
+  }
+
+  element->param_count++;
+  config_reset_added_journald_param( param );
+
+  clear_error(  );
+  return element;
+}
+
+void
+locked_reset_element( struct stumpless_element *element ) {
+  size_t i;
+  size_t kept_count = 0;
+  struct stumpless_param *param;
+
+  for( i = 0; i < element->param_capacity; i++ ) {
+    param = element->params[i];
+
+    // params added by the caller may be used elsewhere, so they are dropped
+    if( param->owner != element ) {
+      continue;
+    }
+
+    element->params[kept_count] = param;
+    kept_count++;
+  }
+
+  element->param_count = 0;
+  element->param_capacity = kept_count;
+}
+
 void
 unchecked_destroy_element( const struct stumpless_element *element ) {
   unchecked_unload_element( element );
@@ -665,6 +773,8 @@ unchecked_load_element( struct stumpless_element *element,
 
   element->params = NULL;
   element->param_count = 0;
+  element->param_capacity = 0;
+  element->owner = NULL;
 
   config_assign_cached_mutex( element->mutex );
   if( !config_check_mutex_valid( element->mutex ) ) {
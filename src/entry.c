@@ -31,6 +31,7 @@
 #include "private/config/wrapper/format_string.h"
 #include "private/config/wrapper/gethostname.h"
 #include "private/config/wrapper/getpid.h"
+#include "private/config/wrapper/journald.h"
 #include "private/config/wrapper/thread_safety.h"
 #include "private/config/wrapper/wel.h"
 #include "private/config/wrapper/wstring.h"
@@ -46,7 +47,80 @@
 #include "private/memory.h"
 #include "private/validate.h"
 
+/** The most entries that a thread keeps in its entry pool. */
+#define ENTRY_POOL_SIZE 16
+
 static struct cache *entry_cache = NULL;
+static CONFIG_THREAD_LOCAL_STORAGE
+struct stumpless_entry *entry_pool[ENTRY_POOL_SIZE];
+static CONFIG_THREAD_LOCAL_STORAGE size_t entry_pool_count = 0;
+
+/**
+ * Adds an element to an entry by reusing the first element kept past the end
+ * of its elements array. The entry must have a kept element and must be
+ * locked, and the name must already be validated.
+ */
+static
+struct stumpless_element *
+locked_reuse_element( struct stumpless_entry *entry,
+                      const char *name,
+                      size_t name_length ) {
+  struct stumpless_element *element;
+
+  element = entry->elements[entry->element_count];
+
+  lock_element( element );
+  element->param_count = 0;
+  if( element->name_length != name_length
+      || memcmp( element->name, name, name_length ) != 0 ) {
+    memcpy( element->name, name, name_length );
+    element->name[name_length] = '\0';
+    element->name_length = name_length;
+    config_reset_journald_element( element );
+  }
+  unlock_element( element );
+
+  entry->element_count++;
+  return element;
+}
+
+/**
+ * Swaps in a new message for an entry, freeing the old message if the entry
+ * owned it.
+ */
+static
+void
+replace_entry_message( struct stumpless_entry *entry,
+                       const char *new_message,
+                       size_t new_message_length,
+                       bool borrowed ) {
+  const char *old_message;
+  bool old_borrowed;
+
+  lock_entry( entry );
+  old_message = entry->message;
+  old_borrowed = entry->message_borrowed;
+  entry->message = ( char * ) new_message;
+  entry->message_length = new_message_length;
+  entry->message_borrowed = borrowed;
+  unlock_entry( entry );
+
+  if( !old_borrowed ) {
+    free_mem( old_message );
+  }
+}
+
+/**
+ * Clears an entry for reuse as described in stumpless_reset_entry, without
+ * changing the current error so that it may be used on failure paths.
+ */
+static
+void
+reset_entry( struct stumpless_entry *entry ) {
+  lock_entry( entry );
+  locked_reset_entry( entry );
+  unlock_entry( entry );
+}
 
 struct stumpless_entry *
 stumpless_add_element( struct stumpless_entry *entry,
@@ -68,14 +142,39 @@ stumpless_add_element( struct stumpless_entry *entry,
 struct stumpless_entry *
 stumpless_add_new_element( struct stumpless_entry *entry,
                            const char *name ) {
+  size_t name_length;
   struct stumpless_element *new_element;
   struct stumpless_entry *result;
 
+  VALIDATE_ARG_NOT_NULL( entry );
+  VALIDATE_ARG_NOT_NULL( name );
+
+  lock_entry( entry );
+  if( entry->element_count < entry->element_capacity ) {
+    if( unlikely( !validate_element_name( name, &name_length ) ) ) {
+      result = NULL;
+
+    } else if( unchecked_entry_has_element( entry, name ) ) {
+      raise_duplicate_element(  );
+      result = NULL;
+
+    } else {
+      locked_reuse_element( entry, name, name_length );
+      clear_error(  );
+      result = entry;
+    }
+
+    unlock_entry( entry );
+    return result;
+  }
+  unlock_entry( entry );
+
   new_element = stumpless_new_element( name );
   if( !new_element ) {
     return NULL;
   }
 
+  new_element->owner = entry;
   result = stumpless_add_element( entry, new_element );
 
   if( !result ) {
@@ -93,6 +192,7 @@ stumpless_add_new_param_to_entry( struct stumpless_entry *entry,
   size_t element_name_len;
   struct stumpless_element *element;
   bool element_created = false;
+  bool element_reused = false;
   const void *result;
 
    VALIDATE_ARG_NOT_NULL( entry );
@@ -105,12 +205,17 @@ stumpless_add_new_param_to_entry( struct stumpless_entry *entry,
   lock_entry( entry );
 
   element = locked_get_element_by_name( entry, element_name );
-  if( !element ) {
+  if( !element && entry->element_count < entry->element_capacity ) {
+    element = locked_reuse_element( entry, element_name, element_name_len );
+    element_reused = true;
+
+  } else if( !element ) {
     element = stumpless_new_element( element_name );
     if( !element ) {
       goto fail_locked;
     }
 
+    element->owner = entry;
     element_created = true;
   }
 
@@ -130,6 +235,9 @@ stumpless_add_new_param_to_entry( struct stumpless_entry *entry,
   return entry;
 
 fail_locked:
+  if( element_reused ) {
+    entry->element_count--;
+  }
   unlock_entry( entry );
   if( element_created ) {
     stumpless_destroy_element_and_contents( element );
@@ -152,11 +260,24 @@ stumpless_copy_entry( const struct stumpless_entry *entry ) {
                               get_severity( entry->prival ),
                               entry->app_name,
                               entry->msgid,
-                              entry->message );
+                              NULL );
   if( !copy ) {
     goto cleanup_and_fail;
   }
 
+  memcpy( copy->timestamp, entry->timestamp, entry->timestamp_length );
+  copy->timestamp[entry->timestamp_length] = '\0';
+  copy->timestamp_length = entry->timestamp_length;
+
+  if( entry->message ) {
+    copy->message = copy_cstring_length( entry->message,
+                                         entry->message_length );
+    if( !copy->message ) {
+      goto fail_elements;
+    }
+    copy->message_length = entry->message_length;
+  }
+
   copy->elements = alloc_array( entry->element_count, sizeof( element_copy ) );
   if( !copy->elements ) {
     goto fail_elements;
@@ -168,8 +289,10 @@ stumpless_copy_entry( const struct stumpless_entry *entry ) {
       goto fail_elements;
     }
 
+    element_copy->owner = copy;
     copy->elements[i] = element_copy;
     copy->element_count++;
+    copy->element_capacity++;
   }
 
   result = config_copy_wel_data( copy, entry );
@@ -208,7 +331,7 @@ stumpless_destroy_entry_and_contents( const struct stumpless_entry *entry ) {
     return;
   }
 
-  for( i = 0; i < entry->element_count; i++ ) {
+  for( i = 0; i < entry->element_capacity; i++ ) {
     stumpless_destroy_element_and_contents( entry->elements[i] );
   }
 
@@ -217,10 +340,21 @@ stumpless_destroy_entry_and_contents( const struct stumpless_entry *entry ) {
 
 void
 stumpless_destroy_entry_only( const struct stumpless_entry *entry ) {
+  size_t i;
+
   if( !entry ) {
     return;
   }
 
+  for( i = 0; i < entry->element_count; i++ ) {
+    entry->elements[i]->owner = NULL;
+  }
+
+  // elements kept for reuse are no longer reachable by the caller
+  for( ; i < entry->element_capacity; i++ ) {
+    stumpless_destroy_element_and_contents( entry->elements[i] );
+  }
+
   unchecked_destroy_entry( entry );
 }
 
@@ -421,7 +555,8 @@ stumpless_get_entry_message( const struct stumpless_entry *entry ) {
     if( !message_copy ) {
       goto cleanup_and_return;
     }
-    memcpy( message_copy, entry->message, entry->message_length + 1 );
+    memcpy( message_copy, entry->message, entry->message_length );
+    message_copy[entry->message_length] = '\0';
   }
   clear_error(  );
 
@@ -699,6 +834,75 @@ stumpless_new_entry_str( enum stumpless_facility facility,
   return entry;
 }
 
+struct stumpless_entry *
+stumpless_new_pooled_entry_str( enum stumpless_facility facility,
+                                enum stumpless_severity severity,
+                                const char *app_name,
+                                const char *msgid,
+                                const char *message ) {
+  struct stumpless_entry *entry;
+
+  if( entry_pool_count == 0 ) {
+    return stumpless_new_entry_str( facility,
+                                    severity,
+                                    app_name,
+                                    msgid,
+                                    message );
+  }
+
+  entry = entry_pool[entry_pool_count - 1];
+
+  if( !stumpless_set_entry_priority( entry, facility, severity ) ) {
+    goto fail;
+  }
+  config_set_entry_wel_type( entry, severity );
+
+  if( app_name && !stumpless_set_entry_app_name( entry, app_name ) ) {
+    goto fail;
+  }
+
+  if( msgid && !stumpless_set_entry_msgid( entry, msgid ) ) {
+    goto fail;
+  }
+
+  if( message && !stumpless_set_entry_message_str( entry, message ) ) {
+    goto fail;
+  }
+
+  entry_pool_count--;
+  return entry;
+
+fail:
+  reset_entry( entry );
+  return NULL;
+}
+
+void
+stumpless_release_pooled_entry( struct stumpless_entry *entry ) {
+  if( !entry ) {
+    return;
+  }
+
+  if( entry_pool_count == ENTRY_POOL_SIZE ) {
+    stumpless_destroy_entry_and_contents( entry );
+    return;
+  }
+
+  stumpless_reset_entry( entry );
+  entry_pool[entry_pool_count] = entry;
+  entry_pool_count++;
+}
+
+struct stumpless_entry *
+stumpless_reset_entry( struct stumpless_entry *entry ) {
+  VALIDATE_ARG_NOT_NULL( entry );
+
+  reset_entry( entry );
+
+  clear_error(  );
+  return entry;
+}
+
 struct stumpless_entry *
 stumpless_set_element( struct stumpless_entry *entry,
                        size_t index,
@@ -721,6 +925,8 @@ stumpless_set_element( struct stumpless_entry *entry,
     goto cleanup_and_return;
   }
 
+  // the replaced element is now left to the caller
+  entry->elements[index]->owner = NULL;
   entry->elements[index] = element;
 
   result = entry;
@@ -734,11 +940,19 @@ cleanup_and_return:
 struct stumpless_entry *
 stumpless_set_entry_app_name( struct stumpless_entry *entry,
                               const char *app_name ) {
-  size_t name_length;
+  return stumpless_set_entry_app_name_buf( entry,
+                                           app_name,
+                                           app_name ? strlen( app_name ) : 0 );
+}
 
+struct stumpless_entry *
+stumpless_set_entry_app_name_buf( struct stumpless_entry *entry,
+                                  const char *app_name,
+                                  size_t name_length ) {
   VALIDATE_ARG_NOT_NULL( entry );
 
-  if( unlikely( app_name && !validate_app_name( app_name, &name_length ) ) ) {
+  if( unlikely( app_name &&
+                !validate_app_name_buf( app_name, name_length ) ) ) {
     return NULL;
   }
 
@@ -779,11 +993,19 @@ stumpless_set_entry_facility( struct stumpless_entry *entry,
 struct stumpless_entry *
 stumpless_set_entry_hostname( struct stumpless_entry *entry,
                               const char *hostname ) {
-  size_t new_length;
+  return stumpless_set_entry_hostname_buf( entry,
+                                           hostname,
+                                           hostname ? strlen( hostname ) : 0 );
+}
 
+struct stumpless_entry *
+stumpless_set_entry_hostname_buf( struct stumpless_entry *entry,
+                                  const char *hostname,
+                                  size_t new_length ) {
   VALIDATE_ARG_NOT_NULL( entry );
 
-  if( unlikely( hostname && !validate_hostname( hostname, &new_length ) ) ) {
+  if( unlikely( hostname &&
+                !validate_hostname_buf( hostname, new_length ) ) ) {
     return NULL;
   }
 
@@ -805,11 +1027,18 @@ stumpless_set_entry_hostname( struct stumpless_entry *entry,
 struct stumpless_entry *
 stumpless_set_entry_msgid( struct stumpless_entry *entry,
                            const char *msgid ) {
-  size_t new_msgid_length;
+  return stumpless_set_entry_msgid_buf( entry,
+                                        msgid,
+                                        msgid ? strlen( msgid ) : 0 );
+}
 
+struct stumpless_entry *
+stumpless_set_entry_msgid_buf( struct stumpless_entry *entry,
+                               const char *msgid,
+                               size_t new_msgid_length ) {
   VALIDATE_ARG_NOT_NULL( entry );
 
-  if( unlikely( msgid && !validate_msgid( msgid, &new_msgid_length ) ) ) {
+  if( unlikely( msgid && !validate_msgid_buf( msgid, new_msgid_length ) ) ) {
     return NULL;
   }
 
@@ -846,29 +1075,48 @@ stumpless_set_entry_message( struct stumpless_entry *entry,
 struct stumpless_entry *
 stumpless_set_entry_message_str( struct stumpless_entry *entry,
                                  const char *message ) {
+  return stumpless_set_entry_message_buf( entry,
+                                          message,
+                                          message ? strlen( message ) : 0 );
+}
+
+struct stumpless_entry *
+stumpless_set_entry_message_buf( struct stumpless_entry *entry,
+                                 const char *message,
+                                 size_t message_length ) {
   char *new_message;
   size_t new_message_length;
-  const char *old_message;
 
   VALIDATE_ARG_NOT_NULL( entry );
 
   if( message ) {
-    new_message = copy_cstring_with_length( message, &new_message_length );
+    new_message = copy_cstring_length( message, message_length );
     if( !new_message ) {
       return NULL;
     }
+    new_message_length = message_length;
   } else {
     new_message = NULL;
     new_message_length = 0;
   }
 
-  lock_entry( entry );
-  old_message = entry->message;
-  entry->message = new_message;
-  entry->message_length = new_message_length;
-  unlock_entry( entry );
+  replace_entry_message( entry, new_message, new_message_length, false );
+  clear_error(  );
+
+  return entry;
+}
+
+struct stumpless_entry *
+stumpless_set_entry_message_borrowed( struct stumpless_entry *entry,
+                                      const char *message,
+                                      size_t message_length ) {
+  VALIDATE_ARG_NOT_NULL( entry );
+
+  if( !message ) {
+    message_length = 0;
+  }
 
-  free_mem( old_message );
+  replace_entry_message( entry, message, message_length, true );
   clear_error(  );
 
   return entry;
@@ -879,7 +1127,6 @@ stumpless_set_entry_message_str_w( struct stumpless_entry *entry,
                                    const wchar_t *message ){
   char *new_message;
   int new_message_size;
-  const char *old_message;
 
   VALIDATE_ARG_NOT_NULL( entry );
 
@@ -895,13 +1142,7 @@ stumpless_set_entry_message_str_w( struct stumpless_entry *entry,
     new_message_size = 0;
   }
 
-  lock_entry( entry );
-  old_message = entry->message;
-  entry->message = new_message;
-  entry->message_length = new_message_size;
-  unlock_entry( entry );
-
-  free_mem( old_message );
+  replace_entry_message( entry, new_message, new_message_size, false );
   clear_error();
 
   return entry;
@@ -982,6 +1223,7 @@ stumpless_set_entry_param_value_by_name( struct stumpless_entry *entry,
       goto cleanup_and_fail;
     }
 
+    element->owner = entry;
     element_created = true;
   }
 
@@ -1045,14 +1287,21 @@ stumpless_set_entry_prival( struct stumpless_entry *entry,
 struct stumpless_entry *
 stumpless_set_entry_procid( struct stumpless_entry *entry,
                             const char *procid ) {
-  size_t procid_length;
+  return stumpless_set_entry_procid_buf( entry,
+                                         procid,
+                                         procid ? strlen( procid ) : 0 );
+}
 
+struct stumpless_entry *
+stumpless_set_entry_procid_buf( struct stumpless_entry *entry,
+                                const char *procid,
+                                size_t procid_length ) {
   VALIDATE_ARG_NOT_NULL( entry );
 
   if( !procid ) {
     procid_length = 0;
   } else {
-    if( unlikely( !validate_procid( procid, &procid_length ) ) ) {
+    if( unlikely( !validate_procid_buf( procid, procid_length ) ) ) {
       return NULL;
     }
   }
@@ -1095,7 +1344,7 @@ stumpless_unload_entry_and_contents( const struct stumpless_entry *entry ) {
     return;
   }
 
-  for( i = 0; i < entry->element_count; i++ ) {
+  for( i = 0; i < entry->element_capacity; i++ ) {
     stumpless_unload_element_and_contents( entry->elements[i] );
   }
 
@@ -1185,7 +1434,6 @@ struct stumpless_entry *
 vstumpless_set_entry_message( struct stumpless_entry *entry,
                               const char *message,
                               va_list subs ) {
-  const char *old_message;
   char *new_message;
   size_t message_length;
 
@@ -1202,13 +1450,7 @@ vstumpless_set_entry_message( struct stumpless_entry *entry,
     }
   }
 
-  lock_entry( entry );
-  old_message = entry->message;
-  entry->message = new_message;
-  entry->message_length = message_length;
-  unlock_entry( entry );
-
-  free_mem( old_message );
+  replace_entry_message( entry, new_message, message_length, false );
   clear_error(  );
   return entry;
 }
@@ -1221,6 +1463,16 @@ entry_free_all( void ) {
   entry_cache = NULL;
 }
 
+void
+entry_free_thread( void ) {
+  size_t i;
+
+  for( i = 0; i < entry_pool_count; i++ ) {
+    stumpless_destroy_entry_and_contents( entry_pool[i] );
+  }
+  entry_pool_count = 0;
+}
+
 void
 lock_entry( const struct stumpless_entry *entry ) {
   config_lock_mutex( entry->mutex );
@@ -1238,21 +1490,79 @@ locked_add_element( struct stumpless_entry *entry,
     return NULL;
   }
 
-  old_elements_size = sizeof( element ) * entry->element_count;
-  new_elements_size = old_elements_size + sizeof( element );
+  if( entry->element_count < entry->element_capacity ) {
+    stumpless_destroy_element_and_contents(
+      entry->elements[entry->element_count] );
 
-  new_elements = realloc_mem( entry->elements, new_elements_size );
-  if( !new_elements ) {
-    return NULL;
+  } else {
+    old_elements_size = sizeof( element ) * entry->element_count;
+    new_elements_size = old_elements_size + sizeof( element );
+
+    new_elements = realloc_mem( entry->elements, new_elements_size );
+    if( !new_elements ) {
+      return NULL;
+    }
+
+    entry->elements = new_elements;
+    entry->element_capacity++;
   }
 
-  new_elements[entry->element_count] = element;
-  entry->elements = new_elements;
+  entry->elements[entry->element_count] = element;
   entry->element_count++;
 
   return entry;
 }
 
+void
+locked_reset_entry( struct stumpless_entry *entry ) {
+  locked_reset_elements( entry );
+
+  entry->app_name[0] = '-';
+  entry->app_name[1] = '\0';
+  entry->app_name_length = 1;
+  entry->msgid[0] = '-';
+  entry->msgid[1] = '\0';
+  entry->msgid_length = 1;
+  entry->hostname_length = 0;
+  entry->procid_length = 0;
+  entry->timestamp_length = 0;
+
+  if( !entry->message_borrowed ) {
+    free_mem( entry->message );
+  }
+  entry->message = NULL;
+  entry->message_length = 0;
+  entry->message_borrowed = false;
+}
+
+void
+locked_reset_elements( struct stumpless_entry *entry ) {
+  size_t i;
+  size_t kept_count = 0;
+  struct stumpless_element *element;
+
+  for( i = 0; i < entry->element_capacity; i++ ) {
+    element = entry->elements[i];
+
+    // elements added by the caller may be used elsewhere, so they are dropped
+    if( element->owner != entry ) {
+      continue;
+    }
+
+    if( i < entry->element_count ) {
+      lock_element( element );
+      locked_reset_element( element );
+      unlock_element( element );
+    }
+
+    entry->elements[kept_count] = element;
+    kept_count++;
+  }
+
+  entry->element_count = 0;
+  entry->element_capacity = kept_count;
+}
+
 struct stumpless_element *
 locked_get_element_by_index( const struct stumpless_entry *entry,
                              size_t index ) {
@@ -1396,8 +1706,9 @@ strbuilder_append_structured_data( struct strbuilder *builder,
       builder = strbuilder_append_char( builder, '=' );
       builder = strbuilder_append_char( builder, '"' );
 
-      builder = strbuilder_append_buffer( builder,
-                                          param->value, param->value_length );
+      builder = strbuilder_append_escaped_param_value( builder,
+                                                       param->value,
+                                                       param->value_length );
 
       builder = strbuilder_append_char( builder, '"' );
     }
@@ -1472,11 +1783,14 @@ unchecked_load_entry( struct stumpless_entry *entry,
 
   entry->procid_length = 0;
   entry->hostname_length = 0;
+  entry->timestamp_length = 0;
   entry->message = message;
   entry->message_length = message_length;
+  entry->message_borrowed = false;
   entry->prival = get_prival( facility, severity );
   entry->elements = NULL;
   entry->element_count = 0;
+  entry->element_capacity = 0;
 
   return entry;
 }
@@ -1488,7 +1802,9 @@ unchecked_unload_entry( const struct stumpless_entry *entry ) {
   config_destroy_wel_data( entry );
 
   free_mem( entry->elements );
-  free_mem( entry->message );
+  if( !entry->message_borrowed ) {
+    free_mem( entry->message );
+  }
 }
 
 void
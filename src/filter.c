@@ -17,9 +17,681 @@
  */
 
 #include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
 #include <stumpless/entry.h>
 #include <stumpless/filter.h>
 #include <stumpless/target.h>
+#include "private/config.h"
+#include "private/config/wrapper/get_monotonic_time.h"
+#include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/thread_safety.h"
+#include "private/element.h"
+#include "private/entry.h"
+#include "private/error.h"
+#include "private/filter.h"
+#include "private/memory.h"
+#include "private/param.h"
+#include "private/severity.h"
+#include "private/strhelper.h"
+#include "private/target.h"
+#include "private/validate.h"
+
+/**
+ * The burst that a rate limit allows, in nanoseconds of its rate. A full
+ * bucket holds one second's worth of entries and bytes.
+ */
+#define RATE_LIMIT_BURST_NS 1000000000ULL
+
+/* global static variables */
+static config_atomic_u64_t last_dedup_serial;
+
+/* per-thread static variables */
+static CONFIG_THREAD_LOCAL_STORAGE
+struct dedup_slot dedup_slots[DEDUP_THREAD_SLOT_COUNT];
+static CONFIG_THREAD_LOCAL_STORAGE uint64_t dedup_clock = 0;
+static CONFIG_THREAD_LOCAL_STORAGE uint64_t sample_state = 0;
+
+/**
+ * Adds bytes to a 64 bit FNV-1a hash.
+ */
+static
+uint64_t
+add_to_hash( uint64_t hash, const void *bytes, size_t length ) {
+  const unsigned char *current = bytes;
+  size_t i;
+
+  for( i = 0; i < length; i++ ) {
+    hash ^= current[i];
+    hash *= 1099511628211ULL;
+  }
+
+  return hash;
+}
+
+/**
+ * Atomically adds one to a counter.
+ *
+ * @return The new value of the counter.
+ */
+static
+uint64_t
+increment_u64( config_atomic_u64_t *counter ) {
+  uint64_t current;
+
+  do {
+    current = config_read_u64( counter );
+  } while( !config_compare_exchange_u64( counter, current, current + 1 ) );
+
+  return current + 1;
+}
+
+/**
+ * Finds the slot of the current thread that holds the state for a duplicate
+ * filter configuration.
+ *
+ * @param serial The serial of the configuration.
+ *
+ * @param claim Whether to claim the least recently used slot for the
+ * configuration if none of them hold it yet.
+ *
+ * @return The slot, or NULL if none hold the configuration and claim is false.
+ */
+static
+struct dedup_slot *
+get_dedup_slot( uint64_t serial, bool claim ) {
+  struct dedup_slot *oldest = &dedup_slots[0];
+  size_t i;
+
+  for( i = 0; i < DEDUP_THREAD_SLOT_COUNT; i++ ) {
+    if( dedup_slots[i].serial == serial ) {
+      dedup_slots[i].last_used = ++dedup_clock;
+      return &dedup_slots[i];
+    }
+
+    if( dedup_slots[i].last_used < oldest->last_used ) {
+      oldest = &dedup_slots[i];
+    }
+  }
+
+  if( !claim ) {
+    return NULL;
+  }
+
+  oldest->serial = serial;
+  oldest->last_used = ++dedup_clock;
+  oldest->seen = false;
+  oldest->repeats = 0;
+  oldest->pending = 0;
+  return oldest;
+}
+
+/**
+ * Checks whether the severity mask of a target allows entries with the given
+ * prival. This is the same check as stumpless_mask_filter, for filters that
+ * have already read the prival of the entry under its lock.
+ */
+static
+bool
+mask_allows( const struct stumpless_target *target, int prival ) {
+  return STUMPLESS_SEVERITY_MASK( get_severity( prival ) )
+           & stumpless_get_target_mask( target );
+}
+
+/**
+ * Gets the bucket of a rate limit that an entry is counted against.
+ *
+ * Must be called with the entry locked.
+ */
+static
+struct rate_limit_bucket *
+get_rate_limit_bucket( struct rate_limit *limit,
+                       const struct stumpless_entry *entry ) {
+  uint32_t hash = 2166136261u;
+  size_t i;
+
+  switch( limit->key ) {
+    case STUMPLESS_RATE_LIMIT_PER_SEVERITY:
+      return &limit->buckets[get_severity( entry->prival )];
+
+    case STUMPLESS_RATE_LIMIT_PER_MSGID:
+      // FNV-1a
+      for( i = 0; i < entry->msgid_length; i++ ) {
+        hash ^= ( unsigned char ) entry->msgid[i];
+        hash *= 16777619u;
+      }
+      return &limit->buckets[hash % RATE_LIMIT_MSGID_BUCKET_COUNT];
+
+    default:
+      return &limit->buckets[0];
+  }
+}
+
+/**
+ * Mixes the bits of a hash so that its low bits can be used as a uniform
+ * random value. This is the finalizer of the SplitMix64 generator.
+ */
+static
+uint64_t
+mix_hash( uint64_t hash ) {
+  hash = ( hash ^ ( hash >> 30 ) ) * 0xbf58476d1ce4e5b9ULL;
+  hash = ( hash ^ ( hash >> 27 ) ) * 0x94d049bb133111ebULL;
+  return hash ^ ( hash >> 31 );
+}
+
+/**
+ * Gets the next random value of the current thread for sampling.
+ */
+static
+uint64_t
+get_sample_random( void ) {
+  if( unlikely( sample_state == 0 ) ) {
+    sample_state = config_get_monotonic_ns(  )
+                     ^ ( uint64_t ) ( uintptr_t ) &sample_state;
+  }
+
+  sample_state += 0x9e3779b97f4a7c15ULL;
+  return mix_hash( sample_state );
+}
+
+/**
+ * Gets the hash of the value of the sampling key param of an entry.
+ *
+ * Must be called with the entry locked. Like the formatter, this reads the
+ * elements and params of the entry under the entry's lock alone.
+ *
+ * @param sample The sampling configuration with the key.
+ *
+ * @param entry The entry to get the key of.
+ *
+ * @param hash Set to the hash of the param value, if it is found.
+ *
+ * @return true if the entry has the key param, false otherwise.
+ */
+static
+bool
+get_sample_key_hash( const struct sample *sample,
+                     const struct stumpless_entry *entry,
+                     uint64_t *hash ) {
+  const struct stumpless_element *element;
+  const struct stumpless_param *param;
+  size_t i;
+  size_t j;
+
+  for( i = 0; i < entry->element_count; i++ ) {
+    element = entry->elements[i];
+
+    if( element->name_length != sample->element_name_length
+        || memcmp( element->name,
+                   sample->element_name,
+                   element->name_length ) != 0 ) {
+      continue;
+    }
+
+    for( j = 0; j < element->param_count; j++ ) {
+      param = element->params[j];
+
+      if( param->name_length == sample->param_name_length
+          && memcmp( param->name,
+                     sample->param_name,
+                     param->name_length ) == 0 ) {
+        *hash = add_to_hash( 14695981039346656037ULL,
+                             param->value,
+                             param->value_length );
+        return true;
+      }
+    }
+
+    // element names are unique within an entry
+    return false;
+  }
+
+  return false;
+}
+
+/**
+ * Gets the sampling configuration of a target, creating it if the target does
+ * not have one yet.
+ *
+ * Must be called with the target locked.
+ *
+ * @return The sampling configuration, or NULL if it could not be created.
+ */
+static
+struct sample *
+locked_get_sample( struct stumpless_target *target ) {
+  struct sample *sample;
+  size_t i;
+
+  if( target->sample ) {
+    return target->sample;
+  }
+
+  sample = alloc_mem( sizeof( *sample ) );
+  if( !sample ) {
+    return NULL;
+  }
+
+  for( i = 0; i < 8; i++ ) {
+    sample->rates[i] = 0;
+  }
+  sample->element_name = NULL;
+  sample->element_name_length = 0;
+  sample->param_name = NULL;
+  sample->param_name_length = 0;
+
+  target->sample = sample;
+  return sample;
+}
+
+/**
+ * Adds a stage to the filter pipeline of a target, after the last stage that
+ * is evaluated before it.
+ *
+ * @param target The target to add the stage to.
+ *
+ * @param stage The stage to add. If it cannot be added, it is destroyed.
+ *
+ * @return The target, or NULL if the stage could not be added.
+ */
+static
+struct stumpless_target *
+add_filter_stage( struct stumpless_target *target,
+                  struct filter_stage *stage ) {
+  struct filter_stages *stages;
+  struct filter_stage **new_stages;
+  size_t i;
+
+  config_write_u64( &stage->passed, 0 );
+  config_write_u64( &stage->dropped, 0 );
+
+  lock_target( target );
+  stages = target->filter_stages;
+  if( !stages ) {
+    stages = alloc_mem( sizeof( *stages ) );
+    if( !stages ) {
+      goto fail;
+    }
+
+    stages->stages = NULL;
+    stages->count = 0;
+    target->filter_stages = stages;
+  }
+
+  new_stages = realloc_mem( stages->stages,
+                            sizeof( *new_stages ) * ( stages->count + 1 ) );
+  if( !new_stages ) {
+    goto fail;
+  }
+  stages->stages = new_stages;
+
+  i = stages->count;
+  while( i > 0 && new_stages[i - 1]->type > stage->type ) {
+    new_stages[i] = new_stages[i - 1];
+    i--;
+  }
+  new_stages[i] = stage;
+  stages->count++;
+  unlock_target( target );
+
+  clear_error(  );
+  return target;
+
+fail:
+  unlock_target( target );
+  free_mem( stage->name );
+  free_mem( stage );
+  return NULL;
+}
+
+/**
+ * Checks an entry against a single filter stage.
+ */
+static
+bool
+check_filter_stage( const struct filter_stage *stage,
+                    const struct stumpless_target *target,
+                    const struct stumpless_entry *entry ) {
+  bool result;
+
+  switch( stage->type ) {
+    case FILTER_STAGE_SEVERITY:
+      return ( STUMPLESS_SEVERITY_MASK( stumpless_get_entry_severity( entry ) )
+               & stage->severity_mask ) != 0;
+
+    case FILTER_STAGE_APP_NAME:
+      lock_entry( entry );
+      result = entry->app_name_length == stage->name_length
+                 && memcmp( entry->app_name,
+                            stage->name,
+                            stage->name_length ) == 0;
+      unlock_entry( entry );
+      return result;
+
+    case FILTER_STAGE_ELEMENT:
+      lock_entry( entry );
+      result = unchecked_entry_has_element( entry, stage->name );
+      unlock_entry( entry );
+      return result;
+
+    default:
+      return stage->filter( target, entry );
+  }
+}
+
+/**
+ * Creates a filter stage holding a copy of a name.
+ *
+ * @return The new stage, or NULL if memory could not be allocated.
+ */
+static
+struct filter_stage *
+new_named_filter_stage( enum filter_stage_type type,
+                        const char *name,
+                        size_t name_length ) {
+  struct filter_stage *stage;
+
+  stage = alloc_mem( sizeof( *stage ) );
+  if( !stage ) {
+    return NULL;
+  }
+
+  stage->name = copy_cstring_length( name, name_length );
+  if( !stage->name ) {
+    free_mem( stage );
+    return NULL;
+  }
+
+  stage->type = type;
+  stage->name_length = name_length;
+  return stage;
+}
+
+/**
+ * Gets the hash that duplicate entries are detected with.
+ *
+ * Must be called with the entry locked.
+ */
+static
+uint64_t
+get_dedup_hash( const struct stumpless_entry *entry ) {
+  uint64_t hash = 14695981039346656037ULL;
+
+  // lengths are included so that fields cannot run into each other
+  hash = add_to_hash( hash, &entry->prival, sizeof( entry->prival ) );
+  hash = add_to_hash( hash,
+                      &entry->app_name_length,
+                      sizeof( entry->app_name_length ) );
+  hash = add_to_hash( hash, entry->app_name, entry->app_name_length );
+  hash = add_to_hash( hash,
+                      &entry->msgid_length,
+                      sizeof( entry->msgid_length ) );
+  hash = add_to_hash( hash, entry->msgid, entry->msgid_length );
+  if( entry->message ) {
+    hash = add_to_hash( hash, entry->message, entry->message_length );
+  }
+
+  return hash;
+}
+
+/**
+ * Tries to take the given cost from a limit, without taking it if the limit
+ * would be exceeded.
+ *
+ * A full limit always admits one cost, so that entries larger than the burst
+ * are not suppressed forever.
+ *
+ * @return true if the cost was taken, false if the limit was exceeded.
+ */
+static
+bool
+take_from_limit( config_atomic_u64_t *tat, uint64_t cost, uint64_t now ) {
+  uint64_t current;
+  uint64_t start;
+
+  do {
+    current = config_read_u64( tat );
+    start = current > now ? current : now;
+
+    if( start > now && start - now + cost > RATE_LIMIT_BURST_NS ) {
+      return false;
+    }
+  } while( !config_compare_exchange_u64( tat, current, start + cost ) );
+
+  return true;
+}
+
+/**
+ * Gives back a cost taken with take_from_limit.
+ */
+static
+void
+return_to_limit( config_atomic_u64_t *tat, uint64_t cost ) {
+  uint64_t current;
+
+  do {
+    current = config_read_u64( tat );
+  } while( !config_compare_exchange_u64( tat,
+                                         current,
+                                         current > cost ? current - cost : 0 ) );
+}
+
+struct stumpless_target *
+stumpless_add_app_name_filter_stage( struct stumpless_target *target,
+                                     const char *app_name ) {
+  size_t app_name_length;
+  struct filter_stage *stage;
+
+  VALIDATE_ARG_NOT_NULL( target );
+  VALIDATE_ARG_NOT_NULL( app_name );
+
+  if( !validate_app_name( app_name, &app_name_length ) ) {
+    return NULL;
+  }
+
+  stage = new_named_filter_stage( FILTER_STAGE_APP_NAME,
+                                  app_name,
+                                  app_name_length );
+  if( !stage ) {
+    return NULL;
+  }
+
+  return add_filter_stage( target, stage );
+}
+
+struct stumpless_target *
+stumpless_add_element_filter_stage( struct stumpless_target *target,
+                                    const char *element_name ) {
+  size_t element_name_length;
+  struct filter_stage *stage;
+
+  VALIDATE_ARG_NOT_NULL( target );
+  VALIDATE_ARG_NOT_NULL( element_name );
+
+  if( !validate_element_name( element_name, &element_name_length ) ) {
+    return NULL;
+  }
+
+  stage = new_named_filter_stage( FILTER_STAGE_ELEMENT,
+                                  element_name,
+                                  element_name_length );
+  if( !stage ) {
+    return NULL;
+  }
+
+  return add_filter_stage( target, stage );
+}
+
+struct stumpless_target *
+stumpless_add_filter_stage( struct stumpless_target *target,
+                            stumpless_filter_func_t filter ) {
+  struct filter_stage *stage;
+
+  VALIDATE_ARG_NOT_NULL( target );
+  VALIDATE_ARG_NOT_NULL( filter );
+
+  stage = alloc_mem( sizeof( *stage ) );
+  if( !stage ) {
+    return NULL;
+  }
+
+  stage->type = FILTER_STAGE_FUNCTION;
+  stage->name = NULL;
+  stage->filter = filter;
+
+  return add_filter_stage( target, stage );
+}
+
+struct stumpless_target *
+stumpless_add_severity_filter_stage( struct stumpless_target *target,
+                                     enum stumpless_severity most_severe,
+                                     enum stumpless_severity least_severe ) {
+  struct filter_stage *stage;
+  int severity;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  if( severity_is_invalid( most_severe ) ) {
+    raise_invalid_severity( most_severe );
+    return NULL;
+  }
+
+  if( severity_is_invalid( least_severe ) ) {
+    raise_invalid_severity( least_severe );
+    return NULL;
+  }
+
+  // a range that is backwards would pass nothing at all
+  if( most_severe > least_severe ) {
+    raise_invalid_severity( least_severe );
+    return NULL;
+  }
+
+  stage = alloc_mem( sizeof( *stage ) );
+  if( !stage ) {
+    return NULL;
+  }
+
+  stage->type = FILTER_STAGE_SEVERITY;
+  stage->name = NULL;
+  stage->severity_mask = 0;
+  for( severity = most_severe; severity <= ( int ) least_severe; severity++ ) {
+    stage->severity_mask |= STUMPLESS_SEVERITY_MASK( severity );
+  }
+
+  return add_filter_stage( target, stage );
+}
+
+struct stumpless_target *
+stumpless_clear_filter_stages( struct stumpless_target *target ) {
+  VALIDATE_ARG_NOT_NULL( target );
+
+  lock_target( target );
+  destroy_filter_stages( target );
+  target->filter_stages = NULL;
+  unlock_target( target );
+
+  clear_error(  );
+  return target;
+}
+
+bool
+stumpless_dedup_filter( const struct stumpless_target *target,
+                        const struct stumpless_entry *entry ) {
+  const struct dedup *dedup;
+  struct dedup_slot *slot;
+  uint64_t hash;
+  int prival;
+  uint64_t now;
+
+  dedup = target->dedup;
+
+  lock_entry( entry );
+  prival = entry->prival;
+  if( dedup ) {
+    hash = get_dedup_hash( entry );
+  }
+  unlock_entry( entry );
+
+  if( !mask_allows( target, prival ) ) {
+    return false;
+  }
+
+  if( !dedup ) {
+    return true;
+  }
+
+  slot = get_dedup_slot( dedup->serial, true );
+  now = config_get_monotonic_ns(  );
+
+  if( slot->seen
+      && slot->hash == hash
+      && ( dedup->window == 0 || now - slot->first_seen < dedup->window ) ) {
+    slot->repeats++;
+    return false;
+  }
+
+  if( slot->repeats != 0 ) {
+    slot->pending += slot->repeats;
+    slot->pending_prival = slot->prival;
+    slot->repeats = 0;
+  }
+
+  slot->seen = true;
+  slot->hash = hash;
+  slot->prival = prival;
+  slot->first_seen = now;
+  return true;
+}
+
+size_t
+stumpless_get_filter_stage_count( const struct stumpless_target *target ) {
+  const struct filter_stages *stages;
+  size_t result;
+
+  VALIDATE_ARG_NOT_NULL_UNSIGNED_RETURN( target );
+
+  lock_target( target );
+  stages = target->filter_stages;
+  result = stages ? stages->count : 0;
+  unlock_target( target );
+
+  clear_error(  );
+  return result;
+}
+
+const struct stumpless_target *
+stumpless_get_filter_stage_stats( const struct stumpless_target *target,
+                                  size_t index,
+                                  size_t *passed,
+                                  size_t *dropped ) {
+  const struct filter_stages *stages;
+  struct filter_stage *stage;
+
+  VALIDATE_ARG_NOT_NULL( target );
+  VALIDATE_ARG_NOT_NULL( passed );
+  VALIDATE_ARG_NOT_NULL( dropped );
+
+  lock_target( target );
+  stages = target->filter_stages;
+  if( !stages || index >= stages->count ) {
+    unlock_target( target );
+    raise_index_out_of_bounds(
+      L10N_INVALID_INDEX_ERROR_MESSAGE( "filter stage" ),
+      index
+    );
+    return NULL;
+  }
+
+  stage = stages->stages[index];
+  *passed = ( size_t ) config_read_u64( &stage->passed );
+  *dropped = ( size_t ) config_read_u64( &stage->dropped );
+  unlock_target( target );
+
+  clear_error(  );
+  return target;
+}
 
 bool
 stumpless_mask_filter( const struct stumpless_target *target,
@@ -27,3 +699,351 @@ stumpless_mask_filter( const struct stumpless_target *target,
   return STUMPLESS_SEVERITY_MASK( stumpless_get_entry_severity( entry ) )
            & stumpless_get_target_mask( target );
 }
+
+bool
+stumpless_rate_limit_filter( const struct stumpless_target *target,
+                             const struct stumpless_entry *entry ) {
+  struct rate_limit *limit;
+  struct rate_limit_bucket *bucket;
+  uint64_t byte_cost;
+  uint64_t now;
+  int prival;
+
+  limit = target->rate_limit;
+
+  // the prival is read along with the bucket so the entry is locked once
+  lock_entry( entry );
+  prival = entry->prival;
+  if( limit ) {
+    bucket = get_rate_limit_bucket( limit, entry );
+    byte_cost = entry->message_length * limit->byte_interval;
+  }
+  unlock_entry( entry );
+
+  if( !mask_allows( target, prival ) ) {
+    return false;
+  }
+
+  if( !limit ) {
+    return true;
+  }
+
+  now = config_get_monotonic_ns(  );
+
+  if( limit->entry_interval != 0
+      && !take_from_limit( &bucket->entry_tat, limit->entry_interval, now ) ) {
+    goto suppress;
+  }
+
+  if( limit->byte_interval != 0
+      && !take_from_limit( &bucket->byte_tat, byte_cost, now ) ) {
+    if( limit->entry_interval != 0 ) {
+      return_to_limit( &bucket->entry_tat, limit->entry_interval );
+    }
+    goto suppress;
+  }
+
+  return true;
+
+suppress:
+  increment_u64( &limit->suppressed );
+  return false;
+}
+
+bool
+stumpless_sample_filter( const struct stumpless_target *target,
+                         const struct stumpless_entry *entry ) {
+  const struct sample *sample;
+  int prival;
+  int severity;
+  unsigned rate = 0;
+  uint64_t value;
+  bool keyed = false;
+
+  sample = target->sample;
+
+  // the prival is read along with the key so the entry is locked once
+  lock_entry( entry );
+  prival = entry->prival;
+  severity = get_severity( prival );
+  if( sample && severity > STUMPLESS_SEVERITY_WARNING_VALUE ) {
+    rate = sample->rates[severity];
+    if( rate > 1 && sample->element_name ) {
+      keyed = get_sample_key_hash( sample, entry, &value );
+    }
+  }
+  unlock_entry( entry );
+
+  if( !mask_allows( target, prival ) ) {
+    return false;
+  }
+
+  if( rate <= 1 ) {
+    return true;
+  }
+
+  if( keyed ) {
+    value = mix_hash( value );
+  } else {
+    value = get_sample_random(  );
+  }
+
+  return value % rate == 0;
+}
+
+struct stumpless_target *
+stumpless_set_target_dedup_window( struct stumpless_target *target,
+                                   unsigned window ) {
+  struct dedup *dedup;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  dedup = alloc_mem( sizeof( *dedup ) );
+  if( !dedup ) {
+    return NULL;
+  }
+
+  dedup->serial = increment_u64( &last_dedup_serial );
+  dedup->window = ( uint64_t ) window * 1000000ULL;
+
+  lock_target( target );
+  free_mem( target->dedup );
+  target->dedup = dedup;
+  unlock_target( target );
+
+  clear_error(  );
+  return target;
+}
+
+struct stumpless_target *
+stumpless_set_target_rate_limit( struct stumpless_target *target,
+                                 size_t entries_per_second,
+                                 size_t bytes_per_second,
+                                 enum stumpless_rate_limit_key key ) {
+  struct rate_limit *limit;
+  size_t i;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  limit = alloc_mem( sizeof( *limit ) );
+  if( !limit ) {
+    return NULL;
+  }
+
+  limit->entry_interval = entries_per_second == 0 ?
+                            0 :
+                            RATE_LIMIT_BURST_NS / entries_per_second;
+  limit->byte_interval = bytes_per_second == 0 ?
+                           0 :
+                           RATE_LIMIT_BURST_NS / bytes_per_second;
+  limit->key = key;
+  config_write_u64( &limit->suppressed, 0 );
+  for( i = 0; i < RATE_LIMIT_MSGID_BUCKET_COUNT; i++ ) {
+    config_write_u64( &limit->buckets[i].entry_tat, 0 );
+    config_write_u64( &limit->buckets[i].byte_tat, 0 );
+  }
+
+  lock_target( target );
+  free_mem( target->rate_limit );
+  target->rate_limit = limit;
+  unlock_target( target );
+
+  clear_error(  );
+  return target;
+}
+
+struct stumpless_target *
+stumpless_set_target_sample_key( struct stumpless_target *target,
+                                 const char *element_name,
+                                 const char *param_name ) {
+  char *new_element_name = NULL;
+  char *new_param_name = NULL;
+  size_t element_name_length = 0;
+  size_t param_name_length = 0;
+  struct sample *sample;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  if( element_name ) {
+    VALIDATE_ARG_NOT_NULL( param_name );
+
+    element_name_length = strlen( element_name );
+    param_name_length = strlen( param_name );
+
+    new_element_name = copy_cstring( element_name );
+    if( !new_element_name ) {
+      goto fail;
+    }
+
+    new_param_name = copy_cstring( param_name );
+    if( !new_param_name ) {
+      goto fail_param;
+    }
+  }
+
+  lock_target( target );
+  sample = locked_get_sample( target );
+  if( !sample ) {
+    unlock_target( target );
+    goto fail_sample;
+  }
+
+  free_mem( sample->element_name );
+  free_mem( sample->param_name );
+  sample->element_name = new_element_name;
+  sample->element_name_length = element_name_length;
+  sample->param_name = new_param_name;
+  sample->param_name_length = param_name_length;
+  unlock_target( target );
+
+  clear_error(  );
+  return target;
+
+fail_sample:
+  free_mem( new_param_name );
+fail_param:
+  free_mem( new_element_name );
+fail:
+  return NULL;
+}
+
+struct stumpless_target *
+stumpless_set_target_sample_rate( struct stumpless_target *target,
+                                  enum stumpless_severity severity,
+                                  unsigned rate ) {
+  struct sample *sample;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  if( severity_is_invalid( severity ) ) {
+    raise_invalid_severity( severity );
+    return NULL;
+  }
+
+  lock_target( target );
+  sample = locked_get_sample( target );
+  if( !sample ) {
+    unlock_target( target );
+    return NULL;
+  }
+
+  sample->rates[severity] = rate;
+  unlock_target( target );
+
+  clear_error(  );
+  return target;
+}
+
+/* private definitions */
+
+void
+destroy_dedup( const struct stumpless_target *target ) {
+  free_mem( target->dedup );
+}
+
+void
+destroy_filter_stages( const struct stumpless_target *target ) {
+  struct filter_stages *stages;
+  size_t i;
+
+  stages = target->filter_stages;
+  if( !stages ) {
+    return;
+  }
+
+  for( i = 0; i < stages->count; i++ ) {
+    free_mem( stages->stages[i]->name );
+    free_mem( stages->stages[i] );
+  }
+
+  free_mem( stages->stages );
+  free_mem( stages );
+}
+
+void
+destroy_rate_limit( const struct stumpless_target *target ) {
+  free_mem( target->rate_limit );
+}
+
+void
+destroy_sample( const struct stumpless_target *target ) {
+  struct sample *sample;
+
+  sample = target->sample;
+  if( !sample ) {
+    return;
+  }
+
+  free_mem( sample->element_name );
+  free_mem( sample->param_name );
+  free_mem( sample );
+}
+
+uint64_t
+take_suppressed_entry_count( const struct stumpless_target *target ) {
+  struct rate_limit *limit;
+  uint64_t suppressed;
+
+  limit = target->rate_limit;
+  if( !limit ) {
+    return 0;
+  }
+
+  do {
+    suppressed = config_read_u64( &limit->suppressed );
+  } while( suppressed != 0
+           && !config_compare_exchange_u64( &limit->suppressed,
+                                            suppressed,
+                                            0 ) );
+
+  return suppressed;
+}
+
+bool
+run_filter_stages( const struct stumpless_target *target,
+                   const struct stumpless_entry *entry ) {
+  const struct filter_stages *stages;
+  struct filter_stage *stage;
+  size_t i;
+
+  stages = target->filter_stages;
+  if( !stages ) {
+    return true;
+  }
+
+  for( i = 0; i < stages->count; i++ ) {
+    stage = stages->stages[i];
+
+    if( !check_filter_stage( stage, target, entry ) ) {
+      increment_u64( &stage->dropped );
+      return false;
+    }
+
+    increment_u64( &stage->passed );
+  }
+
+  return true;
+}
+
+uint64_t
+take_repeated_entry_count( const struct stumpless_target *target,
+                           int *prival ) {
+  const struct dedup *dedup;
+  struct dedup_slot *slot;
+  uint64_t pending;
+
+  dedup = target->dedup;
+  if( !dedup ) {
+    return 0;
+  }
+
+  slot = get_dedup_slot( dedup->serial, false );
+  if( !slot ) {
+    return 0;
+  }
+
+  pending = slot->pending;
+  *prival = slot->pending_prival;
+  slot->pending = 0;
+  return pending;
+}
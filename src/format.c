@@ -0,0 +1,37 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <stumpless/format.h>
+#include "private/strhelper.h"
+
+static const char *format_enum_to_string[] = {
+  STUMPLESS_FOREACH_FORMAT( GENERATE_STRING )
+};
+
+const char *
+stumpless_get_format_string( enum stumpless_format format ) {
+  size_t format_count;
+
+  format_count = sizeof( format_enum_to_string ) / sizeof( const char * );
+  if( format >= 0 && ( size_t ) format < format_count ) {
+    return format_enum_to_string[format];
+  }
+
+  return "NO_SUCH_FORMAT";
+}
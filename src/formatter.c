@@ -16,57 +16,284 @@
  * limitations under the License.
  */
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <string.h>
 #include <stumpless/entry.h>
-#include <stumpless/option.h>
+#include <stumpless/format.h>
 #include <stumpless/target.h>
+#include "private/binary.h"
 #include "private/entry.h"
 #include "private/strbuilder.h"
 #include "private/formatter.h"
+#include "private/target.h"
 #include "private/config/wrapper/get_now.h"
+#include "private/config/wrapper/getpid.h"
+#include "private/config/wrapper/probe.h"
 
+/**
+ * The escape used for each byte in a JSON string. Bytes with a zero entry are
+ * copied as they are, those with a 'u' entry are written as a \u00XX escape,
+ * and all others are written as a backslash followed by the entry.
+ */
+static const char json_escapes[256] = {
+  'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+  'b', 't', 'n', 'u', 'f', 'r', 'u', 'u',
+  'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+  'u', 'u', 'u', 'u', 'u', 'u', 'u', 'u',
+  0, 0, '"', 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, 0, 0, 0, 0,
+  0, 0, 0, 0, '\\'
+};
+
+/** The syslog keywords for each facility code, used in logfmt entries. */
+static const char *facility_names[] = {
+  "kern", "user", "mail", "daemon", "auth", "syslog", "lpr", "news", "uucp",
+  "cron", "authpriv", "ftp", "ntp", "security", "console", "solaris-cron",
+  "local0", "local1", "local2", "local3", "local4", "local5", "local6",
+  "local7"
+};
+
+/** The syslog keywords for each severity, used in logfmt entries. */
+static const char *severity_names[] = {
+  "emerg", "alert", "crit", "err", "warning", "notice", "info", "debug"
+};
+
+/** The month abbreviations used in RFC 3164 timestamps. */
+static const char *month_names[] = {
+  "Jan", "Feb", "Mar", "Apr", "May", "Jun",
+  "Jul", "Aug", "Sep", "Oct", "Nov", "Dec"
+};
+
+static
+bool
+is_nil( const char *value, size_t length ) {
+  return length == 1 && value[0] == RFC_5424_NILVALUE;
+}
+
+/**
+ * Appends a JSON string, including the surrounding quotes. Runs of bytes that
+ * do not need to be escaped are appended together.
+ */
+static
 struct strbuilder *
-format_entry( const struct stumpless_entry *entry,
-              const struct stumpless_target *target ) {
-  char timestamp[RFC_5424_TIMESTAMP_BUFFER_SIZE];
-  struct strbuilder *builder;
-  size_t timestamp_size;
+append_json_string( struct strbuilder *builder,
+                    const char *str,
+                    size_t length ) {
+  static const char hex_digits[] = "0123456789abcdef";
+  char short_escape[2] = { '\\', '\0' };
+  char unicode_escape[6] = { '\\', 'u', '0', '0', '\0', '\0' };
+  size_t run_start = 0;
+  size_t i;
+  unsigned char current;
+  char escape;
 
-  // do this as soon as possible to be closer to invocation
-  timestamp_size = config_get_now( timestamp );
+  builder = strbuilder_append_char( builder, '"' );
 
-  lock_entry( entry );
+  for( i = 0; i < length; i++ ) {
+    current = ( unsigned char ) str[i];
+    escape = json_escapes[current];
+    if( escape == 0 ) {
+      continue;
+    }
+
+    builder = strbuilder_append_buffer( builder,
+                                        str + run_start,
+                                        i - run_start );
+
+    if( escape == 'u' ) {
+      unicode_escape[4] = hex_digits[current >> 4];
+      unicode_escape[5] = hex_digits[current & 0xf];
+      builder = strbuilder_append_buffer( builder,
+                                          unicode_escape,
+                                          sizeof( unicode_escape ) );
+    } else {
+      short_escape[1] = escape;
+      builder = strbuilder_append_buffer( builder,
+                                          short_escape,
+                                          sizeof( short_escape ) );
+    }
+
+    run_start = i + 1;
+  }
+
+  builder = strbuilder_append_buffer( builder,
+                                      str + run_start,
+                                      length - run_start );
+  return strbuilder_append_char( builder, '"' );
+}
 
-  builder = strbuilder_new(  );
+/**
+ * Appends a `,"name":"value"` member to a JSON object.
+ */
+static
+struct strbuilder *
+append_json_member( struct strbuilder *builder,
+                    const char *name,
+                    const char *value,
+                    size_t value_length ) {
+  builder = strbuilder_append_string( builder, ",\"" );
+  builder = strbuilder_append_string( builder, name );
+  builder = strbuilder_append_string( builder, "\":" );
+  return append_json_string( builder, value, value_length );
+}
+
+/**
+ * Appends a logfmt value, which is quoted and escaped only if it is empty or
+ * contains spaces, quotes, equal signs, or control characters.
+ */
+static
+struct strbuilder *
+append_logfmt_value( struct strbuilder *builder,
+                     const char *value,
+                     size_t length ) {
+  size_t i;
+  unsigned char current;
+
+  if( length == 0 ) {
+    return strbuilder_append_string( builder, "\"\"" );
+  }
+
+  for( i = 0; i < length; i++ ) {
+    current = ( unsigned char ) value[i];
+    if( current <= ' ' || current == '=' || json_escapes[current] != 0 ) {
+      return append_json_string( builder, value, length );
+    }
+  }
+
+  return strbuilder_append_buffer( builder, value, length );
+}
+
+/**
+ * Appends a ` key=value` pair to a logfmt entry.
+ */
+static
+struct strbuilder *
+append_logfmt_pair( struct strbuilder *builder,
+                    const char *key,
+                    const char *value,
+                    size_t value_length ) {
+  builder = strbuilder_append_char( builder, ' ' );
+  builder = strbuilder_append_string( builder, key );
+  builder = strbuilder_append_char( builder, '=' );
+  return append_logfmt_value( builder, value, value_length );
+}
+
+/**
+ * Appends the hostname of an entry, or the hostname of the target if the
+ * entry does not have one.
+ */
+static
+struct strbuilder *
+append_hostname( struct strbuilder *builder,
+                 const struct stumpless_entry *entry,
+                 const struct target_header *header ) {
+  if( entry->hostname_length > 0 ) {
+    return strbuilder_append_buffer( builder,
+                                     entry->hostname,
+                                     entry->hostname_length );
+  }
+
+  return strbuilder_append_buffer( builder,
+                                   header->segment,
+                                   header->hostname_length );
+}
+
+/**
+ * Appends the procid of an entry, or the process id if the entry does not have
+ * one. This should only be used if the header includes a process id.
+ */
+static
+struct strbuilder *
+append_procid( struct strbuilder *builder,
+               const struct stumpless_entry *entry,
+               int pid ) {
+  if( entry->procid_length > 0 ) {
+    return strbuilder_append_buffer( builder,
+                                     entry->procid,
+                                     entry->procid_length );
+  }
+
+  return strbuilder_append_positive_int( builder, pid );
+}
+
+/**
+ * Checks whether the pre-rendered header of a target can be used in place of
+ * the hostname, app name, and procid of an entry. The entry must be locked by
+ * the caller.
+ */
+static
+bool
+can_use_target_header( const struct stumpless_entry *entry,
+                       const struct target_header *header,
+                       int pid ) {
+  if( entry->hostname_length > 0 ) {
+    return false;
+  }
+
+  // a forked process must not use the process id of its parent
+  if( header->pid != 0
+      && ( entry->procid_length > 0 || header->pid != pid ) ) {
+    return false;
+  }
+
+  // the app name follows the hostname and a space in the segment
+  return entry->app_name_length == header->app_name_length
+           && memcmp( entry->app_name,
+                      header->segment + header->hostname_length + 1,
+                      header->app_name_length ) == 0;
+}
+
+int
+get_header_pid( const struct target_header *header ) {
+  if( header->pid == 0 ) {
+    return 0;
+  }
+
+  return config_getpid(  );
+}
+
+/**
+ * Appends an entry as an RFC 5424 message. The entry must be locked by the
+ * caller.
+ */
+static
+struct strbuilder *
+append_rfc_5424( struct strbuilder *builder,
+                 const struct stumpless_entry *entry,
+                 const struct target_header *header,
+                 int pid,
+                 const char *timestamp,
+                 size_t timestamp_size ) {
   builder = strbuilder_append_char( builder, '<' );
   builder = strbuilder_append_positive_int( builder, entry->prival );
   builder = strbuilder_append_string( builder, ">1 " );
   builder = strbuilder_append_buffer( builder, timestamp, timestamp_size );
   builder = strbuilder_append_char( builder, ' ' );
 
-  if( entry->hostname_length > 0 ) {
+  if( can_use_target_header( entry, header, pid ) ) {
     builder = strbuilder_append_buffer( builder,
-                                        entry->hostname,
-                                        entry->hostname_length );
-  } else {
-    builder = strbuilder_append_hostname( builder );
-  }
+                                        header->segment,
+                                        header->segment_length );
 
-  builder = strbuilder_append_char( builder, ' ' );
-  builder = strbuilder_append_app_name( builder, entry );
-  builder = strbuilder_append_char( builder, ' ' );
-  if( target->options & STUMPLESS_OPTION_PID ) {
-    if( entry->procid_length > 0 ) {
-      builder = strbuilder_append_buffer( builder,
-                                          entry->procid,
-                                          entry->procid_length );
+  } else {
+    builder = append_hostname( builder, entry, header );
+    builder = strbuilder_append_char( builder, ' ' );
+    builder = strbuilder_append_app_name( builder, entry );
+    builder = strbuilder_append_char( builder, ' ' );
+    if( header->pid != 0 ) {
+      builder = append_procid( builder, entry, pid );
     } else {
-      builder = strbuilder_append_procid( builder );
+      builder = strbuilder_append_char( builder, RFC_5424_NILVALUE );
     }
-  } else {
-    builder = strbuilder_append_char( builder, RFC_5424_NILVALUE );
+    builder = strbuilder_append_char( builder, ' ' );
   }
-  builder = strbuilder_append_char( builder, ' ' );
+
   builder = strbuilder_append_msgid( builder, entry );
   builder = strbuilder_append_char( builder, ' ' );
   builder = strbuilder_append_structured_data( builder, entry );
@@ -76,9 +303,364 @@ format_entry( const struct stumpless_entry *entry,
     builder = strbuilder_append_message( builder, entry );
   }
 
+  return builder;
+}
+
+/**
+ * Appends an entry as an RFC 3164 message. The timestamp is taken from the
+ * RFC 5424 timestamp, and so is in UTC unless the entry kept the time of a
+ * received message, in which case it is the time as the sender wrote it.
+ * Structured data is not included. The entry must be locked by the caller.
+ */
+static
+struct strbuilder *
+append_rfc_3164( struct strbuilder *builder,
+                 const struct stumpless_entry *entry,
+                 const struct target_header *header,
+                 int pid,
+                 const char *timestamp,
+                 size_t timestamp_size ) {
+  int month = 0;
+
+  builder = strbuilder_append_char( builder, '<' );
+  builder = strbuilder_append_positive_int( builder, entry->prival );
+  builder = strbuilder_append_char( builder, '>' );
+
+  // the RFC 5424 timestamp is of the form YYYY-MM-DDThh:mm:ss.ssssssZ
+  if( timestamp_size >= 19 && timestamp[4] == '-' ) {
+    month = ( timestamp[5] - '0' ) * 10 + ( timestamp[6] - '0' );
+  }
+
+  if( month >= 1 && month <= 12 ) {
+    builder = strbuilder_append_string( builder, month_names[month - 1] );
+    builder = strbuilder_append_char( builder, ' ' );
+    builder = strbuilder_append_char( builder,
+                                      timestamp[8] == '0' ? ' ' : timestamp[8] );
+    builder = strbuilder_append_char( builder, timestamp[9] );
+    builder = strbuilder_append_char( builder, ' ' );
+    builder = strbuilder_append_buffer( builder, timestamp + 11, 8 );
+  } else {
+    builder = strbuilder_append_buffer( builder, timestamp, timestamp_size );
+  }
+
+  builder = strbuilder_append_char( builder, ' ' );
+  builder = append_hostname( builder, entry, header );
+  builder = strbuilder_append_char( builder, ' ' );
+
+  if( !is_nil( entry->app_name, entry->app_name_length ) ) {
+    builder = strbuilder_append_app_name( builder, entry );
+    if( header->pid != 0 ) {
+      builder = strbuilder_append_char( builder, '[' );
+      builder = append_procid( builder, entry, pid );
+      builder = strbuilder_append_char( builder, ']' );
+    }
+    builder = strbuilder_append_string( builder, ": " );
+  }
+
+  if( entry->message_length > 0 ) {
+    builder = strbuilder_append_message( builder, entry );
+  }
+
+  return builder;
+}
+
+/**
+ * Appends an entry as a single line JSON object. The entry must be locked by
+ * the caller.
+ */
+static
+struct strbuilder *
+append_json_lines( struct strbuilder *builder,
+                   const struct stumpless_entry *entry,
+                   const struct target_header *header,
+                   int pid,
+                   const char *timestamp,
+                   size_t timestamp_size ) {
+  size_t i;
+  size_t j;
+  const struct stumpless_element *element;
+  const struct stumpless_param *param;
+
+  builder = strbuilder_append_string( builder, "{\"facility\":" );
+  builder = strbuilder_append_positive_int( builder, entry->prival >> 3 );
+  builder = strbuilder_append_string( builder, ",\"severity\":" );
+  builder = strbuilder_append_positive_int( builder, entry->prival & 0x7 );
+
+  if( !is_nil( timestamp, timestamp_size ) ) {
+    builder = append_json_member( builder,
+                                  "timestamp",
+                                  timestamp,
+                                  timestamp_size );
+  }
+
+  if( entry->hostname_length > 0 ) {
+    builder = append_json_member( builder,
+                                  "hostname",
+                                  entry->hostname,
+                                  entry->hostname_length );
+  } else if( !is_nil( header->segment, header->hostname_length ) ) {
+    builder = append_json_member( builder,
+                                  "hostname",
+                                  header->segment,
+                                  header->hostname_length );
+  }
+
+  if( !is_nil( entry->app_name, entry->app_name_length ) ) {
+    builder = append_json_member( builder,
+                                  "app_name",
+                                  entry->app_name,
+                                  entry->app_name_length );
+  }
+
+  if( header->pid != 0 ) {
+    builder = strbuilder_append_string( builder, ",\"procid\":\"" );
+    builder = append_procid( builder, entry, pid );
+    builder = strbuilder_append_char( builder, '"' );
+  }
+
+  if( !is_nil( entry->msgid, entry->msgid_length ) ) {
+    builder = append_json_member( builder,
+                                  "msgid",
+                                  entry->msgid,
+                                  entry->msgid_length );
+  }
+
+  if( entry->element_count > 0 ) {
+    builder = strbuilder_append_string( builder, ",\"structured_data\":{" );
+
+    for( i = 0; i < entry->element_count; i++ ) {
+      element = entry->elements[i];
+
+      if( i > 0 ) {
+        builder = strbuilder_append_char( builder, ',' );
+      }
+      builder = append_json_string( builder,
+                                    element->name,
+                                    element->name_length );
+      builder = strbuilder_append_string( builder, ":{" );
+
+      for( j = 0; j < element->param_count; j++ ) {
+        param = element->params[j];
+
+        if( j > 0 ) {
+          builder = strbuilder_append_char( builder, ',' );
+        }
+        builder = append_json_string( builder,
+                                      param->name,
+                                      param->name_length );
+        builder = strbuilder_append_char( builder, ':' );
+        builder = append_json_string( builder,
+                                      param->value,
+                                      param->value_length );
+      }
+
+      builder = strbuilder_append_char( builder, '}' );
+    }
+
+    builder = strbuilder_append_char( builder, '}' );
+  }
+
+  if( entry->message_length > 0 ) {
+    builder = append_json_member( builder,
+                                  "message",
+                                  entry->message,
+                                  entry->message_length );
+  }
+
+  return strbuilder_append_char( builder, '}' );
+}
+
+/**
+ * Appends an entry as a line of logfmt pairs. Params are written with keys of
+ * the form `element.param`. The entry must be locked by the caller.
+ */
+static
+struct strbuilder *
+append_logfmt( struct strbuilder *builder,
+               const struct stumpless_entry *entry,
+               const struct target_header *header,
+               int pid,
+               const char *timestamp,
+               size_t timestamp_size ) {
+  size_t i;
+  size_t j;
+  const struct stumpless_element *element;
+  const struct stumpless_param *param;
+
+  builder = strbuilder_append_string( builder, "time=" );
+  builder = append_logfmt_value( builder, timestamp, timestamp_size );
+
+  if( entry->hostname_length > 0 ) {
+    builder = append_logfmt_pair( builder,
+                                  "host",
+                                  entry->hostname,
+                                  entry->hostname_length );
+  } else if( !is_nil( header->segment, header->hostname_length ) ) {
+    builder = append_logfmt_pair( builder,
+                                  "host",
+                                  header->segment,
+                                  header->hostname_length );
+  }
+
+  if( !is_nil( entry->app_name, entry->app_name_length ) ) {
+    builder = append_logfmt_pair( builder,
+                                  "app",
+                                  entry->app_name,
+                                  entry->app_name_length );
+  }
+
+  if( header->pid != 0 ) {
+    builder = strbuilder_append_string( builder, " procid=" );
+    builder = append_procid( builder, entry, pid );
+  }
+
+  if( !is_nil( entry->msgid, entry->msgid_length ) ) {
+    builder = append_logfmt_pair( builder,
+                                  "msgid",
+                                  entry->msgid,
+                                  entry->msgid_length );
+  }
+
+  builder = strbuilder_append_string( builder, " facility=" );
+  builder = strbuilder_append_string( builder,
+                                      facility_names[entry->prival >> 3] );
+  builder = strbuilder_append_string( builder, " level=" );
+  builder = strbuilder_append_string( builder,
+                                      severity_names[entry->prival & 0x7] );
+
+  for( i = 0; i < entry->element_count; i++ ) {
+    element = entry->elements[i];
+
+    for( j = 0; j < element->param_count; j++ ) {
+      param = element->params[j];
+
+      builder = strbuilder_append_char( builder, ' ' );
+      builder = strbuilder_append_buffer( builder,
+                                          element->name,
+                                          element->name_length );
+      builder = strbuilder_append_char( builder, '.' );
+      builder = strbuilder_append_buffer( builder,
+                                          param->name,
+                                          param->name_length );
+      builder = strbuilder_append_char( builder, '=' );
+      builder = append_logfmt_value( builder,
+                                     param->value,
+                                     param->value_length );
+    }
+  }
+
+  if( entry->message_length > 0 ) {
+    builder = append_logfmt_pair( builder,
+                                  "msg",
+                                  entry->message,
+                                  entry->message_length );
+  }
+
+  return builder;
+}
+
+struct strbuilder *
+append_formatted_entry( struct strbuilder *builder,
+                        const struct stumpless_entry *entry,
+                        const struct target_header *header,
+                        int pid,
+                        int *prival ) {
+  char now[RFC_5424_TIMESTAMP_BUFFER_SIZE];
+  const char *timestamp = now;
+  size_t timestamp_size;
+
+  config_probe( FORMAT_START );
+
+  // do this as soon as possible to be closer to invocation
+  config_probe( TIMESTAMP_START );
+  timestamp_size = config_get_now( now );
+  config_probe( TIMESTAMP_END );
+
+  lock_entry( entry );
+
+  // entries loaded from received messages keep their original time, except
+  // that RFC 3164 has no NILVALUE, so the current time is used in its place
+  if( entry->timestamp_length > 0
+      && !( header->format == STUMPLESS_FORMAT_RFC_3164
+            && is_nil( entry->timestamp, entry->timestamp_length ) ) ) {
+    timestamp = entry->timestamp;
+    timestamp_size = entry->timestamp_length;
+  }
+
+  if( prival ) {
+    *prival = entry->prival;
+  }
+
+  switch( header->format ) {
+
+    case STUMPLESS_FORMAT_RFC_3164:
+      builder = append_rfc_3164( builder,
+                                 entry,
+                                 header,
+                                 pid,
+                                 timestamp,
+                                 timestamp_size );
+      break;
+
+    case STUMPLESS_FORMAT_JSON_LINES:
+      builder = append_json_lines( builder,
+                                   entry,
+                                   header,
+                                   pid,
+                                   timestamp,
+                                   timestamp_size );
+      break;
+
+    case STUMPLESS_FORMAT_LOGFMT:
+      builder = append_logfmt( builder,
+                               entry,
+                               header,
+                               pid,
+                               timestamp,
+                               timestamp_size );
+      break;
+
+    case STUMPLESS_FORMAT_BINARY:
+      builder = append_binary_record( builder,
+                                      entry,
+                                      header,
+                                      pid,
+                                      timestamp,
+                                      timestamp_size );
+      break;
+
+    default:
+      builder = append_rfc_5424( builder,
+                                 entry,
+                                 header,
+                                 pid,
+                                 timestamp,
+                                 timestamp_size );
+
+  }
+
   builder = strbuilder_append_char( builder, '\n' );
 
   unlock_entry( entry );
 
+  config_probe( FORMAT_END );
+
   return builder;
 }
+
+struct strbuilder *
+format_entry( const struct stumpless_entry *entry,
+              const struct stumpless_target *target ) {
+  struct target_header header;
+  int pid;
+
+  // the target is never locked while an entry is locked
+  read_target_header( target, &header );
+  pid = get_header_pid( &header );
+
+  return append_formatted_entry( strbuilder_new(  ),
+                                 entry,
+                                 &header,
+                                 pid,
+                                 NULL );
+}
@@ -56,6 +56,7 @@ stumpless_free_thread( void ) {
   clear_error(  );
 
   config_journald_free_thread(  );
+  entry_free_thread(  );
   target_free_thread(  );
 }
 
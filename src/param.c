@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
 #include <stumpless/param.h>
@@ -29,6 +30,83 @@
 #include "private/strhelper.h"
 #include "private/validate.h"
 
+/**
+ * Swaps in a new value for a param, freeing the old value if the param owned
+ * it.
+ */
+static
+void
+replace_param_value( struct stumpless_param *param,
+                     const char *new_value,
+                     size_t new_value_length,
+                     bool borrowed ) {
+  const char *old_value;
+  bool old_borrowed;
+
+  lock_param( param );
+  old_value = param->value;
+  old_borrowed = param->value_borrowed;
+  param->value = ( char * ) new_value;
+  param->value_length = new_value_length;
+  param->value_borrowed = borrowed;
+  unlock_param( param );
+
+  if( !old_borrowed ) {
+    free_mem( old_value );
+  }
+}
+
+/**
+ * Creates a new param, either copying the value or borrowing it as requested.
+ */
+static
+struct stumpless_param *
+new_param( const char *name,
+           size_t name_length,
+           const char *value,
+           size_t value_length,
+           bool borrow_value ) {
+  struct stumpless_param *param;
+  struct stumpless_param *result;
+
+  VALIDATE_ARG_NOT_NULL( name );
+  VALIDATE_ARG_NOT_NULL( value );
+
+  if( unlikely( !validate_param_name_buf( name, name_length ) ) ) {
+    return NULL;
+  }
+
+  if( unlikely( !validate_param_value( value, value_length ) ) ) {
+    return NULL;
+  }
+
+  clear_error(  );
+
+  param = alloc_mem( sizeof( *param ) );
+  if( !param ) {
+    return NULL;
+  }
+
+  if( borrow_value ) {
+    result = unchecked_load_param_borrowed( param,
+                                            name,
+                                            name_length,
+                                            value,
+                                            value_length );
+  } else {
+    result = unchecked_load_param( param,
+                                   name,
+                                   name_length,
+                                   value,
+                                   value_length );
+  }
+  if( !result ) {
+    free_mem( param );
+  }
+
+  return result;
+}
+
 struct stumpless_param *
 stumpless_copy_param( const struct stumpless_param *param ) {
   struct stumpless_param *result;
@@ -36,7 +114,10 @@ stumpless_copy_param( const struct stumpless_param *param ) {
   VALIDATE_ARG_NOT_NULL( param );
 
   lock_param( param );
-  result = stumpless_new_param( param->name, param->value );
+  result = stumpless_new_param_buf( param->name,
+                                    param->name_length,
+                                    param->value,
+                                    param->value_length );
   unlock_param( param );
 
   return result;
@@ -49,7 +130,9 @@ stumpless_destroy_param( const struct stumpless_param *param ) {
   }
 
   config_destroy_cached_mutex( param->mutex );
-  free_mem( param->value );
+  if( !param->value_borrowed ) {
+    free_mem( param->value );
+  }
   free_mem( param );
 }
 
@@ -108,39 +191,38 @@ stumpless_load_param( struct stumpless_param *param,
   }
 
   clear_error(  );
-  return unchecked_load_param( param, name, name_length, value );
+  return unchecked_load_param( param,
+                               name,
+                               name_length,
+                               value,
+                               strlen( value ) );
 }
 
 struct stumpless_param *
 stumpless_new_param( const char *name, const char *value ) {
-  size_t name_length;
-  struct stumpless_param *param;
-  struct stumpless_param *result;
-
   VALIDATE_ARG_NOT_NULL( name );
   VALIDATE_ARG_NOT_NULL( value );
 
-  if( unlikely( !validate_param_name( name, &name_length ) ) ) {
-    return NULL;
-  }
-
-  if( unlikely( !validate_param_value( value, strlen(value) ) ) ) {
-    return NULL;
-  }
-
-  clear_error(  );
-
-  param = alloc_mem( sizeof( *param ) );
-  if( !param ) {
-    return NULL;
-  }
+  return stumpless_new_param_buf( name,
+                                  strlen( name ),
+                                  value,
+                                  strlen( value ) );
+}
 
-  result = unchecked_load_param( param, name, name_length, value );
-  if( !result ) {
-    free_mem( param );
-  }
+struct stumpless_param *
+stumpless_new_param_borrowed( const char *name,
+                              size_t name_length,
+                              const char *value,
+                              size_t value_length ) {
+  return new_param( name, name_length, value, value_length, true );
+}
 
-  return result;
+struct stumpless_param *
+stumpless_new_param_buf( const char *name,
+                         size_t name_length,
+                         const char *value,
+                         size_t value_length ) {
+  return new_param( name, name_length, value, value_length, false );
 }
 
 struct stumpless_param *
@@ -210,6 +292,8 @@ stumpless_new_param_from_string( const char *string ) {
   memcpy( param->value, value, value_len - 1 );
   param->value[value_len-1] = '\0';
   param->value_length = value_len - 1;
+  param->value_borrowed = false;
+  param->owner = NULL;
 
   clear_error();
   return param;
@@ -221,19 +305,28 @@ fail:
 
 struct stumpless_param *
 stumpless_set_param_name( struct stumpless_param *param, const char *name ) {
-  size_t new_size;
+  VALIDATE_ARG_NOT_NULL( param );
+  VALIDATE_ARG_NOT_NULL( name );
+
+  return stumpless_set_param_name_buf( param, name, strlen( name ) );
+}
 
+struct stumpless_param *
+stumpless_set_param_name_buf( struct stumpless_param *param,
+                              const char *name,
+                              size_t name_length ) {
   VALIDATE_ARG_NOT_NULL( param );
   VALIDATE_ARG_NOT_NULL( name );
 
-  if( unlikely( !validate_param_name( name, &new_size ) ) ) {
+  if( unlikely( !validate_param_name_buf( name, name_length ) ) ) {
     goto fail;
   }
 
   lock_param( param );
-  param->name_length = new_size;
-  memcpy( param->name, name, new_size );
-  param->name[new_size] = '\0';
+  param->name_length = name_length;
+  memcpy( param->name, name, name_length );
+  param->name[name_length] = '\0';
+  config_reset_journald_param( param );
   unlock_param( param );
 
   clear_error(  );
@@ -245,34 +338,49 @@ fail:
 
 struct stumpless_param *
 stumpless_set_param_value( struct stumpless_param *param, const char *value ) {
+  VALIDATE_ARG_NOT_NULL( param );
+  VALIDATE_ARG_NOT_NULL( value );
+
+  return stumpless_set_param_value_buf( param, value, strlen( value ) );
+}
+
+struct stumpless_param *
+stumpless_set_param_value_buf( struct stumpless_param *param,
+                               const char *value,
+                               size_t value_length ) {
   char *new_value;
-  size_t new_size;
-  const char *old_value;
 
   VALIDATE_ARG_NOT_NULL( param );
   VALIDATE_ARG_NOT_NULL( value );
 
-  if( unlikely( !validate_param_value( value, strlen(value) ) ) ) {
-    goto fail;
+  if( unlikely( !validate_param_value( value, value_length ) ) ) {
+    return NULL;
   }
 
-  new_value = copy_cstring_with_length( value, &new_size );
+  new_value = copy_cstring_length( value, value_length );
   if( !new_value ) {
-    goto fail;
+    return NULL;
   }
 
-  lock_param( param );
-  old_value = param->value;
-  param->value = new_value;
-  param->value_length = new_size;
-  unlock_param( param );
-
-  free_mem( old_value );
+  replace_param_value( param, new_value, value_length, false );
   clear_error(  );
   return param;
+}
 
-fail:
-  return NULL;
+struct stumpless_param *
+stumpless_set_param_value_borrowed( struct stumpless_param *param,
+                                    const char *value,
+                                    size_t value_length ) {
+  VALIDATE_ARG_NOT_NULL( param );
+  VALIDATE_ARG_NOT_NULL( value );
+
+  if( unlikely( !validate_param_value( value, value_length ) ) ) {
+    return NULL;
+  }
+
+  replace_param_value( param, value, value_length, true );
+  clear_error(  );
+  return param;
 }
 
 const char *
@@ -325,7 +433,9 @@ stumpless_unload_param( const struct stumpless_param *param ) {
   }
 
   config_destroy_cached_mutex( param->mutex );
-  free_mem( param->value );
+  if( !param->value_borrowed ) {
+    free_mem( param->value );
+  }
 }
 
 /* private functions */
@@ -336,18 +446,57 @@ lock_param( const struct stumpless_param *param ) {
 }
 
 struct stumpless_param *
-unchecked_load_param( struct stumpless_param *param,
-                      const char *name,
-                      size_t name_length,
-                      const char *value ) {
-  param->value = copy_cstring_with_length( value, &( param->value_length ) );
-  if( !param->value ) {
-    goto fail_value;
+reload_param( struct stumpless_param *param,
+              const char *name,
+              size_t name_length,
+              const char *value,
+              size_t value_length ) {
+  char *new_value;
+
+  lock_param( param );
+
+  if( param->value_borrowed || value_length > param->value_length ) {
+    new_value = alloc_mem( value_length + 1 );
+    if( !new_value ) {
+      unlock_param( param );
+      return NULL;
+    }
+
+    if( !param->value_borrowed ) {
+      free_mem( param->value );
+    }
+
+    param->value = new_value;
+    param->value_borrowed = false;
   }
 
+  memcpy( param->value, value, value_length );
+  param->value[value_length] = '\0';
+  param->value_length = value_length;
+
+  if( param->name_length != name_length
+      || memcmp( param->name, name, name_length ) != 0 ) {
+    memcpy( param->name, name, name_length );
+    param->name[name_length] = '\0';
+    param->name_length = name_length;
+    config_reset_journald_param( param );
+  }
+
+  unlock_param( param );
+  return param;
+}
+
+/**
+ * Loads the name and mutex of a param that already has its value set.
+ */
+static
+struct stumpless_param *
+load_param_name( struct stumpless_param *param,
+                 const char *name,
+                 size_t name_length ) {
   config_assign_cached_mutex( param->mutex );
   if( !config_check_mutex_valid( param->mutex ) ) {
-    goto fail_mutex;
+    return NULL;
   }
 
   param->name_length = name_length;
@@ -357,12 +506,42 @@ unchecked_load_param( struct stumpless_param *param,
   config_init_journald_param( param );
 
   return param;
+}
 
-fail_mutex:
-  free_mem( param->value );
+struct stumpless_param *
+unchecked_load_param( struct stumpless_param *param,
+                      const char *name,
+                      size_t name_length,
+                      const char *value,
+                      size_t value_length ) {
+  param->value = copy_cstring_length( value, value_length );
+  if( !param->value ) {
+    return NULL;
+  }
+  param->value_length = value_length;
+  param->value_borrowed = false;
+  param->owner = NULL;
 
-fail_value:
-  return NULL;
+  if( !load_param_name( param, name, name_length ) ) {
+    free_mem( param->value );
+    return NULL;
+  }
+
+  return param;
+}
+
+struct stumpless_param *
+unchecked_load_param_borrowed( struct stumpless_param *param,
+                               const char *name,
+                               size_t name_length,
+                               const char *value,
+                               size_t value_length ) {
+  param->value = ( char * ) value;
+  param->value_length = value_length;
+  param->value_borrowed = true;
+  param->owner = NULL;
+
+  return load_param_name( param, name, name_length );
 }
 
 void
@@ -0,0 +1,810 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <stumpless/element.h>
+#include <stumpless/entry.h>
+#include <stumpless/param.h>
+#include <stumpless/parse.h>
+#include "private/config/wrapper/journald.h"
+#include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/thread_safety.h"
+#include "private/config/wrapper/wel.h"
+#include "private/element.h"
+#include "private/entry.h"
+#include "private/error.h"
+#include "private/formatter.h"
+#include "private/memory.h"
+#include "private/severity.h"
+#include "private/validate.h"
+
+/** The number of bytes in a timestamp up to the fractional seconds. */
+#define TIMESTAMP_SECONDS_LENGTH 19
+
+/** The most digits allowed in the fractional seconds of a timestamp. */
+#define MAX_SECFRAC_LENGTH 6
+
+/** A part of the message being parsed. */
+struct field {
+  const char *start;
+  size_t length;
+};
+
+static
+bool
+is_digit( char c ) {
+  return c >= '0' && c <= '9';
+}
+
+static
+bool
+is_printable( char c ) {
+  return c >= 33 && c <= 126;
+}
+
+static
+bool
+is_name_char( char c ) {
+  return is_printable( c ) && c != '=' && c != ']' && c != '"';
+}
+
+static
+bool
+is_escaped_char( char c ) {
+  return c == '"' || c == '\\' || c == ']';
+}
+
+/**
+ * Reads two digits at the given position, which must be in bounds, checking
+ * that the value is no more than max.
+ */
+static
+bool
+read_two_digits( const char *pos, int max, int *value ) {
+  if( !is_digit( pos[0] ) || !is_digit( pos[1] ) ) {
+    return false;
+  }
+
+  *value = ( pos[0] - '0' ) * 10 + ( pos[1] - '0' );
+  return *value <= max;
+}
+
+/**
+ * Moves past the space after a field, raising the given error if there is not
+ * one.
+ */
+static
+const char *
+skip_space( const char *pos, const char *end, const char *error_message ) {
+  if( pos >= end || *pos != ' ' ) {
+    raise_invalid_encoding( error_message );
+    return NULL;
+  }
+
+  return pos + 1;
+}
+
+/**
+ * Parses the PRI and VERSION at the start of the message.
+ */
+static
+const char *
+parse_pri_and_version( const char *pos, const char *end, int *prival ) {
+  const char *digits_end;
+
+  if( pos >= end || *pos != '<' ) {
+    goto fail_pri;
+  }
+  pos++;
+
+  *prival = 0;
+  digits_end = pos + 3 < end ? pos + 3 : end;
+  while( pos < digits_end && is_digit( *pos ) ) {
+    *prival = *prival * 10 + ( *pos - '0' );
+    pos++;
+  }
+
+  if( pos >= end
+      || *pos != '>'
+      || pos[-1] == '<'
+      || *prival > RFC_5424_MAX_PRIVAL ) {
+    goto fail_pri;
+  }
+  pos++;
+
+  // this is the only version that exists
+  if( pos >= end || *pos != '1' ) {
+    raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "version" ) );
+    return NULL;
+  }
+
+  return skip_space( pos + 1, end, L10N_FORMAT_ERROR_MESSAGE( "version" ) );
+
+fail_pri:
+  raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "PRI" ) );
+  return NULL;
+}
+
+/**
+ * Parses a timestamp, which is either a NILVALUE or a date and time with an
+ * optional fraction of a second and a time zone offset.
+ */
+static
+const char *
+parse_timestamp( const char *pos, const char *end, struct field *timestamp ) {
+  const char *start = pos;
+  const char *secfrac_end;
+  int value;
+
+  if( pos < end && *pos == RFC_5424_NILVALUE ) {
+    timestamp->start = NULL;
+    timestamp->length = 0;
+    return skip_space( pos + 1,
+                       end,
+                       L10N_FORMAT_ERROR_MESSAGE( "timestamp" ) );
+  }
+
+  // the shortest timestamp has a single 'Z' after the seconds
+  if( end - pos < TIMESTAMP_SECONDS_LENGTH + 1
+      || !is_digit( pos[0] ) || !is_digit( pos[1] )
+      || !read_two_digits( pos + 2, 99, &value )
+      || pos[4] != '-'
+      || !read_two_digits( pos + 5, 12, &value ) || value == 0
+      || pos[7] != '-'
+      || !read_two_digits( pos + 8, 31, &value ) || value == 0
+      || pos[10] != 'T'
+      || !read_two_digits( pos + 11, 23, &value )
+      || pos[13] != ':'
+      || !read_two_digits( pos + 14, 59, &value )
+      || pos[16] != ':'
+      || !read_two_digits( pos + 17, 59, &value ) ) {
+    goto fail;
+  }
+  pos += TIMESTAMP_SECONDS_LENGTH;
+
+  if( *pos == '.' ) {
+    pos++;
+    secfrac_end = pos;
+    while( secfrac_end < end && is_digit( *secfrac_end ) ) {
+      secfrac_end++;
+    }
+
+    if( secfrac_end == pos || secfrac_end - pos > MAX_SECFRAC_LENGTH ) {
+      goto fail;
+    }
+    pos = secfrac_end;
+  }
+
+  if( pos < end && *pos == 'Z' ) {
+    pos++;
+
+  } else if( end - pos >= 6
+             && ( *pos == '+' || *pos == '-' )
+             && read_two_digits( pos + 1, 23, &value )
+             && pos[3] == ':'
+             && read_two_digits( pos + 4, 59, &value ) ) {
+    pos += 6;
+
+  } else {
+    goto fail;
+  }
+
+  timestamp->start = start;
+  timestamp->length = pos - start;
+  return skip_space( pos, end, L10N_FORMAT_ERROR_MESSAGE( "timestamp" ) );
+
+fail:
+  raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "timestamp" ) );
+  return NULL;
+}
+
+/**
+ * Parses one of the hostname, app name, procid, or msgid, which are made of
+ * printable ASCII characters and followed by a space.
+ */
+static
+const char *
+parse_header_field( const char *pos,
+                    const char *end,
+                    size_t max_length,
+                    const char *error_message,
+                    struct field *field ) {
+  const char *start = pos;
+
+  while( pos < end && is_printable( *pos ) ) {
+    pos++;
+  }
+
+  field->start = start;
+  field->length = pos - start;
+
+  if( field->length > max_length ) {
+    raise_argument_too_big( L10N_STRING_TOO_LONG_ERROR_MESSAGE,
+                            field->length,
+                            L10N_STRING_LENGTH_ERROR_CODE_TYPE );
+    return NULL;
+  }
+
+  if( field->length == 0 ) {
+    raise_invalid_encoding( error_message );
+    return NULL;
+  }
+
+  return skip_space( pos, end, error_message );
+}
+
+/**
+ * Parses an SD-NAME, which is either an SD-ID or a PARAM-NAME.
+ */
+static
+const char *
+parse_sd_name( const char *pos,
+               const char *end,
+               size_t max_length,
+               struct field *name ) {
+  const char *start = pos;
+
+  while( pos < end && is_name_char( *pos ) ) {
+    pos++;
+  }
+
+  name->start = start;
+  name->length = pos - start;
+
+  if( name->length > max_length ) {
+    raise_argument_too_big( L10N_STRING_TOO_LONG_ERROR_MESSAGE,
+                            name->length,
+                            L10N_STRING_LENGTH_ERROR_CODE_TYPE );
+    return NULL;
+  }
+
+  if( name->length == 0 ) {
+    raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "structured data" ) );
+    return NULL;
+  }
+
+  return pos;
+}
+
+/**
+ * Finds the closing quote of a param value, counting the number of bytes the
+ * value has once its escapes are removed. Backslashes that do not escape a
+ * character are kept as they are, as RFC 5424 requires. A ']' does not need to
+ * be escaped here, as a quoted value cannot end the element.
+ */
+static
+const char *
+parse_param_value( const char *pos,
+                   const char *end,
+                   struct field *value,
+                   size_t *unescaped_length ) {
+  size_t escape_count = 0;
+
+  value->start = pos;
+  while( pos < end && *pos != '"' ) {
+    if( *pos == '\\' && pos + 1 < end && is_escaped_char( pos[1] ) ) {
+      escape_count++;
+      pos++;
+    }
+
+    pos++;
+  }
+
+  if( pos >= end ) {
+    raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "structured data" ) );
+    return NULL;
+  }
+
+  value->length = pos - value->start;
+  *unescaped_length = value->length - escape_count;
+
+  // escapes are all ASCII, so the raw value can be checked as it is
+  if( !validate_param_value( value->start, value->length ) ) {
+    return NULL;
+  }
+
+  return pos + 1;
+}
+
+/**
+ * Copies a field into one of the fixed size name arrays of an entry.
+ */
+static
+void
+load_name( char *name, size_t *name_length, const struct field *field ) {
+  memcpy( name, field->start, field->length );
+  name[field->length] = '\0';
+  *name_length = field->length;
+}
+
+/**
+ * Copies a value into a param, growing the value only if it is too small.
+ */
+static
+bool
+load_param_value( struct stumpless_param *param,
+                  const struct field *value,
+                  size_t unescaped_length ) {
+  char *new_value;
+  size_t i;
+  size_t j;
+
+  if( param->value_borrowed ) {
+    param->value = NULL;
+    param->value_borrowed = false;
+  }
+
+  if( !param->value || unescaped_length > param->value_length ) {
+    new_value = realloc_mem( param->value, unescaped_length + 1 );
+    if( !new_value ) {
+      return false;
+    }
+
+    param->value = new_value;
+  }
+
+  if( unescaped_length == value->length ) {
+    memcpy( param->value, value->start, value->length );
+
+  } else {
+    j = 0;
+    for( i = 0; i < value->length; i++ ) {
+      if( value->start[i] == '\\' && is_escaped_char( value->start[i + 1] ) ) {
+        i++;
+      }
+
+      param->value[j] = value->start[i];
+      j++;
+    }
+  }
+
+  param->value[unescaped_length] = '\0';
+  param->value_length = unescaped_length;
+
+  return true;
+}
+
+/**
+ * Gets the param at the given index of an element to load, adding a new one if
+ * the element does not have that many, including ones kept for reuse.
+ */
+static
+struct stumpless_param *
+get_param_to_load( struct stumpless_element *element, size_t index ) {
+  struct stumpless_param *param;
+  struct stumpless_param **new_params;
+
+  if( index < element->param_capacity ) {
+    return element->params[index];
+  }
+
+  param = alloc_mem( sizeof( *param ) );
+  if( !param ) {
+    goto fail;
+  }
+
+  param->value = NULL;
+  param->value_length = 0;
+  param->value_borrowed = false;
+  param->name_length = 0;
+  param->owner = element;
+  config_assign_cached_mutex( param->mutex );
+  if( !config_check_mutex_valid( param->mutex ) ) {
+    goto fail_mutex;
+  }
+  config_init_journald_param( param );
+
+  new_params = realloc_mem( element->params,
+                            sizeof( param )
+                              * ( element->param_capacity + 1 ) );
+  if( !new_params ) {
+    goto fail_params;
+  }
+
+  new_params[element->param_capacity] = param;
+  element->params = new_params;
+  element->param_capacity++;
+
+  return param;
+
+fail_params:
+  config_destroy_cached_mutex( param->mutex );
+fail_mutex:
+  free_mem( param );
+fail:
+  return NULL;
+}
+
+/**
+ * Gets the element at the given index of an entry to load, adding a new one if
+ * the entry does not have that many, including ones kept for reuse.
+ */
+static
+struct stumpless_element *
+get_element_to_load( struct stumpless_entry *entry, size_t index ) {
+  struct stumpless_element *element;
+  struct stumpless_element **new_elements;
+
+  if( index < entry->element_capacity ) {
+    return entry->elements[index];
+  }
+
+  element = alloc_mem( sizeof( *element ) );
+  if( !element ) {
+    goto fail;
+  }
+
+  if( !unchecked_load_element( element, "", 0 ) ) {
+    goto fail_load;
+  }
+  element->owner = entry;
+
+  new_elements = realloc_mem( entry->elements,
+                              sizeof( element )
+                                * ( entry->element_capacity + 1 ) );
+  if( !new_elements ) {
+    goto fail_elements;
+  }
+
+  new_elements[entry->element_capacity] = element;
+  entry->elements = new_elements;
+  entry->element_capacity++;
+
+  return element;
+
+fail_elements:
+  unchecked_unload_element( element );
+fail_load:
+  free_mem( element );
+fail:
+  return NULL;
+}
+
+/**
+ * Parses the params of an element into it. Any params that are not needed are
+ * kept past the end of the element's params for reuse. The element must be
+ * locked.
+ */
+static
+const char *
+load_params( struct stumpless_element *element,
+             const char *pos,
+             const char *end ) {
+  size_t param_count = 0;
+  struct field name;
+  struct field value;
+  size_t unescaped_length;
+  struct stumpless_param *param;
+
+  while( pos < end && *pos == ' ' ) {
+    pos = parse_sd_name( pos + 1, end, STUMPLESS_MAX_PARAM_NAME_LENGTH, &name );
+    if( !pos ) {
+      return NULL;
+    }
+
+    if( end - pos < 2 || pos[0] != '=' || pos[1] != '"' ) {
+      raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "structured data" ) );
+      return NULL;
+    }
+
+    pos = parse_param_value( pos + 2, end, &value, &unescaped_length );
+    if( !pos ) {
+      return NULL;
+    }
+
+    param = get_param_to_load( element, param_count );
+    if( !param ) {
+      return NULL;
+    }
+
+    lock_param( param );
+
+    if( param->name_length != name.length
+        || memcmp( param->name, name.start, name.length ) != 0 ) {
+      load_name( param->name, &param->name_length, &name );
+      config_reset_journald_param( param );
+    }
+
+    if( !load_param_value( param, &value, unescaped_length ) ) {
+      unlock_param( param );
+      return NULL;
+    }
+
+    unlock_param( param );
+
+    param_count++;
+  }
+
+  element->param_count = param_count;
+
+  return pos;
+}
+
+/**
+ * Parses an SD-ELEMENT into the element at the given index of an entry. The
+ * elements before the index must already be loaded.
+ */
+static
+const char *
+load_element( struct stumpless_entry *entry,
+              size_t index,
+              const char *pos,
+              const char *end ) {
+  struct field name;
+  struct stumpless_element *element;
+  size_t i;
+  bool duplicate;
+
+  pos = parse_sd_name( pos + 1, end, STUMPLESS_MAX_ELEMENT_NAME_LENGTH, &name );
+  if( !pos ) {
+    return NULL;
+  }
+
+  for( i = 0; i < index; i++ ) {
+    element = entry->elements[i];
+    lock_element( element );
+    duplicate = element->name_length == name.length
+                && memcmp( element->name, name.start, name.length ) == 0;
+    unlock_element( element );
+
+    if( duplicate ) {
+      raise_duplicate_element(  );
+      return NULL;
+    }
+  }
+
+  element = get_element_to_load( entry, index );
+  if( !element ) {
+    return NULL;
+  }
+
+  lock_element( element );
+
+  pos = load_params( element, pos, end );
+  if( !pos ) {
+    unlock_element( element );
+    return NULL;
+  }
+
+  if( element->name_length != name.length
+      || memcmp( element->name, name.start, name.length ) != 0 ) {
+    load_name( element->name, &element->name_length, &name );
+    config_reset_journald_element( element );
+  }
+
+  unlock_element( element );
+
+  if( pos >= end || *pos != ']' ) {
+    raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "structured data" ) );
+    return NULL;
+  }
+
+  return pos + 1;
+}
+
+/**
+ * Parses the structured data of a message into the elements of an entry. Any
+ * elements that are not needed are kept past the end of the entry's elements
+ * for reuse.
+ */
+static
+const char *
+load_structured_data( struct stumpless_entry *entry,
+                      const char *pos,
+                      const char *end ) {
+  size_t element_count = 0;
+
+  // only the elements and params created by the entry are loaded into
+  locked_reset_elements( entry );
+
+  if( pos < end && *pos == RFC_5424_NILVALUE ) {
+    pos++;
+
+  } else if( pos < end && *pos == '[' ) {
+    while( pos < end && *pos == '[' ) {
+      pos = load_element( entry, element_count, pos, end );
+      if( !pos ) {
+        return NULL;
+      }
+
+      element_count++;
+    }
+
+  } else {
+    raise_invalid_encoding( L10N_FORMAT_ERROR_MESSAGE( "structured data" ) );
+    return NULL;
+  }
+
+  entry->element_count = element_count;
+
+  return pos;
+}
+
+/**
+ * Copies the MSG into an entry, growing the message only if it is too small.
+ */
+static
+bool
+load_entry_message( struct stumpless_entry *entry,
+              const char *pos,
+              const char *end ) {
+  size_t length = end - pos;
+  char *new_message;
+
+  if( length >= 3
+      && pos[0] == '\xef' && pos[1] == '\xbb' && pos[2] == '\xbf' ) {
+    // the same UTF-8 check used for param values, which skips the BOM
+    if( !validate_param_value( pos, length ) ) {
+      return false;
+    }
+
+    pos += 3;
+    length -= 3;
+  }
+
+  if( entry->message_borrowed ) {
+    entry->message = NULL;
+    entry->message_length = 0;
+    entry->message_borrowed = false;
+  }
+
+  if( length == 0 ) {
+    free_mem( entry->message );
+    entry->message = NULL;
+    entry->message_length = 0;
+    return true;
+  }
+
+  if( !entry->message || length > entry->message_length ) {
+    new_message = realloc_mem( entry->message, length + 1 );
+    if( !new_message ) {
+      return false;
+    }
+
+    entry->message = new_message;
+  }
+
+  memcpy( entry->message, pos, length );
+  entry->message[length] = '\0';
+  entry->message_length = length;
+
+  return true;
+}
+
+struct stumpless_entry *
+stumpless_load_entry_from_rfc_5424( struct stumpless_entry *entry,
+                                    const char *message,
+                                    size_t message_length,
+                                    const char **timestamp,
+                                    size_t *timestamp_length ) {
+  const char *pos;
+  const char *end;
+  int prival;
+  struct field timestamp_field;
+  struct field hostname;
+  struct field app_name;
+  struct field procid;
+  struct field msgid;
+
+  VALIDATE_ARG_NOT_NULL( entry );
+  VALIDATE_ARG_NOT_NULL( message );
+
+  end = message + message_length;
+
+  // the header is checked before the entry is changed
+  pos = parse_pri_and_version( message, end, &prival );
+  if( !pos ) {
+    return NULL;
+  }
+
+  pos = parse_timestamp( pos, end, &timestamp_field );
+  if( !pos ) {
+    return NULL;
+  }
+
+  pos = parse_header_field( pos,
+                            end,
+                            STUMPLESS_MAX_HOSTNAME_LENGTH,
+                            L10N_FORMAT_ERROR_MESSAGE( "hostname" ),
+                            &hostname );
+  if( !pos ) {
+    return NULL;
+  }
+
+  pos = parse_header_field( pos,
+                            end,
+                            STUMPLESS_MAX_APP_NAME_LENGTH,
+                            L10N_FORMAT_ERROR_MESSAGE( "app name" ),
+                            &app_name );
+  if( !pos ) {
+    return NULL;
+  }
+
+  pos = parse_header_field( pos,
+                            end,
+                            STUMPLESS_MAX_PROCID_LENGTH,
+                            L10N_FORMAT_ERROR_MESSAGE( "procid" ),
+                            &procid );
+  if( !pos ) {
+    return NULL;
+  }
+
+  pos = parse_header_field( pos,
+                            end,
+                            STUMPLESS_MAX_MSGID_LENGTH,
+                            L10N_FORMAT_ERROR_MESSAGE( "msgid" ),
+                            &msgid );
+  if( !pos ) {
+    return NULL;
+  }
+
+  lock_entry( entry );
+
+  entry->prival = prival;
+  config_set_entry_wel_type( entry, get_severity( prival ) );
+  load_name( entry->hostname, &entry->hostname_length, &hostname );
+  load_name( entry->app_name, &entry->app_name_length, &app_name );
+  load_name( entry->procid, &entry->procid_length, &procid );
+  load_name( entry->msgid, &entry->msgid_length, &msgid );
+  if( timestamp_field.start ) {
+    load_name( entry->timestamp, &entry->timestamp_length, &timestamp_field );
+  } else {
+    entry->timestamp[0] = RFC_5424_NILVALUE;
+    entry->timestamp[1] = '\0';
+    entry->timestamp_length = 1;
+  }
+
+  pos = load_structured_data( entry, pos, end );
+  if( !pos ) {
+    goto fail;
+  }
+
+  if( pos < end ) {
+    pos = skip_space( pos,
+                      end,
+                      L10N_FORMAT_ERROR_MESSAGE( "structured data" ) );
+    if( !pos ) {
+      goto fail;
+    }
+  }
+
+  if( !load_entry_message( entry, pos, end ) ) {
+    goto fail;
+  }
+
+  unlock_entry( entry );
+
+  if( timestamp ) {
+    *timestamp = timestamp_field.start;
+  }
+
+  if( timestamp_length ) {
+    *timestamp_length = timestamp_field.length;
+  }
+
+  clear_error(  );
+  return entry;
+
+fail:
+  // a partly loaded entry is cleared so that no stale fields are left behind
+  locked_reset_entry( entry );
+  unlock_entry( entry );
+  return NULL;
+}
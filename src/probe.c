@@ -0,0 +1,63 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <stumpless/probe.h>
+#include "private/probe.h"
+#include "private/strhelper.h"
+
+static const char *probe_enum_to_string[] = {
+  STUMPLESS_FOREACH_PROBE( GENERATE_STRING )
+};
+
+static stumpless_probe_hook_func_t probe_hook = NULL;
+
+stumpless_probe_hook_func_t
+stumpless_get_probe_hook( void ) {
+  return probe_hook;
+}
+
+const char *
+stumpless_get_probe_string( enum stumpless_probe probe ) {
+  size_t probe_count;
+
+  probe_count = sizeof( probe_enum_to_string ) / sizeof( const char * );
+  if( probe >= 0 && ( size_t ) probe < probe_count ) {
+    return probe_enum_to_string[probe];
+  }
+
+  return "NO_SUCH_PROBE";
+}
+
+stumpless_probe_hook_func_t
+stumpless_set_probe_hook( stumpless_probe_hook_func_t hook ) {
+  probe_hook = hook;
+  return probe_hook;
+}
+
+/* private definitions */
+
+void
+fire_probe( enum stumpless_probe probe ) {
+  stumpless_probe_hook_func_t hook;
+
+  hook = probe_hook;
+  if( hook ) {
+    hook( probe );
+  }
+}
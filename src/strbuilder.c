@@ -109,6 +109,28 @@ strbuilder_append_char( struct strbuilder *builder, char c ) {
   return builder;
 }
 
+struct strbuilder *
+strbuilder_append_escaped_param_value( struct strbuilder *builder,
+                                      const char *value,
+                                      size_t length ) {
+  size_t run_start = 0;
+  size_t i;
+
+  for( i = 0; i < length; i++ ) {
+    if( value[i] == '"' || value[i] == '\\' || value[i] == ']' ) {
+      builder = strbuilder_append_buffer( builder,
+                                          value + run_start,
+                                          i - run_start );
+      builder = strbuilder_append_char( builder, '\\' );
+      run_start = i;
+    }
+  }
+
+  return strbuilder_append_buffer( builder,
+                                   value + run_start,
+                                   length - run_start );
+}
+
 struct strbuilder *
 strbuilder_append_positive_int( struct strbuilder *builder, int i ) {
   struct strbuilder *result = builder;
@@ -20,6 +20,7 @@
 #include <stdio.h>
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <string.h>
 #include <stumpless/config.h>
 #include <stumpless/element.h>
@@ -27,6 +28,7 @@
 #include <stumpless/error.h>
 #include <stumpless/facility.h>
 #include <stumpless/filter.h>
+#include <stumpless/format.h>
 #include <stumpless/option.h>
 #include <stumpless/param.h>
 #include <stumpless/severity.h>
@@ -36,10 +38,15 @@
 #include <stumpless/target/file.h>
 #include <stumpless/target/function.h>
 #include <stumpless/target/stream.h>
+#include "private/binary.h"
 #include "private/config.h"
 #include "private/config/wrapper/locale.h"
 #include "private/config/wrapper/chain.h"
+#include "private/config/wrapper/get_monotonic_time.h"
+#include "private/config/wrapper/gethostname.h"
+#include "private/config/wrapper/getpid.h"
 #include "private/config/wrapper/open_default_target.h"
+#include "private/config/wrapper/probe.h"
 #include "private/config/wrapper/wel.h"
 #include "private/config/wrapper/journald.h"
 #include "private/config/wrapper/network_supported.h"
@@ -50,6 +57,7 @@
 #include "private/entry.h"
 #include "private/error.h"
 #include "private/facility.h"
+#include "private/filter.h"
 #include "private/formatter.h"
 #include "private/inthelper.h"
 #include "private/memory.h"
@@ -108,18 +116,19 @@ static CONFIG_THREAD_LOCAL_STORAGE bool cached_trace_valid = false;
 static
 struct stumpless_entry *
 add_trace_element( void ) {
-    if( unlikely( !unchecked_load_param( &trace_file, "file", 4, "-" ) ) ) {
+    if( unlikely( !unchecked_load_param( &trace_file, "file", 4, "-", 1 ) ) ) {
       goto fail;
     }
 
-    if( unlikely( !unchecked_load_param( &trace_line, "line", 4, "-") ) ) {
+    if( unlikely( !unchecked_load_param( &trace_line, "line", 4, "-", 1 ) ) ) {
       goto fail_line;
     }
 
     if( unlikely( !unchecked_load_param( &trace_function,
                                          "function",
                                          8,
-                                         "-" ) ) ) {
+                                         "-",
+                                         1 ) ) ) {
       goto fail_function;
     }
 
@@ -157,56 +166,173 @@ fail:
     return NULL;
 }
 
-/* public definitions */
+/**
+ * Gets the index of the latency histogram bucket that a latency falls into.
+ */
+static
+size_t
+get_latency_bucket( uint64_t latency ) {
+  size_t power = 0;
+  size_t index;
 
-const char *
-stumpless_get_target_type_string( enum stumpless_target_type target_type ){
-  size_t upper_bound;
+  if( latency < 4 ) {
+    return ( size_t ) latency;
+  }
 
-  upper_bound = sizeof( target_type_enum_to_string ) / sizeof( const char * );
-  if ( target_type >= 0 && target_type < cap_size_t_to_int( upper_bound ) ) {
-    return target_type_enum_to_string[target_type];
-  } else {
-    return "NO_SUCH_TARGET_TYPE";
+  while( ( latency >> power ) > 1 ) {
+    power++;
+  }
+
+  index = ( 4 * ( power - 1 ) ) + ( ( latency >> ( power - 2 ) ) & 3 );
+  if( index >= STUMPLESS_LATENCY_BUCKET_COUNT ) {
+    return STUMPLESS_LATENCY_BUCKET_COUNT - 1;
+  }
+
+  return index;
+}
+
+/**
+ * Gets the time at which sending entries to a target starts, for the latency
+ * histogram of the target.
+ *
+ * @param target The target the entries are being sent to.
+ *
+ * @return The current monotonic time if the latency histogram of the target is
+ * enabled, or zero without reading the clock if it is not.
+ */
+static
+uint64_t
+get_send_start( const struct stumpless_target *target ) {
+  struct target_stats *stats = target->stats;
+
+  if( !config_read_bool( &stats->latency_enabled ) ) {
+    return 0;
   }
+
+  return config_get_monotonic_ns(  );
 }
 
+/**
+ * Updates the counters of a target after an entry has been sent to it.
+ *
+ * @param target The target the entry was sent to.
+ *
+ * @param result The result of sending the entry.
+ *
+ * @param bytes The number of formatted bytes that were sent.
+ *
+ * @param start The time at which sending the entry started, as returned by
+ * get_send_start. The latency is not recorded if this is zero.
+ */
 static
 void
-close_unsupported_target( const struct stumpless_target *target ) {
-  ( void ) target;
+record_send( const struct stumpless_target *target,
+             int result,
+             size_t bytes,
+             uint64_t start ) {
+  struct target_stats *stats = target->stats;
+  uint64_t latency;
+
+  if( start != 0 ) {
+    latency = config_get_monotonic_ns(  ) - start;
+    config_add_u64( &stats->latency_counts[get_latency_bucket( latency )], 1 );
+  }
 
-  raise_target_unsupported( L10N_CLOSE_UNSUPPORTED_TARGET_ERROR_MESSAGE );
+  if( result < 0 ) {
+    config_add_u64( &stats->entries_failed, 1 );
+  } else {
+    config_add_u64( &stats->entries_sent, 1 );
+    config_add_u64( &stats->bytes_written, bytes );
+  }
 }
 
-int
-stumpless_add_entry( struct stumpless_target *target,
-                     const struct stumpless_entry *entry ) {
-  stumpless_filter_func_t filter;
-  struct strbuilder *builder = NULL;
-  size_t builder_length;
-  const char *buffer = NULL;
-  int result;
+/**
+ * Writes a formatted message to the console stream, for targets with the
+ * STUMPLESS_OPTION_CONS option that failed to send it. Any error is ignored.
+ *
+ * @param msg The formatted message.
+ *
+ * @param msg_length The length of the message.
+ */
+static
+void
+write_to_cons_stream( const char *msg, size_t msg_length ) {
   FILE *current_cons_stream;
   bool locked;
 
-  VALIDATE_ARG_NOT_NULL_INT_RETURN( target );
-  VALIDATE_ARG_NOT_NULL_INT_RETURN( entry );
+  current_cons_stream = stumpless_get_cons_stream(  );
+  if ( current_cons_stream ) {
+    do {
+      locked = config_compare_exchange_bool( &cons_stream_free, true, false );
+    } while( !locked );
 
-  if( unlikely( !target->id ) ) {
-    raise_invalid_id(  );
-    return -1;
+    fwrite( msg, sizeof( char ), msg_length, current_cons_stream );
+
+    config_write_bool( &cons_stream_free, true );
   }
+}
 
-  filter = stumpless_get_target_filter( target );
-  if( filter && !filter( target, entry ) ) {
-    return 0;
+/**
+ * Gets the binary encoder that must be held while entries are formatted with
+ * a copy of the header of a target and written.
+ *
+ * @param header A copy of the header of the target.
+ *
+ * @return The encoder of the target if it uses the binary format, and NULL
+ * otherwise.
+ */
+static
+struct binary_encoder *
+get_header_encoder( const struct target_header *header ) {
+  if( header->format != STUMPLESS_FORMAT_BINARY ) {
+    return NULL;
   }
 
+  return header->binary_encoder;
+}
+
+/**
+ * Sends an entry to a target without checking the filter of the target.
+ *
+ * @param target The target to send the entry to.
+ *
+ * @param entry The entry to send.
+ *
+ * @return A non-negative value if no error is encountered. If an error is
+ * encountered, then a negative value is returned and an error code is set
+ * appropriately.
+ */
+static
+int
+send_entry( struct stumpless_target *target,
+            const struct stumpless_entry *entry ) {
+  struct target_header header;
+  struct binary_encoder *encoder;
+  struct strbuilder *builder = NULL;
+  size_t builder_length = 0;
+  const char *buffer = NULL;
+  int pid;
+  int prival = 0;
+  int result;
+  uint64_t start;
+
+  start = get_send_start( target );
+
+  // the target is never locked while an entry is locked
+  read_target_header( target, &header );
+  pid = get_header_pid( &header );
+  encoder = get_header_encoder( &header );
+  lock_binary_encoder( encoder );
+
   if( stumpless_get_option( target, STUMPLESS_OPTION_PERROR ) ){
-    builder = format_entry( entry, target );
+    builder = append_formatted_entry( strbuilder_new(  ),
+                                      entry,
+                                      &header,
+                                      pid,
+                                      &prival );
     if( !builder ) {
-      return -1;
+      result = -1;
+      goto finish;
     }
     buffer = strbuilder_get_buffer( builder, &builder_length );
     write_to_error_stream( buffer, builder_length );
@@ -238,13 +364,20 @@ stumpless_add_entry( struct stumpless_target *target,
 
   // entry was not formatted before
   if( !buffer ){
-    builder = format_entry( entry, target );
+    builder = append_formatted_entry( strbuilder_new(  ),
+                                      entry,
+                                      &header,
+                                      pid,
+                                      &prival );
     if( !builder ) {
-      return -1;
+      result = -1;
+      goto finish;
     }
     buffer = strbuilder_get_buffer( builder, &builder_length );
   }
 
+  config_probe( SEND_START );
+
   switch ( target->type ) {
 
     case STUMPLESS_BUFFER_TARGET:
@@ -258,7 +391,8 @@ stumpless_add_entry( struct stumpless_target *target,
     case STUMPLESS_NETWORK_TARGET:
       result = config_sendto_network_target( target->id,
                                              buffer,
-                                             builder_length );
+                                             builder_length,
+                                             prival );
       break;
 
     case STUMPLESS_SOCKET_TARGET:
@@ -268,7 +402,10 @@ stumpless_add_entry( struct stumpless_target *target,
       break;
 
     case STUMPLESS_STREAM_TARGET:
-      result = sendto_stream_target( target->id, buffer, builder_length, entry );
+      result = sendto_stream_target( target->id,
+                                     buffer,
+                                     builder_length,
+                                     get_severity( prival ) );
       break;
 
     case STUMPLESS_WINDOWS_EVENT_LOG_TARGET:
@@ -282,28 +419,470 @@ stumpless_add_entry( struct stumpless_target *target,
       result = sendto_unsupported_target( target, buffer, builder_length );
   }
 
+  config_probe( SEND_END );
+
   /* STUMPLESS_OPTION_CONS: if target write fails, write to system console.
    * Important: use unchecked_ to preserve the error from the failed target.
    * Ignore any further errors; more important to return the original result.
    */
   if ( result < 0 && unchecked_get_option( target, STUMPLESS_OPTION_CONS ) ) {
-    current_cons_stream = stumpless_get_cons_stream(  );
-    if ( current_cons_stream ) {
-      do {
-        locked = config_compare_exchange_bool( &cons_stream_free, true, false );
-      } while( !locked );
+    write_to_cons_stream( buffer, builder_length );
+  }
 
-      fwrite( buffer, sizeof( char ), builder_length, current_cons_stream );
+finish:
+  unlock_binary_encoder( encoder, result );
+  record_send( target, result, builder_length, start );
+  if( builder ) {
+    strbuilder_destroy( builder );
+  }
+  return result;
+}
 
-      config_write_bool( &cons_stream_free, true );
+/**
+ * Sends an entry to a target in place of entries that were suppressed by its
+ * filter. The summary uses the default app name and msgid of the target.
+ *
+ * Any error encountered is ignored, as the entry that follows the summary is
+ * more important than the summary itself.
+ *
+ * @param target The target to send the summary to.
+ *
+ * @param prival The prival of the summary.
+ *
+ * @param message The format of the summary message, which must take the count
+ * as an unsigned long long.
+ *
+ * @param count The number of entries that were suppressed.
+ */
+static
+void
+send_summary( struct stumpless_target *target,
+              int prival,
+              const char *message,
+              uint64_t count ) {
+  struct stumpless_entry *summary;
+
+  summary = stumpless_new_entry( STUMPLESS_FACILITY_USER,
+                                 STUMPLESS_SEVERITY_NOTICE_VALUE,
+                                 NULL,
+                                 NULL,
+                                 message,
+                                 ( unsigned long long ) count );
+  if( !summary ) {
+    return;
+  }
+
+  // the summary has not been shared yet, so it does not need to be locked
+  summary->prival = prival;
+
+  lock_target( target );
+  memcpy( summary->app_name,
+          target->default_app_name,
+          target->default_app_name_length );
+  summary->app_name_length = target->default_app_name_length;
+  memcpy( summary->msgid,
+          target->default_msgid,
+          target->default_msgid_length );
+  summary->msgid_length = target->default_msgid_length;
+  unlock_target( target );
+
+  send_entry( target, summary );
+  stumpless_destroy_entry_only( summary );
+}
+
+/**
+ * Runs an entry through the filter and filter stages of a target, updating
+ * the counters of the target and sending any pending summaries of suppressed
+ * entries if it is accepted.
+ *
+ * @param target The target the entry is being added to.
+ *
+ * @param entry The entry being added.
+ *
+ * @return true if the entry should be sent to the target, false if it was
+ * filtered out.
+ */
+static
+bool
+accept_entry( struct stumpless_target *target,
+              const struct stumpless_entry *entry ) {
+  stumpless_filter_func_t filter;
+  struct target_stats *stats;
+  uint64_t suppressed;
+  int repeated_prival;
+
+  stats = target->stats;
+  config_add_u64( &stats->entries_accepted, 1 );
+
+  config_probe( FILTER_START );
+
+  filter = stumpless_get_target_filter( target );
+  if( filter && !filter( target, entry ) ) {
+    config_probe( FILTER_END );
+    config_add_u64( &stats->entries_filtered, 1 );
+    return false;
+  }
+
+  if( !run_filter_stages( target, entry ) ) {
+    config_probe( FILTER_END );
+    config_add_u64( &stats->entries_filtered, 1 );
+    return false;
+  }
+
+  config_probe( FILTER_END );
+
+  suppressed = take_repeated_entry_count( target, &repeated_prival );
+  if( unlikely( suppressed != 0 ) ) {
+    send_summary( target, repeated_prival, DEDUP_SUMMARY_MESSAGE, suppressed );
+  }
+
+  suppressed = take_suppressed_entry_count( target );
+  if( unlikely( suppressed != 0 ) ) {
+    send_summary( target,
+                  get_prival( stumpless_get_entry_facility( entry ),
+                              STUMPLESS_SEVERITY_NOTICE_VALUE ),
+                  RATE_LIMIT_SUMMARY_MESSAGE,
+                  suppressed );
+  }
+
+  return true;
+}
+
+/**
+ * Sends a group of entries to a target without checking the filter of the
+ * target. Target types that support it are sent all of the entries at once,
+ * formatted into a single buffer if they need to be, and the rest are sent
+ * each entry in turn.
+ *
+ * @param target The target to send the entries to.
+ *
+ * @param entries The entries to send.
+ *
+ * @param entry_count The number of entries in the entries array.
+ *
+ * @param results Set to the result of sending each entry.
+ *
+ * @return A non-negative value if all of the entries were sent. If an error is
+ * encountered, then a negative value is returned and an error code is set
+ * appropriately.
+ */
+static
+int
+send_entries( struct stumpless_target *target,
+              const struct stumpless_entry * const *entries,
+              size_t entry_count,
+              int *results ) {
+  struct target_header header;
+  struct binary_encoder *encoder = NULL;
+  struct strbuilder *builder = NULL;
+  size_t *ends = NULL;
+  int *severities = NULL;
+  int prival;
+  const char *buffer = NULL;
+  size_t builder_length = 0;
+  size_t msg_start;
+  size_t i;
+  int pid;
+  int result = 0;
+  uint64_t start;
+  bool formatted;
+
+  switch( target->type ) {
+    case STUMPLESS_BUFFER_TARGET:
+    case STUMPLESS_FILE_TARGET:
+    case STUMPLESS_SOCKET_TARGET:
+    case STUMPLESS_STREAM_TARGET:
+      formatted = true;
+      break;
+
+    case STUMPLESS_JOURNALD_TARGET:
+    case STUMPLESS_SQLITE3_TARGET:
+      formatted = false;
+      break;
+
+    default:
+      // the remaining types are sent one entry at a time
+      for( i = 0; i < entry_count; i++ ) {
+        results[i] = send_entry( target, entries[i] );
+        if( results[i] < 0 ) {
+          result = -1;
+        }
+      }
+      return result;
+  }
+
+  start = get_send_start( target );
+
+  if( formatted || stumpless_get_option( target, STUMPLESS_OPTION_PERROR ) ) {
+    ends = alloc_mem( sizeof( *ends ) * entry_count );
+    if( !ends ) {
+      goto fail;
+    }
+
+    if( target->type == STUMPLESS_STREAM_TARGET ) {
+      severities = alloc_mem( sizeof( *severities ) * entry_count );
+      if( !severities ) {
+        goto fail;
+      }
+    }
+
+    read_target_header( target, &header );
+    pid = get_header_pid( &header );
+    encoder = get_header_encoder( &header );
+    lock_binary_encoder( encoder );
+
+    builder = strbuilder_new(  );
+    for( i = 0; i < entry_count; i++ ) {
+      // keep the builder so that it can be destroyed if this fails
+      if( !append_formatted_entry( builder,
+                                   entries[i],
+                                   &header,
+                                   pid,
+                                   &prival ) ) {
+        goto fail;
+      }
+
+      if( severities ) {
+        severities[i] = get_severity( prival );
+      }
+
+      strbuilder_get_buffer( builder, &ends[i] );
+    }
+
+    buffer = strbuilder_get_buffer( builder, &builder_length );
+
+    if( stumpless_get_option( target, STUMPLESS_OPTION_PERROR ) ) {
+      write_to_error_stream( buffer, builder_length );
     }
   }
 
-finish:
+  config_probe( SEND_START );
+
+  switch( target->type ) {
+
+    case STUMPLESS_BUFFER_TARGET:
+      result = sendto_buffer_target_batch( target->id,
+                                           buffer,
+                                           ends,
+                                           entry_count,
+                                           results );
+      break;
+
+    case STUMPLESS_FILE_TARGET:
+      result = sendto_file_target_batch( target->id,
+                                         buffer,
+                                         ends,
+                                         entry_count,
+                                         results );
+      break;
+
+    case STUMPLESS_JOURNALD_TARGET:
+      result = config_send_entries_to_journald_target( target,
+                                                       entries,
+                                                       entry_count,
+                                                       results );
+      break;
+
+    case STUMPLESS_SOCKET_TARGET:
+      result = config_sendto_socket_target_batch( target->id,
+                                                  buffer,
+                                                  ends,
+                                                  entry_count,
+                                                  results );
+      break;
+
+    case STUMPLESS_SQLITE3_TARGET:
+      result = config_send_entries_to_sqlite3_target( target,
+                                                      entries,
+                                                      entry_count,
+                                                      results );
+      break;
+
+    default:
+      result = sendto_stream_target_batch( target->id,
+                                           buffer,
+                                           ends,
+                                           severities,
+                                           entry_count,
+                                           results );
+  }
+
+  config_probe( SEND_END );
+
+  unlock_binary_encoder( encoder, result );
+
+  msg_start = 0;
+  for( i = 0; i < entry_count; i++ ) {
+    if( formatted
+        && results[i] < 0
+        && unchecked_get_option( target, STUMPLESS_OPTION_CONS ) ) {
+      write_to_cons_stream( buffer + msg_start, ends[i] - msg_start );
+    }
+
+    record_send( target, results[i], ends ? ends[i] - msg_start : 0, start );
+    msg_start = ends ? ends[i] : 0;
+  }
+
   if( builder ) {
     strbuilder_destroy( builder );
   }
+  free_mem( severities );
+  free_mem( ends );
   return result;
+
+fail:
+  unlock_binary_encoder( encoder, -1 );
+
+  for( i = 0; i < entry_count; i++ ) {
+    results[i] = -1;
+    record_send( target, -1, 0, start );
+  }
+
+  if( builder ) {
+    strbuilder_destroy( builder );
+  }
+  free_mem( severities );
+  free_mem( ends );
+  return -1;
+}
+
+/* public definitions */
+
+const char *
+stumpless_get_target_type_string( enum stumpless_target_type target_type ){
+  size_t upper_bound;
+
+  upper_bound = sizeof( target_type_enum_to_string ) / sizeof( const char * );
+  if ( target_type >= 0 && target_type < cap_size_t_to_int( upper_bound ) ) {
+    return target_type_enum_to_string[target_type];
+  } else {
+    return "NO_SUCH_TARGET_TYPE";
+  }
+}
+
+static
+void
+close_unsupported_target( const struct stumpless_target *target ) {
+  ( void ) target;
+
+  raise_target_unsupported( L10N_CLOSE_UNSUPPORTED_TARGET_ERROR_MESSAGE );
+}
+
+int
+stumpless_add_entry( struct stumpless_target *target,
+                     const struct stumpless_entry *entry ) {
+  VALIDATE_ARG_NOT_NULL_INT_RETURN( target );
+  VALIDATE_ARG_NOT_NULL_INT_RETURN( entry );
+
+  if( unlikely( !target->id ) ) {
+    raise_invalid_id(  );
+    return -1;
+  }
+
+  if( !accept_entry( target, entry ) ) {
+    return 0;
+  }
+
+  return send_entry( target, entry );
+}
+
+int
+stumpless_add_entries( struct stumpless_target *target,
+                       const struct stumpless_entry * const *entries,
+                       size_t entry_count,
+                       int *results ) {
+  const struct stumpless_entry **accepted;
+  size_t *accepted_indices;
+  int *accepted_results;
+  size_t accepted_count = 0;
+  bool null_entry = false;
+  size_t i;
+  int result = 0;
+
+  VALIDATE_ARG_NOT_NULL_INT_RETURN( target );
+  VALIDATE_ARG_NOT_NULL_INT_RETURN( entries );
+
+  if( unlikely( !target->id ) ) {
+    raise_invalid_id(  );
+    return -1;
+  }
+
+  clear_error(  );
+
+  if( entry_count == 0 ) {
+    return 0;
+  }
+
+  accepted = alloc_mem( sizeof( *accepted ) * entry_count );
+  if( !accepted ) {
+    goto fail;
+  }
+
+  accepted_indices = alloc_mem( sizeof( *accepted_indices ) * entry_count );
+  if( !accepted_indices ) {
+    goto fail_indices;
+  }
+
+  accepted_results = alloc_mem( sizeof( *accepted_results ) * entry_count );
+  if( !accepted_results ) {
+    goto fail_results;
+  }
+
+  for( i = 0; i < entry_count; i++ ) {
+    if( !entries[i] ) {
+      null_entry = true;
+      if( results ) {
+        results[i] = -1;
+      }
+
+    } else if( !accept_entry( target, entries[i] ) ) {
+      if( results ) {
+        results[i] = 0;
+      }
+
+    } else {
+      accepted[accepted_count] = entries[i];
+      accepted_indices[accepted_count] = i;
+      accepted_count++;
+    }
+  }
+
+  if( accepted_count > 0
+      && send_entries( target,
+                       accepted,
+                       accepted_count,
+                       accepted_results ) < 0 ) {
+    result = -1;
+  }
+
+  if( results ) {
+    for( i = 0; i < accepted_count; i++ ) {
+      results[accepted_indices[i]] = accepted_results[i];
+    }
+  }
+
+  // raised last so that it is not cleared while the others are sent
+  if( null_entry ) {
+    raise_argument_empty( L10N_NULL_ARG_ERROR_MESSAGE( "entry" ) );
+    result = -1;
+  }
+
+  free_mem( accepted_results );
+  free_mem( accepted_indices );
+  free_mem( accepted );
+  return result;
+
+fail_results:
+  free_mem( accepted_indices );
+fail_indices:
+  free_mem( accepted );
+fail:
+  if( results ) {
+    for( i = 0; i < entry_count; i++ ) {
+      results[i] = -1;
+    }
+  }
+  return -1;
 }
 
 int
@@ -514,6 +1093,18 @@ unchecked_get_option( const struct stumpless_target *target, int option ) {
   return options & option;
 }
 
+unsigned long long
+stumpless_get_latency_bucket_min( size_t index ) {
+  size_t power;
+
+  if( index < 4 ) {
+    return index;
+  }
+
+  power = ( index / 4 ) + 1;
+  return ( 4ULL + ( index % 4 ) ) << ( power - 2 );
+}
+
 int
 stumpless_get_option( const struct stumpless_target *target, int option ) {
   int options;
@@ -589,6 +1180,23 @@ stumpless_get_target_filter( const struct stumpless_target *target ) {
   return filter;
 }
 
+enum stumpless_format
+stumpless_get_target_format( const struct stumpless_target *target ) {
+  enum stumpless_format format;
+
+  if( !target ) {
+    raise_argument_empty( L10N_NULL_ARG_ERROR_MESSAGE( "target" ) );
+    return STUMPLESS_FORMAT_RFC_5424;
+  }
+
+  lock_target( target );
+  format = target->format;
+  unlock_target( target );
+
+  clear_error(  );
+  return format;
+}
+
 int
 stumpless_get_target_mask( const struct stumpless_target *target ) {
   int mask;
@@ -625,6 +1233,35 @@ cleanup_and_return:
   return name_copy;
 }
 
+const struct stumpless_target *
+stumpless_get_target_stats( const struct stumpless_target *target,
+                            struct stumpless_target_stats *stats ) {
+  struct target_stats *target_stats;
+  size_t i;
+
+  VALIDATE_ARG_NOT_NULL( target );
+  VALIDATE_ARG_NOT_NULL( stats );
+
+  target_stats = target->stats;
+  stats->entries_accepted =
+    ( size_t ) config_read_u64( &target_stats->entries_accepted );
+  stats->entries_filtered =
+    ( size_t ) config_read_u64( &target_stats->entries_filtered );
+  stats->entries_sent =
+    ( size_t ) config_read_u64( &target_stats->entries_sent );
+  stats->entries_failed =
+    ( size_t ) config_read_u64( &target_stats->entries_failed );
+  stats->bytes_written =
+    ( size_t ) config_read_u64( &target_stats->bytes_written );
+  for( i = 0; i < STUMPLESS_LATENCY_BUCKET_COUNT; i++ ) {
+    stats->latency_counts[i] =
+      ( size_t ) config_read_u64( &target_stats->latency_counts[i] );
+  }
+
+  clear_error(  );
+  return target;
+}
+
 struct stumpless_target *
 stumpless_open_target( struct stumpless_target *target ) {
   struct stumpless_target *result;
@@ -645,6 +1282,27 @@ stumpless_open_target( struct stumpless_target *target ) {
   return result;
 }
 
+struct stumpless_target *
+stumpless_reset_target_stats( struct stumpless_target *target ) {
+  struct target_stats *stats;
+  size_t i;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  stats = target->stats;
+  config_write_u64( &stats->entries_accepted, 0 );
+  config_write_u64( &stats->entries_filtered, 0 );
+  config_write_u64( &stats->entries_sent, 0 );
+  config_write_u64( &stats->entries_failed, 0 );
+  config_write_u64( &stats->bytes_written, 0 );
+  for( i = 0; i < STUMPLESS_LATENCY_BUCKET_COUNT; i++ ) {
+    config_write_u64( &stats->latency_counts[i], 0 );
+  }
+
+  clear_error(  );
+  return target;
+}
+
 void
 stumpless_set_cons_stream( FILE *stream ) {
   config_write_ptr( &cons_stream, stream );
@@ -684,6 +1342,7 @@ stumpless_set_option( struct stumpless_target *target, int option ) {
 
   lock_target( target );
   target->options |= option;
+  render_target_header( target );
   unlock_target( target );
 
   clear_error(  );
@@ -707,6 +1366,7 @@ stumpless_set_target_default_app_name( struct stumpless_target *target,
   lock_target( target );
   memcpy( target->default_app_name, app_name, new_length );
   target->default_app_name_length = new_length;
+  render_target_header( target );
   unlock_target( target );
 
   return target;
@@ -747,6 +1407,68 @@ stumpless_set_target_filter( struct stumpless_target *target,
   return target;
 }
 
+struct stumpless_target *
+stumpless_set_target_format( struct stumpless_target *target,
+                             enum stumpless_format format ) {
+  struct target_header *header;
+  struct binary_encoder *encoder;
+  struct binary_encoder *new_encoder = NULL;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  if( format < STUMPLESS_FORMAT_RFC_5424 || format > STUMPLESS_FORMAT_BINARY ) {
+    raise_index_out_of_bounds( L10N_INVALID_INDEX_ERROR_MESSAGE( "format" ),
+                               format );
+    return NULL;
+  }
+
+  if( format == STUMPLESS_FORMAT_BINARY ) {
+    // the encoder is never locked while the target is
+    lock_target( target );
+    encoder = ( ( struct target_header * ) target->header )->binary_encoder;
+    unlock_target( target );
+
+    if( encoder ) {
+      reset_binary_encoder( encoder );
+    } else {
+      new_encoder = new_binary_encoder(  );
+      if( !new_encoder ) {
+        return NULL;
+      }
+    }
+  }
+
+  lock_target( target );
+  header = target->header;
+  if( new_encoder && !header->binary_encoder ) {
+    header->binary_encoder = new_encoder;
+    new_encoder = NULL;
+  }
+  target->format = format;
+  render_target_header( target );
+  unlock_target( target );
+
+  // another thread set up the encoder first
+  destroy_binary_encoder( new_encoder );
+
+  clear_error(  );
+  return target;
+}
+
+struct stumpless_target *
+stumpless_set_target_latency_histogram( struct stumpless_target *target,
+                                        bool enabled ) {
+  struct target_stats *stats;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  stats = target->stats;
+  config_write_bool( &stats->latency_enabled, enabled );
+
+  clear_error(  );
+  return target;
+}
+
 struct stumpless_target *
 stumpless_set_target_mask( struct stumpless_target *target, int mask ) {
   VALIDATE_ARG_NOT_NULL( target );
@@ -933,6 +1655,7 @@ stumpless_unset_option( struct stumpless_target *target, int option ) {
 
   lock_target( target );
   target->options &= ~option;
+  render_target_header( target );
   unlock_target( target );
 
   clear_error(  );
@@ -1069,6 +1792,15 @@ void
 destroy_target( const struct stumpless_target *target ) {
   config_compare_exchange_ptr( &current_target, target, NULL );
 
+  destroy_dedup( target );
+  destroy_filter_stages( target );
+  destroy_rate_limit( target );
+  destroy_sample( target );
+  destroy_binary_encoder(
+    ( ( struct target_header * ) target->header )->binary_encoder
+  );
+  free_mem( target->header );
+  free_mem( target->stats );
   config_destroy_cached_mutex( target->mutex );
   free_mem( target->name );
   free_mem( target );
@@ -1082,6 +1814,7 @@ lock_target( const struct stumpless_target *target ) {
 struct stumpless_target *
 new_target( enum stumpless_target_type type, const char *name ) {
   struct stumpless_target *target;
+  struct target_stats *stats;
 
   target = alloc_mem( sizeof( *target ) );
   if( !target ) {
@@ -1093,6 +1826,19 @@ new_target( enum stumpless_target_type type, const char *name ) {
     goto fail_name;
   }
 
+  target->stats = alloc_mem( sizeof( struct target_stats ) );
+  if( !target->stats ) {
+    goto fail_stats;
+  }
+  stumpless_reset_target_stats( target );
+  stats = target->stats;
+  config_write_bool( &stats->latency_enabled, false );
+
+  target->header = alloc_mem( sizeof( struct target_header ) );
+  if( !target->header ) {
+    goto fail_header;
+  }
+
   config_assign_cached_mutex( target->mutex );
   if( !config_check_mutex_valid( target->mutex ) ) {
     goto fail_mutex;
@@ -1106,12 +1852,23 @@ new_target( enum stumpless_target_type type, const char *name ) {
   target->default_app_name_length = 1;
   target->default_msgid[0] = '-';
   target->default_msgid_length = 1;
+  target->format = STUMPLESS_FORMAT_RFC_5424;
   target->mask = STUMPLESS_SEVERITY_MASK_UPTO( STUMPLESS_SEVERITY_DEBUG_VALUE );
   target->filter = stumpless_mask_filter;
+  target->rate_limit = NULL;
+  target->dedup = NULL;
+  target->sample = NULL;
+  target->filter_stages = NULL;
+  ( ( struct target_header * ) target->header )->binary_encoder = NULL;
+  render_target_header( target );
 
   return target;
 
 fail_mutex:
+  free_mem( target->header );
+fail_header:
+  free_mem( target->stats );
+fail_stats:
   free_mem( target->name );
 fail_name:
   free_mem( target );
@@ -1127,6 +1884,76 @@ open_unsupported_target( struct stumpless_target *target ) {
   return NULL;
 }
 
+void
+read_target_header( const struct stumpless_target *target,
+                    struct target_header *header ) {
+  const struct target_header *source;
+
+  lock_target( target );
+  source = target->header;
+  header->hostname_length = source->hostname_length;
+  header->app_name_length = source->app_name_length;
+  header->pid = source->pid;
+  memcpy( header->segment, source->segment, source->segment_length );
+  header->segment_length = source->segment_length;
+  header->format = source->format;
+  header->binary_encoder = source->binary_encoder;
+  unlock_target( target );
+}
+
+void
+render_target_header( struct stumpless_target *target ) {
+  struct target_header *header = target->header;
+  char hostname[STUMPLESS_MAX_HOSTNAME_LENGTH + 1];
+  char digits[MAX_INT_SIZE];
+  size_t digit_count = 0;
+  char *pos;
+  int pid;
+
+  if( config_gethostname( hostname, sizeof( hostname ) ) == -1 ) {
+    hostname[0] = RFC_5424_NILVALUE;
+    header->hostname_length = 1;
+  } else {
+    hostname[sizeof( hostname ) - 1] = '\0';
+    header->hostname_length = strlen( hostname );
+  }
+
+  header->app_name_length = target->default_app_name_length;
+
+  if( target->options & STUMPLESS_OPTION_PID ) {
+    header->pid = config_getpid(  );
+  } else {
+    header->pid = 0;
+  }
+
+  // rendered by hand, as a memory failure here must not affect the setter
+  pos = header->segment;
+  memcpy( pos, hostname, header->hostname_length );
+  pos += header->hostname_length;
+  *( pos++ ) = ' ';
+  memcpy( pos, target->default_app_name, header->app_name_length );
+  pos += header->app_name_length;
+  *( pos++ ) = ' ';
+
+  pid = header->pid;
+  if( pid <= 0 ) {
+    *( pos++ ) = RFC_5424_NILVALUE;
+  } else {
+    while( pid != 0 ) {
+      digits[digit_count++] = ( char ) ( '0' + ( pid % 10 ) );
+      pid /= 10;
+    }
+
+    while( digit_count > 0 ) {
+      *( pos++ ) = digits[--digit_count];
+    }
+  }
+
+  *( pos++ ) = ' ';
+  header->segment_length = pos - header->segment;
+  header->format = target->format;
+}
+
 int
 send_entry_and_msg_to_unsupported_target( const struct stumpless_target *target,
                                           const struct stumpless_entry *entry,
@@ -1155,6 +1982,48 @@ send_entry_to_unsupported_target( const struct stumpless_target *target,
   return -1;
 }
 
+int
+send_entries_to_unsupported_target( const struct stumpless_target *target,
+                                    const struct stumpless_entry * const *entries,
+                                    size_t entry_count,
+                                    int *results ) {
+  size_t i;
+
+  ( void ) target;
+  ( void ) entries;
+
+  for( i = 0; i < entry_count; i++ ) {
+    results[i] = -1;
+  }
+
+  raise_target_unsupported(
+    L10N_SEND_ENTRY_TO_UNSUPPORTED_TARGET_ERROR_MESSAGE
+  );
+  return -1;
+}
+
+int
+sendto_batch_to_unsupported_target( const struct stumpless_target *target,
+                                    const char *msgs,
+                                    const size_t *ends,
+                                    size_t count,
+                                    int *results ) {
+  size_t i;
+
+  ( void ) target;
+  ( void ) msgs;
+  ( void ) ends;
+
+  for( i = 0; i < count; i++ ) {
+    results[i] = -1;
+  }
+
+  raise_target_unsupported(
+    L10N_SEND_MESSAGE_TO_UNSUPPORTED_TARGET_ERROR_MESSAGE
+  );
+  return -1;
+}
+
 int
 sendto_unsupported_target( const struct stumpless_target *target,
                            const char *msg,
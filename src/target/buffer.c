@@ -21,6 +21,7 @@
 #include <stumpless/target.h>
 #include <stumpless/target/buffer.h>
 #include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/probe.h"
 #include "private/config/wrapper/thread_safety.h"
 #include "private/error.h"
 #include "private/inthelper.h"
@@ -29,6 +30,62 @@
 #include "private/target/buffer.h"
 #include "private/validate.h"
 
+/**
+ * Writes a message into a buffer target, overwriting the oldest messages if
+ * there is not enough room. The buffer mutex must be held by the caller, and
+ * the message must be smaller than the buffer.
+ *
+ * @param target The buffer target to write to.
+ *
+ * @param msg The message to write.
+ *
+ * @param msg_length The length of the message, not including the newline.
+ */
+static
+void
+write_message( struct buffer_target *target,
+               const char *msg,
+               size_t msg_length ) {
+  size_t write_start;
+  size_t buffer_remaining;
+  size_t free_space_left;
+
+  write_start = target->write_position;
+  buffer_remaining = target->size - write_start;
+
+  if( buffer_remaining > msg_length ) {
+    // the entire message will fit into the buffer without wrapping around
+    memcpy( target->buffer + write_start, msg, msg_length );
+    target->write_position += msg_length + 1;
+
+  } else {
+    // we need to split the message and wrap it around to the beginning
+    memcpy( target->buffer + write_start, msg, buffer_remaining );
+    memcpy( target->buffer,
+            msg + buffer_remaining,
+            msg_length - buffer_remaining );
+    target->write_position = msg_length - buffer_remaining + 1;
+  }
+
+  target->buffer[target->write_position - 1] = '\0';
+
+  // checking to see if we have overwritten older messages and need to adjust
+  // the read position to reflect this
+  if( target->read_position > write_start ) {
+    free_space_left = target->read_position - write_start;
+  } else {
+    free_space_left = ( target->size - write_start ) + target->read_position;
+  }
+
+  if( free_space_left <= msg_length ) {
+    target->read_position = ( target->write_position + 1 ) % target->size;
+
+    if( target->buffer[target->read_position] == '\0' ) {
+      target->read_position = ( target->read_position + 1 ) % target->size;
+    }
+  }
+}
+
 void
 stumpless_close_buffer_target( const struct stumpless_target *target ) {
   if( !target ) {
@@ -149,10 +206,6 @@ int
 sendto_buffer_target( struct buffer_target *target,
                       const char *msg,
                       size_t msg_length ) {
-  size_t write_start;
-  size_t buffer_remaining;
-  size_t free_space_left;
-
   // leave off the newline
   msg_length--;
 
@@ -164,42 +217,51 @@ sendto_buffer_target( struct buffer_target *target,
   }
 
   config_lock_mutex( &target->buffer_mutex );
-  write_start = target->write_position;
-  buffer_remaining = target->size - write_start;
-
-  if( buffer_remaining > msg_length ) {
-    // the entire message will fit into the buffer without wrapping around
-    memcpy( target->buffer + write_start, msg, msg_length );
-    target->write_position += msg_length + 1;
-
-  } else {
-    // we need to split the message and wrap it around to the beginning
-    memcpy( target->buffer + write_start, msg, buffer_remaining );
-    memcpy( target->buffer,
-            msg + buffer_remaining,
-            msg_length - buffer_remaining );
-    target->write_position = msg_length - buffer_remaining + 1;
-  }
-
-  target->buffer[target->write_position - 1] = '\0';
+  config_probe( LOCK_ACQUIRED );
+  config_probe( WRITE_START );
+  write_message( target, msg, msg_length );
+  config_probe( WRITE_END );
+  config_unlock_mutex( &target->buffer_mutex );
 
-  // checking to see if we have overwritten older messages and need to adjust
-  // the read position to reflect this
-  if( target->read_position > write_start ) {
-    free_space_left = target->read_position - write_start;
-  } else {
-    free_space_left = ( target->size - write_start ) + target->read_position;
-  }
+  return cap_size_t_to_int( msg_length + 1 );
+}
 
-  if( free_space_left <= msg_length ) {
-    target->read_position = ( target->write_position + 1 ) % target->size;
+int
+sendto_buffer_target_batch( struct buffer_target *target,
+                            const char *msgs,
+                            const size_t *ends,
+                            size_t count,
+                            int *results ) {
+  size_t i;
+  size_t start = 0;
+  size_t msg_length;
+  int result = 0;
 
-    if( target->buffer[target->read_position] == '\0' ) {
-      target->read_position = ( target->read_position + 1 ) % target->size;
+  config_lock_mutex( &target->buffer_mutex );
+  config_probe( LOCK_ACQUIRED );
+  config_probe( WRITE_START );
+
+  for( i = 0; i < count; i++ ) {
+    // leave off the newline
+    msg_length = ends[i] - start - 1;
+
+    if( msg_length >= target->size ) {
+      raise_argument_too_big( L10N_BUFFER_TOO_SMALL_ERROR_MESSAGE,
+                              msg_length,
+                              L10N_MESSAGE_SIZE_ERROR_CODE_TYPE );
+      results[i] = -1;
+      result = -1;
+
+    } else {
+      write_message( target, msgs + start, msg_length );
+      results[i] = cap_size_t_to_int( msg_length + 1 );
     }
+
+    start = ends[i];
   }
 
+  config_probe( WRITE_END );
   config_unlock_mutex( &target->buffer_mutex );
 
-  return cap_size_t_to_int( msg_length + 1 );
+  return result;
 }
@@ -16,12 +16,15 @@
  * limitations under the License.
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <stumpless/config.h>
 #include <stumpless/target.h>
 #include <stumpless/target/file.h>
+#include "private/config/wrapper/compress.h"
 #include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/probe.h"
 #include "private/config/wrapper/thread_safety.h"
 #include "private/error.h"
 #include "private/inthelper.h"
@@ -60,7 +63,7 @@ stumpless_open_file_target( const char *name ) {
     goto fail;
   }
 
-  target->id = new_file_target( name );
+  target->id = new_file_target( name, "a" );
   if( !target->id ) {
     goto fail_id;
   }
@@ -74,10 +77,33 @@ fail:
   return NULL;
 }
 
+/**
+ * Writes messages to the file of a target, compressing them first if the
+ * target is compressed. The stream mutex must be held by the caller.
+ *
+ * @return true if all of the messages were written.
+ */
+static
+bool
+write_to_file( struct file_target *target,
+               const char *msg,
+               size_t msg_length ) {
+  if( target->compressor ) {
+    return config_compress_to_file( target->compressor,
+                                    target->stream,
+                                    msg,
+                                    msg_length );
+  }
+
+  return fwrite( msg, sizeof( char ), msg_length, target->stream )
+           == msg_length;
+}
+
 /* private definitions */
 
 void
 destroy_file_target( struct file_target *target ) {
+  config_destroy_file_compressor( target->compressor, target->stream );
   config_destroy_mutex( &target->stream_mutex );
   fclose( target->stream );
   free_mem( target );
@@ -89,7 +115,7 @@ file_open_default_target( void ) {
 }
 
 struct file_target *
-new_file_target( const char *filename ) {
+new_file_target( const char *filename, const char *mode ) {
   struct file_target *target;
 
   target = alloc_mem( sizeof( *target ) );
@@ -97,7 +123,8 @@ new_file_target( const char *filename ) {
     goto fail;
   }
 
-  target->stream = config_fopen( filename, "a" );
+  target->compressor = NULL;
+  target->stream = config_fopen( filename, mode );
   if( !target->stream ) {
     raise_file_open_failure(  );
     goto fail_stream;
@@ -117,19 +144,59 @@ int
 sendto_file_target( struct file_target *target,
                     const char *msg,
                     size_t msg_length ) {
-  size_t fwrite_result;
+  bool written;
 
   config_lock_mutex( &target->stream_mutex );
-  fwrite_result = fwrite( msg, sizeof( char ), msg_length, target->stream );
+  config_probe( LOCK_ACQUIRED );
+  config_probe( WRITE_START );
+  written = write_to_file( target, msg, msg_length );
+  config_probe( WRITE_END );
   config_unlock_mutex( &target->stream_mutex );
 
-  if( fwrite_result != msg_length ) {
+  if( !written ) {
     goto write_failure;
   }
 
-  return cap_size_t_to_int( fwrite_result + 1 );
+  return cap_size_t_to_int( msg_length + 1 );
 
 write_failure:
   raise_file_write_failure(  );
   return -1;
 }
+
+int
+sendto_file_target_batch( struct file_target *target,
+                          const char *msgs,
+                          const size_t *ends,
+                          size_t count,
+                          int *results ) {
+  size_t batch_length;
+  bool written;
+  size_t start = 0;
+  size_t i;
+
+  batch_length = count == 0 ? 0 : ends[count - 1];
+
+  config_lock_mutex( &target->stream_mutex );
+  config_probe( LOCK_ACQUIRED );
+  config_probe( WRITE_START );
+  written = write_to_file( target, msgs, batch_length );
+  config_probe( WRITE_END );
+  config_unlock_mutex( &target->stream_mutex );
+
+  if( !written ) {
+    raise_file_write_failure(  );
+  }
+
+  for( i = 0; i < count; i++ ) {
+    if( written ) {
+      results[i] = cap_size_t_to_int( ends[i] - start + 1 );
+    } else {
+      results[i] = -1;
+    }
+
+    start = ends[i];
+  }
+
+  return written ? 0 : -1;
+}
@@ -16,9 +16,7 @@
  * limitations under the License.
  */
 
-// keeps systemd from showing stumpless itself as the source of the entries
-#define SD_JOURNAL_SUPPRESS_LOCATION 1
-
+#include <stdbool.h>
 #include <stddef.h>
 #include <string.h>
 #include <stumpless/element.h>
@@ -27,10 +25,10 @@
 #include <stumpless/target.h>
 #include <stumpless/target/journald.h>
 #include <sys/uio.h>
-#include <systemd/sd-journal.h>
 #include "private/config/wrapper/locale.h"
 #include "private/config/wrapper/getpid.h"
 #include "private/config/wrapper/get_now.h"
+#include "private/config/wrapper/journald_protocol.h"
 #include "private/config/wrapper/thread_safety.h"
 #include "private/element.h"
 #include "private/entry.h"
@@ -175,9 +173,12 @@ get_journald_field_name( char *flattened, const char *raw, size_t size ) {
       flattened[flattened_i] = '_';
     }
 
-    // skip over utf-8 multibyte characters
-    while( current >= 128 ) {
-      raw_i++;
+    // skip over the continuation bytes of utf-8 multibyte characters
+    if( current >= 128 ) {
+      while( raw_i + 1 < size
+             && ( ( unsigned char ) raw[raw_i + 1] & 0xc0 ) == 0x80 ) {
+        raw_i++;
+      }
     }
 
     raw_i++;
@@ -238,6 +239,8 @@ journald_free_thread( void ) {
   free_mem( sd_buffer );
   sd_buffer = NULL;
   sd_buffer_size = 0;
+
+  config_journald_protocol_free_thread(  );
 }
 
 void
@@ -250,7 +253,8 @@ load_facility( const struct stumpless_entry *entry ) {
     fields[1].iov_len = 17;
   } else {
     fixed_fields->facility[FACILITY_PREFIX_SIZE] = ( facility_val / 10 ) + 48;
-    fixed_fields->facility[FACILITY_PREFIX_SIZE] = ( facility_val % 10 ) + 48;
+    fixed_fields->facility[FACILITY_PREFIX_SIZE + 1] =
+                                                   ( facility_val % 10 ) + 48;
     fields[1].iov_len = 18;
   }
 
@@ -331,15 +335,53 @@ load_priority( const struct stumpless_entry *entry ) {
   fixed_fields->priority[PRIORITY_PREFIX_SIZE] = severity;
 }
 
+size_t
+load_element_field( struct stumpless_element *element ) {
+  size_t name_length;
+
+  if( element->journald_field_length == 0 ) {
+    name_length = get_journald_field_name( element->journald_field,
+                                           element->name,
+                                           element->name_length );
+    element->journald_field[name_length] = '=';
+    element->journald_field_length = name_length + 1;
+  }
+
+  return element->journald_field_length;
+}
+
+size_t
+load_param_prefix( struct stumpless_element *element,
+                   struct stumpless_param *param ) {
+  size_t prefix_length;
+
+  if( param->journald_prefix_length == 0
+      || param->journald_prefix_element != element ) {
+    prefix_length = load_element_field( element ) - 1;
+    memcpy( param->journald_prefix, element->journald_field, prefix_length );
+    param->journald_prefix[prefix_length++] = '_';
+    prefix_length += get_journald_field_name( param->journald_prefix
+                                                + prefix_length,
+                                              param->name,
+                                              param->name_length );
+    param->journald_prefix[prefix_length++] = '=';
+    param->journald_prefix_length = prefix_length;
+    param->journald_prefix_element = element;
+  }
+
+  return param->journald_prefix_length;
+}
+
 size_t
 load_sd_fields( const struct stumpless_entry *entry ) {
   size_t fields_offset = SD_FIELDS_OFFSET;
   size_t field_count;
   size_t i;
-  const struct stumpless_element *element;
+  struct stumpless_element *element;
+  bool default_element_namer;
   size_t size_needed = 0;
   size_t j;
-  const struct stumpless_param *param;
+  struct stumpless_param *param;
   char *new_sd_buffer;
   char *pos;
   struct iovec *vec;
@@ -349,13 +391,24 @@ load_sd_fields( const struct stumpless_entry *entry ) {
   for( i = 0; i < entry->element_count; i++ ) {
     element = entry->elements[i];
     lock_element( element );
-    size_needed += element->get_journald_name( entry, i, NULL, 0 ) + 1;
+    default_element_namer = uses_default_element_namer( element );
+    if( default_element_namer ) {
+      size_needed += load_element_field( element );
+    } else {
+      size_needed += element->get_journald_name( entry, i, NULL, 0 ) + 1;
+    }
+
     field_count += element->param_count;
     for( j = 0; j < element->param_count; j++ ) {
       param = element->params[j];
       lock_param( param );
-      size_needed += param->get_journald_name( entry, i, j, NULL, 0 );
-      size_needed += 1 + param->value_length;
+      if( default_element_namer && uses_default_param_namer( param ) ) {
+        size_needed += load_param_prefix( element, param );
+      } else {
+        size_needed += param->get_journald_name( entry, i, j, NULL, 0 ) + 1;
+      }
+
+      size_needed += param->value_length;
     }
   }
 
@@ -379,19 +432,31 @@ load_sd_fields( const struct stumpless_entry *entry ) {
   pos = sd_buffer;
   for( i = 0; i < entry->element_count; i++ ) {
     element = entry->elements[i];
+    default_element_namer = uses_default_element_namer( element );
     vec = &fields[fields_offset++];
     vec->iov_base = pos;
-    size_left = sd_buffer_size - ( pos - sd_buffer );
-    pos += element->get_journald_name( entry, i, pos, size_left );
-    *( pos++ ) = '=';
+    if( default_element_namer ) {
+      memcpy( pos, element->journald_field, element->journald_field_length );
+      pos += element->journald_field_length;
+    } else {
+      size_left = sd_buffer_size - ( pos - sd_buffer );
+      pos += element->get_journald_name( entry, i, pos, size_left );
+      *( pos++ ) = '=';
+    }
     vec->iov_len = pos - ( char * ) vec->iov_base;
-    for( j = 0; j < entry->elements[i]->param_count; j++ ) {
+
+    for( j = 0; j < element->param_count; j++ ) {
       param = element->params[j];
       vec = &fields[fields_offset++];
       vec->iov_base = pos;
-      size_left = sd_buffer_size - ( pos - sd_buffer );
-      pos += param->get_journald_name( entry, i, j, pos, size_left );
-      *( pos++ ) = '=';
+      if( default_element_namer && uses_default_param_namer( param ) ) {
+        memcpy( pos, param->journald_prefix, param->journald_prefix_length );
+        pos += param->journald_prefix_length;
+      } else {
+        size_left = sd_buffer_size - ( pos - sd_buffer );
+        pos += param->get_journald_name( entry, i, j, pos, size_left );
+        *( pos++ ) = '=';
+      }
       memcpy( pos, param->value, param->value_length );
       pos += param->value_length;
       unlock_param( param );
@@ -423,18 +488,16 @@ load_timestamp( void ) {
   return TIMESTAMP_PREFIX_SIZE + config_get_now( timestamp );
 }
 
-int
-send_entry_to_journald_target( const struct stumpless_target *target,
-                               const struct stumpless_entry *entry ) {
+size_t
+load_entry_fields( const struct stumpless_entry *entry ) {
   size_t timestamp_size;
   size_t pid_size;
   size_t field_count;
-  int sendv_result;
 
   if( !fixed_fields ) {
     init_fixed_fields(  );
     if( !fixed_fields ) {
-      goto fail;
+      return 0;
     }
   }
 
@@ -462,17 +525,79 @@ send_entry_to_journald_target( const struct stumpless_target *target,
   fields[2].iov_len = timestamp_size;
   fields[4].iov_len = pid_size;
 
-  sendv_result = sd_journal_sendv( fields, field_count );
+  return field_count;
+
+fail_locked:
+  unlock_entry( entry );
+  return 0;
+}
+
+int
+send_entries_to_journald_target( const struct stumpless_target *target,
+                                 const struct stumpless_entry * const *entries,
+                                 size_t entry_count,
+                                 int *results ) {
+  size_t i;
+  size_t batch_start = 0;
+  size_t field_count;
+  int entry_result;
+  int flush_result;
+  int result = 0;
+
+  for( i = 0; i < entry_count; i++ ) {
+    field_count = load_entry_fields( entries[i] );
+    if( field_count == 0 ) {
+      entry_result = -1;
+
+    } else {
+      entry_result = config_journald_append( fields, field_count );
+      if( entry_result == 0 ) {
+        results[i] = 0;
+        continue;
+      }
+
+      raise_journald_failure( entry_result );
+    }
+
+    // entries before this one are sent first so that the pending datagrams
+    // line up with their results
+    flush_result = config_journald_flush( results + batch_start );
+    if( flush_result != 0 ) {
+      raise_journald_failure( flush_result );
+      result = flush_result;
+    }
+
+    results[i] = entry_result;
+    result = entry_result;
+    batch_start = i + 1;
+  }
+
+  flush_result = config_journald_flush( results + batch_start );
+  if( flush_result != 0 ) {
+    raise_journald_failure( flush_result );
+    result = flush_result;
+  }
+
+  return result;
+}
+
+int
+send_entry_to_journald_target( const struct stumpless_target *target,
+                               const struct stumpless_entry *entry ) {
+  size_t field_count;
+  int sendv_result;
+
+  field_count = load_entry_fields( entry );
+  if( field_count == 0 ) {
+    return -1;
+  }
+
+  sendv_result = config_journald_sendv( fields, field_count );
   if( sendv_result != 0 ) {
     raise_journald_failure( sendv_result );
   }
 
   return sendv_result;
-
-fail_locked:
-  unlock_entry( entry );
-fail:
-  return -1;
 }
 
 void
@@ -485,3 +610,13 @@ set_field_bases( void ) {
   fields[4].iov_base = fixed_fields->pid;
   fields[5].iov_base = fixed_fields->msgid;
 }
+
+bool
+uses_default_element_namer( const struct stumpless_element *element ) {
+  return element->get_journald_name == stumpless_flatten_element_name;
+}
+
+bool
+uses_default_param_namer( const struct stumpless_param *param ) {
+  return param->get_journald_name == stumpless_flatten_param_name;
+}
@@ -16,15 +16,19 @@
  * limitations under the License.
  */
 
+#include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 #include <stumpless/target.h>
 #include <stumpless/target/network.h>
+#include "private/config/wrapper/get_monotonic_time.h"
 #include "private/config/wrapper/locale.h"
 #include "private/config/wrapper/network_supported.h"
 #include "private/config/wrapper/thread_safety.h"
 #include "private/error.h"
+#include "private/facility.h"
 #include "private/memory.h"
 #include "private/strhelper.h"
 #include "private/target.h"
@@ -33,6 +37,8 @@
 
 static CONFIG_THREAD_LOCAL_STORAGE char *tcp_send_buffer = NULL;
 static CONFIG_THREAD_LOCAL_STORAGE size_t tcp_send_buffer_length = 0;
+static CONFIG_THREAD_LOCAL_STORAGE size_t connection_cursor = 0;
+static CONFIG_THREAD_LOCAL_STORAGE size_t destination_cursor = 0;
 
 static
 void
@@ -60,6 +66,71 @@ destroy_ipv6_target( const struct network_target *target ) {
   }
 }
 
+static
+void
+destroy_pooled_connection( const struct network_target *connection ) {
+
+  if( connection->network == STUMPLESS_IPV4_NETWORK_PROTOCOL ) {
+    destroy_ipv4_target( connection );
+
+  } else { // STUMPLESS_IPV6_NETWORK_PROTOCOL
+    destroy_ipv6_target( connection );
+
+  }
+
+  free_mem( connection->spill_buffer );
+  free_mem( connection );
+}
+
+/**
+ * Gets the connection that the next frame from this thread should be sent
+ * on. Each thread walks through the connections in turn, which spreads the
+ * load without any shared state between threads.
+ */
+static
+struct network_target *
+get_next_connection( struct network_target *target ) {
+  size_t index;
+
+  if( target->connection_count <= 1 ) {
+    return target;
+  }
+
+  index = connection_cursor++ % target->connection_count;
+  return index == 0 ? target : target->connections[index - 1];
+}
+
+/**
+ * Gets the connection at the given index out of all of those that a TCP
+ * setting applies to: the target itself, followed by its pooled connections
+ * and then its added destinations. There are connection_count +
+ * destination_count of these in total.
+ */
+static
+struct network_target *
+get_setting_connection( struct network_target *target, size_t index ) {
+  if( index == 0 ) {
+    return target;
+  }
+
+  if( index < target->connection_count ) {
+    return target->connections[index - 1];
+  }
+
+  return target->destinations[index - target->connection_count];
+}
+
+/**
+ * Gets the time that a destination which failed at the given time should be
+ * tried again.
+ */
+static
+uint64_t
+get_retry_time( uint64_t now ) {
+  return now + ( ( uint64_t ) STUMPLESS_NETWORK_DESTINATION_RETRY_DELAY
+                 * 1000000 );
+}
+
 static
 struct network_target *
 init_ipv4_target( struct network_target *target ) {
@@ -121,6 +192,44 @@ init_network_target( struct network_target *target ) {
   }
 }
 
+static
+struct network_target *
+new_pooled_connection( const struct network_target *target ) {
+  struct network_target *connection;
+
+  connection = alloc_mem( sizeof( *connection ) );
+  if( !connection ) {
+    return NULL;
+  }
+
+  connection->destination = target->destination;
+  connection->port = target->port;
+  connection->max_msg_size = target->max_msg_size;
+  connection->network = target->network;
+  connection->transport = target->transport;
+  connection->reconnect_min_delay = target->reconnect_min_delay;
+  connection->reconnect_max_delay = target->reconnect_max_delay;
+  connection->reconnect_delay = target->reconnect_min_delay;
+  connection->next_reconnect = 0;
+  connection->spill_buffer = NULL;
+  connection->spill_size = target->spill_size;
+  connection->spill_used = 0;
+  connection->send_timeout = target->send_timeout;
+  connection->connections = NULL;
+  connection->connection_count = 1;
+  connection->destinations = NULL;
+  connection->destination_count = 0;
+  connection->balance_policy = STUMPLESS_NETWORK_BALANCE_FAILOVER;
+  connection->unhealthy_until = 0;
+
+  if( !init_network_target( connection ) ) {
+    free_mem( connection );
+    return NULL;
+  }
+
+  return connection;
+}
+
 static
 int
 ipv4_target_is_open( const struct network_target *target ) {
@@ -204,6 +313,69 @@ open_private_network_target( struct network_target *target ) {
   }
 }
 
+/**
+ * Opens a pooled connection. If the connection cannot be opened but automatic
+ * reconnection is enabled, then it is left closed to be reconnected later.
+ */
+static
+bool
+open_pooled_connection( struct network_target *connection ) {
+  if( open_private_network_target( connection ) ) {
+    return true;
+  }
+
+  if( !network_target_reconnect_enabled( connection ) ) {
+    return false;
+  }
+
+  lock_network_target( connection );
+  network_target_connection_failed( connection );
+  unlock_network_target( connection );
+  return true;
+}
+
+static
+struct network_target *
+open_pooled_connections( struct network_target *target ) {
+  size_t i;
+
+  for( i = 0; i + 1 < target->connection_count; i++ ) {
+    if( !open_pooled_connection( target->connections[i] ) ) {
+      return NULL;
+    }
+  }
+
+  return target;
+}
+
+/**
+ * Opens a destination added to a target. Failures are not treated as errors,
+ * but leave the destination unhealthy so that it is retried later.
+ */
+static
+void
+open_added_destination( struct network_target *destination ) {
+  uint64_t now;
+
+  if( open_private_network_target( destination ) ) {
+    return;
+  }
+
+  now = config_get_monotonic_ns(  );
+  destination->unhealthy_until = get_retry_time( now );
+  clear_error(  );
+}
+
+static
+void
+open_added_destinations( struct network_target *target ) {
+  size_t i;
+
+  for( i = 0; i < target->destination_count; i++ ) {
+    open_added_destination( target->destinations[i] );
+  }
+}
+
 static
 struct network_target *
 reopen_ipv4_target( struct network_target *target ) {
@@ -247,7 +419,8 @@ static
 int
 sendto_tcp_target( struct network_target *target,
                    const char *msg,
-                   size_t msg_length ) {
+                   size_t msg_length,
+                   bool spill ) {
   size_t int_length;
   size_t required_length;
   char *new_buffer;
@@ -270,15 +443,19 @@ sendto_tcp_target( struct network_target *target,
   int_length = strlen( tcp_send_buffer );
   memcpy( tcp_send_buffer + int_length, msg, msg_length );
 
+  target = get_next_connection( target );
+
   if( target->network == STUMPLESS_IPV4_NETWORK_PROTOCOL ) {
     return config_sendto_tcp4_target( target,
                                       tcp_send_buffer,
-                                      int_length + msg_length );
+                                      int_length + msg_length,
+                                      spill );
 
   } else { // STUMPLESS_IPV6_NETWORK_PROTOCOL
     return config_sendto_tcp6_target( target,
                                       tcp_send_buffer,
-                                      int_length + msg_length );
+                                      int_length + msg_length,
+                                      spill );
 
   }
 }
@@ -308,8 +485,262 @@ sendto_udp_target( const struct network_target *target,
   }
 }
 
+/**
+ * Gets the destination at the given index, where the target itself is the
+ * first one.
+ */
+static
+struct network_target *
+get_destination( struct network_target *target, size_t index ) {
+  return index == 0 ? target : target->destinations[index - 1];
+}
+
+/**
+ * Gets the index of the destination that the balance policy of the target
+ * picks for an entry with the given prival, before taking health into
+ * account.
+ */
+static
+size_t
+get_preferred_destination( const struct network_target *target,
+                           int prival ) {
+  size_t count = target->destination_count + 1;
+
+  switch( target->balance_policy ) {
+
+    case STUMPLESS_NETWORK_BALANCE_ROUND_ROBIN:
+      return destination_cursor++ % count;
+
+    case STUMPLESS_NETWORK_BALANCE_FACILITY_HASH:
+      return ( size_t ) ( get_facility( prival ) >> 3 ) % count;
+
+    default: // STUMPLESS_NETWORK_BALANCE_FAILOVER
+      return 0;
+
+  }
+}
+
+static
+void
+set_destination_health( struct network_target *destination,
+                        uint64_t unhealthy_until ) {
+  lock_network_target( destination );
+  destination->unhealthy_until = unhealthy_until;
+  unlock_network_target( destination );
+}
+
+/**
+ * Connects a destination and any pooled connections it has again, whether or
+ * not their connections are still open.
+ *
+ * @return true if the destination was connected, false if not.
+ */
+static
+bool
+reconnect_destination( struct network_target *destination ) {
+  size_t i;
+
+  if( !config_reconnect_network_target( destination ) ) {
+    return false;
+  }
+
+  // pooled connections that fail are left for their own reconnection
+  for( i = 0; i + 1 < destination->connection_count; i++ ) {
+    config_reconnect_network_target( destination->connections[i] );
+  }
+
+  clear_error(  );
+  return true;
+}
+
+/**
+ * Checks whether a destination should be skipped, reconnecting it first if it
+ * was unhealthy but its retry delay has passed. The retry is claimed before
+ * reconnecting so that other threads keep skipping the destination until it
+ * is done, and the destination is left unhealthy if it is still down.
+ */
+static
+bool
+skip_destination( struct network_target *destination, uint64_t now ) {
+  uint64_t unhealthy_until;
+
+  lock_network_target( destination );
+  unhealthy_until = destination->unhealthy_until;
+  if( unhealthy_until != 0 && now >= unhealthy_until ) {
+    destination->unhealthy_until = get_retry_time( now );
+  }
+  unlock_network_target( destination );
+
+  if( unhealthy_until == 0 ) {
+    return false;
+  }
+
+  if( now < unhealthy_until ) {
+    return true;
+  }
+
+  if( !reconnect_destination( destination ) ) {
+    return true;
+  }
+
+  set_destination_health( destination, 0 );
+  return false;
+}
+
+static
+int
+sendto_destination( struct network_target *destination,
+                    const char *msg,
+                    size_t msg_length,
+                    bool spill ) {
+  if( destination->transport == STUMPLESS_UDP_TRANSPORT_PROTOCOL ) {
+     return sendto_udp_target( destination, msg, msg_length );
+
+  } else {
+     return sendto_tcp_target( destination, msg, msg_length, spill );
+
+  }
+}
+
+/**
+ * Sends a message to the destinations of a target with more than one,
+ * starting with the one picked by the balance policy and moving on to the
+ * next healthy destination whenever a send fails.
+ *
+ * Frames are not spilled while other destinations may still take them, as
+ * a spilled frame would otherwise count as sent and stop the failover. Only
+ * if no destination takes the frame is it held in the spill queue of the
+ * preferred one, if it has one.
+ */
+static
+int
+sendto_balanced_target( struct network_target *target,
+                        const char *msg,
+                        size_t msg_length,
+                        int prival ) {
+  size_t count = target->destination_count + 1;
+  size_t preferred;
+  size_t i;
+  struct network_target *destination;
+  uint64_t now;
+  bool attempted = false;
+  int result = -1;
+
+  preferred = get_preferred_destination( target, prival );
+  now = config_get_monotonic_ns(  );
+
+  for( i = 0; i < count; i++ ) {
+    destination = get_destination( target, ( preferred + i ) % count );
+    if( skip_destination( destination, now ) ) {
+      continue;
+    }
+
+    attempted = true;
+    result = sendto_destination( destination, msg, msg_length, false );
+    if( result >= 0 ) {
+      set_destination_health( destination, 0 );
+      clear_error(  );
+      return result;
+    }
+
+    set_destination_health( destination, get_retry_time( now ) );
+  }
+
+  destination = get_destination( target, preferred );
+
+  // reconnecting targets take care of their own connection, holding the
+  // frame in their spill queue until it is back
+  if( network_target_reconnect_enabled( destination ) ) {
+    return sendto_destination( destination, msg, msg_length, true );
+  }
+
+  // with no healthy destinations left, the preferred one is tried anyway
+  if( !attempted ) {
+    if( reconnect_destination( destination ) ) {
+      set_destination_health( destination, 0 );
+    }
+
+    result = sendto_destination( destination, msg, msg_length, true );
+  }
+
+  return result;
+}
+
 /* public definitions */
 
+struct stumpless_target *
+stumpless_add_network_destination( struct stumpless_target *target,
+                                   const char *destination,
+                                   const char *port ) {
+  struct network_target *net_target;
+  struct network_target **new_destinations;
+  struct network_target *added;
+  const char *destination_copy;
+  const char *port_copy;
+
+  VALIDATE_ARG_NOT_NULL( target );
+  VALIDATE_ARG_NOT_NULL( destination );
+
+  lock_target( target );
+  if( target->type != STUMPLESS_NETWORK_TARGET ) {
+    raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+    goto fail;
+  }
+
+  net_target = target->id;
+  new_destinations = realloc_mem( net_target->destinations,
+                                  sizeof( *new_destinations )
+                                    * ( net_target->destination_count + 1 ) );
+  if( !new_destinations ) {
+    goto fail;
+  }
+  net_target->destinations = new_destinations;
+
+  destination_copy = copy_cstring( destination );
+  if( !destination_copy ) {
+    goto fail;
+  }
+
+  port_copy = copy_cstring( port ? port : net_target->port );
+  if( !port_copy ) {
+    goto fail_port;
+  }
+
+  added = new_network_target( net_target->network, net_target->transport );
+  if( !added ) {
+    goto fail_added;
+  }
+
+  free_mem( added->port );
+  added->port = port_copy;
+  added->destination = destination_copy;
+  added->max_msg_size = net_target->max_msg_size;
+  added->reconnect_min_delay = net_target->reconnect_min_delay;
+  added->reconnect_max_delay = net_target->reconnect_max_delay;
+  added->reconnect_delay = net_target->reconnect_min_delay;
+  added->spill_size = net_target->spill_size;
+  added->send_timeout = net_target->send_timeout;
+
+  if( network_target_is_open( target ) ) {
+    open_added_destination( added );
+  }
+
+  net_target->destinations[net_target->destination_count] = added;
+  net_target->destination_count++;
+
+  unlock_target( target );
+  clear_error(  );
+  return target;
+
+fail_added:
+  free_mem( port_copy );
+fail_port:
+  free_mem( destination_copy );
+fail:
+  unlock_target( target );
+  return NULL;
+}
+
 void
 stumpless_close_network_target( const struct stumpless_target *target ) {
   clear_error(  );
@@ -546,6 +977,7 @@ stumpless_set_destination( struct stumpless_target *target,
   const char *destination_copy;
   struct network_target *net_target;
   const char *old_destination;
+  size_t i;
 
   VALIDATE_ARG_NOT_NULL( target );
   VALIDATE_ARG_NOT_NULL( destination );
@@ -567,6 +999,12 @@ stumpless_set_destination( struct stumpless_target *target,
   clear_error(  );
 
   reopen_network_target( net_target );
+  for( i = 0; i + 1 < net_target->connection_count; i++ ) {
+    lock_network_target( net_target->connections[i] );
+    net_target->connections[i]->destination = destination_copy;
+    unlock_network_target( net_target->connections[i] );
+    reopen_network_target( net_target->connections[i] );
+  }
 
   unlock_target( target );
   free_mem( old_destination );
@@ -578,12 +1016,249 @@ cleanup_and_fail:
   return NULL;
 }
 
+struct stumpless_target *
+stumpless_set_network_balance_policy( struct stumpless_target *target,
+                                      enum stumpless_network_balance_policy policy ) {
+  struct network_target *net_target;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  lock_target( target );
+  if( target->type != STUMPLESS_NETWORK_TARGET ) {
+    unlock_target( target );
+    raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+    return NULL;
+  }
+
+  net_target = target->id;
+  net_target->balance_policy = policy;
+  unlock_target( target );
+
+  clear_error(  );
+  return target;
+}
+
+struct stumpless_target *
+stumpless_set_tcp_connection_count( struct stumpless_target *target,
+                                    size_t count ) {
+  struct network_target *net_target;
+  struct network_target **new_connections;
+  struct network_target *connection;
+  size_t i;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  if( count == 0 ) {
+    count = 1;
+  }
+
+  lock_target( target );
+  if( target->type != STUMPLESS_NETWORK_TARGET ) {
+    goto incompatible;
+  }
+
+  net_target = target->id;
+  if( net_target->transport != STUMPLESS_TCP_TRANSPORT_PROTOCOL ) {
+    goto incompatible;
+  }
+
+  while( net_target->connection_count > count ) {
+    net_target->connection_count--;
+    i = net_target->connection_count - 1;
+    destroy_pooled_connection( net_target->connections[i] );
+  }
+
+  if( net_target->connection_count == 1 ) {
+    free_mem( net_target->connections );
+    net_target->connections = NULL;
+  }
+
+  if( net_target->connection_count < count ) {
+    new_connections = realloc_mem( net_target->connections,
+                                   sizeof( *new_connections ) * ( count - 1 ) );
+    if( !new_connections ) {
+      goto fail;
+    }
+    net_target->connections = new_connections;
+
+    while( net_target->connection_count < count ) {
+      connection = new_pooled_connection( net_target );
+      if( !connection ) {
+        goto fail;
+      }
+
+      if( network_target_is_open( target )
+          && !open_pooled_connection( connection ) ) {
+        destroy_pooled_connection( connection );
+        goto fail;
+      }
+
+      i = net_target->connection_count - 1;
+      net_target->connections[i] = connection;
+      net_target->connection_count++;
+    }
+  }
+
+  unlock_target( target );
+  clear_error(  );
+  return target;
+
+incompatible:
+  raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+fail:
+  unlock_target( target );
+  return NULL;
+}
+
+struct stumpless_target *
+stumpless_set_tcp_reconnect_backoff( struct stumpless_target *target,
+                                     unsigned min_delay,
+                                     unsigned max_delay ) {
+  struct network_target *net_target;
+  struct network_target *connection;
+  size_t i;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  if( max_delay < min_delay ) {
+    max_delay = min_delay;
+  }
+
+  lock_target( target );
+  if( target->type != STUMPLESS_NETWORK_TARGET ) {
+    goto incompatible;
+  }
+
+  net_target = target->id;
+  if( net_target->transport != STUMPLESS_TCP_TRANSPORT_PROTOCOL ) {
+    goto incompatible;
+  }
+
+  for( i = 0;
+       i < net_target->connection_count + net_target->destination_count;
+       i++ ) {
+    connection = get_setting_connection( net_target, i );
+    lock_network_target( connection );
+    connection->reconnect_min_delay = min_delay;
+    connection->reconnect_max_delay = max_delay;
+    connection->reconnect_delay = min_delay;
+    connection->next_reconnect = 0;
+    unlock_network_target( connection );
+  }
+
+  unlock_target( target );
+  clear_error(  );
+  return target;
+
+incompatible:
+  unlock_target( target );
+  raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+  return NULL;
+}
+
+struct stumpless_target *
+stumpless_set_tcp_send_timeout( struct stumpless_target *target,
+                                unsigned timeout ) {
+  struct network_target *net_target;
+  struct network_target *connection;
+  size_t i;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  lock_target( target );
+  if( target->type != STUMPLESS_NETWORK_TARGET ) {
+    goto incompatible;
+  }
+
+  net_target = target->id;
+  if( net_target->transport != STUMPLESS_TCP_TRANSPORT_PROTOCOL ) {
+    goto incompatible;
+  }
+
+  for( i = 0;
+       i < net_target->connection_count + net_target->destination_count;
+       i++ ) {
+    connection = get_setting_connection( net_target, i );
+    lock_network_target( connection );
+    connection->send_timeout = timeout;
+    unlock_network_target( connection );
+  }
+
+  unlock_target( target );
+  clear_error(  );
+  return target;
+
+incompatible:
+  unlock_target( target );
+  raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+  return NULL;
+}
+
+struct stumpless_target *
+stumpless_set_tcp_spill_queue_size( struct stumpless_target *target,
+                                    size_t size ) {
+  struct network_target *net_target;
+  struct network_target *connection;
+  char *new_buffer;
+  size_t i;
+
+  VALIDATE_ARG_NOT_NULL( target );
+
+  lock_target( target );
+  if( target->type != STUMPLESS_NETWORK_TARGET ) {
+    goto incompatible;
+  }
+
+  net_target = target->id;
+  if( net_target->transport != STUMPLESS_TCP_TRANSPORT_PROTOCOL ) {
+    goto incompatible;
+  }
+
+  for( i = 0;
+       i < net_target->connection_count + net_target->destination_count;
+       i++ ) {
+    connection = get_setting_connection( net_target, i );
+    lock_network_target( connection );
+
+    if( size == 0 ) {
+      free_mem( connection->spill_buffer );
+      connection->spill_buffer = NULL;
+    } else if( connection->spill_buffer ) {
+      new_buffer = realloc_mem( connection->spill_buffer, size );
+      if( !new_buffer ) {
+        unlock_network_target( connection );
+        unlock_target( target );
+        return NULL;
+      }
+      connection->spill_buffer = new_buffer;
+    }
+
+    // frames cannot be partially dropped, so all are dropped if needed
+    if( connection->spill_used > size ) {
+      connection->spill_used = 0;
+    }
+
+    connection->spill_size = size;
+    unlock_network_target( connection );
+  }
+
+  unlock_target( target );
+  clear_error(  );
+  return target;
+
+incompatible:
+  unlock_target( target );
+  raise_target_incompatible( L10N_INVALID_TARGET_TYPE_ERROR_MESSAGE );
+  return NULL;
+}
+
 struct stumpless_target *
 stumpless_set_transport_port( struct stumpless_target *target,
                               const char *port ) {
   const char *port_copy;
   struct network_target *net_target;
   const char *old_port;
+  size_t i;
 
   VALIDATE_ARG_NOT_NULL( target );
   VALIDATE_ARG_NOT_NULL( port );
@@ -605,6 +1280,12 @@ stumpless_set_transport_port( struct stumpless_target *target,
   clear_error(  );
 
   reopen_network_target( net_target );
+  for( i = 0; i + 1 < net_target->connection_count; i++ ) {
+    lock_network_target( net_target->connections[i] );
+    net_target->connections[i]->port = port_copy;
+    unlock_network_target( net_target->connections[i] );
+    reopen_network_target( net_target->connections[i] );
+  }
 
   unlock_target( target );
   free_mem( old_port );
@@ -620,6 +1301,7 @@ struct stumpless_target *
 stumpless_set_udp_max_message_size( struct stumpless_target *target,
                                     size_t max_msg_size ) {
   struct network_target *net_target;
+  size_t i;
 
   VALIDATE_ARG_NOT_NULL( target );
 
@@ -635,6 +1317,9 @@ stumpless_set_udp_max_message_size( struct stumpless_target *target,
 
   net_target = target->id;
   net_target->max_msg_size = max_msg_size;
+  for( i = 0; i < net_target->destination_count; i++ ) {
+    net_target->destinations[i]->max_msg_size = max_msg_size;
+  }
   unlock_target( target );
 
   clear_error(  );
@@ -698,6 +1383,7 @@ cleanup_and_fail:
 
 void
 destroy_network_target( const struct network_target *target ) {
+  size_t i;
 
   if( target->network == STUMPLESS_IPV4_NETWORK_PROTOCOL ) {
     destroy_ipv4_target( target );
@@ -707,6 +1393,18 @@ destroy_network_target( const struct network_target *target ) {
 
   }
 
+  for( i = 0; i + 1 < target->connection_count; i++ ) {
+    destroy_pooled_connection( target->connections[i] );
+  }
+
+  free_mem( target->connections );
+
+  for( i = 0; i < target->destination_count; i++ ) {
+    destroy_network_target( target->destinations[i] );
+  }
+
+  free_mem( target->destinations );
+  free_mem( target->spill_buffer );
   free_mem( target->destination );
   free_mem( target->port );
   free_mem( target );
@@ -725,6 +1423,24 @@ network_free_all( void ) {
   tcp_send_buffer_length = 0;
 }
 
+void
+network_target_connection_failed( struct network_target *target ) {
+  target->next_reconnect = config_get_monotonic_ns(  )
+                           + ( ( uint64_t ) target->reconnect_delay * 1000000 );
+
+  if( target->reconnect_delay > target->reconnect_max_delay / 2 ) {
+    target->reconnect_delay = target->reconnect_max_delay;
+  } else {
+    target->reconnect_delay *= 2;
+  }
+}
+
+void
+network_target_connection_restored( struct network_target *target ) {
+  target->reconnect_delay = target->reconnect_min_delay;
+  target->next_reconnect = 0;
+}
+
 int
 network_target_is_open( const struct stumpless_target *target ) {
   const struct network_target *net_target;
@@ -740,6 +1456,18 @@ network_target_is_open( const struct stumpless_target *target ) {
   }
 }
 
+bool
+network_target_reconnect_due( const struct network_target *target ) {
+  return network_target_reconnect_enabled( target )
+         && target->destination
+         && config_get_monotonic_ns(  ) >= target->next_reconnect;
+}
+
+bool
+network_target_reconnect_enabled( const struct network_target *target ) {
+  return target->reconnect_min_delay != 0;
+}
+
 struct network_target *
 new_network_target( enum stumpless_network_protocol network,
                     enum stumpless_transport_protocol transport ) {
@@ -762,6 +1490,20 @@ new_network_target( enum stumpless_network_protocol network,
   target->max_msg_size = STUMPLESS_DEFAULT_UDP_MAX_MESSAGE_SIZE;
   target->network = network;
   target->transport = transport;
+  target->reconnect_min_delay = 0;
+  target->reconnect_max_delay = 0;
+  target->reconnect_delay = 0;
+  target->next_reconnect = 0;
+  target->spill_buffer = NULL;
+  target->spill_size = 0;
+  target->spill_used = 0;
+  target->send_timeout = 0;
+  target->connections = NULL;
+  target->connection_count = 1;
+  target->destinations = NULL;
+  target->destination_count = 0;
+  target->balance_policy = STUMPLESS_NETWORK_BALANCE_FAILOVER;
+  target->unhealthy_until = 0;
 
   init_result = init_network_target( target );
   if( !init_result ) {
@@ -783,7 +1525,8 @@ open_network_target( struct stumpless_target *target ) {
   const struct network_target *result;
 
   result = open_private_network_target( target->id );
-  if( result ) {
+  if( result && open_pooled_connections( target->id ) ) {
+    open_added_destinations( target->id );
     return target;
 
   } else {
@@ -825,17 +1568,39 @@ fail:
 int
 sendto_network_target( struct network_target *target,
                        const char *msg,
-                       size_t msg_length ) {
+                       size_t msg_length,
+                       int prival ) {
   // leave off the newline
   msg_length--;
 
-  if( target->transport == STUMPLESS_UDP_TRANSPORT_PROTOCOL ) {
-     return sendto_udp_target( target, msg, msg_length );
+  if( target->destination_count > 0 ) {
+    return sendto_balanced_target( target, msg, msg_length, prival );
+  }
 
-  } else {
-     return sendto_tcp_target( target, msg, msg_length );
+  return sendto_destination( target, msg, msg_length, true );
+}
 
+int
+spill_network_frame( struct network_target *target,
+                     const char *frame,
+                     size_t frame_length ) {
+  if( frame_length > target->spill_size - target->spill_used ) {
+    raise_network_closed( L10N_NETWORK_CLOSED_ERROR_MESSAGE );
+    return -1;
   }
+
+  if( !target->spill_buffer ) {
+    target->spill_buffer = alloc_mem( target->spill_size );
+    if( !target->spill_buffer ) {
+      return -1;
+    }
+  }
+
+  memcpy( target->spill_buffer + target->spill_used, frame, frame_length );
+  target->spill_used += frame_length;
+
+  clear_error(  );
+  return 1;
 }
 
 void
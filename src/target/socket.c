@@ -16,16 +16,26 @@
  * limitations under the License.
  */
 
+#include "private/config.h"
+
+#ifdef HAVE_SENDMMSG
+// needed for the declaration of sendmmsg
+#  define _GNU_SOURCE
+#endif
+
 #include <errno.h>
 #include <stddef.h>
 #include <string.h>
 #include <unistd.h>
 #include <sys/socket.h>
+#include <sys/uio.h>
 #include <stumpless/target.h>
 #include <stumpless/target/socket.h>
 #include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/probe.h"
 #include "private/config/wrapper/socket.h"
 #include "private/error.h"
+#include "private/inthelper.h"
 #include "private/memory.h"
 #include "private/target.h"
 #include "private/target/socket.h"
@@ -164,12 +174,14 @@ sendto_socket_target( const struct socket_target *target,
   // leave off the newline
   msg_length--;
 
+ config_probe( WRITE_START );
  result = sendto( target->local_socket,
                   msg,
                   msg_length,
                   0,
                   ( const struct sockaddr * ) &target->target_addr,
                   target->target_addr_len );
+ config_probe( WRITE_END );
 
   if( result == -1 ) {
     raise_socket_send_failure( L10N_SENDTO_UNIX_SOCKET_FAILED_ERROR_MESSAGE,
@@ -179,3 +191,105 @@ sendto_socket_target( const struct socket_target *target,
 
   return result;
 }
+
+#ifdef HAVE_SENDMMSG
+
+int
+sendto_socket_target_batch( const struct socket_target *target,
+                            const char *msgs,
+                            const size_t *ends,
+                            size_t count,
+                            int *results ) {
+  struct mmsghdr *messages;
+  struct iovec *message_vecs;
+  size_t start = 0;
+  size_t sent = 0;
+  size_t i;
+  int result;
+
+  messages = alloc_mem( sizeof( *messages ) * count );
+  if( !messages ) {
+    goto fail;
+  }
+
+  message_vecs = alloc_mem( sizeof( *message_vecs ) * count );
+  if( !message_vecs ) {
+    goto fail_vecs;
+  }
+
+  for( i = 0; i < count; i++ ) {
+    // leave off the newline
+    message_vecs[i].iov_base = ( void * ) ( msgs + start );
+    message_vecs[i].iov_len = ends[i] - start - 1;
+    start = ends[i];
+
+    memset( &messages[i], 0, sizeof( messages[i] ) );
+    messages[i].msg_hdr.msg_name = ( void * ) &target->target_addr;
+    messages[i].msg_hdr.msg_namelen = target->target_addr_len;
+    messages[i].msg_hdr.msg_iov = &message_vecs[i];
+    messages[i].msg_hdr.msg_iovlen = 1;
+  }
+
+  config_probe( WRITE_START );
+  while( sent < count ) {
+    result = sendmmsg( target->local_socket, messages + sent, count - sent, 0 );
+    if( result == -1 ) {
+      if( errno == EINTR ) {
+        continue;
+      }
+
+      raise_socket_send_failure( L10N_SENDTO_UNIX_SOCKET_FAILED_ERROR_MESSAGE,
+                                 errno,
+                                 L10N_ERRNO_ERROR_CODE_TYPE );
+      break;
+    }
+
+    for( i = sent; i < sent + result; i++ ) {
+      results[i] = cap_size_t_to_int( messages[i].msg_len );
+    }
+    sent += result;
+  }
+  config_probe( WRITE_END );
+
+  for( i = sent; i < count; i++ ) {
+    results[i] = -1;
+  }
+
+  free_mem( message_vecs );
+  free_mem( messages );
+  return sent == count ? 0 : -1;
+
+fail_vecs:
+  free_mem( messages );
+fail:
+  for( i = 0; i < count; i++ ) {
+    results[i] = -1;
+  }
+  return -1;
+}
+
+#else
+
+int
+sendto_socket_target_batch( const struct socket_target *target,
+                            const char *msgs,
+                            const size_t *ends,
+                            size_t count,
+                            int *results ) {
+  size_t start = 0;
+  size_t i;
+  int result = 0;
+
+  for( i = 0; i < count; i++ ) {
+    results[i] = sendto_socket_target( target, msgs + start, ends[i] - start );
+    if( results[i] < 0 ) {
+      result = -1;
+    }
+
+    start = ends[i];
+  }
+
+  return result;
+}
+
+#endif
@@ -40,6 +40,63 @@
 #include "private/target/sqlite3.h"
 #include "private/validate.h"
 
+/**
+ * Inserts an entry into the database of a target. The db_mutex must be held
+ * by the caller.
+ *
+ * @param db_target The SQLite3 target to insert the entry with.
+ *
+ * @param entry The entry to insert.
+ *
+ * @return A value greater than or equal to zero if no errors were encountered.
+ * If an error was encountered then a negative value is returned and an error
+ * code is set appropriately.
+ */
+static
+int
+insert_entry( struct sqlite3_target *db_target,
+              const struct stumpless_entry *entry ) {
+  size_t stmt_count;
+  size_t i;
+  sqlite3_stmt **statements;
+  int sql_result;
+  size_t try_count = 0;
+  bool busy;
+
+  statements = db_target->prepare_func( entry,
+                                        db_target->prepare_data,
+                                        &stmt_count );
+  if( !statements ) {
+    if( db_target->prepare_func != &stumpless_sqlite3_prepare ) {
+      raise_error( STUMPLESS_SQLITE3_CALLBACK_FAILURE,
+                   L10N_SQLITE3_CUSTOM_PREPARE_FAILED_ERROR_MESSAGE,
+                   0,
+                   NULL );
+    }
+    return -1;
+  }
+
+  for( i = 0; i < stmt_count; i++ ) {
+    do {
+      try_count++;
+      sql_result = sqlite3_step( statements[i] );
+
+      busy = sql_result == SQLITE_BUSY;
+      if( busy && try_count >= STUMPLESS_SQLITE3_RETRY_MAX ) {
+        raise_sqlite3_busy();
+        return 1;
+      }
+    } while( busy );
+
+    if( sql_result != SQLITE_DONE ) {
+      raise_sqlite3_failure( L10N_SQLITE3_STEP_FAILED_ERROR_MESSAGE,
+                             sql_result );
+      return -1;
+    }
+  }
+
+  return 1;
+}
 
 bool
 stumpless_close_sqlite3_target_and_db( const struct stumpless_target *target ) {
@@ -579,56 +636,73 @@ new_sqlite3_target( sqlite3 *db ) {
 }
 
 int
-send_entry_to_sqlite3_target( const struct stumpless_target *target,
-                              const struct stumpless_entry *entry ) {
+send_entries_to_sqlite3_target( const struct stumpless_target *target,
+                                const struct stumpless_entry * const *entries,
+                                size_t entry_count,
+                                int *results ) {
   struct sqlite3_target *db_target;
-  size_t stmt_count;
-  size_t i;
-  sqlite3_stmt **statements;
-  int result = 1;
-  int sql_result;
+  bool in_transaction;
   size_t try_count = 0;
-  bool busy;
+  int sql_result;
+  int result = 0;
+  size_t i;
 
   db_target = target->id;
 
   config_lock_mutex( &db_target->db_mutex );
 
-  statements = db_target->prepare_func( entry,
-                                        db_target->prepare_data,
-                                        &stmt_count );
-  if( !statements ) {
-    result = -1;
-    if( db_target->prepare_func != &stumpless_sqlite3_prepare ) {
-      raise_error( STUMPLESS_SQLITE3_CALLBACK_FAILURE,
-                   L10N_SQLITE3_CUSTOM_PREPARE_FAILED_ERROR_MESSAGE,
-                   0,
-                   NULL );
+  // without a transaction each insert is still made, only more slowly
+  in_transaction = sqlite3_exec( db_target->db,
+                                 "BEGIN",
+                                 NULL,
+                                 NULL,
+                                 NULL ) == SQLITE_OK;
+
+  for( i = 0; i < entry_count; i++ ) {
+    results[i] = insert_entry( db_target, entries[i] );
+    if( results[i] < 0 ) {
+      result = -1;
     }
-    goto cleanup_and_finish;
   }
 
-  for( i = 0; i < stmt_count; i++ ) {
+  if( in_transaction ) {
     do {
       try_count++;
-      sql_result = sqlite3_step( statements[i] );
+      sql_result = sqlite3_exec( db_target->db, "COMMIT", NULL, NULL, NULL );
+    } while( sql_result == SQLITE_BUSY
+             && try_count < STUMPLESS_SQLITE3_RETRY_MAX );
 
-      busy = sql_result == SQLITE_BUSY;
-      if( busy && try_count >= STUMPLESS_SQLITE3_RETRY_MAX ) {
-        raise_sqlite3_busy();
-        goto cleanup_and_finish;
+    if( sql_result != SQLITE_OK ) {
+      if( sql_result == SQLITE_BUSY ) {
+        raise_sqlite3_busy(  );
+      } else {
+        raise_sqlite3_failure( L10N_SQLITE3_STEP_FAILED_ERROR_MESSAGE,
+                               sql_result );
       }
-    } while( busy );
 
-    if( sql_result != SQLITE_DONE ) {
+      sqlite3_exec( db_target->db, "ROLLBACK", NULL, NULL, NULL );
+      for( i = 0; i < entry_count; i++ ) {
+        results[i] = -1;
+      }
       result = -1;
-      raise_sqlite3_failure( L10N_SQLITE3_STEP_FAILED_ERROR_MESSAGE,
-                             sql_result );
-      goto cleanup_and_finish;
     }
   }
 
-cleanup_and_finish:
   config_unlock_mutex( &db_target->db_mutex );
   return result;
 }
+
+int
+send_entry_to_sqlite3_target( const struct stumpless_target *target,
+                              const struct stumpless_entry *entry ) {
+  struct sqlite3_target *db_target;
+  int result;
+
+  db_target = target->id;
+
+  config_lock_mutex( &db_target->db_mutex );
+  result = insert_entry( db_target, entry );
+  config_unlock_mutex( &db_target->db_mutex );
+
+  return result;
+}
@@ -16,6 +16,7 @@
  * limitations under the License.
  */
 
+#include <stdbool.h>
 #include <stddef.h>
 #include <stdio.h>
 #include <string.h>
@@ -24,8 +25,10 @@
 #include <stumpless/entry.h>
 #include <stumpless/target/stream.h>
 #include "private/config/wrapper/locale.h"
+#include "private/config/wrapper/probe.h"
 #include "private/config/wrapper/thread_safety.h"
 #include "private/error.h"
+#include "private/formatter.h"
 #include "private/inthelper.h"
 #include "private/memory.h"
 #include "private/target.h"
@@ -33,6 +36,124 @@
 #include "private/validate.h"
 #include "private/severity.h"
 
+/* static functions */
+
+/**
+ * Gets the line to write for a message, adding the escape codes for the
+ * severity of the message if the target has any. The stream mutex must be
+ * held by the caller.
+ *
+ * @param target The stream target the message is written to.
+ *
+ * @param msg The formatted message.
+ *
+ * @param msg_length The length of the message.
+ *
+ * @param severity The severity of the entry the message was formatted from.
+ *
+ * @param line_length Set to the length of the returned line.
+ *
+ * @return The message itself if it has no escape codes, a line buffer owned by
+ * the target holding the colored message, or NULL if the line buffer could not
+ * be grown.
+ */
+static
+const char *
+get_line( struct stream_target *target,
+          const char *msg,
+          size_t msg_length,
+          int severity,
+          size_t *line_length ) {
+  size_t code_length;
+  char *new_buffer;
+
+  code_length = target->escape_code_lengths[severity];
+
+  *line_length = msg_length;
+  if( code_length == 0 ) {
+    return msg;
+  }
+
+  *line_length += code_length + STREAM_TARGET_RESET_CODE_LENGTH;
+
+  if( *line_length > target->line_buffer_size ) {
+    new_buffer = realloc_mem( target->line_buffer, *line_length );
+    if( !new_buffer ) {
+      return NULL;
+    }
+
+    target->line_buffer = new_buffer;
+    target->line_buffer_size = *line_length;
+  }
+
+  memcpy( target->line_buffer,
+          target->escape_codes[severity],
+          code_length );
+  memcpy( target->line_buffer + code_length, msg, msg_length );
+  memcpy( target->line_buffer + code_length + msg_length,
+          STREAM_TARGET_RESET_CODE,
+          STREAM_TARGET_RESET_CODE_LENGTH );
+
+  return target->line_buffer;
+}
+
+/**
+ * Writes a run of consecutive uncolored messages from a batch with a single
+ * call to fwrite. The stream mutex must be held by the caller.
+ *
+ * @param target The stream target to write to.
+ *
+ * @param msgs The buffer holding the messages of the batch.
+ *
+ * @param ends The end offset of each message in the batch.
+ *
+ * @param first The index of the first message in the run.
+ *
+ * @param last The index after the last message in the run.
+ *
+ * @param run_start The offset of the first message in the run.
+ *
+ * @param results The results of the batch, which are set for each message in
+ * the run.
+ *
+ * @return true if the run could not be written, false otherwise.
+ */
+static
+bool
+write_run( struct stream_target *target,
+           const char *msgs,
+           const size_t *ends,
+           size_t first,
+           size_t last,
+           size_t run_start,
+           int *results ) {
+  size_t run_length;
+  size_t i;
+  size_t start;
+  bool failed;
+
+  if( first == last ) {
+    return false;
+  }
+
+  run_length = ends[last - 1] - run_start;
+  failed = fwrite( msgs + run_start, sizeof( char ), run_length, target->stream )
+             != run_length;
+  if( failed ) {
+    raise_stream_write_failure(  );
+  }
+
+  start = run_start;
+  for( i = first; i < last; i++ ) {
+    results[i] = failed ? -1 : cap_size_t_to_int( ends[i] - start + 1 );
+    start = ends[i];
+  }
+
+  return failed;
+}
+
+/* public definitions */
+
 void
 stumpless_close_stream_target( const struct stumpless_target *target ) {
   if( !target ) {
@@ -107,9 +228,6 @@ stumpless_open_stream_target( const char *name, FILE *stream ) {
     goto fail_id;
   }
 
-  for (unsigned short i = 0; i < 8; i++)
-    ((struct stream_target *)(target->id))->escape_codes[i][0] = 0;
-
   stumpless_set_current_target( target );
   return target;
 
@@ -120,27 +238,41 @@ fail:
 }
 
 void
-stumpless_set_severity_color( struct stumpless_target *target, enum stumpless_severity severity, const char *escape_code )
-{
-  if (severity_is_invalid(severity)) {
-    raise_invalid_severity(severity);
+stumpless_set_severity_color( struct stumpless_target *target,
+                              enum stumpless_severity severity,
+                              const char *escape_code ) {
+  struct stream_target *starget;
+  size_t code_length;
+
+  VALIDATE_ARG_NOT_NULL_VOID_RETURN( target );
+  VALIDATE_ARG_NOT_NULL_VOID_RETURN( escape_code );
+
+  if( severity_is_invalid( severity ) ) {
+    raise_invalid_severity( severity );
     return;
   }
 
-  lock_target(target);
-  if (target->type != STUMPLESS_STREAM_TARGET) {
+  if( target->type != STUMPLESS_STREAM_TARGET ) {
     raise_target_unsupported(
       L10N_SEVERITY_COLORS_UNSUPPORTED_TARGET_ERROR_MESSAGE );
     return;
   }
 
-  struct stream_target *starget = (struct stream_target *)target->id;
+  code_length = 0;
+  while( code_length < STREAM_TARGET_ESCAPE_CODE_SIZE - 1
+         && escape_code[code_length] != '\0' ) {
+    code_length++;
+  }
+
+  starget = ( struct stream_target * ) target->id;
 
-  strncpy(starget->escape_codes[severity], escape_code, 32);
-  starget->escape_codes[severity][31] = 0;
+  config_lock_mutex( &starget->stream_mutex );
+  memcpy( starget->escape_codes[severity], escape_code, code_length );
+  starget->escape_codes[severity][code_length] = '\0';
+  starget->escape_code_lengths[severity] = code_length;
+  config_unlock_mutex( &starget->stream_mutex );
 
-  unlock_target(target);
-  clear_error();
+  clear_error(  );
 }
 
 
@@ -149,12 +281,14 @@ stumpless_set_severity_color( struct stumpless_target *target, enum stumpless_se
 void
 destroy_stream_target( const struct stream_target *target ) {
   config_destroy_mutex( &target->stream_mutex );
+  free_mem( target->line_buffer );
   free_mem( target );
 }
 
 struct stream_target *
 new_stream_target( FILE *stream ) {
   struct stream_target *target;
+  size_t i;
 
   target = alloc_mem( sizeof( *target ) );
   if( !target ) {
@@ -163,6 +297,13 @@ new_stream_target( FILE *stream ) {
 
   config_init_mutex( &target->stream_mutex );
   target->stream = stream;
+  target->line_buffer = NULL;
+  target->line_buffer_size = 0;
+
+  for( i = 0; i < 8; i++ ) {
+    target->escape_codes[i][0] = '\0';
+    target->escape_code_lengths[i] = 0;
+  }
 
   return target;
 }
@@ -171,43 +312,91 @@ int
 sendto_stream_target( struct stream_target *target,
                       const char *msg,
                       size_t msg_length,
-                      const struct stumpless_entry *entry ) {
+                      int severity ) {
+  const char *line;
+  size_t line_length;
   size_t fwrite_result;
-  enum stumpless_severity severity = stumpless_get_entry_severity(entry);
-  const char *sev_code = target->escape_codes[severity];
-  unsigned short sev_code_len = strlen(sev_code);
-  const char *reset_code = "\33[0m";
-  unsigned short reset_code_len = strlen(reset_code);
-  
+
   config_lock_mutex( &target->stream_mutex );
-  if (sev_code_len != 0)
-  {
-    fwrite_result = fwrite( sev_code, sizeof( char ), sev_code_len, target->stream );
+  config_probe( LOCK_ACQUIRED );
 
-    if( fwrite_result != sev_code_len ) {
-      goto write_failure;
-    }
+  line = get_line( target, msg, msg_length, severity, &line_length );
+  if( !line ) {
+    config_unlock_mutex( &target->stream_mutex );
+    return -1;
   }
 
-  fwrite_result = fwrite( msg, sizeof( char ), msg_length, target->stream );
-  if( fwrite_result != msg_length ) {
-    goto write_failure;
+  config_probe( WRITE_START );
+  fwrite_result = fwrite( line, sizeof( char ), line_length, target->stream );
+  config_probe( WRITE_END );
+
+  config_unlock_mutex( &target->stream_mutex );
+
+  if( fwrite_result != line_length ) {
+    raise_stream_write_failure(  );
+    return -1;
   }
 
-  if (sev_code_len != 0)
-  {
-    fwrite_result = fwrite( reset_code, sizeof( char ), reset_code_len, target->stream );
+  return cap_size_t_to_int( fwrite_result + 1 );
+}
 
-    if( fwrite_result != reset_code_len ) {
-      goto write_failure;
+int
+sendto_stream_target_batch( struct stream_target *target,
+                            const char *msgs,
+                            const size_t *ends,
+                            const int *severities,
+                            size_t count,
+                            int *results ) {
+  size_t i;
+  size_t start = 0;
+  size_t run_first = 0;
+  size_t run_start = 0;
+  const char *line;
+  size_t line_length;
+  int result = 0;
+
+  config_lock_mutex( &target->stream_mutex );
+  config_probe( LOCK_ACQUIRED );
+  config_probe( WRITE_START );
+
+  for( i = 0; i < count; i++ ) {
+    line = get_line( target,
+                     msgs + start,
+                     ends[i] - start,
+                     severities[i],
+                     &line_length );
+
+    // uncolored messages are written together with their neighbors
+    if( line != msgs + start ) {
+      if( write_run( target, msgs, ends, run_first, i, run_start, results ) ) {
+        result = -1;
+      }
+
+      if( !line ) {
+        results[i] = -1;
+        result = -1;
+      } else if( fwrite( line, sizeof( char ), line_length, target->stream )
+                   != line_length ) {
+        raise_stream_write_failure(  );
+        results[i] = -1;
+        result = -1;
+      } else {
+        results[i] = cap_size_t_to_int( line_length + 1 );
+      }
+
+      run_first = i + 1;
+      run_start = ends[i];
     }
+
+    start = ends[i];
   }
 
-  config_unlock_mutex( &target->stream_mutex );
-  return cap_size_t_to_int( fwrite_result + 1 );
+  if( write_run( target, msgs, ends, run_first, count, run_start, results ) ) {
+    result = -1;
+  }
 
-write_failure:
+  config_probe( WRITE_END );
   config_unlock_mutex( &target->stream_mutex );
-  raise_stream_write_failure(  );
-  return -1;
+
+  return result;
 }
@@ -23,7 +23,6 @@
 #include <stumpless/entry.h>
 #include <stumpless/target.h>
 #include <stumpless/target/wel.h>
-#include "private/config/have_windows.h"
 #include "private/config/wrapper/locale.h"
 #include "private/config/wel_supported.h"
 #include "private/entry.h"
@@ -211,11 +210,11 @@ sendto_wel_target( const struct wel_target *target,
   } else {
     event_id = get_event_id( prival );
     insertion_string_count = 1;
-    lock_entry( entry );
-    msg_insertion_strings[0] = windows_copy_cstring_to_lpwstr( entry->message,
-                                                               NULL );
-    unlock_entry( entry );
+    msg_insertion_strings[0] = copy_entry_message_to_lpwstr( entry );
     insertion_strings = msg_insertion_strings;
+    if( !msg_insertion_strings[0] ) {
+      goto cleanup_and_return;
+    }
   }
 
   success = ReportEventW( target->handle,
@@ -0,0 +1,216 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <string.h>
+#include <stumpless/element.h>
+#include <stumpless/entry.h>
+#include <stumpless/param.h>
+#include <stumpless/template.h>
+#include "private/config/wrapper/wel.h"
+#include "private/element.h"
+#include "private/entry.h"
+#include "private/error.h"
+#include "private/facility.h"
+#include "private/memory.h"
+#include "private/param.h"
+#include "private/severity.h"
+#include "private/validate.h"
+
+struct stumpless_entry_template {
+/**
+ * The compiled copy of the prototype. Entries created from the template
+ * reference the param values and message of this entry.
+ */
+  struct stumpless_entry *prototype;
+};
+
+/**
+ * Creates an element with the same name and params as one in a template,
+ * with each param value referencing the template's.
+ *
+ * The element and its params are allocated with their own mutexes rather than
+ * referencing the template's, as callers may get them from the entry and lock
+ * or change them independently of the template and of other entries.
+ */
+static
+struct stumpless_element *
+new_element_from_template( const struct stumpless_element *source ) {
+  struct stumpless_element *element;
+  struct stumpless_param *param;
+  const struct stumpless_param *source_param;
+  size_t i;
+
+  element = alloc_mem( sizeof( *element ) );
+  if( !element ) {
+    return NULL;
+  }
+
+  if( !unchecked_load_element( element,
+                               source->name,
+                               source->name_length ) ) {
+    free_mem( element );
+    return NULL;
+  }
+
+  if( source->param_count == 0 ) {
+    return element;
+  }
+
+  element->params = alloc_array( source->param_count, sizeof( param ) );
+  if( !element->params ) {
+    goto fail;
+  }
+
+  for( i = 0; i < source->param_count; i++ ) {
+    source_param = source->params[i];
+
+    param = alloc_mem( sizeof( *param ) );
+    if( !param ) {
+      goto fail;
+    }
+
+    if( !unchecked_load_param_borrowed( param,
+                                        source_param->name,
+                                        source_param->name_length,
+                                        source_param->value,
+                                        source_param->value_length ) ) {
+      free_mem( param );
+      goto fail;
+    }
+
+    param->owner = element;
+    element->params[i] = param;
+    element->param_count++;
+    element->param_capacity++;
+  }
+
+  return element;
+
+fail:
+  stumpless_destroy_element_and_contents( element );
+  return NULL;
+}
+
+void
+stumpless_destroy_entry_template( const struct stumpless_entry_template *tmpl ) {
+  if( !tmpl ) {
+    return;
+  }
+
+  stumpless_destroy_entry_and_contents( tmpl->prototype );
+  free_mem( tmpl );
+}
+
+struct stumpless_entry *
+stumpless_new_entry_from_template( const struct stumpless_entry_template *tmpl ) {
+  const struct stumpless_entry *prototype;
+  struct stumpless_entry *entry;
+  struct stumpless_element *element;
+  const struct stumpless_entry *result;
+  size_t i;
+
+  VALIDATE_ARG_NOT_NULL( tmpl );
+
+  prototype = tmpl->prototype;
+  entry = new_entry( get_facility( prototype->prival ),
+                     get_severity( prototype->prival ),
+                     prototype->app_name,
+                     prototype->msgid,
+                     NULL,
+                     0 );
+  if( !entry ) {
+    return NULL;
+  }
+
+  memcpy( entry->hostname, prototype->hostname, prototype->hostname_length );
+  entry->hostname[prototype->hostname_length] = '\0';
+  entry->hostname_length = prototype->hostname_length;
+  memcpy( entry->procid, prototype->procid, prototype->procid_length );
+  entry->procid[prototype->procid_length] = '\0';
+  entry->procid_length = prototype->procid_length;
+
+  entry->message = prototype->message;
+  entry->message_length = prototype->message_length;
+  entry->message_borrowed = true;
+
+  if( prototype->element_count != 0 ) {
+    entry->elements = alloc_array( prototype->element_count,
+                                   sizeof( element ) );
+    if( !entry->elements ) {
+      goto fail;
+    }
+
+    for( i = 0; i < prototype->element_count; i++ ) {
+      element = new_element_from_template( prototype->elements[i] );
+      if( !element ) {
+        goto fail;
+      }
+
+      element->owner = entry;
+      entry->elements[i] = element;
+      entry->element_count++;
+      entry->element_capacity++;
+    }
+  }
+
+  result = config_copy_wel_data( entry, prototype );
+  if( !result ) {
+    goto fail;
+  }
+
+  clear_error(  );
+  return entry;
+
+fail:
+  stumpless_destroy_entry_and_contents( entry );
+  return NULL;
+}
+
+struct stumpless_entry_template *
+stumpless_new_entry_template( const struct stumpless_entry *prototype ) {
+  struct stumpless_entry_template *tmpl;
+  struct stumpless_entry *copy;
+
+  VALIDATE_ARG_NOT_NULL( prototype );
+
+  tmpl = alloc_mem( sizeof( *tmpl ) );
+  if( !tmpl ) {
+    return NULL;
+  }
+
+  copy = stumpless_copy_entry( prototype );
+  if( !copy ) {
+    free_mem( tmpl );
+    return NULL;
+  }
+
+  lock_entry( prototype );
+  memcpy( copy->hostname, prototype->hostname, prototype->hostname_length );
+  copy->hostname[prototype->hostname_length] = '\0';
+  copy->hostname_length = prototype->hostname_length;
+  memcpy( copy->procid, prototype->procid, prototype->procid_length );
+  copy->procid[prototype->procid_length] = '\0';
+  copy->procid_length = prototype->procid_length;
+  unlock_entry( prototype );
+
+  tmpl->prototype = copy;
+
+  clear_error(  );
+  return tmpl;
+}
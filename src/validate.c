@@ -25,6 +25,27 @@
 #include "private/validate.h"
 #include "private/config/wrapper/locale.h"
 
+/**
+ * Validates that a length is less than or equal to the maximum length
+ * provided. An error is raised if the validation fails.
+ *
+ * @param length The length of the string, in bytes.
+ *
+ * @param max_length The maximum length allowed for the string.
+ */
+static
+bool
+validate_max_length( size_t length, size_t max_length ) {
+  if( length > max_length ) {
+    raise_argument_too_big( L10N_STRING_TOO_LONG_ERROR_MESSAGE,
+                            length,
+                            L10N_STRING_LENGTH_ERROR_CODE_TYPE );
+    return false;
+  } else {
+    return true;
+  }
+}
+
 /**
  * Validates that a provide string is less than or equal to the maximum length
  * provided. An error is raised if the validation fails.
@@ -41,20 +62,19 @@ static
 bool
 validate_string_length( const char *str, size_t max_length, size_t *length ) {
   *length = strlen( str );
-  if( *length > max_length ) {
-    raise_argument_too_big( L10N_STRING_TOO_LONG_ERROR_MESSAGE,
-                            *length,
-                            L10N_STRING_LENGTH_ERROR_CODE_TYPE );
-    return false;
-  } else {
-    return true;
-  }
+  return validate_max_length( *length, max_length );
 }
 
 bool
 validate_app_name( const char *str, size_t *length ) {
-  return validate_app_name_length( str, length ) &&
-         validate_printable_ascii( str, *length );
+  *length = strlen( str );
+  return validate_app_name_buf( str, *length );
+}
+
+bool
+validate_app_name_buf( const char *str, size_t length ) {
+  return validate_max_length( length, STUMPLESS_MAX_APP_NAME_LENGTH ) &&
+         validate_printable_ascii( str, length );
 }
 
 bool
@@ -66,8 +86,14 @@ validate_app_name_length( const char *app_name, size_t *length ) {
 
 bool
 validate_element_name( const char *str, size_t *length ) {
-  return validate_element_name_length( str, length ) &&
-         validate_name_chars( str, *length );
+  *length = strlen( str );
+  return validate_element_name_buf( str, *length );
+}
+
+bool
+validate_element_name_buf( const char *str, size_t length ) {
+  return validate_max_length( length, STUMPLESS_MAX_ELEMENT_NAME_LENGTH ) &&
+         validate_name_chars( str, length );
 }
 
 bool
@@ -79,8 +105,14 @@ validate_element_name_length( const char *name, size_t *length ) {
 
 bool
 validate_hostname( const char *hostname, size_t *length ) {
-  return validate_hostname_length( hostname, length ) &&
-         validate_printable_ascii( hostname, *length );
+  *length = strlen( hostname );
+  return validate_hostname_buf( hostname, *length );
+}
+
+bool
+validate_hostname_buf( const char *hostname, size_t length ) {
+  return validate_max_length( length, STUMPLESS_MAX_HOSTNAME_LENGTH ) &&
+         validate_printable_ascii( hostname, length );
 }
 
 bool
@@ -92,8 +124,14 @@ validate_hostname_length( const char *hostname, size_t *length ) {
 
 bool
 validate_msgid( const char *str, size_t *length ) {
-  return validate_msgid_length( str, length ) &&
-         validate_printable_ascii( str, *length );
+  *length = strlen( str );
+  return validate_msgid_buf( str, *length );
+}
+
+bool
+validate_msgid_buf( const char *str, size_t length ) {
+  return validate_max_length( length, STUMPLESS_MAX_MSGID_LENGTH ) &&
+         validate_printable_ascii( str, length );
 }
 
 bool
@@ -123,8 +161,14 @@ validate_name_chars( const char *str, size_t length ) {
 
 bool
 validate_param_name( const char *str, size_t *length ) {
-  return validate_param_name_length( str, length ) &&
-         validate_name_chars( str, *length );
+  *length = strlen( str );
+  return validate_param_name_buf( str, *length );
+}
+
+bool
+validate_param_name_buf( const char *str, size_t length ) {
+  return validate_max_length( length, STUMPLESS_MAX_PARAM_NAME_LENGTH ) &&
+         validate_name_chars( str, length );
 }
 
 bool
@@ -242,6 +286,14 @@ validate_utf8_compliance( const char *str, size_t length ) {
     #undef VALIDATE_CONTINUATION_BYTE
   }
 
+  // the string must not end in the middle of a character
+  if( current_state != LEAD_CHAR ) {
+    raise_invalid_encoding(
+      L10N_FORMAT_ERROR_MESSAGE( "UTF-8 continuation byte" )
+    );
+    return false;
+  }
+
   return true;
 }
 
@@ -266,8 +318,14 @@ validate_printable_ascii( const char *str, size_t length ) {
 
 bool
 validate_procid( const char *procid, size_t *length ) {
-  return validate_procid_length( procid, length ) &&
-         validate_printable_ascii( procid, *length );
+  *length = strlen( procid );
+  return validate_procid_buf( procid, *length );
+}
+
+bool
+validate_procid_buf( const char *procid, size_t length ) {
+  return validate_max_length( length, STUMPLESS_MAX_PROCID_LENGTH ) &&
+         validate_printable_ascii( procid, length );
 }
 
 bool
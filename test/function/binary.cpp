@@ -0,0 +1,415 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <fstream>
+#include <iterator>
+#include <string>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stumpless.h>
+#include "test/helper/assert.hpp"
+#include "test/helper/fixture.hpp"
+#include "test/helper/rfc5424.hpp"
+
+using::testing::EndsWith;
+using::testing::HasSubstr;
+using::testing::Not;
+using::testing::StartsWith;
+
+namespace {
+
+  class BinaryTest : public::testing::Test {
+
+    protected:
+      char buffer[8192];
+      char read_buffer[2048];
+      struct stumpless_target *target;
+      struct stumpless_entry *basic_entry;
+      struct stumpless_binary_decoder *decoder;
+
+      virtual void
+      SetUp( void ) {
+        target = stumpless_open_buffer_target( "binary-test",
+                                               buffer,
+                                               sizeof( buffer ) );
+        stumpless_set_target_format( target, STUMPLESS_FORMAT_BINARY );
+        basic_entry = create_entry(  );
+        decoder = stumpless_new_binary_decoder(  );
+      }
+
+      virtual void
+      TearDown( void ) {
+        stumpless_destroy_binary_decoder( decoder );
+        stumpless_destroy_entry_and_contents( basic_entry );
+        stumpless_close_buffer_target( target );
+        stumpless_free_all(  );
+      }
+
+      size_t
+      AddAndRead( const struct stumpless_entry *entry ) {
+        int result;
+        size_t read_result;
+
+        result = stumpless_add_entry( target, entry );
+        EXPECT_NO_ERROR;
+        EXPECT_GE( result, 0 );
+
+        read_result = stumpless_read_buffer( target,
+                                             read_buffer,
+                                             sizeof( read_buffer ) );
+        EXPECT_GT( read_result, 0 );
+
+        return read_result;
+      }
+
+      std::string
+      AddAndDecode( const struct stumpless_entry *entry ) {
+        size_t record_size;
+        size_t consumed;
+        const char *message;
+
+        record_size = AddAndRead( entry );
+        message = stumpless_decode_binary_record( decoder,
+                                                  read_buffer,
+                                                  record_size,
+                                                  &consumed );
+        EXPECT_NO_ERROR;
+        EXPECT_EQ( consumed, record_size );
+        if( !message ) {
+          return std::string(  );
+        }
+
+        return std::string( message );
+      }
+  };
+
+  TEST_F( BinaryTest, DictionaryReferences ) {
+    size_t first_size;
+    size_t second_size;
+    size_t consumed;
+    const char *message;
+
+    first_size = AddAndRead( basic_entry );
+    message = stumpless_decode_binary_record( decoder,
+                                              read_buffer,
+                                              first_size,
+                                              &consumed );
+    EXPECT_NOT_NULL( message );
+
+    second_size = AddAndRead( basic_entry );
+    EXPECT_LT( second_size, first_size );
+    message = stumpless_decode_binary_record( decoder,
+                                              read_buffer,
+                                              second_size,
+                                              &consumed );
+    EXPECT_NO_ERROR;
+    ASSERT_NOT_NULL( message );
+    EXPECT_THAT( message, HasSubstr( " fixture-app-name - fixture-msgid " ) );
+    TestRFC5424Compliance( message );
+  }
+
+  TEST_F( BinaryTest, EscapedParamValue ) {
+    std::string message;
+
+    stumpless_set_entry_param_value_by_name( basic_entry,
+                                             "fixture-element",
+                                             "fixture-param-1",
+                                             "a\"b\\c]d" );
+    EXPECT_NO_ERROR;
+
+    message = AddAndDecode( basic_entry );
+    TestRFC5424Compliance( message );
+    EXPECT_THAT( message,
+                 HasSubstr( "fixture-param-1=\"a\\\"b\\\\c\\]d\"" ) );
+  }
+
+  TEST_F( BinaryTest, FileTarget ) {
+    const char *filename = "binarytestfile.log";
+    struct stumpless_target *file_target;
+    const struct stumpless_entry *entries[3];
+    int results[3];
+    std::string contents;
+    size_t position = 0;
+    size_t consumed;
+    const char *message;
+    int count = 0;
+
+    remove( filename );
+    file_target = stumpless_open_file_target( filename );
+    ASSERT_NOT_NULL( file_target );
+    stumpless_set_target_format( file_target, STUMPLESS_FORMAT_BINARY );
+
+    entries[0] = basic_entry;
+    entries[1] = basic_entry;
+    entries[2] = basic_entry;
+    stumpless_add_entries( file_target, entries, 3, results );
+    EXPECT_NO_ERROR;
+    stumpless_close_file_target( file_target );
+
+    std::ifstream file( filename, std::ios::binary );
+    contents.assign( std::istreambuf_iterator<char>( file ),
+                     std::istreambuf_iterator<char>(  ) );
+
+    while( position < contents.size(  ) ) {
+      message = stumpless_decode_binary_record( decoder,
+                                                contents.data(  ) + position,
+                                                contents.size(  ) - position,
+                                                &consumed );
+      EXPECT_NO_ERROR;
+      ASSERT_NOT_NULL( message );
+      EXPECT_THAT( message, EndsWith( " fixture message" ) );
+      position += consumed;
+      count++;
+    }
+
+    EXPECT_EQ( count, 3 );
+    remove( filename );
+  }
+
+  TEST_F( BinaryTest, IncompleteRecord ) {
+    size_t record_size;
+    size_t consumed = 5;
+    const char *message;
+
+    record_size = AddAndRead( basic_entry );
+
+    message = stumpless_decode_binary_record( decoder,
+                                              read_buffer,
+                                              record_size - 1,
+                                              &consumed );
+    EXPECT_NO_ERROR;
+    EXPECT_NULL( message );
+    EXPECT_EQ( consumed, 0 );
+
+    message = stumpless_decode_binary_record( decoder,
+                                              read_buffer,
+                                              0,
+                                              &consumed );
+    EXPECT_NO_ERROR;
+    EXPECT_NULL( message );
+    EXPECT_EQ( consumed, 0 );
+  }
+
+  TEST_F( BinaryTest, InvalidFlags ) {
+    const char record[] = { 0x03, 0x01, 0x01, '\n' };
+    const char *message;
+    size_t consumed;
+    const struct stumpless_error *error;
+
+    message = stumpless_decode_binary_record( decoder,
+                                              record,
+                                              sizeof( record ),
+                                              &consumed );
+    EXPECT_NULL( message );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+    EXPECT_EQ( consumed, sizeof( record ) );
+  }
+
+  TEST_F( BinaryTest, InvalidLength ) {
+    const char record[] = { 0x00, 0x01, '\n' };
+    const char *message;
+    size_t consumed;
+    const struct stumpless_error *error;
+
+    message = stumpless_decode_binary_record( decoder,
+                                              record,
+                                              sizeof( record ),
+                                              &consumed );
+    EXPECT_NULL( message );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+    EXPECT_EQ( consumed, sizeof( record ) );
+  }
+
+  TEST_F( BinaryTest, InvalidPrival ) {
+    const char record[] = { 0x03,
+                            ( char ) 0x81,
+                            ( char ) 0xc0,
+                            0x01,
+                            '\n' };
+    const char *message;
+    size_t consumed;
+    const struct stumpless_error *error;
+
+    message = stumpless_decode_binary_record( decoder,
+                                              record,
+                                              sizeof( record ),
+                                              &consumed );
+    EXPECT_NULL( message );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+    EXPECT_EQ( consumed, sizeof( record ) );
+  }
+
+  TEST_F( BinaryTest, MissedReset ) {
+    size_t record_size;
+    size_t consumed;
+    const char *message;
+    const struct stumpless_error *error;
+
+    AddAndRead( basic_entry );
+    record_size = AddAndRead( basic_entry );
+
+    message = stumpless_decode_binary_record( decoder,
+                                              read_buffer,
+                                              record_size,
+                                              &consumed );
+    EXPECT_NULL( message );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+    EXPECT_EQ( consumed, record_size );
+  }
+
+  TEST_F( BinaryTest, NilEntry ) {
+    struct stumpless_entry *nil_entry;
+    std::string message;
+
+    nil_entry = create_nil_entry(  );
+    ASSERT_NOT_NULL( nil_entry );
+
+    message = AddAndDecode( nil_entry );
+    EXPECT_THAT( message, StartsWith( "<14>1 " ) );
+    EXPECT_THAT( message, EndsWith( " - - - -" ) );
+    TestRFC5424Compliance( message );
+
+    stumpless_destroy_entry_and_contents( nil_entry );
+  }
+
+  TEST_F( BinaryTest, PastResetInterval ) {
+    std::string message;
+    int i;
+
+    for( i = 0; i < 600; i++ ) {
+      message = AddAndDecode( basic_entry );
+      ASSERT_THAT( message, EndsWith( " fixture message" ) );
+    }
+  }
+
+  TEST_F( BinaryTest, Procid ) {
+    std::string message;
+
+    stumpless_set_option( target, STUMPLESS_OPTION_PID );
+
+    message = AddAndDecode( basic_entry );
+    TestRFC5424Compliance( message );
+    EXPECT_THAT( message, Not( HasSubstr( " fixture-app-name - " ) ) );
+  }
+
+  TEST_F( BinaryTest, RelayedNilTimestamp ) {
+    std::string message;
+    std::string relayed( "<14>1 - - relayed-app - - - relayed message" );
+    const struct stumpless_entry *result;
+
+    result = stumpless_load_entry_from_rfc_5424( basic_entry,
+                                                 relayed.data(  ),
+                                                 relayed.size(  ),
+                                                 NULL,
+                                                 NULL );
+    ASSERT_EQ( result, basic_entry );
+
+    message = AddAndDecode( basic_entry );
+    TestRFC5424Compliance( message );
+    EXPECT_THAT( message, StartsWith( "<14>1 - " ) );
+  }
+
+  TEST_F( BinaryTest, RelayedOffsetTimestamp ) {
+    std::string message;
+    std::string relayed( "<14>1 2003-10-11T22:14:15.003+02:00 - relayed-app "
+                         "- - - relayed message" );
+    const struct stumpless_entry *result;
+
+    result = stumpless_load_entry_from_rfc_5424( basic_entry,
+                                                 relayed.data(  ),
+                                                 relayed.size(  ),
+                                                 NULL,
+                                                 NULL );
+    ASSERT_EQ( result, basic_entry );
+
+    message = AddAndDecode( basic_entry );
+    TestRFC5424Compliance( message );
+    EXPECT_THAT( message, StartsWith( "<14>1 2003-10-11T20:14:15.003000Z " ) );
+
+    relayed = "<14>1 2003-10-11T22:14:15-07:30 - relayed-app - - - relayed";
+    result = stumpless_load_entry_from_rfc_5424( basic_entry,
+                                                 relayed.data(  ),
+                                                 relayed.size(  ),
+                                                 NULL,
+                                                 NULL );
+    ASSERT_EQ( result, basic_entry );
+
+    message = AddAndDecode( basic_entry );
+    EXPECT_THAT( message, StartsWith( "<14>1 2003-10-12T05:44:15.000000Z " ) );
+  }
+
+  TEST_F( BinaryTest, RoundTrip ) {
+    std::string message;
+
+    message = AddAndDecode( basic_entry );
+    TestRFC5424Compliance( message );
+    EXPECT_THAT( message, StartsWith( "<14>1 " ) );
+    EXPECT_THAT( message, HasSubstr( " fixture-app-name - fixture-msgid " ) );
+    EXPECT_THAT( message,
+                 HasSubstr( "[fixture-element "
+                            "fixture-param-1=\"fixture-value-1\" "
+                            "fixture-param-2=\"fixture-value-2\"]" ) );
+    EXPECT_THAT( message, EndsWith( " fixture message" ) );
+  }
+
+  TEST_F( BinaryTest, SmallerThanRfc5424 ) {
+    size_t binary_size;
+    size_t text_size;
+
+    AddAndRead( basic_entry );
+    binary_size = AddAndRead( basic_entry );
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_RFC_5424 );
+    text_size = AddAndRead( basic_entry );
+
+    EXPECT_LT( binary_size, text_size );
+  }
+
+  TEST( DecodeBinaryRecord, NullArguments ) {
+    struct stumpless_binary_decoder *decoder;
+    const char *data = "\x01";
+    size_t consumed;
+    const char *result;
+    const struct stumpless_error *error;
+
+    decoder = stumpless_new_binary_decoder(  );
+    ASSERT_NOT_NULL( decoder );
+
+    result = stumpless_decode_binary_record( NULL, data, 1, &consumed );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    result = stumpless_decode_binary_record( decoder, NULL, 1, &consumed );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    result = stumpless_decode_binary_record( decoder, data, 1, NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_destroy_binary_decoder( decoder );
+    stumpless_free_all(  );
+  }
+
+  TEST( DestroyBinaryDecoder, NullDecoder ) {
+    stumpless_destroy_binary_decoder( NULL );
+  }
+
+}
@@ -0,0 +1,71 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <gtest/gtest.h>
+#include <stumpless.h>
+#include "test/helper/assert.hpp"
+
+namespace {
+
+  TEST( CompressedFileTargetTest, Flush ) {
+    const char *filename = "compressed-unsupported.log";
+    struct stumpless_target *target;
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    target = stumpless_open_file_target( filename );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_flush_compressed_file_target( target );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_file_target( target );
+    stumpless_free_all(  );
+    remove( filename );
+  }
+
+  TEST( CompressedFileTargetTest, Open ) {
+    struct stumpless_target *target;
+    const struct stumpless_error *error;
+
+    target = stumpless_open_compressed_file_target( "unsupported.log.gz", -1 );
+    EXPECT_NULL( target );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_UNSUPPORTED );
+  }
+
+  TEST( CompressedFileTargetTest, SetFrameSize ) {
+    const char *filename = "compressed-unsupported.log";
+    struct stumpless_target *target;
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    target = stumpless_open_file_target( filename );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_compressed_file_frame_size( target, 10 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_file_target( target );
+    stumpless_free_all(  );
+    remove( filename );
+  }
+}
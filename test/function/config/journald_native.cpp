@@ -0,0 +1,273 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stumpless.h>
+#include "test/helper/assert.hpp"
+#include "test/helper/fixture.hpp"
+
+using::testing::HasSubstr;
+using::testing::Not;
+
+namespace {
+
+  class JournaldNativeTest : public::testing::Test {
+
+    protected:
+      int test_socket;
+      const char *socket_name = "journaldnativetest";
+      char buffer[4096];
+      std::string datagram;
+      struct stumpless_target *target;
+      struct stumpless_entry *basic_entry;
+
+      virtual void
+      SetUp( void ) {
+        struct sockaddr_un test_socket_addr;
+        struct timeval read_timeout;
+
+        test_socket_addr.sun_family = AF_UNIX;
+        memcpy(&test_socket_addr.sun_path, socket_name, strlen(socket_name)+1);
+
+        test_socket = socket(test_socket_addr.sun_family, SOCK_DGRAM, 0);
+
+        read_timeout.tv_sec = 2;
+        read_timeout.tv_usec = 0;
+        setsockopt(test_socket, SOL_SOCKET, SO_RCVTIMEO, &read_timeout, sizeof read_timeout);
+
+        bind(test_socket, (struct sockaddr *) &test_socket_addr, sizeof(test_socket_addr));
+
+        stumpless_set_journald_socket_path( socket_name );
+        target = stumpless_open_journald_target( "journald-native-test" );
+
+        basic_entry = create_entry(  );
+      }
+
+      virtual void
+      TearDown( void ) {
+        stumpless_destroy_entry_and_contents( basic_entry );
+        stumpless_close_journald_target( target );
+        stumpless_set_journald_socket_path( NULL );
+        close( test_socket );
+        unlink( socket_name );
+        stumpless_free_all(  );
+      }
+
+      void
+      GetNextDatagram( void ) {
+        ssize_t msg_len;
+
+        msg_len = recv( test_socket, buffer, sizeof( buffer ), 0 );
+        if( msg_len < 0 ) {
+          datagram.clear(  );
+        } else {
+          datagram.assign( buffer, msg_len );
+        }
+      }
+
+  };
+
+  TEST_F( JournaldNativeTest, AddEntry ) {
+    int result;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+
+    GetNextDatagram(  );
+    EXPECT_THAT( datagram, HasSubstr( "\nMESSAGE=fixture message\n" ) );
+    EXPECT_THAT( datagram, HasSubstr( "SYSLOG_IDENTIFIER=fixture-app-name\n" ) );
+    EXPECT_THAT( datagram, HasSubstr( "SYSLOG_MSGID=fixture-msgid\n" ) );
+    EXPECT_THAT( datagram, HasSubstr( "FIXTURE_ELEMENT_FIXTURE_PARAM_1=fixture-value-1\n" ) );
+    EXPECT_EQ( datagram.compare( 0, 9, "PRIORITY=" ), 0 );
+    EXPECT_EQ( datagram.back(  ), '\n' );
+  }
+
+  TEST_F( JournaldNativeTest, AddMultilineMessage ) {
+    int result;
+    const char *message = "first line\nsecond line";
+    std::string expected( "\nMESSAGE\n" );
+
+    expected.push_back( ( char ) strlen( message ) );
+    expected.append( 7, '\0' );
+    expected.append( message );
+    expected.push_back( '\n' );
+
+    stumpless_set_entry_message_str( basic_entry, message );
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+
+    GetNextDatagram(  );
+    EXPECT_THAT( datagram, HasSubstr( expected ) );
+    EXPECT_THAT( datagram, Not( HasSubstr( "MESSAGE=" ) ) );
+  }
+
+  TEST_F( JournaldNativeTest, FacilityOverNine ) {
+    int result;
+
+    stumpless_set_entry_facility( basic_entry, STUMPLESS_FACILITY_LOCAL7 );
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+
+    GetNextDatagram(  );
+    EXPECT_THAT( datagram, HasSubstr( "\nSYSLOG_FACILITY=23\n" ) );
+  }
+
+  TEST_F( JournaldNativeTest, RenameElement ) {
+    int result;
+    struct stumpless_element *element;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+    GetNextDatagram(  );
+    EXPECT_THAT( datagram, HasSubstr( "\nFIXTURE_ELEMENT_FIXTURE_PARAM_1=" ) );
+
+    element = stumpless_get_element_by_index( basic_entry, 0 );
+    stumpless_set_element_name( element, "renamed" );
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+    GetNextDatagram(  );
+    EXPECT_THAT( datagram, HasSubstr( "\nRENAMED=\n" ) );
+    EXPECT_THAT( datagram, HasSubstr( "\nRENAMED_FIXTURE_PARAM_1=fixture-value-1\n" ) );
+    EXPECT_THAT( datagram, Not( HasSubstr( "FIXTURE_ELEMENT" ) ) );
+  }
+
+  TEST_F( JournaldNativeTest, RenameParam ) {
+    int result;
+    struct stumpless_param *param;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+    GetNextDatagram(  );
+
+    param = stumpless_get_param_by_name( stumpless_get_element_by_index( basic_entry, 0 ),
+                                         "fixture-param-1" );
+    ASSERT_NOT_NULL( param );
+    stumpless_set_param_name( param, "new-name" );
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+    GetNextDatagram(  );
+    EXPECT_THAT( datagram, HasSubstr( "\nFIXTURE_ELEMENT_NEW_NAME=fixture-value-1\n" ) );
+    EXPECT_THAT( datagram, Not( HasSubstr( "FIXTURE_PARAM_1" ) ) );
+  }
+
+  TEST_F( JournaldNativeTest, CopiedParamInNewElement ) {
+    int result;
+    struct stumpless_element *element;
+    struct stumpless_param *param;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+    GetNextDatagram(  );
+
+    element = stumpless_new_element( "other" );
+    ASSERT_NOT_NULL( element );
+    param = stumpless_get_param_by_index( stumpless_get_element_by_index( basic_entry, 0 ), 0 );
+    stumpless_add_param( element, stumpless_copy_param( param ) );
+    stumpless_add_element( basic_entry, element );
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+    GetNextDatagram(  );
+    EXPECT_THAT( datagram, HasSubstr( "\nOTHER_FIXTURE_PARAM_1=fixture-value-1\n" ) );
+    EXPECT_THAT( datagram, HasSubstr( "\nFIXTURE_ELEMENT_FIXTURE_PARAM_1=fixture-value-1\n" ) );
+  }
+
+  TEST_F( JournaldNativeTest, FailedDatagramInGroup ) {
+    struct stumpless_entry *huge_entry;
+    const struct stumpless_entry *entries[3];
+    int results[3];
+    int result;
+    // larger than the send buffer of the socket, so it cannot be sent
+    std::string huge_message( 32 * 1024 * 1024, 'a' );
+
+    huge_entry = create_entry(  );
+    ASSERT_NOT_NULL( huge_entry );
+    stumpless_set_entry_message_str( huge_entry, huge_message.c_str(  ) );
+
+    entries[0] = basic_entry;
+    entries[1] = huge_entry;
+    entries[2] = basic_entry;
+
+    result = stumpless_add_entries( target, entries, 3, results );
+    EXPECT_LT( result, 0 );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_JOURNALD_FAILURE );
+    EXPECT_EQ( results[0], 0 );
+    EXPECT_LT( results[1], 0 );
+    EXPECT_EQ( results[2], 0 );
+
+    GetNextDatagram(  );
+    EXPECT_THAT( datagram, HasSubstr( "\nMESSAGE=fixture message\n" ) );
+    GetNextDatagram(  );
+    EXPECT_THAT( datagram, HasSubstr( "\nMESSAGE=fixture message\n" ) );
+
+    stumpless_destroy_entry_and_contents( huge_entry );
+  }
+
+  TEST_F( JournaldNativeTest, MissingSocket ) {
+    int result;
+    const struct stumpless_error *error;
+
+    stumpless_set_journald_socket_path( "journaldnativemissing" );
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_LT( result, 0 );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_JOURNALD_FAILURE );
+  }
+
+  TEST( SetJournaldSocketPath, Default ) {
+    const char *result;
+
+    result = stumpless_set_journald_socket_path( NULL );
+    EXPECT_NO_ERROR;
+    EXPECT_STREQ( result, "/run/systemd/journal/socket" );
+
+    stumpless_free_all(  );
+  }
+
+  TEST( SetJournaldSocketPath, TooLong ) {
+    std::string long_path( 200, 'a' );
+    const char *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_set_journald_socket_path( long_path.c_str(  ) );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_TOO_BIG );
+
+    stumpless_free_all(  );
+  }
+
+}
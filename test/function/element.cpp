@@ -18,6 +18,7 @@
 
 #include <cstddef>
 #include <cstdlib>
+#include <cstring>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <stumpless.h>
@@ -1004,6 +1005,32 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( NewElementTest, NameBuffer ) {
+    struct stumpless_element *element;
+    const char *names = "first-name second-name";
+
+    element = stumpless_new_element_buf( names, 10 );
+    ASSERT_NOT_NULL( element );
+    EXPECT_NO_ERROR;
+
+    EXPECT_EQ( element->name_length, 10 );
+    EXPECT_STREQ( element->name, "first-name" );
+
+    stumpless_destroy_element_and_contents( element );
+    stumpless_free_all(  );
+  }
+
+  TEST( NewElementTest, NameBufferTooLong ) {
+    struct stumpless_element *element;
+    const char *name = "checking-valid-element-name-length";
+
+    element = stumpless_new_element_buf( name, strlen( name ) );
+    EXPECT_NULL( element );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_TOO_BIG );
+
+    stumpless_free_all(  );
+  }
+
   TEST( NewElementTest, NullName ) {
     struct stumpless_element *element;
 
@@ -1043,6 +1070,27 @@ namespace {
     stumpless_free_all(  );
   }
   
+  TEST( SetElementNameTest, NameBuffer ) {
+    struct stumpless_element *element;
+    struct stumpless_element *result;
+    const char *names = "first-name second-name";
+
+    element = stumpless_new_element( "element" );
+    ASSERT_NOT_NULL( element );
+
+    result = stumpless_set_element_name_buf( element, names + 11, 11 );
+    EXPECT_EQ( result, element );
+    EXPECT_NO_ERROR;
+    EXPECT_STREQ( element->name, "second-name" );
+
+    result = stumpless_set_element_name_buf( element, "ele=ment", 8 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+
+    stumpless_destroy_element_and_contents( element );
+    stumpless_free_all(  );
+  }
+
   TEST( SetElementNameTest, NullElement ) {
     const struct stumpless_element *result;
 
@@ -2153,6 +2153,356 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( NewPooledEntryTest, NullAppName ) {
+    struct stumpless_entry *entry;
+
+    entry = stumpless_new_pooled_entry_str( STUMPLESS_FACILITY_USER,
+                                            STUMPLESS_SEVERITY_INFO,
+                                            "test-app-name",
+                                            "test-msgid",
+                                            "test-message" );
+    ASSERT_NOT_NULL( entry );
+    stumpless_release_pooled_entry( entry );
+
+    entry = stumpless_new_pooled_entry_str( STUMPLESS_FACILITY_USER,
+                                            STUMPLESS_SEVERITY_INFO,
+                                            NULL,
+                                            NULL,
+                                            NULL );
+    ASSERT_NOT_NULL( entry );
+    EXPECT_NO_ERROR;
+
+    EXPECT_STREQ( entry->app_name, "-" );
+    EXPECT_STREQ( entry->msgid, "-" );
+    EXPECT_NULL( entry->message );
+
+    stumpless_release_pooled_entry( entry );
+    stumpless_free_all(  );
+  }
+
+  TEST( NewPooledEntryTest, ReusesEntry ) {
+    struct stumpless_entry *entry;
+    struct stumpless_entry *reused;
+    const char *message;
+
+    entry = stumpless_new_pooled_entry_str( STUMPLESS_FACILITY_USER,
+                                            STUMPLESS_SEVERITY_INFO,
+                                            "test-app-name",
+                                            "test-msgid",
+                                            "test-message" );
+    ASSERT_NOT_NULL( entry );
+    EXPECT_NO_ERROR;
+
+    stumpless_release_pooled_entry( entry );
+
+    reused = stumpless_new_pooled_entry_str( STUMPLESS_FACILITY_LOCAL0,
+                                             STUMPLESS_SEVERITY_ERR,
+                                             "other-app-name",
+                                             "other-msgid",
+                                             "other message" );
+    ASSERT_NOT_NULL( reused );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( reused, entry );
+
+    EXPECT_EQ( stumpless_get_entry_facility( reused ),
+               STUMPLESS_FACILITY_LOCAL0 );
+    EXPECT_EQ( stumpless_get_entry_severity( reused ), STUMPLESS_SEVERITY_ERR );
+    EXPECT_STREQ( reused->app_name, "other-app-name" );
+    EXPECT_STREQ( reused->msgid, "other-msgid" );
+    message = stumpless_get_entry_message( reused );
+    EXPECT_STREQ( message, "other message" );
+    free( ( void * ) message );
+
+    stumpless_release_pooled_entry( reused );
+    stumpless_free_all(  );
+  }
+
+  TEST( NewPooledEntryTest, InvalidAppName ) {
+    struct stumpless_entry *entry;
+    const struct stumpless_entry *result;
+
+    entry = create_entry(  );
+    ASSERT_NOT_NULL( entry );
+    stumpless_release_pooled_entry( entry );
+
+    result = stumpless_new_pooled_entry_str( STUMPLESS_FACILITY_USER,
+                                             STUMPLESS_SEVERITY_INFO,
+                                             "app name with spaces",
+                                             "test-msgid",
+                                             "test-message" );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+
+    result = stumpless_new_pooled_entry_str( STUMPLESS_FACILITY_USER,
+                                             STUMPLESS_SEVERITY_INFO,
+                                             "test-app-name",
+                                             "test-msgid",
+                                             "test-message" );
+    EXPECT_EQ( result, entry );
+    EXPECT_EQ( stumpless_get_element_count( entry ), 0 );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
+  TEST( NewPooledEntryTest, InvalidFacility ) {
+    struct stumpless_entry *entry;
+    const struct stumpless_entry *result;
+    const char *app_name;
+
+    entry = create_entry(  );
+    ASSERT_NOT_NULL( entry );
+    stumpless_release_pooled_entry( entry );
+
+    result = stumpless_new_pooled_entry_str( ( enum stumpless_facility ) -66,
+                                             STUMPLESS_SEVERITY_INFO,
+                                             "test-app-name",
+                                             "test-msgid",
+                                             "test-message" );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_FACILITY );
+
+    result = stumpless_new_pooled_entry_str( STUMPLESS_FACILITY_USER,
+                                             STUMPLESS_SEVERITY_INFO,
+                                             NULL,
+                                             NULL,
+                                             NULL );
+    EXPECT_EQ( result, entry );
+
+    app_name = stumpless_get_entry_app_name( entry );
+    EXPECT_STREQ( app_name, "-" );
+    free( ( void * ) app_name );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
+  TEST( ReleasePooledEntryTest, FullPool ) {
+    struct stumpless_entry *entries[20];
+    int i;
+
+    for( i = 0; i < 20; i++ ) {
+      entries[i] = create_entry(  );
+      ASSERT_NOT_NULL( entries[i] );
+    }
+
+    for( i = 0; i < 20; i++ ) {
+      stumpless_release_pooled_entry( entries[i] );
+    }
+
+    stumpless_free_thread(  );
+    stumpless_free_all(  );
+  }
+
+  TEST( ReleasePooledEntryTest, NullEntry ) {
+    stumpless_release_pooled_entry( NULL );
+    stumpless_free_all(  );
+  }
+
+  TEST( ResetEntryTest, NullEntry ) {
+    const struct stumpless_entry *result;
+
+    result = stumpless_reset_entry( NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_free_all(  );
+  }
+
+  TEST( ResetEntryTest, Reset ) {
+    struct stumpless_entry *entry;
+    const struct stumpless_entry *result;
+    int prival;
+
+    entry = create_entry(  );
+    ASSERT_NOT_NULL( entry );
+    stumpless_set_entry_hostname( entry, "test-host" );
+    stumpless_set_entry_procid( entry, "1234" );
+    prival = stumpless_get_entry_prival( entry );
+
+    result = stumpless_reset_entry( entry );
+    EXPECT_EQ( result, entry );
+    EXPECT_NO_ERROR;
+
+    EXPECT_EQ( stumpless_get_element_count( entry ), 0 );
+    EXPECT_EQ( entry->element_capacity, 1 );
+    EXPECT_STREQ( entry->app_name, "-" );
+    EXPECT_STREQ( entry->msgid, "-" );
+    EXPECT_EQ( entry->hostname_length, 0 );
+    EXPECT_EQ( entry->procid_length, 0 );
+    EXPECT_NULL( entry->message );
+    EXPECT_EQ( entry->message_length, 0 );
+    EXPECT_EQ( stumpless_get_entry_prival( entry ), prival );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
+  TEST( ResetEntryTest, ReusesElementsAndParams ) {
+    struct stumpless_entry *entry;
+    struct stumpless_element *element;
+    struct stumpless_param *param;
+    struct stumpless_element *reused_element;
+    struct stumpless_param *reused_param;
+    const struct stumpless_entry *result;
+    const char *value;
+
+    entry = create_entry(  );
+    ASSERT_NOT_NULL( entry );
+    element = entry->elements[0];
+    param = element->params[0];
+
+    stumpless_reset_entry( entry );
+
+    result = stumpless_add_new_param_to_entry( entry,
+                                               "new-element",
+                                               "new-param",
+                                               "short" );
+    EXPECT_EQ( result, entry );
+    EXPECT_NO_ERROR;
+
+    EXPECT_EQ( stumpless_get_element_count( entry ), 1 );
+    reused_element = stumpless_get_element_by_index( entry, 0 );
+    EXPECT_EQ( reused_element, element );
+    EXPECT_STREQ( reused_element->name, "new-element" );
+    EXPECT_EQ( stumpless_get_param_count( reused_element ), 1 );
+
+    reused_param = stumpless_get_param_by_index( reused_element, 0 );
+    EXPECT_EQ( reused_param, param );
+    EXPECT_STREQ( reused_param->name, "new-param" );
+
+    value = stumpless_get_entry_param_value_by_name( entry,
+                                                     "new-element",
+                                                     "new-param" );
+    EXPECT_STREQ( value, "short" );
+    free( ( void * ) value );
+
+    result = stumpless_add_new_element( entry, "new-element" );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_DUPLICATE_ELEMENT );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
+  TEST( ResetEntryTest, AddElementOverKept ) {
+    struct stumpless_entry *entry;
+    struct stumpless_element *element;
+    const struct stumpless_entry *result;
+
+    entry = create_entry(  );
+    ASSERT_NOT_NULL( entry );
+    stumpless_reset_entry( entry );
+
+    element = stumpless_new_element( "added-element" );
+    ASSERT_NOT_NULL( element );
+
+    result = stumpless_add_element( entry, element );
+    EXPECT_EQ( result, entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( stumpless_get_element_count( entry ), 1 );
+    EXPECT_EQ( entry->element_capacity, 1 );
+    EXPECT_EQ( stumpless_get_element_by_index( entry, 0 ), element );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
+  TEST( ResetEntryTest, SharedElementAndParam ) {
+    struct stumpless_entry *first;
+    struct stumpless_entry *second;
+    struct stumpless_element *element;
+    struct stumpless_param *param;
+    const struct stumpless_entry *result;
+    const char *value;
+
+    first = create_entry(  );
+    ASSERT_NOT_NULL( first );
+    second = create_entry(  );
+    ASSERT_NOT_NULL( second );
+
+    element = stumpless_new_element( "shared-element" );
+    ASSERT_NOT_NULL( element );
+    stumpless_add_new_param( element, "shared-param", "shared-value" );
+    stumpless_add_element( first, element );
+    stumpless_add_element( second, element );
+
+    param = stumpless_new_param( "caller-param", "caller-value" );
+    ASSERT_NOT_NULL( param );
+    stumpless_add_param( first->elements[0], param );
+    stumpless_add_param( second->elements[0], param );
+
+    result = stumpless_reset_entry( first );
+    EXPECT_EQ( result, first );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( first->element_capacity, 1 );
+    EXPECT_NE( first->elements[0], element );
+    EXPECT_EQ( first->elements[0]->param_capacity, 2 );
+
+    result = stumpless_add_new_element( first, "new-element" );
+    EXPECT_EQ( result, first );
+    result = stumpless_add_new_element( first, "another-element" );
+    EXPECT_EQ( result, first );
+    result = stumpless_add_new_param_to_entry( first,
+                                               "new-element",
+                                               "new-param",
+                                               "new-value" );
+    EXPECT_EQ( result, first );
+    EXPECT_NO_ERROR;
+
+    EXPECT_STREQ( element->name, "shared-element" );
+    EXPECT_EQ( stumpless_get_param_count( element ), 1 );
+    EXPECT_STREQ( param->name, "caller-param" );
+
+    value = stumpless_get_entry_param_value_by_name( second,
+                                                     "shared-element",
+                                                     "shared-param" );
+    EXPECT_STREQ( value, "shared-value" );
+    free( ( void * ) value );
+
+    value = stumpless_get_entry_param_value_by_name( second,
+                                                     "fixture-element",
+                                                     "caller-param" );
+    EXPECT_STREQ( value, "caller-value" );
+    free( ( void * ) value );
+
+    stumpless_destroy_entry_and_contents( first );
+    stumpless_destroy_entry_and_contents( second );
+    stumpless_free_all(  );
+  }
+
+  TEST( SetAppNameTest, AppNameBuffer ) {
+    struct stumpless_entry *entry;
+    const struct stumpless_entry *result;
+    const char *fields = "buffer-app-name buffer-msgid";
+
+    entry = create_empty_entry(  );
+    ASSERT_NOT_NULL( entry );
+
+    result = stumpless_set_entry_app_name_buf( entry, fields, 15 );
+    EXPECT_EQ( result, entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( entry->app_name_length, 15 );
+    EXPECT_STREQ( entry->app_name, "buffer-app-name" );
+
+    result = stumpless_set_entry_msgid_buf( entry, fields + 16, 12 );
+    EXPECT_EQ( result, entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( entry->msgid_length, 12 );
+    EXPECT_STREQ( entry->msgid, "buffer-msgid" );
+
+    result = stumpless_set_entry_app_name_buf( entry, fields, 16 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+
+    result = stumpless_set_entry_app_name_buf( entry, NULL, 5 );
+    EXPECT_EQ( result, entry );
+    EXPECT_STREQ( entry->app_name, "-" );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
   TEST( SetAppNameTest, NullEntry ) {
     const struct stumpless_entry *result;
 
@@ -2229,6 +2579,79 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( SetMessageBufTest, MessageBuffer ) {
+    struct stumpless_entry *entry;
+    const struct stumpless_entry *result;
+    const char *new_message;
+
+    entry = create_empty_entry(  );
+    ASSERT_NOT_NULL( entry );
+
+    result = stumpless_set_entry_message_buf( entry, "first second", 5 );
+    EXPECT_EQ( entry, result );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( entry->message_length, 5 );
+
+    new_message = stumpless_get_entry_message( entry );
+    EXPECT_STREQ( new_message, "first" );
+    free( ( void * ) new_message );
+
+    result = stumpless_set_entry_message_buf( entry, NULL, 5 );
+    EXPECT_EQ( entry, result );
+    EXPECT_NULL( entry->message );
+    EXPECT_EQ( entry->message_length, 0 );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
+  TEST( SetMessageBorrowedTest, MessageBorrowed ) {
+    struct stumpless_entry *entry;
+    struct stumpless_entry *copy;
+    const struct stumpless_entry *result;
+    const char *message = "borrowed message";
+    const char *new_message;
+
+    entry = create_empty_entry(  );
+    ASSERT_NOT_NULL( entry );
+
+    result = stumpless_set_entry_message_borrowed( entry, message, 8 );
+    EXPECT_EQ( entry, result );
+    EXPECT_NO_ERROR;
+    EXPECT_TRUE( entry->message_borrowed );
+    EXPECT_EQ( entry->message, message );
+    EXPECT_EQ( entry->message_length, 8 );
+
+    new_message = stumpless_get_entry_message( entry );
+    EXPECT_STREQ( new_message, "borrowed" );
+    free( ( void * ) new_message );
+
+    copy = stumpless_copy_entry( entry );
+    ASSERT_NOT_NULL( copy );
+    EXPECT_FALSE( copy->message_borrowed );
+    EXPECT_NE( copy->message, message );
+    EXPECT_STREQ( copy->message, "borrowed" );
+    stumpless_destroy_entry_and_contents( copy );
+
+    result = stumpless_set_entry_message_str( entry, "owned message" );
+    EXPECT_EQ( entry, result );
+    EXPECT_FALSE( entry->message_borrowed );
+    EXPECT_STREQ( entry->message, "owned message" );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
+  TEST( SetMessageBorrowedTest, NullEntry ) {
+    const struct stumpless_entry *result;
+
+    result = stumpless_set_entry_message_borrowed( NULL, "message", 7 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_free_all(  );
+  }
+
   TEST( SetMessageStrTest, AsciiMessage ) {
     struct stumpless_entry *entry;
     const char *ascii_message;
@@ -2655,6 +3078,28 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( SetProcid, SetBuffer ) {
+    struct stumpless_entry *entry;
+    struct stumpless_entry *result;
+
+    entry = create_entry(  );
+    ASSERT_NOT_NULL( entry );
+
+    result = stumpless_set_entry_procid_buf( entry, "1234 5678", 4 );
+    EXPECT_EQ( result, entry );
+    EXPECT_NO_ERROR;
+
+    EXPECT_EQ( entry->procid_length, 4 );
+    EXPECT_STREQ( entry->procid, "1234" );
+
+    result = stumpless_set_entry_procid_buf( entry, "1234 5678", 5 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
   TEST( SetProcid, ResetValue ) {
     struct stumpless_entry *entry;
     struct stumpless_entry *result;
@@ -2832,6 +3277,24 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( SetHostName, SetBuffer ) {
+    struct stumpless_entry *entry;
+    struct stumpless_entry *result;
+
+    entry = create_entry(  );
+    ASSERT_NOT_NULL( entry );
+
+    result = stumpless_set_entry_hostname_buf( entry, "host.example", 4 );
+    EXPECT_EQ( result, entry );
+    EXPECT_NO_ERROR;
+
+    EXPECT_EQ( entry->hostname_length, 4 );
+    EXPECT_STREQ( entry->hostname, "host" );
+
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+  }
+
   TEST( SetHostName, ResetValue ) {
     struct stumpless_entry *entry;
     struct stumpless_entry *result;
@@ -16,12 +16,18 @@
  * limitations under the License.
  */
 
+#include <chrono>
 #include <cstddef>
+#include <thread>
+#include <gmock/gmock.h>
 #include <gtest/gtest.h>
+#include <string>
 #include <stumpless.h>
 #include "test/helper/assert.hpp"
 #include "test/helper/fixture.hpp"
 
+using::testing::HasSubstr;
+
 namespace {
 
   static const size_t TEST_BUFFER_LENGTH = 8192;
@@ -49,6 +55,253 @@ namespace {
     }
   };
 
+  TEST_F( FilterTest, DedupFilterDifferentEntries ) {
+    stumpless_set_target_dedup_window( target, 0 );
+    EXPECT_NO_ERROR;
+
+    EXPECT_TRUE( stumpless_dedup_filter( target, entry ) );
+    EXPECT_FALSE( stumpless_dedup_filter( target, entry ) );
+
+    stumpless_set_entry_message_str( entry, "different message" );
+    EXPECT_TRUE( stumpless_dedup_filter( target, entry ) );
+
+    stumpless_set_entry_msgid( entry, "different-msgid" );
+    EXPECT_TRUE( stumpless_dedup_filter( target, entry ) );
+
+    stumpless_set_entry_severity( entry, STUMPLESS_SEVERITY_ERR );
+    EXPECT_TRUE( stumpless_dedup_filter( target, entry ) );
+  }
+
+  TEST_F( FilterTest, DedupFilterMask ) {
+    stumpless_set_target_dedup_window( target, 0 );
+    EXPECT_NO_ERROR;
+
+    stumpless_set_target_mask( target, 0 );
+    EXPECT_NO_ERROR;
+
+    EXPECT_FALSE( stumpless_dedup_filter( target, entry ) );
+  }
+
+  TEST_F( FilterTest, DedupFilterNotSetUp ) {
+    EXPECT_TRUE( stumpless_dedup_filter( target, entry ) );
+    EXPECT_TRUE( stumpless_dedup_filter( target, entry ) );
+  }
+
+  TEST_F( FilterTest, DedupFilterWindow ) {
+    stumpless_set_target_dedup_window( target, 100 );
+    EXPECT_NO_ERROR;
+
+    EXPECT_TRUE( stumpless_dedup_filter( target, entry ) );
+    EXPECT_FALSE( stumpless_dedup_filter( target, entry ) );
+
+    std::this_thread::sleep_for( std::chrono::milliseconds( 150 ) );
+
+    EXPECT_TRUE( stumpless_dedup_filter( target, entry ) );
+    EXPECT_FALSE( stumpless_dedup_filter( target, entry ) );
+  }
+
+  TEST_F( FilterTest, DedupSummary ) {
+    char read_buffer[1024];
+    int result;
+    int i;
+
+    stumpless_set_target_dedup_window( target, 0 );
+    EXPECT_NO_ERROR;
+    stumpless_set_target_filter( target, stumpless_dedup_filter );
+    EXPECT_NO_ERROR;
+
+    for( i = 0; i < 5; i++ ) {
+      result = stumpless_add_entry( target, entry );
+      EXPECT_NO_ERROR;
+      EXPECT_GE( result, 0 );
+    }
+
+    stumpless_set_entry_message_str( entry, "different message" );
+    result = stumpless_add_entry( target, entry );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( result, 0 );
+
+    stumpless_read_buffer( target, read_buffer, sizeof( read_buffer ) );
+    EXPECT_THAT( read_buffer, HasSubstr( "fixture message" ) );
+
+    stumpless_read_buffer( target, read_buffer, sizeof( read_buffer ) );
+    EXPECT_THAT( read_buffer, HasSubstr( "last message repeated 4 times" ) );
+
+    stumpless_read_buffer( target, read_buffer, sizeof( read_buffer ) );
+    EXPECT_THAT( read_buffer, HasSubstr( "different message" ) );
+  }
+
+  TEST_F( FilterTest, AppNameFilterStage ) {
+    struct stumpless_target *result;
+    size_t passed;
+    size_t dropped;
+
+    result = stumpless_add_app_name_filter_stage( target, "fixture-app-name" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    stumpless_add_entry( target, entry );
+    stumpless_set_entry_app_name( entry, "other-app-name" );
+    stumpless_add_entry( target, entry );
+
+    stumpless_get_filter_stage_stats( target, 0, &passed, &dropped );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( passed, 1 );
+    EXPECT_EQ( dropped, 1 );
+  }
+
+  TEST_F( FilterTest, ClearFilterStages ) {
+    struct stumpless_target *result;
+    size_t count;
+
+    stumpless_add_element_filter_stage( target, "fixture-element" );
+    stumpless_add_filter_stage( target, stumpless_mask_filter );
+    count = stumpless_get_filter_stage_count( target );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( count, 2 );
+
+    result = stumpless_clear_filter_stages( target );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    count = stumpless_get_filter_stage_count( target );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( count, 0 );
+  }
+
+  TEST_F( FilterTest, ElementFilterStage ) {
+    struct stumpless_target *result;
+    struct stumpless_entry *empty_entry;
+    size_t passed;
+    size_t dropped;
+
+    result = stumpless_add_element_filter_stage( target, "fixture-element" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    empty_entry = create_empty_entry(  );
+    ASSERT_NOT_NULL( empty_entry );
+
+    stumpless_add_entry( target, entry );
+    stumpless_add_entry( target, empty_entry );
+
+    stumpless_get_filter_stage_stats( target, 0, &passed, &dropped );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( passed, 1 );
+    EXPECT_EQ( dropped, 1 );
+
+    stumpless_destroy_entry_and_contents( empty_entry );
+  }
+
+  TEST_F( FilterTest, FilterStageIndexOutOfBounds ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+    size_t passed;
+    size_t dropped;
+
+    result = stumpless_get_filter_stage_stats( target, 0, &passed, &dropped );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INDEX_OUT_OF_BOUNDS );
+
+    stumpless_add_filter_stage( target, stumpless_mask_filter );
+    result = stumpless_get_filter_stage_stats( target, 1, &passed, &dropped );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INDEX_OUT_OF_BOUNDS );
+  }
+
+  TEST_F( FilterTest, FilterStageOrder ) {
+    size_t passed;
+    size_t dropped;
+
+    stumpless_add_filter_stage( target, stumpless_mask_filter );
+    stumpless_add_severity_filter_stage( target,
+                                         STUMPLESS_SEVERITY_EMERG,
+                                         STUMPLESS_SEVERITY_WARNING );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( stumpless_get_filter_stage_count( target ), 2 );
+
+    // the severity stage is evaluated first, even though it was added last
+    stumpless_add_entry( target, entry );
+
+    stumpless_get_filter_stage_stats( target, 0, &passed, &dropped );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( passed, 0 );
+    EXPECT_EQ( dropped, 1 );
+
+    stumpless_get_filter_stage_stats( target, 1, &passed, &dropped );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( passed, 0 );
+    EXPECT_EQ( dropped, 0 );
+  }
+
+  TEST_F( FilterTest, FunctionFilterStage ) {
+    struct stumpless_target *result;
+    size_t passed;
+    size_t dropped;
+    int i;
+
+    stumpless_set_target_rate_limit( target,
+                                     10,
+                                     0,
+                                     STUMPLESS_RATE_LIMIT_PER_TARGET );
+    result = stumpless_add_filter_stage( target, stumpless_rate_limit_filter );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    for( i = 0; i < 15; i++ ) {
+      stumpless_add_entry( target, entry );
+    }
+
+    stumpless_get_filter_stage_stats( target, 0, &passed, &dropped );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( passed, 10 );
+    EXPECT_EQ( dropped, 5 );
+  }
+
+  TEST_F( FilterTest, InvalidAppNameFilterStage ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_add_app_name_filter_stage( target, "bad app name" );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+  }
+
+  TEST_F( FilterTest, InvalidElementFilterStage ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_add_element_filter_stage( target, "bad=element" );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+    EXPECT_EQ( stumpless_get_filter_stage_count( target ), 0 );
+  }
+
+  TEST_F( FilterTest, InvalidSeverityFilterStage ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_add_severity_filter_stage(
+               target,
+               STUMPLESS_SEVERITY_EMERG,
+               ( enum stumpless_severity ) 8
+             );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_SEVERITY );
+  }
+
+  TEST_F( FilterTest, ReversedSeverityFilterStage ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_add_severity_filter_stage( target,
+                                                  STUMPLESS_SEVERITY_INFO,
+                                                  STUMPLESS_SEVERITY_ERR );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_SEVERITY );
+    EXPECT_EQ( stumpless_get_filter_stage_count( target ), 0 );
+  }
+
   TEST_F( FilterTest, MaskFilterAccept ) {
     int mask;
 
@@ -81,4 +334,364 @@ namespace {
 
     EXPECT_FALSE( stumpless_mask_filter( target, entry ) );
   }
+
+  TEST_F( FilterTest, RateLimitFilterBytes ) {
+    struct stumpless_target *result;
+
+    // the fixture message is 15 bytes long
+    result = stumpless_set_target_rate_limit( target,
+                                              0,
+                                              30,
+                                              STUMPLESS_RATE_LIMIT_PER_TARGET );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    EXPECT_TRUE( stumpless_rate_limit_filter( target, entry ) );
+    EXPECT_TRUE( stumpless_rate_limit_filter( target, entry ) );
+    EXPECT_FALSE( stumpless_rate_limit_filter( target, entry ) );
+  }
+
+  TEST_F( FilterTest, RateLimitFilterEntries ) {
+    struct stumpless_target *result;
+    int passed = 0;
+    int i;
+
+    result = stumpless_set_target_rate_limit( target,
+                                              10,
+                                              0,
+                                              STUMPLESS_RATE_LIMIT_PER_TARGET );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    for( i = 0; i < 15; i++ ) {
+      if( stumpless_rate_limit_filter( target, entry ) ) {
+        passed++;
+      }
+    }
+
+    EXPECT_EQ( passed, 10 );
+  }
+
+  TEST_F( FilterTest, RateLimitFilterMask ) {
+    stumpless_set_target_rate_limit( target,
+                                     10,
+                                     0,
+                                     STUMPLESS_RATE_LIMIT_PER_TARGET );
+    EXPECT_NO_ERROR;
+
+    stumpless_set_target_mask( target, 0 );
+    EXPECT_NO_ERROR;
+
+    EXPECT_FALSE( stumpless_rate_limit_filter( target, entry ) );
+  }
+
+  TEST_F( FilterTest, RateLimitFilterNoLimit ) {
+    int i;
+
+    for( i = 0; i < 100; i++ ) {
+      EXPECT_TRUE( stumpless_rate_limit_filter( target, entry ) );
+    }
+  }
+
+  TEST_F( FilterTest, RateLimitFilterPerMsgid ) {
+    stumpless_set_target_rate_limit( target,
+                                     1,
+                                     0,
+                                     STUMPLESS_RATE_LIMIT_PER_MSGID );
+    EXPECT_NO_ERROR;
+
+    EXPECT_TRUE( stumpless_rate_limit_filter( target, entry ) );
+    EXPECT_FALSE( stumpless_rate_limit_filter( target, entry ) );
+
+    stumpless_set_entry_msgid( entry, "other-msgid" );
+    EXPECT_TRUE( stumpless_rate_limit_filter( target, entry ) );
+  }
+
+  TEST_F( FilterTest, RateLimitFilterPerSeverity ) {
+    stumpless_set_target_rate_limit( target,
+                                     1,
+                                     0,
+                                     STUMPLESS_RATE_LIMIT_PER_SEVERITY );
+    EXPECT_NO_ERROR;
+
+    stumpless_set_entry_severity( entry, STUMPLESS_SEVERITY_INFO );
+    EXPECT_TRUE( stumpless_rate_limit_filter( target, entry ) );
+    EXPECT_FALSE( stumpless_rate_limit_filter( target, entry ) );
+
+    stumpless_set_entry_severity( entry, STUMPLESS_SEVERITY_ERR );
+    EXPECT_TRUE( stumpless_rate_limit_filter( target, entry ) );
+  }
+
+  TEST_F( FilterTest, RateLimitSummary ) {
+    char read_buffer[1024];
+    int result;
+    int i;
+
+    stumpless_set_target_rate_limit( target,
+                                     10,
+                                     0,
+                                     STUMPLESS_RATE_LIMIT_PER_TARGET );
+    EXPECT_NO_ERROR;
+    stumpless_set_target_filter( target, stumpless_rate_limit_filter );
+    EXPECT_NO_ERROR;
+
+    for( i = 0; i < 15; i++ ) {
+      result = stumpless_add_entry( target, entry );
+      EXPECT_NO_ERROR;
+      EXPECT_GE( result, 0 );
+    }
+
+    for( i = 0; i < 10; i++ ) {
+      stumpless_read_buffer( target, read_buffer, sizeof( read_buffer ) );
+      EXPECT_THAT( read_buffer, HasSubstr( "fixture message" ) );
+    }
+
+    // wait for part of the limit to be replenished
+    std::this_thread::sleep_for( std::chrono::milliseconds( 300 ) );
+
+    result = stumpless_add_entry( target, entry );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( result, 0 );
+
+    stumpless_read_buffer( target, read_buffer, sizeof( read_buffer ) );
+    EXPECT_THAT( read_buffer,
+                 HasSubstr( "5 entries were suppressed by the rate limit" ) );
+
+    stumpless_read_buffer( target, read_buffer, sizeof( read_buffer ) );
+    EXPECT_THAT( read_buffer, HasSubstr( "fixture message" ) );
+  }
+
+  TEST_F( FilterTest, SampleFilterKey ) {
+    struct stumpless_param *param;
+    bool first_result;
+    std::string value;
+    int kept = 0;
+    int i;
+
+    stumpless_set_target_sample_rate( target, STUMPLESS_SEVERITY_INFO, 2 );
+    EXPECT_NO_ERROR;
+    stumpless_set_target_sample_key( target,
+                                     "fixture-element",
+                                     "fixture-param-1" );
+    EXPECT_NO_ERROR;
+
+    first_result = stumpless_sample_filter( target, entry );
+    for( i = 0; i < 100; i++ ) {
+      EXPECT_EQ( stumpless_sample_filter( target, entry ), first_result );
+    }
+
+    param = stumpless_get_param_by_name(
+              stumpless_get_element_by_name( entry, "fixture-element" ),
+              "fixture-param-1" );
+    ASSERT_NOT_NULL( param );
+
+    for( i = 0; i < 1000; i++ ) {
+      value = "trace-" + std::to_string( i );
+      stumpless_set_param_value( param, value.c_str(  ) );
+      if( stumpless_sample_filter( target, entry ) ) {
+        kept++;
+      }
+    }
+
+    EXPECT_GT( kept, 400 );
+    EXPECT_LT( kept, 600 );
+  }
+
+  TEST_F( FilterTest, SampleFilterMask ) {
+    stumpless_set_target_sample_rate( target, STUMPLESS_SEVERITY_INFO, 1 );
+    EXPECT_NO_ERROR;
+
+    stumpless_set_target_mask( target, 0 );
+    EXPECT_NO_ERROR;
+
+    EXPECT_FALSE( stumpless_sample_filter( target, entry ) );
+  }
+
+  TEST_F( FilterTest, SampleFilterNotSetUp ) {
+    int i;
+
+    for( i = 0; i < 100; i++ ) {
+      EXPECT_TRUE( stumpless_sample_filter( target, entry ) );
+    }
+  }
+
+  TEST_F( FilterTest, SampleFilterRate ) {
+    int kept = 0;
+    int i;
+
+    stumpless_set_target_sample_rate( target, STUMPLESS_SEVERITY_INFO, 10 );
+    EXPECT_NO_ERROR;
+
+    for( i = 0; i < 10000; i++ ) {
+      if( stumpless_sample_filter( target, entry ) ) {
+        kept++;
+      }
+    }
+
+    EXPECT_GT( kept, 800 );
+    EXPECT_LT( kept, 1200 );
+  }
+
+  TEST_F( FilterTest, SampleFilterWarningKept ) {
+    int i;
+
+    stumpless_set_target_sample_rate( target,
+                                      STUMPLESS_SEVERITY_WARNING,
+                                      1000 );
+    EXPECT_NO_ERROR;
+    stumpless_set_entry_severity( entry, STUMPLESS_SEVERITY_WARNING );
+
+    for( i = 0; i < 100; i++ ) {
+      EXPECT_TRUE( stumpless_sample_filter( target, entry ) );
+    }
+  }
+
+  TEST( FilterStage, NullArguments ) {
+    struct stumpless_target *target;
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+    char buffer[100];
+    size_t passed;
+    size_t count;
+
+    result = stumpless_add_app_name_filter_stage( NULL, "app" );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    result = stumpless_add_element_filter_stage( NULL, "element" );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    result = stumpless_add_filter_stage( NULL, stumpless_mask_filter );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    result = stumpless_add_severity_filter_stage( NULL,
+                                                  STUMPLESS_SEVERITY_EMERG,
+                                                  STUMPLESS_SEVERITY_DEBUG );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    result = stumpless_clear_filter_stages( NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    count = stumpless_get_filter_stage_count( NULL );
+    EXPECT_EQ( count, 0 );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    target = stumpless_open_buffer_target( "null-arguments",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_add_app_name_filter_stage( target, NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    result = stumpless_add_element_filter_stage( target, NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    result = stumpless_add_filter_stage( target, NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_add_filter_stage( target, stumpless_mask_filter );
+    result = stumpless_get_filter_stage_stats( target, 0, &passed, NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_close_buffer_target( target );
+    stumpless_free_all(  );
+  }
+
+  TEST( SetTargetDedupWindow, NullTarget ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_set_target_dedup_window( NULL, 0 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_free_all(  );
+  }
+
+  TEST( SetTargetRateLimit, NullTarget ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_set_target_rate_limit( NULL,
+                                              10,
+                                              0,
+                                              STUMPLESS_RATE_LIMIT_PER_TARGET );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_free_all(  );
+  }
+
+  TEST( SetTargetSampleKey, NullParamName ) {
+    struct stumpless_target *target;
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+    char buffer[100];
+
+    target = stumpless_open_buffer_target( "null-param-name",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_target_sample_key( target, "element", NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_close_buffer_target( target );
+    stumpless_free_all(  );
+  }
+
+  TEST( SetTargetSampleKey, NullTarget ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_set_target_sample_key( NULL, "element", "param" );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_free_all(  );
+  }
+
+  TEST( SetTargetSampleRate, InvalidSeverity ) {
+    struct stumpless_target *target;
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+    char buffer[100];
+
+    target = stumpless_open_buffer_target( "invalid-severity",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_target_sample_rate( target,
+                                               ( enum stumpless_severity ) 8,
+                                               10 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_SEVERITY );
+
+    stumpless_close_buffer_target( target );
+    stumpless_free_all(  );
+  }
+
+  TEST( SetTargetSampleRate, NullTarget ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_set_target_sample_rate( NULL,
+                                               STUMPLESS_SEVERITY_INFO,
+                                               10 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_free_all(  );
+  }
 }
@@ -0,0 +1,320 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <regex>
+#include <string>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stumpless.h>
+#include "test/helper/assert.hpp"
+#include "test/helper/fixture.hpp"
+
+using::testing::EndsWith;
+using::testing::HasSubstr;
+using::testing::Not;
+using::testing::StartsWith;
+
+namespace {
+
+  class FormatTest : public::testing::Test {
+
+    protected:
+      char buffer[4096];
+      char read_buffer[2048];
+      struct stumpless_target *target;
+      struct stumpless_entry *basic_entry;
+
+      virtual void
+      SetUp( void ) {
+        target = stumpless_open_buffer_target( "format-test",
+                                               buffer,
+                                               sizeof( buffer ) );
+        basic_entry = create_entry(  );
+      }
+
+      virtual void
+      TearDown( void ) {
+        stumpless_destroy_entry_and_contents( basic_entry );
+        stumpless_close_buffer_target( target );
+        stumpless_free_all(  );
+      }
+
+      std::string
+      AddAndRead( const struct stumpless_entry *entry ) {
+        int result;
+        size_t read_result;
+        std::string line;
+
+        result = stumpless_add_entry( target, entry );
+        EXPECT_NO_ERROR;
+        EXPECT_GE( result, 0 );
+
+        read_result = stumpless_read_buffer( target,
+                                             read_buffer,
+                                             sizeof( read_buffer ) );
+        EXPECT_GT( read_result, 0 );
+
+        line.assign( read_buffer );
+        if( !line.empty(  ) && line.back(  ) == '\n' ) {
+          line.pop_back(  );
+        }
+
+        return line;
+      }
+  };
+
+  TEST_F( FormatTest, DefaultFormat ) {
+    enum stumpless_format format;
+    std::string line;
+
+    format = stumpless_get_target_format( target );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( format, STUMPLESS_FORMAT_RFC_5424 );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_THAT( line, StartsWith( "<14>1 " ) );
+  }
+
+  TEST_F( FormatTest, JsonLines ) {
+    const struct stumpless_target *result;
+    std::string line;
+
+    result = stumpless_set_target_format( target, STUMPLESS_FORMAT_JSON_LINES );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+    EXPECT_EQ( stumpless_get_target_format( target ),
+               STUMPLESS_FORMAT_JSON_LINES );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_THAT( line,
+                 StartsWith( "{\"facility\":1,\"severity\":6,\"timestamp\":\"" ) );
+    EXPECT_THAT( line, HasSubstr( ",\"hostname\":\"" ) );
+    EXPECT_THAT( line, HasSubstr( ",\"app_name\":\"fixture-app-name\"" ) );
+    EXPECT_THAT( line, HasSubstr( ",\"msgid\":\"fixture-msgid\"" ) );
+    EXPECT_THAT( line,
+                 HasSubstr( ",\"structured_data\":{\"fixture-element\":{"
+                            "\"fixture-param-1\":\"fixture-value-1\","
+                            "\"fixture-param-2\":\"fixture-value-2\"}}" ) );
+    EXPECT_THAT( line, EndsWith( ",\"message\":\"fixture message\"}" ) );
+    EXPECT_THAT( line, Not( HasSubstr( "procid" ) ) );
+  }
+
+  TEST_F( FormatTest, JsonLinesEscapes ) {
+    std::string line;
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_JSON_LINES );
+    stumpless_set_entry_message_str( basic_entry,
+                                     "q\" b\\ n\n t\t bell\a end" );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_THAT( line,
+                 EndsWith( "\"message\":\"q\\\" b\\\\ n\\n t\\t bell\\u0007 end\"}" ) );
+  }
+
+  TEST_F( FormatTest, JsonLinesNilEntry ) {
+    struct stumpless_entry *nil_entry;
+    std::string line;
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_JSON_LINES );
+    nil_entry = create_nil_entry(  );
+    ASSERT_NOT_NULL( nil_entry );
+
+    line = AddAndRead( nil_entry );
+    EXPECT_THAT( line, EndsWith( "}" ) );
+    EXPECT_THAT( line, Not( HasSubstr( "app_name" ) ) );
+    EXPECT_THAT( line, Not( HasSubstr( "msgid" ) ) );
+    EXPECT_THAT( line, Not( HasSubstr( "structured_data" ) ) );
+    EXPECT_THAT( line, Not( HasSubstr( "message" ) ) );
+
+    stumpless_destroy_entry_and_contents( nil_entry );
+  }
+
+  TEST_F( FormatTest, JsonLinesProcid ) {
+    std::string line;
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_JSON_LINES );
+    stumpless_set_option( target, STUMPLESS_OPTION_PID );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_TRUE( std::regex_search( line,
+                                    std::regex( ",\"procid\":\"[0-9]+\"," ) ) );
+  }
+
+  TEST_F( FormatTest, Logfmt ) {
+    std::string line;
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_LOGFMT );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_THAT( line, StartsWith( "time=" ) );
+    EXPECT_THAT( line, HasSubstr( " app=fixture-app-name" ) );
+    EXPECT_THAT( line, HasSubstr( " msgid=fixture-msgid" ) );
+    EXPECT_THAT( line, HasSubstr( " facility=user level=info" ) );
+    EXPECT_THAT( line,
+                 HasSubstr( " fixture-element.fixture-param-1=fixture-value-1" ) );
+    EXPECT_THAT( line,
+                 HasSubstr( " fixture-element.fixture-param-2=fixture-value-2" ) );
+    EXPECT_THAT( line, EndsWith( " msg=\"fixture message\"" ) );
+  }
+
+  TEST_F( FormatTest, LogfmtQuotedValues ) {
+    std::string line;
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_LOGFMT );
+    stumpless_add_new_param_to_entry( basic_entry,
+                                      "fixture-element",
+                                      "spaced",
+                                      "a b" );
+    stumpless_add_new_param_to_entry( basic_entry,
+                                      "fixture-element",
+                                      "equals",
+                                      "a=b" );
+    stumpless_add_new_param_to_entry( basic_entry,
+                                      "fixture-element",
+                                      "empty",
+                                      "" );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_THAT( line, HasSubstr( " fixture-element.spaced=\"a b\"" ) );
+    EXPECT_THAT( line, HasSubstr( " fixture-element.equals=\"a=b\"" ) );
+    EXPECT_THAT( line, HasSubstr( " fixture-element.empty=\"\"" ) );
+  }
+
+  TEST_F( FormatTest, Rfc3164 ) {
+    std::string line;
+    std::regex rfc3164_regex( "<14>(Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|"
+                              "Nov|Dec) [ 123][0-9] [0-9]{2}:[0-9]{2}:[0-9]{2} "
+                              "[^ ]+ fixture-app-name: fixture message" );
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_RFC_3164 );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_TRUE( std::regex_match( line, rfc3164_regex ) ) << line;
+    EXPECT_THAT( line, Not( HasSubstr( "fixture-element" ) ) );
+  }
+
+  TEST_F( FormatTest, Rfc3164Pid ) {
+    std::string line;
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_RFC_3164 );
+    stumpless_set_option( target, STUMPLESS_OPTION_PID );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_TRUE( std::regex_search( line,
+                                    std::regex( " fixture-app-name\\[[0-9]+\\]: "
+                                                "fixture message$" ) ) );
+  }
+
+  TEST_F( FormatTest, Rfc3164RelayedNilTimestamp ) {
+    std::string line;
+    std::string message( "<14>1 - - relayed-app - - - relayed message" );
+    const struct stumpless_entry *result;
+    std::regex rfc3164_regex( "<14>(Jan|Feb|Mar|Apr|May|Jun|Jul|Aug|Sep|Oct|"
+                              "Nov|Dec) [ 123][0-9] [0-9]{2}:[0-9]{2}:[0-9]{2} "
+                              "[^ ]+ relayed-app: relayed message" );
+
+    result = stumpless_load_entry_from_rfc_5424( basic_entry,
+                                                 message.data(  ),
+                                                 message.size(  ),
+                                                 NULL,
+                                                 NULL );
+    ASSERT_EQ( result, basic_entry );
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_RFC_3164 );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_TRUE( std::regex_match( line, rfc3164_regex ) ) << line;
+  }
+
+  TEST_F( FormatTest, Rfc3164RelayedOffsetTimestamp ) {
+    std::string line;
+    std::string message( "<14>1 2003-10-11T22:14:15.003+02:00 - relayed-app - "
+                         "- - relayed message" );
+    const struct stumpless_entry *result;
+
+    result = stumpless_load_entry_from_rfc_5424( basic_entry,
+                                                 message.data(  ),
+                                                 message.size(  ),
+                                                 NULL,
+                                                 NULL );
+    ASSERT_EQ( result, basic_entry );
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_RFC_3164 );
+
+    line = AddAndRead( basic_entry );
+    EXPECT_THAT( line, StartsWith( "<14>Oct 11 22:14:15 " ) );
+  }
+
+  TEST_F( FormatTest, SetInvalidFormat ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_set_target_format( target,
+                                          ( enum stumpless_format ) -1 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INDEX_OUT_OF_BOUNDS );
+
+    result = stumpless_set_target_format( target,
+                                          ( enum stumpless_format ) 500 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INDEX_OUT_OF_BOUNDS );
+
+    EXPECT_EQ( stumpless_get_target_format( target ),
+               STUMPLESS_FORMAT_RFC_5424 );
+  }
+
+  TEST( GetFormatString, EachFormat ) {
+    const char *result;
+
+    #define CHECK_FORMAT_STRING( STRING, ENUM ) \
+      result = stumpless_get_format_string( STRING ); \
+      EXPECT_STREQ( result, #STRING );
+
+    STUMPLESS_FOREACH_FORMAT( CHECK_FORMAT_STRING )
+  }
+
+  TEST( GetFormatString, NoSuchFormat ) {
+    const char *result;
+
+    result = stumpless_get_format_string( ( enum stumpless_format ) -1 );
+    EXPECT_STREQ( result, "NO_SUCH_FORMAT" );
+
+    result = stumpless_get_format_string( ( enum stumpless_format ) 500 );
+    EXPECT_STREQ( result, "NO_SUCH_FORMAT" );
+  }
+
+  TEST( GetTargetFormat, NullTarget ) {
+    enum stumpless_format result;
+    const struct stumpless_error *error;
+
+    result = stumpless_get_target_format( NULL );
+    EXPECT_EQ( result, STUMPLESS_FORMAT_RFC_5424 );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST( SetTargetFormat, NullTarget ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_set_target_format( NULL, STUMPLESS_FORMAT_JSON_LINES );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+}
@@ -24,6 +24,7 @@
 #include "test/helper/memory_counter.hpp"
 
 NEW_MEMORY_COUNTER( add_new_element_leak )
+NEW_MEMORY_COUNTER( destroy_reset_entry_only )
 NEW_MEMORY_COUNTER( set_app_name_leak )
 NEW_MEMORY_COUNTER( set_param_value_by_name )
 
@@ -54,6 +55,26 @@ namespace {
     ASSERT_NO_LEAK( add_new_element_leak );
   }
 
+  TEST( DestroyEntryOnlyLeakTest, ResetEntry ) {
+    struct stumpless_entry *entry;
+    const struct stumpless_entry *result;
+
+    INIT_MEMORY_COUNTER( destroy_reset_entry_only );
+
+    entry = create_entry(  );
+    EXPECT_NO_ERROR;
+    ASSERT_NOT_NULL( entry );
+
+    result = stumpless_reset_entry( entry );
+    EXPECT_NO_ERROR;
+    ASSERT_EQ( result, entry );
+
+    stumpless_destroy_entry_only( entry );
+    stumpless_free_all(  );
+
+    ASSERT_NO_LEAK( destroy_reset_entry_only );
+  }
+
   TEST( SetAppNameLeakTest, TypicalUse ) {
     struct stumpless_entry *entry;
     const struct stumpless_entry *result;
@@ -323,6 +323,56 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( NewParamTest, NewBuffer ) {
+    struct stumpless_param *param;
+    const char *line = "name=value and more";
+
+    param = stumpless_new_param_buf( line, 4, line + 5, 5 );
+    ASSERT_NOT_NULL( param );
+    EXPECT_NO_ERROR;
+
+    EXPECT_EQ( param->name_length, 4 );
+    EXPECT_STREQ( param->name, "name" );
+    EXPECT_EQ( param->value_length, 5 );
+    EXPECT_STREQ( param->value, "value" );
+
+    stumpless_destroy_param( param );
+    stumpless_free_all(  );
+  }
+
+  TEST( NewParamTest, NewBufferInvalidUTF8 ) {
+    struct stumpless_param *param;
+    // the length ends the value partway through U+2162
+    const char *value = "\xe2\x85\xa2";
+
+    param = stumpless_new_param_buf( "name", 4, value, 2 );
+    EXPECT_NULL( param );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+
+    stumpless_free_all(  );
+  }
+
+  TEST( NewParamTest, NewBorrowed ) {
+    struct stumpless_param *param;
+    char value[] = "borrowed-value";
+    const char *result;
+
+    param = stumpless_new_param_borrowed( "name", 4, value, 8 );
+    ASSERT_NOT_NULL( param );
+    EXPECT_NO_ERROR;
+
+    EXPECT_TRUE( param->value_borrowed );
+    EXPECT_EQ( param->value, value );
+    EXPECT_EQ( param->value_length, 8 );
+
+    result = stumpless_get_param_value( param );
+    EXPECT_STREQ( result, "borrowed" );
+    free( ( void * ) result );
+
+    stumpless_destroy_param( param );
+    stumpless_free_all(  );
+  }
+
   TEST( NewParamTest, NullName ) {
     struct stumpless_param *param;
 
@@ -446,6 +496,26 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( SetName, NameBuffer ) {
+    struct stumpless_param *param;
+    struct stumpless_param *result;
+
+    param = stumpless_new_param( "my-name", "my-value" );
+    ASSERT_NOT_NULL( param );
+
+    result = stumpless_set_param_name_buf( param, "new-name-ignored", 8 );
+    EXPECT_EQ( result, param );
+    EXPECT_NO_ERROR;
+    EXPECT_STREQ( param->name, "new-name" );
+
+    result = stumpless_set_param_name_buf( param, "new=name", 8 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+
+    stumpless_destroy_param( param );
+    stumpless_free_all(  );
+  }
+
   TEST( SetName, NullParam ) {
     const struct stumpless_param *result;
 
@@ -520,6 +590,51 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( SetValue, ValueBuffer ) {
+    struct stumpless_param *param;
+    struct stumpless_param *result;
+
+    param = stumpless_new_param( "my-name", "my-value" );
+    ASSERT_NOT_NULL( param );
+
+    result = stumpless_set_param_value_buf( param, "new-value-ignored", 9 );
+    EXPECT_EQ( result, param );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( param->value_length, 9 );
+    EXPECT_STREQ( param->value, "new-value" );
+
+    stumpless_destroy_param( param );
+    stumpless_free_all(  );
+  }
+
+  TEST( SetValue, ValueBorrowed ) {
+    struct stumpless_param *param;
+    struct stumpless_param *result;
+    const char *value = "borrowed-value";
+
+    param = stumpless_new_param( "my-name", "my-value" );
+    ASSERT_NOT_NULL( param );
+
+    result = stumpless_set_param_value_borrowed( param, value, 8 );
+    EXPECT_EQ( result, param );
+    EXPECT_NO_ERROR;
+    EXPECT_TRUE( param->value_borrowed );
+    EXPECT_EQ( param->value, value );
+
+    result = stumpless_set_param_value( param, "owned-value" );
+    EXPECT_EQ( result, param );
+    EXPECT_FALSE( param->value_borrowed );
+    EXPECT_STREQ( param->value, "owned-value" );
+
+    result = stumpless_set_param_value_borrowed( param, "\xe2\x85\xa2", 2 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INVALID_ENCODING );
+    EXPECT_FALSE( param->value_borrowed );
+
+    stumpless_destroy_param( param );
+    stumpless_free_all(  );
+  }
+
   TEST( SetValue, NullParam ) {
     const struct stumpless_param *result;
 
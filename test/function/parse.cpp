@@ -0,0 +1,376 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stumpless.h>
+#include "test/helper/assert.hpp"
+#include "test/helper/fixture.hpp"
+#include "test/helper/rfc5424.hpp"
+
+using::std::string;
+using::testing::Not;
+using::testing::StartsWith;
+
+namespace {
+
+  class ParseTest : public::testing::Test {
+    protected:
+      struct stumpless_entry *entry;
+      string line;
+      const char *timestamp;
+      size_t timestamp_length;
+
+      virtual void
+      SetUp( void ) {
+        entry = create_entry(  );
+      }
+
+      virtual void
+      TearDown( void ) {
+        stumpless_destroy_entry_and_contents( entry );
+        stumpless_free_all(  );
+      }
+
+      const struct stumpless_entry *
+      Load( const string &message ) {
+        // the timestamp points into the line, so it must be kept
+        line = message;
+        return stumpless_load_entry_from_rfc_5424( entry,
+                                                   line.data(  ),
+                                                   line.size(  ),
+                                                   &timestamp,
+                                                   &timestamp_length );
+      }
+
+      void
+      ExpectInvalid( const string &message,
+                     enum stumpless_error_id id ) {
+        const struct stumpless_entry *result;
+
+        result = Load( message );
+        EXPECT_NULL( result );
+        EXPECT_ERROR_ID_EQ( id );
+      }
+
+      string
+      GetValue( const char *element_name, const char *param_name ) {
+        const char *value;
+        string result;
+
+        value = stumpless_get_entry_param_value_by_name( entry,
+                                                         element_name,
+                                                         param_name );
+        EXPECT_NOT_NULL( value );
+        if( value ) {
+          result = value;
+          free( ( void * ) value );
+        }
+
+        return result;
+      }
+  };
+
+  TEST_F( ParseTest, EscapedParamValue ) {
+    const struct stumpless_entry *result;
+
+    result = Load( "<14>1 - - - - - [e@32473 p=\"a\\\"b\\\\c\\]d\\e]f\"]" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+
+    // the unknown escape is kept, and ']' does not need to be escaped
+    EXPECT_EQ( GetValue( "e@32473", "p" ), "a\"b\\c]d\\e]f" );
+  }
+
+  TEST_F( ParseTest, FullMessage ) {
+    const struct stumpless_entry *result;
+    const char *field;
+    const char *message;
+
+    result = Load( "<165>1 2003-10-11T22:14:15.003Z mymachine.example.com "
+                   "evntslog 1234 ID47 [exampleSDID@32473 iut=\"3\" "
+                   "eventSource=\"Application\" eventID=\"1011\"]"
+                   "[examplePriority@32473 class=\"high\"] An application "
+                   "event log entry..." );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+
+    EXPECT_EQ( stumpless_get_entry_prival( entry ), 165 );
+    EXPECT_EQ( string( timestamp, timestamp_length ),
+               "2003-10-11T22:14:15.003Z" );
+
+    field = stumpless_get_entry_hostname( entry );
+    EXPECT_STREQ( field, "mymachine.example.com" );
+    free( ( void * ) field );
+
+    field = stumpless_get_entry_app_name( entry );
+    EXPECT_STREQ( field, "evntslog" );
+    free( ( void * ) field );
+
+    field = stumpless_get_entry_procid( entry );
+    EXPECT_STREQ( field, "1234" );
+    free( ( void * ) field );
+
+    field = stumpless_get_entry_msgid( entry );
+    EXPECT_STREQ( field, "ID47" );
+    free( ( void * ) field );
+
+    EXPECT_EQ( stumpless_get_element_count( entry ), 2 );
+    EXPECT_EQ( GetValue( "exampleSDID@32473", "iut" ), "3" );
+    EXPECT_EQ( GetValue( "exampleSDID@32473", "eventSource" ), "Application" );
+    EXPECT_EQ( GetValue( "exampleSDID@32473", "eventID" ), "1011" );
+    EXPECT_EQ( GetValue( "examplePriority@32473", "class" ), "high" );
+
+    message = stumpless_get_entry_message( entry );
+    EXPECT_STREQ( message, "An application event log entry..." );
+    free( ( void * ) message );
+  }
+
+  TEST_F( ParseTest, InvalidHeader ) {
+    ExpectInvalid( "", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "14>1 - - - - -", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<>1 - - - - -", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<192>1 - - - - -", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<1000>1 - - - - -", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>2 - - - - -", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1  - - - - -", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - -", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - host\x7f - - - -", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - " + string( 33, 'm' ) + " -",
+                   STUMPLESS_ARGUMENT_TOO_BIG );
+  }
+
+  TEST_F( ParseTest, InvalidStructuredData ) {
+    ExpectInvalid( "<14>1 - - - - - [", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - []", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - [e", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - [e p]", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - [e p=v]", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - [e p=\"v]", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - [e p=\"v\\\"]",
+                   STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - [e p=\"\xff\"]",
+                   STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - [e][e]", STUMPLESS_DUPLICATE_ELEMENT );
+    ExpectInvalid( "<14>1 - - - - - -[e]", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - [e]msg", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 - - - - - x", STUMPLESS_INVALID_ENCODING );
+  }
+
+  TEST_F( ParseTest, FailureResetsEntry ) {
+    const struct stumpless_entry *result;
+
+    result = Load( "<14>1 - - app - - [a x=\"1\"][b y=\"2\"] message" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+
+    ExpectInvalid( "<14>1 - - other - - [b x=\"1\"][c bad",
+                   STUMPLESS_INVALID_ENCODING );
+
+    EXPECT_EQ( stumpless_get_element_count( entry ), 0 );
+    EXPECT_STREQ( entry->app_name, "-" );
+    EXPECT_NULL( entry->message );
+
+    result = Load( "<14>1 - - - - - [a x=\"3\"][b y=\"4\"] reloaded" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+    EXPECT_EQ( stumpless_get_element_count( entry ), 2 );
+    EXPECT_EQ( GetValue( "a", "x" ), "3" );
+    EXPECT_EQ( GetValue( "b", "y" ), "4" );
+  }
+
+  TEST_F( ParseTest, InvalidTimestamp ) {
+    ExpectInvalid( "<14>1 2003-10-11 - - - - -", STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 2003-13-11T22:14:15Z - - - - -",
+                   STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 2003-10-11T24:14:15Z - - - - -",
+                   STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 2003-10-11T22:14:15 - - - - -",
+                   STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 2003-10-11T22:14:15.Z - - - - -",
+                   STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 2003-10-11T22:14:15.0000001Z - - - - -",
+                   STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 2003-10-11t22:14:15z - - - - -",
+                   STUMPLESS_INVALID_ENCODING );
+    ExpectInvalid( "<14>1 2003-10-11T22:14:15+7:00 - - - - -",
+                   STUMPLESS_INVALID_ENCODING );
+  }
+
+  TEST_F( ParseTest, MessageWithBom ) {
+    const struct stumpless_entry *result;
+    const char *message;
+
+    result = Load( "<14>1 - - - - - - \xef\xbb\xbf\xc3\xa9t\xc3\xa9" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+
+    message = stumpless_get_entry_message( entry );
+    EXPECT_STREQ( message, "\xc3\xa9t\xc3\xa9" );
+    free( ( void * ) message );
+
+    ExpectInvalid( "<14>1 - - - - - - \xef\xbb\xbf\xc3",
+                   STUMPLESS_INVALID_ENCODING );
+  }
+
+  TEST_F( ParseTest, MessageWithoutBomIsNotChecked ) {
+    const struct stumpless_entry *result;
+
+    result = Load( "<14>1 - - - - - - \xc3" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+  }
+
+  TEST_F( ParseTest, KeepsTimestamp ) {
+    char buffer[2048];
+    struct stumpless_target *target;
+    const struct stumpless_entry *result;
+    size_t read_size;
+
+    target = stumpless_open_buffer_target( "parse-test",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = Load( "<165>1 2003-10-11T22:14:15.003Z - - - - - forwarded" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+
+    stumpless_add_entry( target, entry );
+    read_size = stumpless_read_buffer( target, buffer, sizeof( buffer ) );
+    ASSERT_GT( read_size, 1 );
+    EXPECT_THAT( buffer, StartsWith( "<165>1 2003-10-11T22:14:15.003Z " ) );
+
+    result = Load( "<165>1 - - - - - - forwarded" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+
+    stumpless_add_entry( target, entry );
+    read_size = stumpless_read_buffer( target, buffer, sizeof( buffer ) );
+    ASSERT_GT( read_size, 1 );
+    EXPECT_THAT( buffer, StartsWith( "<165>1 - " ) );
+
+    stumpless_reset_entry( entry );
+    stumpless_add_entry( target, entry );
+    read_size = stumpless_read_buffer( target, buffer, sizeof( buffer ) );
+    ASSERT_GT( read_size, 1 );
+    TestRFC5424Compliance( buffer );
+    EXPECT_THAT( buffer, Not( StartsWith( "<165>1 - " ) ) );
+
+    stumpless_close_buffer_target( target );
+  }
+
+  TEST_F( ParseTest, NilValues ) {
+    const struct stumpless_entry *result;
+    const char *field;
+
+    result = Load( "<0>1 - - - - - -" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+
+    EXPECT_EQ( stumpless_get_entry_prival( entry ), 0 );
+    EXPECT_NULL( timestamp );
+    EXPECT_EQ( timestamp_length, 0 );
+    EXPECT_EQ( stumpless_get_element_count( entry ), 0 );
+    EXPECT_NULL( stumpless_get_entry_message( entry ) );
+
+    field = stumpless_get_entry_hostname( entry );
+    EXPECT_STREQ( field, "-" );
+    free( ( void * ) field );
+  }
+
+  TEST_F( ParseTest, NullArguments ) {
+    const struct stumpless_entry *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_load_entry_from_rfc_5424( NULL, "<14>1 - - - - -", 15,
+                                                 NULL, NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    result = stumpless_load_entry_from_rfc_5424( entry, NULL, 15, NULL, NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST_F( ParseTest, ReusesEntry ) {
+    const struct stumpless_entry *result;
+    const char *message;
+
+    result = Load( "<14>1 - - - - - [a x=\"1\" y=\"2\"][b z=\"3\"] first "
+                   "message" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+    EXPECT_EQ( stumpless_get_element_count( entry ), 2 );
+
+    result = Load( "<14>1 - - - - - [c w=\"4\"] second" );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, entry );
+
+    EXPECT_EQ( stumpless_get_element_count( entry ), 1 );
+    EXPECT_FALSE( stumpless_entry_has_element( entry, "a" ) );
+    EXPECT_EQ( stumpless_get_param_count( stumpless_get_element_by_index( entry,
+                                                                          0 ) ),
+               1 );
+    EXPECT_EQ( GetValue( "c", "w" ), "4" );
+
+    message = stumpless_get_entry_message( entry );
+    EXPECT_STREQ( message, "second" );
+    free( ( void * ) message );
+  }
+
+  TEST_F( ParseTest, RoundTrip ) {
+    char buffer[2048];
+    struct stumpless_target *target;
+    const struct stumpless_entry *result;
+    size_t read_size;
+    struct stumpless_entry *parsed;
+
+    target = stumpless_open_buffer_target( "parse-test",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+    stumpless_add_entry( target, entry );
+    read_size = stumpless_read_buffer( target, buffer, sizeof( buffer ) );
+    ASSERT_GT( read_size, 1 );
+
+    parsed = create_empty_entry(  );
+    result = stumpless_load_entry_from_rfc_5424( parsed,
+                                                 buffer,
+                                                 strlen( buffer ),
+                                                 NULL,
+                                                 NULL );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, parsed );
+
+    stumpless_add_entry( target, parsed );
+    read_size = stumpless_read_buffer( target, buffer, sizeof( buffer ) );
+    ASSERT_GT( read_size, 1 );
+    TestRFC5424Compliance( buffer );
+
+    EXPECT_EQ( stumpless_get_element_count( parsed ), 1 );
+    EXPECT_TRUE( stumpless_entry_has_element( parsed, "fixture-element" ) );
+
+    stumpless_destroy_entry_and_contents( parsed );
+    stumpless_close_buffer_target( target );
+  }
+}
@@ -0,0 +1,159 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <vector>
+#include <gtest/gtest.h>
+#include <stumpless.h>
+#include "test/helper/assert.hpp"
+#include "test/helper/fixture.hpp"
+
+namespace {
+
+  std::vector<enum stumpless_probe> fired_probes;
+
+  void
+  record_probe( enum stumpless_probe probe ) {
+    fired_probes.push_back( probe );
+  }
+
+  class ProbeTest : public::testing::Test {
+
+    protected:
+      char buffer[1000];
+      struct stumpless_target *target;
+      struct stumpless_entry *basic_entry;
+
+      virtual void
+      SetUp( void ) {
+        target = stumpless_open_buffer_target( "probe-test",
+                                               buffer,
+                                               sizeof( buffer ) );
+        basic_entry = create_entry(  );
+        fired_probes.clear(  );
+        stumpless_set_probe_hook( record_probe );
+      }
+
+      virtual void
+      TearDown( void ) {
+        stumpless_set_probe_hook( NULL );
+        stumpless_destroy_entry_and_contents( basic_entry );
+        stumpless_close_buffer_target( target );
+        stumpless_free_all(  );
+      }
+  };
+
+#ifdef STUMPLESS_PROBES_SUPPORTED
+  TEST_F( ProbeTest, AddEntry ) {
+    int result;
+    std::vector<enum stumpless_probe> expected = {
+      STUMPLESS_PROBE_FILTER_START,
+      STUMPLESS_PROBE_FILTER_END,
+      STUMPLESS_PROBE_FORMAT_START,
+      STUMPLESS_PROBE_TIMESTAMP_START,
+      STUMPLESS_PROBE_TIMESTAMP_END,
+      STUMPLESS_PROBE_FORMAT_END,
+      STUMPLESS_PROBE_SEND_START,
+      STUMPLESS_PROBE_LOCK_ACQUIRED,
+      STUMPLESS_PROBE_WRITE_START,
+      STUMPLESS_PROBE_WRITE_END,
+      STUMPLESS_PROBE_SEND_END
+    };
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( result, 0 );
+
+    EXPECT_EQ( fired_probes, expected );
+  }
+
+  TEST_F( ProbeTest, FilteredEntry ) {
+    int result;
+    std::vector<enum stumpless_probe> expected = {
+      STUMPLESS_PROBE_FILTER_START,
+      STUMPLESS_PROBE_FILTER_END
+    };
+
+    stumpless_set_target_mask( target, 0 );
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, 0 );
+
+    EXPECT_EQ( fired_probes, expected );
+  }
+#else
+  TEST_F( ProbeTest, NotFired ) {
+    int result;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( result, 0 );
+
+    EXPECT_TRUE( fired_probes.empty(  ) );
+  }
+#endif
+
+  TEST_F( ProbeTest, NoHook ) {
+    int result;
+
+    stumpless_set_probe_hook( NULL );
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( result, 0 );
+
+    EXPECT_TRUE( fired_probes.empty(  ) );
+  }
+
+  TEST( GetProbeHook, Default ) {
+    EXPECT_NULL( stumpless_get_probe_hook(  ) );
+  }
+
+  TEST( GetProbeString, EachProbe ) {
+    const char *result;
+
+    #define CHECK_PROBE_STRING( STRING, ENUM ) \
+      result = stumpless_get_probe_string( STRING ); \
+      EXPECT_STREQ( result, #STRING );
+
+    STUMPLESS_FOREACH_PROBE( CHECK_PROBE_STRING )
+  }
+
+  TEST( GetProbeString, NoSuchProbe ) {
+    const char *result;
+
+    result = stumpless_get_probe_string( ( enum stumpless_probe ) -1 );
+    EXPECT_STREQ( result, "NO_SUCH_PROBE" );
+
+    result = stumpless_get_probe_string( ( enum stumpless_probe ) 500 );
+    EXPECT_STREQ( result, "NO_SUCH_PROBE" );
+  }
+
+  TEST( SetProbeHook, Hook ) {
+    stumpless_probe_hook_func_t result;
+
+    result = stumpless_set_probe_hook( record_probe );
+    EXPECT_TRUE( result == record_probe );
+    EXPECT_TRUE( stumpless_get_probe_hook(  ) == record_probe );
+
+    result = stumpless_set_probe_hook( NULL );
+    EXPECT_NULL( result );
+    EXPECT_NULL( stumpless_get_probe_hook(  ) );
+  }
+}
@@ -0,0 +1,202 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstring>
+#include <string>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stumpless.h>
+#include "relay.h"
+
+using::std::string;
+using::testing::EndsWith;
+using::testing::StartsWith;
+
+namespace {
+
+  class RelayTest : public::testing::Test {
+
+    protected:
+      char buffer[8192];
+      char read_buffer[2048];
+      struct relay relay;
+      struct connection *connection;
+      struct stumpless_target *target;
+
+      virtual void
+      SetUp( void ) {
+        target = stumpless_open_buffer_target( "relay-test",
+                                               buffer,
+                                               sizeof( buffer ) );
+        stumpless_set_option( target, STUMPLESS_OPTION_PID );
+
+        memset( &relay, 0, sizeof( relay ) );
+        relay.targets[0] = target;
+        relay.target_count = 1;
+        relay.batch_size = 4;
+        ASSERT_EQ( create_batch( &relay ), 0 );
+
+        connection = new struct connection;
+        connection->size = 0;
+      }
+
+      virtual void
+      TearDown( void ) {
+        delete connection;
+        destroy_batch( &relay );
+        stumpless_close_buffer_target( target );
+        stumpless_free_all(  );
+      }
+
+      int
+      Receive( const string &data ) {
+        memcpy( connection->data + connection->size,
+                data.data(  ),
+                data.size(  ) );
+        connection->size += data.size(  );
+
+        return read_frames( &relay, connection );
+      }
+
+      string
+      ReadMessage( void ) {
+        size_t read_size;
+
+        read_size = stumpless_read_buffer( target,
+                                           read_buffer,
+                                           sizeof( read_buffer ) );
+        if( read_size <= 1 ) {
+          return string(  );
+        }
+
+        return string( read_buffer, read_size - 1 );
+      }
+  };
+
+  TEST_F( RelayTest, FullBatch ) {
+    int result;
+
+    result = Receive( "<14>1 - - - - - one\n"
+                      "<14>1 - - - - - two\n"
+                      "<14>1 - - - - - three\n"
+                      "<14>1 - - - - - four\n"
+                      "<14>1 - - - - - five\n" );
+    EXPECT_EQ( result, 0 );
+    EXPECT_EQ( relay.batch_count, 1 );
+
+    EXPECT_THAT( ReadMessage(  ), EndsWith( " one" ) );
+    EXPECT_THAT( ReadMessage(  ), EndsWith( " two" ) );
+    EXPECT_THAT( ReadMessage(  ), EndsWith( " three" ) );
+    EXPECT_THAT( ReadMessage(  ), EndsWith( " four" ) );
+
+    send_batch( &relay );
+    EXPECT_EQ( relay.batch_count, 0 );
+    EXPECT_THAT( ReadMessage(  ), EndsWith( " five" ) );
+  }
+
+  TEST_F( RelayTest, InvalidFraming ) {
+    EXPECT_EQ( Receive( "12x<14>1 - - - - - bad" ), -1 );
+  }
+
+  TEST_F( RelayTest, InvalidMessage ) {
+    int result;
+
+    result = Receive( "not a syslog message\n<14>1 - - - - - valid\n" );
+    EXPECT_EQ( result, 0 );
+    EXPECT_EQ( relay.batch_count, 1 );
+
+    send_batch( &relay );
+    EXPECT_THAT( ReadMessage(  ), EndsWith( " valid" ) );
+  }
+
+  TEST_F( RelayTest, KeepsMessage ) {
+    string message;
+
+    Receive( "<165>1 2003-10-11T22:14:15.003Z mymachine.example.com evntslog "
+             "1234 ID47 [exampleSDID@32473 iut=\"3\" eventSource=\"App\\]\"] "
+             "An application event log entry...\n" );
+    EXPECT_EQ( relay.batch_count, 1 );
+    send_batch( &relay );
+
+    message = ReadMessage(  );
+    EXPECT_EQ( message,
+               "<165>1 2003-10-11T22:14:15.003Z mymachine.example.com "
+               "evntslog 1234 ID47 [exampleSDID@32473 iut=\"3\" "
+               "eventSource=\"App\\]\"] An application event log entry..." );
+  }
+
+  TEST_F( RelayTest, LargestOctetCountedFrame ) {
+    string header = "<14>1 - - - - - ";
+    string frame;
+    int result;
+
+    frame = std::to_string( MAX_MESSAGE_SIZE ) + " " + header;
+    frame.append( MAX_MESSAGE_SIZE - header.size(  ), 'a' );
+    ASSERT_EQ( frame.size(  ), ( size_t ) MAX_FRAME_SIZE );
+
+    result = Receive( frame );
+    EXPECT_EQ( result, 0 );
+    EXPECT_EQ( relay.batch_count, 1 );
+    EXPECT_EQ( connection->size, 0 );
+  }
+
+  TEST_F( RelayTest, OctetCounting ) {
+    string first = "<14>1 - - - - - first";
+    string second = "<14>1 - - - - - second\nline";
+    int result;
+
+    result = Receive( std::to_string( first.size(  ) ) + " " + first
+                      + std::to_string( second.size(  ) ) + " "
+                      + second.substr( 0, 10 ) );
+    EXPECT_EQ( result, 0 );
+    EXPECT_EQ( relay.batch_count, 1 );
+    EXPECT_EQ( connection->size, 3 + 10 );
+
+    result = Receive( second.substr( 10 ) );
+    EXPECT_EQ( result, 0 );
+    EXPECT_EQ( relay.batch_count, 2 );
+    EXPECT_EQ( connection->size, 0 );
+
+    send_batch( &relay );
+    EXPECT_THAT( ReadMessage(  ), EndsWith( " first" ) );
+    EXPECT_THAT( ReadMessage(  ), EndsWith( " second\nline" ) );
+  }
+
+  TEST_F( RelayTest, TooLongOctetCount ) {
+    EXPECT_EQ( Receive( std::to_string( MAX_MESSAGE_SIZE + 1 ) + " " ), -1 );
+  }
+
+  TEST_F( RelayTest, TrailingNewline ) {
+    int result;
+
+    result = Receive( "<14>1 - - - - - first\n<14>1 - - - - - sec" );
+    EXPECT_EQ( result, 0 );
+    EXPECT_EQ( relay.batch_count, 1 );
+    EXPECT_EQ( connection->size, 19 );
+
+    result = Receive( "ond\n" );
+    EXPECT_EQ( result, 0 );
+    EXPECT_EQ( relay.batch_count, 2 );
+    EXPECT_EQ( connection->size, 0 );
+
+    send_batch( &relay );
+    EXPECT_THAT( ReadMessage(  ), StartsWith( "<14>1 - - - - - first" ) );
+    EXPECT_THAT( ReadMessage(  ), EndsWith( " second" ) );
+  }
+}
@@ -32,6 +32,7 @@
 #include "test/helper/rfc5424.hpp"
 
 using::testing::HasSubstr;
+using::testing::Not;
 
 namespace {
 
@@ -72,6 +73,64 @@ namespace {
     }
   };
 
+  TEST_F( TargetTest, AddEntries ) {
+    struct stumpless_entry *info_entry;
+    struct stumpless_entry *debug_entry;
+    const struct stumpless_entry *entries[3];
+    int results[3];
+    char message_buffer[TEST_BUFFER_LENGTH];
+    int result;
+
+    info_entry = create_entry(  );
+    debug_entry = create_entry(  );
+    stumpless_set_entry_severity( debug_entry, STUMPLESS_SEVERITY_DEBUG );
+    stumpless_set_entry_message_str( debug_entry, "debug message" );
+    stumpless_set_target_mask( target,
+                               STUMPLESS_SEVERITY_MASK_UPTO( STUMPLESS_SEVERITY_INFO ) );
+
+    entries[0] = info_entry;
+    entries[1] = debug_entry;
+    entries[2] = info_entry;
+
+    result = stumpless_add_entries( target, entries, 3, results );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( result, 0 );
+    EXPECT_GT( results[0], 0 );
+    EXPECT_EQ( results[1], 0 );
+    EXPECT_GT( results[2], 0 );
+
+    stumpless_read_buffer( target, message_buffer, TEST_BUFFER_LENGTH );
+    TestRFC5424Compliance( message_buffer );
+    stumpless_read_buffer( target, message_buffer, TEST_BUFFER_LENGTH );
+    TestRFC5424Compliance( message_buffer );
+    EXPECT_THAT( message_buffer, Not( HasSubstr( "debug message" ) ) );
+    stumpless_read_buffer( target, message_buffer, TEST_BUFFER_LENGTH );
+    EXPECT_EQ( message_buffer[0], '\0' );
+
+    stumpless_destroy_entry_and_contents( debug_entry );
+    stumpless_destroy_entry_and_contents( info_entry );
+  }
+
+  TEST_F( TargetTest, AddEntriesNullEntry ) {
+    struct stumpless_entry *entry;
+    const struct stumpless_entry *entries[2];
+    int results[2];
+    int result;
+    const struct stumpless_error *error;
+
+    entry = create_entry(  );
+    entries[0] = NULL;
+    entries[1] = entry;
+
+    result = stumpless_add_entries( target, entries, 2, results );
+    EXPECT_LT( result, 0 );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+    EXPECT_LT( results[0], 0 );
+    EXPECT_GT( results[1], 0 );
+
+    stumpless_destroy_entry_and_contents( entry );
+  }
+
   TEST_F( TargetTest, FilterReject ) {
     const char *message = "filter-reject-message";
     int result;
@@ -192,6 +251,132 @@ namespace {
     EXPECT_TRUE( set_malloc_result == malloc );
   }
 
+  TEST_F( TargetTest, HeaderEntryOverrides ) {
+    struct stumpless_entry *entry;
+    char message_buffer[TEST_BUFFER_LENGTH];
+    std::cmatch matches;
+    std::regex rfc5424_regex( RFC_5424_REGEX_STRING );
+
+    entry = stumpless_new_entry_str( STUMPLESS_FACILITY_USER,
+                                     STUMPLESS_SEVERITY_INFO,
+                                     "entry-app-name",
+                                     "entry-msgid",
+                                     "header override message" );
+    ASSERT_NOT_NULL( entry );
+    stumpless_set_entry_hostname( entry, "entry-hostname" );
+    stumpless_set_entry_procid( entry, "entry-procid" );
+    stumpless_set_option( target, STUMPLESS_OPTION_PID );
+
+    stumpless_add_entry( target, entry );
+    EXPECT_NO_ERROR;
+
+    stumpless_read_buffer( target, message_buffer, TEST_BUFFER_LENGTH );
+    ASSERT_TRUE( std::regex_match( message_buffer, matches, rfc5424_regex ) );
+    EXPECT_EQ( matches[RFC_5424_HOSTNAME_MATCH_INDEX], "entry-hostname" );
+    EXPECT_EQ( matches[RFC_5424_APP_NAME_MATCH_INDEX], "entry-app-name" );
+    EXPECT_EQ( matches[RFC_5424_PROCID_MATCH_INDEX], "entry-procid" );
+
+    stumpless_destroy_entry_and_contents( entry );
+  }
+
+  TEST_F( TargetTest, HeaderUpdatedByDefaultAppName ) {
+    char message_buffer[TEST_BUFFER_LENGTH];
+    std::cmatch matches;
+    std::regex rfc5424_regex( RFC_5424_REGEX_STRING );
+
+    stumpless_add_message( target, "first header message" );
+    stumpless_read_buffer( target, message_buffer, TEST_BUFFER_LENGTH );
+    ASSERT_TRUE( std::regex_match( message_buffer, matches, rfc5424_regex ) );
+    EXPECT_EQ( matches[RFC_5424_APP_NAME_MATCH_INDEX], default_app_name );
+
+    stumpless_set_target_default_app_name( target, "new-app-name" );
+    EXPECT_NO_ERROR;
+
+    stumpless_add_message( target, "second header message" );
+    stumpless_read_buffer( target, message_buffer, TEST_BUFFER_LENGTH );
+    ASSERT_TRUE( std::regex_match( message_buffer, matches, rfc5424_regex ) );
+    EXPECT_EQ( matches[RFC_5424_APP_NAME_MATCH_INDEX], "new-app-name" );
+  }
+
+  TEST_F( TargetTest, ResetStats ) {
+    struct stumpless_target_stats stats;
+    struct stumpless_target *result;
+    size_t i;
+
+    stumpless_add_message( target, "reset-stats-message" );
+
+    result = stumpless_reset_target_stats( target );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    stumpless_get_target_stats( target, &stats );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( stats.entries_accepted, 0 );
+    EXPECT_EQ( stats.entries_sent, 0 );
+    EXPECT_EQ( stats.bytes_written, 0 );
+    for( i = 0; i < STUMPLESS_LATENCY_BUCKET_COUNT; i++ ) {
+      EXPECT_EQ( stats.latency_counts[i], 0 );
+    }
+  }
+
+  TEST_F( TargetTest, Stats ) {
+    struct stumpless_target_stats stats;
+    const struct stumpless_target *result;
+    size_t latency_total = 0;
+    size_t i;
+
+    stumpless_add_message( target, "stats-message-1" );
+    stumpless_add_message( target, "stats-message-2" );
+    stumpless_add_message( target, "stats-message-3" );
+    stumpless_set_target_mask( target, 0 );
+    stumpless_add_message( target, "stats-message-4" );
+
+    result = stumpless_get_target_stats( target, &stats );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    EXPECT_EQ( stats.entries_accepted, 4 );
+    EXPECT_EQ( stats.entries_filtered, 1 );
+    EXPECT_EQ( stats.entries_sent, 3 );
+    EXPECT_EQ( stats.entries_failed, 0 );
+    EXPECT_GT( stats.bytes_written, 0 );
+
+    // the latency histogram is not recorded unless it is enabled
+    for( i = 0; i < STUMPLESS_LATENCY_BUCKET_COUNT; i++ ) {
+      latency_total += stats.latency_counts[i];
+    }
+    EXPECT_EQ( latency_total, 0 );
+  }
+
+  TEST_F( TargetTest, StatsLatencyHistogram ) {
+    struct stumpless_target_stats stats;
+    const struct stumpless_target *result;
+    size_t latency_total = 0;
+    size_t i;
+
+    result = stumpless_set_target_latency_histogram( target, true );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    stumpless_add_message( target, "latency-message-1" );
+    stumpless_add_message( target, "latency-message-2" );
+
+    result = stumpless_set_target_latency_histogram( target, false );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    stumpless_add_message( target, "latency-message-3" );
+
+    stumpless_get_target_stats( target, &stats );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( stats.entries_sent, 3 );
+
+    for( i = 0; i < STUMPLESS_LATENCY_BUCKET_COUNT; i++ ) {
+      latency_total += stats.latency_counts[i];
+    }
+    EXPECT_EQ( latency_total, 2 );
+  }
+
   TEST_F( TargetTest, TraceEntry ) {
     struct stumpless_entry *entry;
     const char *filename = "trace_entry_test.c";
@@ -336,6 +521,37 @@ namespace {
 
   /* non-fixture tests */
 
+  TEST( AddEntriesTest, NullEntries ) {
+    char buffer[100];
+    struct stumpless_target *target;
+    int result;
+    const struct stumpless_error *error;
+
+    target = stumpless_open_buffer_target( "null entries target",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_add_entries( target, NULL, 1, NULL );
+    EXPECT_LT( result, 0 );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_close_buffer_target( target );
+    stumpless_free_all(  );
+  }
+
+  TEST( AddEntriesTest, NullTarget ) {
+    const struct stumpless_entry *entries[1] = { NULL };
+    int result;
+    const struct stumpless_error *error;
+
+    result = stumpless_add_entries( NULL, entries, 1, NULL );
+    EXPECT_LT( result, 0 );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_free_all(  );
+  }
+
   TEST( AddEntryTest, NullEntry ) {
     int result;
     struct stumpless_target *target;
@@ -596,6 +812,22 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( GetLatencyBucketMin, Buckets ) {
+    size_t i;
+
+    EXPECT_EQ( stumpless_get_latency_bucket_min( 0 ), 0 );
+    EXPECT_EQ( stumpless_get_latency_bucket_min( 3 ), 3 );
+    EXPECT_EQ( stumpless_get_latency_bucket_min( 4 ), 4 );
+    EXPECT_EQ( stumpless_get_latency_bucket_min( 8 ), 8 );
+    EXPECT_EQ( stumpless_get_latency_bucket_min( 9 ), 10 );
+    EXPECT_EQ( stumpless_get_latency_bucket_min( 12 ), 16 );
+
+    for( i = 1; i < STUMPLESS_LATENCY_BUCKET_COUNT; i++ ) {
+      EXPECT_LT( stumpless_get_latency_bucket_min( i - 1 ),
+                 stumpless_get_latency_bucket_min( i ) );
+    }
+  }
+
   TEST( GetOption, NullTarget ) {
     int option;
 
@@ -605,6 +837,37 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( GetTargetStats, NullStats ) {
+    char buffer[100];
+    struct stumpless_target *target;
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    target = stumpless_open_buffer_target( "null-stats",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_get_target_stats( target, NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_close_buffer_target( target );
+    stumpless_free_all(  );
+  }
+
+  TEST( GetTargetStats, NullTarget ) {
+    struct stumpless_target_stats stats;
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_get_target_stats( NULL, &stats );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_free_all(  );
+  }
+
   TEST( OpenTarget, AlreadyOpenTarget ) {
     char buffer[100];
     struct stumpless_target *target;
@@ -747,6 +1010,17 @@ namespace {
     stumpless_close_buffer_target( target );
   }
 
+  TEST( ResetTargetStats, NullTarget ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_reset_target_stats( NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_free_all(  );
+  }
+
   TEST( SetDefaultAppName, MemoryFailure ) {
     char buffer[100];
     struct stumpless_target *target;
@@ -1043,6 +1317,16 @@ namespace {
     stumpless_free_all(  );
   }
 
+  TEST( SetLatencyHistogram, NullTarget ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_set_target_latency_histogram( NULL, true );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+    stumpless_free_all(  );
+  }
+
   TEST( SetMask, NullTarget ) {
     const struct stumpless_target *result;
 
@@ -19,6 +19,7 @@
 #include <cstddef>
 #include <cstdlib>
 #include <cstring>
+#include <string>
 #include <gmock/gmock.h>
 #include <gtest/gtest.h>
 #include <stumpless.h>
@@ -155,10 +156,53 @@ namespace {
     stumpless_destroy_entry_and_contents( entry );
   }
 
+  TEST_F( BufferTargetTest, EscapedParamValue ) {
+    struct stumpless_element *element;
+    struct stumpless_param *param;
+    int write_result;
+    size_t read_result;
+
+    element = stumpless_get_element_by_index( basic_entry, 0 );
+    ASSERT_NOT_NULL( element );
+    param = stumpless_new_param( "escaped-param", "a\"b\\c]d" );
+    ASSERT_NOT_NULL( param );
+    stumpless_add_param( element, param );
+
+    write_result = stumpless_add_entry( target, basic_entry );
+    EXPECT_GE( write_result, 0 );
+    EXPECT_NO_ERROR;
+
+    read_result = stumpless_read_buffer( target,
+                                         read_buffer,
+                                         READ_BUFFER_LENGTH );
+    EXPECT_EQ( read_result, write_result );
+    EXPECT_NO_ERROR;
+
+    TestRFC5424Compliance( read_buffer );
+    EXPECT_THAT( read_buffer,
+                 HasSubstr( "escaped-param=\"a\\\"b\\\\c\\]d\"" ) );
+  }
+
   TEST_F( BufferTargetTest, IsOpen ) {
     EXPECT_TRUE( stumpless_target_is_open( target ) );
   }
 
+  TEST_F( BufferTargetTest, LongFormattedMessage ) {
+    std::string padding( 300, 'p' );
+    int write_result;
+    size_t read_result;
+
+    write_result = stump( "start %s end %d", padding.c_str(  ), 42 );
+    EXPECT_GE( write_result, 0 );
+    EXPECT_NO_ERROR;
+
+    read_result = stumpless_read_buffer( target,
+                                         read_buffer,
+                                         READ_BUFFER_LENGTH );
+    EXPECT_EQ( read_result, write_result );
+    EXPECT_THAT( read_buffer, HasSubstr( "start " + padding + " end 42" ) );
+  }
+
   TEST_F( BufferTargetTest, NullReadBuffer ) {
     size_t result;
 
@@ -0,0 +1,305 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstdio>
+#include <sstream>
+#include <string>
+#include <vector>
+#include <gtest/gtest.h>
+#include <stumpless.h>
+#include <zlib.h>
+#include "test/helper/assert.hpp"
+#include "test/helper/fixture.hpp"
+#include "test/helper/rfc5424.hpp"
+
+using::std::string;
+using::std::vector;
+
+namespace {
+
+  /**
+   * Reads all of the lines in a gzip file, the same way that zcat would,
+   * including every member of the file.
+   */
+  vector<string>
+  ReadGzipLines( const char *filename ) {
+    gzFile file;
+    char buffer[4096];
+    int read_count;
+    string contents;
+    string line;
+    vector<string> lines;
+
+    file = gzopen( filename, "rb" );
+    if( !file ) {
+      return lines;
+    }
+
+    while( ( read_count = gzread( file, buffer, sizeof( buffer ) ) ) > 0 ) {
+      contents.append( buffer, read_count );
+    }
+    EXPECT_EQ( read_count, 0 );
+    gzclose( file );
+
+    std::istringstream stream( contents );
+    while( std::getline( stream, line ) ) {
+      lines.push_back( line );
+    }
+
+    return lines;
+  }
+
+  long
+  GetFileSize( const char *filename ) {
+    FILE *file;
+    long size;
+
+    file = fopen( filename, "rb" );
+    if( !file ) {
+      return -1;
+    }
+
+    fseek( file, 0, SEEK_END );
+    size = ftell( file );
+    fclose( file );
+
+    return size;
+  }
+
+  class CompressedFileTargetTest : public::testing::Test {
+    protected:
+      const char *filename = "compressedtestfile.log.gz";
+      struct stumpless_target *target;
+      struct stumpless_entry *basic_entry;
+
+    virtual void
+    SetUp( void ) {
+      remove( filename );
+      target = stumpless_open_compressed_file_target( filename, -1 );
+      basic_entry = create_entry(  );
+    }
+
+    virtual void
+    TearDown( void ) {
+      stumpless_destroy_entry_and_contents( basic_entry );
+      stumpless_close_file_target( target );
+      stumpless_free_all(  );
+      remove( filename );
+    }
+
+    void
+    CloseTarget( void ) {
+      stumpless_close_file_target( target );
+      EXPECT_NO_ERROR;
+      target = NULL;
+    }
+  };
+
+  TEST_F( CompressedFileTargetTest, AddEntries ) {
+    const struct stumpless_entry *entries[3];
+    int results[3];
+    int result;
+    size_t i;
+    vector<string> lines;
+
+    for( i = 0; i < 3; i++ ) {
+      entries[i] = basic_entry;
+    }
+
+    result = stumpless_add_entries( target, entries, 3, results );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( result, 0 );
+
+    for( i = 0; i < 3; i++ ) {
+      EXPECT_GT( results[i], 0 );
+    }
+
+    CloseTarget(  );
+    lines = ReadGzipLines( filename );
+    ASSERT_EQ( lines.size(  ), 3 );
+    for( i = 0; i < 3; i++ ) {
+      TestRFC5424Compliance( lines[i] );
+    }
+  }
+
+  TEST_F( CompressedFileTargetTest, AddEntry ) {
+    int result;
+    vector<string> lines;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_NO_ERROR;
+    EXPECT_GT( result, 0 );
+
+    CloseTarget(  );
+    lines = ReadGzipLines( filename );
+    ASSERT_EQ( lines.size(  ), 1 );
+    TestRFC5424Compliance( lines[0] );
+  }
+
+  TEST_F( CompressedFileTargetTest, AppendToExistingFile ) {
+    vector<string> lines;
+
+    stumpless_add_entry( target, basic_entry );
+    CloseTarget(  );
+
+    target = stumpless_open_compressed_file_target( filename, 9 );
+    ASSERT_NOT_NULL( target );
+    stumpless_add_entry( target, basic_entry );
+    CloseTarget(  );
+
+    lines = ReadGzipLines( filename );
+    EXPECT_EQ( lines.size(  ), 2 );
+  }
+
+  TEST_F( CompressedFileTargetTest, Compresses ) {
+    int result;
+    size_t uncompressed_size = 0;
+    int i;
+
+    for( i = 0; i < 1000; i++ ) {
+      result = stumpless_add_entry( target, basic_entry );
+      ASSERT_GT( result, 0 );
+      uncompressed_size += result;
+    }
+
+    CloseTarget(  );
+    EXPECT_LT( GetFileSize( filename ), ( long ) uncompressed_size / 10 );
+    EXPECT_EQ( ReadGzipLines( filename ).size(  ), 1000 );
+  }
+
+  TEST_F( CompressedFileTargetTest, Flush ) {
+    const struct stumpless_target *result;
+    vector<string> lines;
+
+    stumpless_add_entry( target, basic_entry );
+
+    // the frame is not finished yet
+    EXPECT_EQ( GetFileSize( filename ), 0 );
+
+    result = stumpless_flush_compressed_file_target( target );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    lines = ReadGzipLines( filename );
+    ASSERT_EQ( lines.size(  ), 1 );
+    TestRFC5424Compliance( lines[0] );
+
+    stumpless_add_entry( target, basic_entry );
+    CloseTarget(  );
+    EXPECT_EQ( ReadGzipLines( filename ).size(  ), 2 );
+  }
+
+  TEST_F( CompressedFileTargetTest, FrameSize ) {
+    const struct stumpless_target *result;
+    int i;
+
+    result = stumpless_set_compressed_file_frame_size( target, 0 );
+    EXPECT_NO_ERROR;
+    EXPECT_EQ( result, target );
+
+    // every entry is readable without closing the target
+    for( i = 1; i <= 3; i++ ) {
+      stumpless_add_entry( target, basic_entry );
+      EXPECT_EQ( ReadGzipLines( filename ).size(  ), i );
+    }
+  }
+
+  /* non-fixture tests */
+
+  TEST( CompressedFileTargetFlushTest, NotCompressed ) {
+    const char *filename = "notcompressedflushtest.log";
+    struct stumpless_target *target;
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    target = stumpless_open_file_target( filename );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_flush_compressed_file_target( target );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    result = stumpless_set_compressed_file_frame_size( target, 10 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_file_target( target );
+    stumpless_free_all(  );
+    remove( filename );
+  }
+
+  TEST( CompressedFileTargetFlushTest, NullTarget ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_flush_compressed_file_target( NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST( CompressedFileTargetFlushTest, WrongTargetType ) {
+    char buffer[100];
+    struct stumpless_target *target;
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    target = stumpless_open_buffer_target( "not a file", buffer, 100 );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_flush_compressed_file_target( target );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_buffer_target( target );
+    stumpless_free_all(  );
+  }
+
+  TEST( CompressedFileTargetOpenTest, InvalidLevel ) {
+    struct stumpless_target *target;
+    const struct stumpless_error *error;
+
+    target = stumpless_open_compressed_file_target( "invalid-level.log.gz",
+                                                    10 );
+    EXPECT_NULL( target );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INDEX_OUT_OF_BOUNDS );
+
+    target = stumpless_open_compressed_file_target( "invalid-level.log.gz",
+                                                    -2 );
+    EXPECT_NULL( target );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_INDEX_OUT_OF_BOUNDS );
+  }
+
+  TEST( CompressedFileTargetOpenTest, NullName ) {
+    struct stumpless_target *target;
+    const struct stumpless_error *error;
+
+    target = stumpless_open_compressed_file_target( NULL, -1 );
+    EXPECT_NULL( target );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST( CompressedFileTargetSetFrameSizeTest, NullTarget ) {
+    const struct stumpless_target *result;
+    const struct stumpless_error *error;
+
+    result = stumpless_set_compressed_file_frame_size( NULL, 10 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+}
@@ -62,6 +62,29 @@ namespace {
     }
   };
 
+  TEST_F( FileTargetTest, AddEntries ) {
+    const struct stumpless_entry *entries[3];
+    int results[3];
+    int result;
+    size_t i;
+
+    for( i = 0; i < 3; i++ ) {
+      entries[i] = basic_entry;
+    }
+
+    result = stumpless_add_entries( target, entries, 3, results );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( result, 0 );
+
+    for( i = 0; i < 3; i++ ) {
+      EXPECT_GT( results[i], 0 );
+    }
+
+    stumpless_close_file_target( target );
+    target = NULL;
+    TestRFC5424File( filename, 3 );
+  }
+
   TEST_F( FileTargetTest, AddEntry ) {
     int result;
 
@@ -37,6 +37,91 @@ using::testing::Not;
 
 namespace {
 
+  TEST( NetworkTargetAddDestination, BadTargetType ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    char buffer[100];
+
+    target = stumpless_open_buffer_target( "not-a-network-target",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_add_network_destination( target, "127.0.0.1", NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_buffer_target( target );
+  }
+
+  TEST( NetworkTargetAddDestination, MallocFailure ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    void * ( *set_malloc_result ) ( size_t );
+
+    target = stumpless_open_udp4_target( "target-to-self", "127.0.0.1" );
+    ASSERT_NOT_NULL( target );
+
+    set_malloc_result = stumpless_set_malloc( MALLOC_FAIL );
+    ASSERT_NOT_NULL( set_malloc_result );
+
+    result = stumpless_add_network_destination( target, "127.0.0.1", "5514" );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_MEMORY_ALLOCATION_FAILURE );
+
+    set_malloc_result = stumpless_set_malloc( malloc );
+    ASSERT_TRUE( set_malloc_result == malloc );
+
+    stumpless_close_network_target( target );
+  }
+
+  TEST( NetworkTargetAddDestination, NullDestination ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+
+    target = stumpless_open_udp4_target( "target-to-self", "127.0.0.1" );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_add_network_destination( target, NULL, NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+
+    stumpless_close_network_target( target );
+  }
+
+  TEST( NetworkTargetAddDestination, NullTarget ) {
+    struct stumpless_target *result;
+
+    result = stumpless_add_network_destination( NULL, "127.0.0.1", NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST( NetworkTargetAddDestination, Udp4 ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    int add_result;
+
+    target = stumpless_open_udp4_target( "target-to-self", "127.0.0.1" );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_add_network_destination( target, "127.0.0.1", "5514" );
+    EXPECT_EQ( result, target );
+    EXPECT_NO_ERROR;
+
+    result = stumpless_set_network_balance_policy( target,
+                                                   STUMPLESS_NETWORK_BALANCE_ROUND_ROBIN );
+    EXPECT_EQ( result, target );
+    EXPECT_NO_ERROR;
+
+    add_result = stumpless_add_message( target, "first destination" );
+    EXPECT_GE( add_result, 0 );
+    add_result = stumpless_add_message( target, "second destination" );
+    EXPECT_GE( add_result, 0 );
+
+    stumpless_close_network_target( target );
+  }
+
   TEST( NetworkTargetCloseTest, Generic ) {
     const char *target_name = "generic-close-test";
     struct stumpless_target *target;
@@ -394,6 +479,150 @@ namespace {
     EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
   }
 
+  TEST( NetworkTargetSetBalancePolicy, BadTargetType ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    char buffer[100];
+
+    target = stumpless_open_buffer_target( "not-a-network-target",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_network_balance_policy( target,
+                                                   STUMPLESS_NETWORK_BALANCE_ROUND_ROBIN );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_buffer_target( target );
+  }
+
+  TEST( NetworkTargetSetBalancePolicy, NullTarget ) {
+    struct stumpless_target *result;
+
+    result = stumpless_set_network_balance_policy( NULL,
+                                                   STUMPLESS_NETWORK_BALANCE_ROUND_ROBIN );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST( NetworkTargetSetTcpConnectionCount, BadTargetType ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    char buffer[100];
+
+    target = stumpless_open_buffer_target( "not-a-tcp-target",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_tcp_connection_count( target, 2 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_buffer_target( target );
+  }
+
+  TEST( NetworkTargetSetTcpConnectionCount, NullTarget ) {
+    struct stumpless_target *result;
+
+    result = stumpless_set_tcp_connection_count( NULL, 2 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST( NetworkTargetSetTcpConnectionCount, UdpTarget ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+
+    target = stumpless_open_udp4_target( "not-a-tcp-target", "127.0.0.1" );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_tcp_connection_count( target, 2 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_network_target( target );
+  }
+
+  TEST( NetworkTargetSetTcpReconnectBackoff, BadTargetType ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    char buffer[100];
+
+    target = stumpless_open_buffer_target( "not-a-tcp-target",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_tcp_reconnect_backoff( target, 100, 1000 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_buffer_target( target );
+  }
+
+  TEST( NetworkTargetSetTcpReconnectBackoff, NullTarget ) {
+    struct stumpless_target *result;
+
+    result = stumpless_set_tcp_reconnect_backoff( NULL, 100, 1000 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST( NetworkTargetSetTcpReconnectBackoff, UdpTarget ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+
+    target = stumpless_open_udp4_target( "not-a-tcp-target", "127.0.0.1" );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_tcp_reconnect_backoff( target, 100, 1000 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_network_target( target );
+  }
+
+  TEST( NetworkTargetSetTcpSpillQueueSize, BadTargetType ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    char buffer[100];
+
+    target = stumpless_open_buffer_target( "not-a-tcp-target",
+                                           buffer,
+                                           sizeof( buffer ) );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_tcp_spill_queue_size( target, 4096 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_buffer_target( target );
+  }
+
+  TEST( NetworkTargetSetTcpSpillQueueSize, NullTarget ) {
+    struct stumpless_target *result;
+
+    result = stumpless_set_tcp_spill_queue_size( NULL, 4096 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST( NetworkTargetSetTcpSpillQueueSize, UdpTarget ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+
+    target = stumpless_open_udp4_target( "not-a-tcp-target", "127.0.0.1" );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_tcp_spill_queue_size( target, 4096 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_network_target( target );
+  }
+
   TEST( NetworkTargetSetTransportPort, BadTargetType ) {
     struct stumpless_target *target;
     struct stumpless_target *result;
@@ -91,6 +91,28 @@ namespace {
 
   };
 
+  TEST_F( SocketTargetTest, AddEntries ) {
+    const struct stumpless_entry *entries[2];
+    int results[2];
+    int result;
+
+    entries[0] = basic_entry;
+    entries[1] = basic_entry;
+
+    result = stumpless_add_entries( target, entries, 2, results );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( result, 0 );
+    EXPECT_GT( results[0], 0 );
+    EXPECT_GT( results[1], 0 );
+
+    // each entry is still sent as its own datagram
+    GetNextMessage(  );
+    TestRFC5424Compliance( buffer );
+    EXPECT_EQ( strlen( buffer ), ( size_t ) results[0] );
+    GetNextMessage(  );
+    TestRFC5424Compliance( buffer );
+  }
+
   TEST_F( SocketTargetTest, AddEntry ) {
     stumpless_add_entry( target, basic_entry );
     EXPECT_NO_ERROR;
@@ -281,6 +281,24 @@ namespace {
     stumpless_destroy_entry_only( entry );
   }
 
+  TEST_F( Sqlite3TargetTest, AddEntries ) {
+    const struct stumpless_entry *entries[2];
+    int results[2];
+    int add_result;
+
+    entries[0] = basic_entry;
+    entries[1] = empty_entry;
+
+    add_result = stumpless_add_entries( target, entries, 2, results );
+    EXPECT_GE( add_result, 0 );
+    EXPECT_NO_ERROR;
+    EXPECT_GE( results[0], 0 );
+    EXPECT_GE( results[1], 0 );
+
+    TestEntryInDatabase( std::string( db_filename ), "logs", basic_entry );
+    TestEntryInDatabase( std::string( db_filename ), "logs", empty_entry );
+  }
+
   TEST_F( Sqlite3TargetTest, AddTwoEntries ) {
     int add_result;
 
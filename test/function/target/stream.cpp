@@ -21,6 +21,7 @@
 #include <stddef.h>
 #include <stdlib.h>
 #include <string>
+#include <cstring>
 #include <stumpless.h>
 #include <gtest/gtest.h>
 #include <gmock/gmock.h>
@@ -90,6 +91,84 @@ namespace {
     EXPECT_NO_ERROR;
   }
 
+  TEST_F( StreamTargetTest, AddColoredEntry ) {
+    int result;
+    char line[1024];
+    const char *escape_code = "\33[35m";
+    size_t escape_code_length = strlen( escape_code );
+
+    stumpless_set_severity_color( target, STUMPLESS_SEVERITY_INFO, escape_code );
+    EXPECT_NO_ERROR;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_GE( result, 0 );
+    EXPECT_NO_ERROR;
+
+    rewind( stream );
+    ASSERT_NOT_NULL( fgets( line, sizeof( line ), stream ) );
+    EXPECT_EQ( strncmp( line, escape_code, escape_code_length ), 0 );
+    EXPECT_EQ( strncmp( line + escape_code_length, "<14>1 ", 6 ), 0 );
+
+    ASSERT_NOT_NULL( fgets( line, sizeof( line ), stream ) );
+    EXPECT_STREQ( line, "\33[0m" );
+  }
+
+  TEST_F( StreamTargetTest, AddColoredJsonLinesEntry ) {
+    int result;
+    char line[1024];
+    const char *escape_code = "\33[35m";
+    size_t escape_code_length = strlen( escape_code );
+
+    stumpless_set_target_format( target, STUMPLESS_FORMAT_JSON_LINES );
+    EXPECT_NO_ERROR;
+    stumpless_set_severity_color( target, STUMPLESS_SEVERITY_INFO, escape_code );
+    EXPECT_NO_ERROR;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_GE( result, 0 );
+    EXPECT_NO_ERROR;
+
+    rewind( stream );
+    ASSERT_NOT_NULL( fgets( line, sizeof( line ), stream ) );
+    EXPECT_EQ( strncmp( line, escape_code, escape_code_length ), 0 );
+    EXPECT_EQ( line[escape_code_length], '{' );
+  }
+
+  TEST_F( StreamTargetTest, AddUncoloredSeverity ) {
+    int result;
+    char line[1024];
+
+    stumpless_set_severity_color( target, STUMPLESS_SEVERITY_ERR, "\33[31m" );
+    EXPECT_NO_ERROR;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_GE( result, 0 );
+    EXPECT_NO_ERROR;
+
+    rewind( stream );
+    ASSERT_NOT_NULL( fgets( line, sizeof( line ), stream ) );
+    EXPECT_EQ( strncmp( line, "<14>1 ", 6 ), 0 );
+    EXPECT_NULL( fgets( line, sizeof( line ), stream ) );
+  }
+
+  TEST_F( StreamTargetTest, LongEscapeCode ) {
+    int result;
+    char line[1024];
+    const char *long_code = "\33[38;5;208;48;5;17;1;3;4;53;21;9m";
+
+    stumpless_set_severity_color( target, STUMPLESS_SEVERITY_INFO, long_code );
+    EXPECT_NO_ERROR;
+
+    result = stumpless_add_entry( target, basic_entry );
+    EXPECT_GE( result, 0 );
+    EXPECT_NO_ERROR;
+
+    rewind( stream );
+    ASSERT_NOT_NULL( fgets( line, sizeof( line ), stream ) );
+    EXPECT_EQ( strncmp( line, long_code, 31 ), 0 );
+    EXPECT_EQ( line[31], '<' );
+  }
+
   /* non-fixture tests */
 
   TEST( StreamTargetCloseTest, Generic ) {
@@ -427,6 +506,22 @@ namespace {
     stumpless_free_all();
   }
 
+  TEST(StreamSetSeverityColorTest, NullEscapeCode) {
+    struct stumpless_target *target = stumpless_open_stdout_target("stdout");
+    stumpless_set_severity_color(target, STUMPLESS_SEVERITY_ALERT, NULL);
+
+    EXPECT_ERROR_ID_EQ(STUMPLESS_ARGUMENT_EMPTY);
+
+    stumpless_close_target(target);
+    stumpless_free_all();
+  }
+
+  TEST(StreamSetSeverityColorTest, NullTarget) {
+    stumpless_set_severity_color(NULL, STUMPLESS_SEVERITY_ALERT, "\33[0m");
+
+    EXPECT_ERROR_ID_EQ(STUMPLESS_ARGUMENT_EMPTY);
+  }
+
   TEST(StreamSetSeverityColorTest, WrongTargetType) {
     char buf;
     struct stumpless_target *target = stumpless_open_buffer_target("buffer", &buf, 1);
@@ -18,10 +18,14 @@
 
 #include "test/helper/server.hpp"
 
+#include <cerrno>
+#include <chrono>
 #include <cstddef>
 #include <cstdio>
 #include <cstring>
 #include <regex>
+#include <string>
+#include <thread>
 #include <stumpless.h>
 #include <gtest/gtest.h>
 #include "test/helper/assert.hpp"
@@ -454,6 +458,440 @@ namespace {
     close_server_socket( new_port_handle );
   }
 
+  TEST( Tcp4AddEntryTest, ConnectionPool ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    char buffer[1024];
+    int add_result;
+    int i;
+    socket_handle_t accepted[2];
+    socket_handle_t port_handle;
+
+    port_handle = open_tcp4_server_socket( destination, "514" );
+
+    if( port_handle == BAD_HANDLE ) {
+      printf( "WARNING: " BINDING_DISABLED_WARNING "\n" );
+      SUCCEED(  ) <<  BINDING_DISABLED_WARNING;
+
+    } else {
+      target = stumpless_open_tcp4_target( "pool-test", destination );
+      ASSERT_NOT_NULL( target );
+
+      // the test server has a backlog of one, so connections are accepted
+      // one at a time
+      accepted[0] = accept_tcp_connection( port_handle );
+
+      result = stumpless_set_tcp_connection_count( target, 2 );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+
+      accepted[1] = accept_tcp_connection( port_handle );
+
+      for( i = 0; i < 2; i++ ) {
+        add_result = stumpless_add_message( target, "pooled message" );
+        EXPECT_GE( add_result, 0 );
+        EXPECT_NO_ERROR;
+      }
+
+      for( i = 0; i < 2; i++ ) {
+        recv_from_handle( accepted[i], buffer, 1024 );
+        EXPECT_TRUE( strstr( buffer, "pooled message" ) != NULL );
+        close_server_socket( accepted[i] );
+      }
+
+      result = stumpless_set_tcp_connection_count( target, 1 );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+
+      stumpless_close_network_target( target );
+      close_server_socket( port_handle );
+    }
+  }
+
+  TEST( Tcp4MultipleDestinationTest, FacilityHash ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    char buffer[1024];
+    int add_result;
+    socket_handle_t first_accepted;
+    socket_handle_t second_accepted;
+    socket_handle_t first_handle;
+    socket_handle_t second_handle;
+
+    first_handle = open_tcp4_server_socket( destination, "514" );
+    second_handle = open_tcp4_server_socket( destination, "515" );
+
+    if( first_handle != BAD_HANDLE && second_handle != BAD_HANDLE ) {
+      target = stumpless_open_tcp4_target( "multiple-test", destination );
+      ASSERT_NOT_NULL( target );
+      first_accepted = accept_tcp_connection( first_handle );
+
+      result = stumpless_add_network_destination( target, destination, "515" );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+      second_accepted = accept_tcp_connection( second_handle );
+
+      result = stumpless_set_network_balance_policy( target,
+                                                     STUMPLESS_NETWORK_BALANCE_FACILITY_HASH );
+      EXPECT_EQ( result, target );
+
+      add_result = stumpless_add_log( target,
+                                      STUMPLESS_FACILITY_LOCAL1 | STUMPLESS_SEVERITY_INFO,
+                                      "odd facility" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      add_result = stumpless_add_log( target,
+                                      STUMPLESS_FACILITY_LOCAL0 | STUMPLESS_SEVERITY_INFO,
+                                      "even facility" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      recv_from_handle( first_accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "even facility" ) != NULL );
+      recv_from_handle( second_accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "odd facility" ) != NULL );
+
+      close_server_socket( first_accepted );
+      close_server_socket( second_accepted );
+      stumpless_close_network_target( target );
+    }
+
+    close_server_socket( first_handle );
+    close_server_socket( second_handle );
+  }
+
+  TEST( Tcp4MultipleDestinationTest, Failover ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    char buffer[1024];
+    int add_result;
+    socket_handle_t first_accepted;
+    socket_handle_t second_accepted;
+    socket_handle_t first_handle;
+    socket_handle_t second_handle;
+
+    first_handle = open_tcp4_server_socket( destination, "514" );
+    second_handle = open_tcp4_server_socket( destination, "515" );
+
+    if( first_handle != BAD_HANDLE && second_handle != BAD_HANDLE ) {
+      target = stumpless_open_tcp4_target( "multiple-test", destination );
+      ASSERT_NOT_NULL( target );
+      first_accepted = accept_tcp_connection( first_handle );
+
+      result = stumpless_add_network_destination( target, destination, "515" );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+      second_accepted = accept_tcp_connection( second_handle );
+
+      // take the first destination down entirely
+      close_server_socket( first_accepted );
+      close_server_socket( first_handle );
+      first_accepted = BAD_HANDLE;
+      first_handle = BAD_HANDLE;
+
+      add_result = stumpless_add_message( target, "failover message" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      add_result = stumpless_add_message( target, "failover message" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      recv_from_handle( second_accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "failover message" ) != NULL );
+
+      close_server_socket( first_accepted );
+      close_server_socket( second_accepted );
+      stumpless_close_network_target( target );
+    }
+
+    close_server_socket( first_handle );
+    close_server_socket( second_handle );
+  }
+
+  TEST( Tcp4MultipleDestinationTest, FailoverWithSpillQueue ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    char buffer[1024];
+    int add_result;
+    socket_handle_t first_accepted;
+    socket_handle_t second_accepted;
+    socket_handle_t first_handle;
+    socket_handle_t second_handle;
+
+    first_handle = open_tcp4_server_socket( destination, "514" );
+    second_handle = open_tcp4_server_socket( destination, "515" );
+
+    if( first_handle != BAD_HANDLE && second_handle != BAD_HANDLE ) {
+      target = stumpless_open_tcp4_target( "multiple-test", destination );
+      ASSERT_NOT_NULL( target );
+      first_accepted = accept_tcp_connection( first_handle );
+
+      result = stumpless_set_tcp_reconnect_backoff( target, 60000, 60000 );
+      EXPECT_EQ( result, target );
+      result = stumpless_set_tcp_spill_queue_size( target, 1024 );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+
+      result = stumpless_add_network_destination( target, destination, "515" );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+      second_accepted = accept_tcp_connection( second_handle );
+
+      // take the first destination down entirely
+      close_server_socket( first_accepted );
+      close_server_socket( first_handle );
+      first_accepted = BAD_HANDLE;
+      first_handle = BAD_HANDLE;
+
+      // the frame must not stay in the spill queue of the first destination
+      add_result = stumpless_add_message( target, "failover message" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      recv_from_handle( second_accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "failover message" ) != NULL );
+
+      close_server_socket( second_accepted );
+      stumpless_close_network_target( target );
+    }
+
+    close_server_socket( first_handle );
+    close_server_socket( second_handle );
+  }
+
+  TEST( Tcp4MultipleDestinationTest, RestartedCollector ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    char buffer[1024];
+    int add_result;
+    socket_handle_t first_accepted;
+    socket_handle_t second_accepted;
+    socket_handle_t first_handle;
+    socket_handle_t second_handle;
+
+    first_handle = open_tcp4_server_socket( destination, "514" );
+    second_handle = open_tcp4_server_socket( destination, "515" );
+
+    if( first_handle != BAD_HANDLE && second_handle != BAD_HANDLE ) {
+      target = stumpless_open_tcp4_target( "multiple-test", destination );
+      ASSERT_NOT_NULL( target );
+      first_accepted = accept_tcp_connection( first_handle );
+
+      result = stumpless_add_network_destination( target, destination, "515" );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+      second_accepted = accept_tcp_connection( second_handle );
+
+      // stop the first collector so that its connection is closed
+      close_server_socket( first_accepted );
+      close_server_socket( first_handle );
+
+      add_result = stumpless_add_message( target, "failover message" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      recv_from_handle( second_accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "failover message" ) != NULL );
+
+      // start it again and wait for the destination to be retried
+      first_handle = open_tcp4_server_socket( destination, "514" );
+      ASSERT_NE( first_handle, BAD_HANDLE );
+      std::this_thread::sleep_for(
+        std::chrono::milliseconds( STUMPLESS_NETWORK_DESTINATION_RETRY_DELAY
+                                   + 100 ) );
+
+      add_result = stumpless_add_message( target, "after restart" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      first_accepted = accept_tcp_connection( first_handle );
+      recv_from_handle( first_accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "after restart" ) != NULL );
+
+      close_server_socket( first_accepted );
+      close_server_socket( second_accepted );
+      stumpless_close_network_target( target );
+    }
+
+    close_server_socket( first_handle );
+    close_server_socket( second_handle );
+  }
+
+  TEST( Tcp4MultipleDestinationTest, RoundRobin ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    char buffer[1024];
+    int add_result;
+    socket_handle_t first_accepted;
+    socket_handle_t second_accepted;
+    socket_handle_t first_handle;
+    socket_handle_t second_handle;
+
+    first_handle = open_tcp4_server_socket( destination, "514" );
+    second_handle = open_tcp4_server_socket( destination, "515" );
+
+    if( first_handle != BAD_HANDLE && second_handle != BAD_HANDLE ) {
+      target = stumpless_open_tcp4_target( "multiple-test", destination );
+      ASSERT_NOT_NULL( target );
+      first_accepted = accept_tcp_connection( first_handle );
+
+      result = stumpless_add_network_destination( target, destination, "515" );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+      second_accepted = accept_tcp_connection( second_handle );
+
+      result = stumpless_set_network_balance_policy( target,
+                                                     STUMPLESS_NETWORK_BALANCE_ROUND_ROBIN );
+      EXPECT_EQ( result, target );
+
+      add_result = stumpless_add_message( target, "balanced message" );
+      EXPECT_GE( add_result, 0 );
+      add_result = stumpless_add_message( target, "balanced message" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      recv_from_handle( first_accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "balanced message" ) != NULL );
+      recv_from_handle( second_accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "balanced message" ) != NULL );
+
+      close_server_socket( first_accepted );
+      close_server_socket( second_accepted );
+      stumpless_close_network_target( target );
+    }
+
+    close_server_socket( first_handle );
+    close_server_socket( second_handle );
+  }
+
+  TEST( Tcp4AddEntryTest, ReconnectAfterClosedSession ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    char buffer[1024];
+    int add_result;
+    socket_handle_t accepted;
+    socket_handle_t port_handle;
+
+    port_handle = open_tcp4_server_socket( destination, "514" );
+
+    if( port_handle == BAD_HANDLE ) {
+      printf( "WARNING: " BINDING_DISABLED_WARNING "\n" );
+      SUCCEED(  ) <<  BINDING_DISABLED_WARNING;
+
+    } else {
+      target = stumpless_open_tcp4_target( "reconnect-test", destination );
+      ASSERT_NOT_NULL( target );
+
+      result = stumpless_set_tcp_reconnect_backoff( target, 10, 1000 );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+
+      add_result = stumpless_add_message( target, "first message" );
+      EXPECT_GE( add_result, 0 );
+
+      // accept and then close the connection early
+      accepted = accept_tcp_connection( port_handle );
+      close_server_socket( accepted );
+
+      add_result = stumpless_add_message( target, "after reconnect" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      add_result = stumpless_add_message( target, "after reconnect" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      accepted = accept_tcp_connection( port_handle );
+      recv_from_handle( accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "after reconnect" ) != NULL );
+
+      close_server_socket( accepted );
+      stumpless_close_network_target( target );
+      close_server_socket( port_handle );
+    }
+  }
+
+  TEST( Tcp4AddEntryTest, SpillWhileDisconnected ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    char buffer[1024];
+    int add_result;
+    const struct stumpless_error *error;
+    socket_handle_t accepted;
+    socket_handle_t port_handle;
+
+    port_handle = open_tcp4_server_socket( destination, "514" );
+
+    if( port_handle == BAD_HANDLE ) {
+      printf( "WARNING: " BINDING_DISABLED_WARNING "\n" );
+      SUCCEED(  ) <<  BINDING_DISABLED_WARNING;
+
+    } else {
+      target = stumpless_open_tcp4_target( "spill-test", destination );
+      ASSERT_NOT_NULL( target );
+
+      result = stumpless_set_tcp_reconnect_backoff( target, 60000, 60000 );
+      EXPECT_EQ( result, target );
+      result = stumpless_set_tcp_spill_queue_size( target, 1024 );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+
+      add_result = stumpless_add_message( target, "first message" );
+      EXPECT_GE( add_result, 0 );
+
+      // take the whole server down so that reconnecting fails
+      accepted = accept_tcp_connection( port_handle );
+      close_server_socket( accepted );
+      close_server_socket( port_handle );
+
+      add_result = stumpless_add_message( target, "spilled message" );
+      EXPECT_GE( add_result, 0 );
+      add_result = stumpless_add_message( target, "spilled message" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      // a full spill queue is reported as a closed network
+      result = stumpless_set_tcp_spill_queue_size( target, 0 );
+      EXPECT_EQ( result, target );
+      add_result = stumpless_add_message( target, "dropped message" );
+      EXPECT_LT( add_result, 0 );
+      EXPECT_ERROR_ID_EQ( STUMPLESS_NETWORK_CLOSED );
+
+      result = stumpless_set_tcp_spill_queue_size( target, 1024 );
+      EXPECT_EQ( result, target );
+      add_result = stumpless_add_message( target, "spilled message" );
+      EXPECT_GE( add_result, 0 );
+
+      // resetting the backoff allows an immediate reconnect
+      port_handle = open_tcp4_server_socket( destination, "514" );
+      ASSERT_NE( port_handle, BAD_HANDLE );
+      stumpless_set_tcp_reconnect_backoff( target, 60000, 60000 );
+
+      add_result = stumpless_add_message( target, "after restart" );
+      EXPECT_GE( add_result, 0 );
+      EXPECT_NO_ERROR;
+
+      accepted = accept_tcp_connection( port_handle );
+      recv_from_handle( accepted, buffer, 1024 );
+      EXPECT_TRUE( strstr( buffer, "spilled message" ) != NULL );
+      EXPECT_TRUE( strstr( buffer, "dropped message" ) == NULL );
+
+      close_server_socket( accepted );
+      stumpless_close_network_target( target );
+      close_server_socket( port_handle );
+    }
+  }
+
   TEST( Tcp4AddEntryTest, ClosedSession ) {
     struct stumpless_target *target;
     const char *destination = "127.0.0.1";
@@ -491,4 +929,161 @@ namespace {
 
     }
   }
+
+#ifndef _WIN32
+  TEST( Tcp4AddEntryTest, SlowReader ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    const int message_count = 2000;
+    std::string padding( 1000, 'x' );
+    std::string received;
+    std::string message;
+    std::thread reader;
+    socket_handle_t accepted;
+    socket_handle_t port_handle;
+    int receive_buffer_size = 4096;
+    int add_result;
+    int i;
+    size_t pos;
+    size_t space;
+    size_t frame_length;
+
+    port_handle = open_tcp4_server_socket( destination, "514" );
+
+    if( port_handle == BAD_HANDLE ) {
+      printf( "WARNING: " BINDING_DISABLED_WARNING "\n" );
+      SUCCEED(  ) <<  BINDING_DISABLED_WARNING;
+
+    } else {
+      // a small receive buffer makes the sender run out of room quickly
+      setsockopt( port_handle,
+                  SOL_SOCKET,
+                  SO_RCVBUF,
+                  &receive_buffer_size,
+                  sizeof( receive_buffer_size ) );
+
+      target = stumpless_open_tcp4_target( "slow-reader-test", destination );
+      ASSERT_NOT_NULL( target );
+      result = stumpless_set_tcp_send_timeout( target, 10000 );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+
+      accepted = accept_tcp_connection( port_handle );
+      ASSERT_NE( accepted, BAD_HANDLE );
+
+      reader = std::thread( [accepted, &received]( void ) {
+        char chunk[512];
+        ssize_t recv_result;
+
+        while( ( recv_result = recv( accepted, chunk, sizeof( chunk ), 0 ) ) > 0 ) {
+          received.append( chunk, recv_result );
+          std::this_thread::sleep_for( std::chrono::microseconds( 50 ) );
+        }
+      } );
+
+      for( i = 0; i < message_count; i++ ) {
+        message = "seq-" + std::to_string( i ) + " " + padding;
+        add_result = stumpless_add_message( target, message.c_str(  ) );
+        EXPECT_GE( add_result, 0 );
+      }
+      EXPECT_NO_ERROR;
+
+      stumpless_close_network_target( target );
+      reader.join(  );
+
+      // every frame must be whole and in order
+      pos = 0;
+      for( i = 0; i < message_count; i++ ) {
+        space = received.find( ' ', pos );
+        ASSERT_NE( space, std::string::npos );
+        frame_length = std::stoul( received.substr( pos, space - pos ) );
+        ASSERT_LE( space + 1 + frame_length, received.length(  ) );
+
+        message = received.substr( space + 1, frame_length );
+        EXPECT_NE( message.find( "seq-" + std::to_string( i ) + " " ),
+                   std::string::npos );
+        EXPECT_NE( message.find( padding ), std::string::npos );
+
+        pos = space + 1 + frame_length;
+      }
+      EXPECT_EQ( pos, received.length(  ) );
+
+      close_server_socket( accepted );
+      close_server_socket( port_handle );
+    }
+  }
+
+  TEST( Tcp4AddEntryTest, SendTimeout ) {
+    struct stumpless_target *target;
+    struct stumpless_target *result;
+    const char *destination = "127.0.0.1";
+    std::string message( 1000, 'x' );
+    const struct stumpless_error *error;
+    socket_handle_t accepted;
+    socket_handle_t port_handle;
+    int receive_buffer_size = 4096;
+    int add_result = 0;
+    int i;
+
+    port_handle = open_tcp4_server_socket( destination, "514" );
+
+    if( port_handle == BAD_HANDLE ) {
+      printf( "WARNING: " BINDING_DISABLED_WARNING "\n" );
+      SUCCEED(  ) <<  BINDING_DISABLED_WARNING;
+
+    } else {
+      setsockopt( port_handle,
+                  SOL_SOCKET,
+                  SO_RCVBUF,
+                  &receive_buffer_size,
+                  sizeof( receive_buffer_size ) );
+
+      target = stumpless_open_tcp4_target( "timeout-test", destination );
+      ASSERT_NOT_NULL( target );
+      result = stumpless_set_tcp_send_timeout( target, 50 );
+      EXPECT_EQ( result, target );
+      EXPECT_NO_ERROR;
+
+      // the connection is accepted but never read from
+      accepted = accept_tcp_connection( port_handle );
+
+      for( i = 0; i < 100000 && add_result >= 0; i++ ) {
+        add_result = stumpless_add_message( target, message.c_str(  ) );
+      }
+
+      EXPECT_LT( add_result, 0 );
+      EXPECT_ERROR_ID_EQ( STUMPLESS_SOCKET_SEND_FAILURE );
+      error = stumpless_get_error(  );
+      ASSERT_NOT_NULL( error );
+      EXPECT_EQ( error->code, ETIMEDOUT );
+
+      stumpless_close_network_target( target );
+      close_server_socket( accepted );
+      close_server_socket( port_handle );
+    }
+  }
+#endif
+
+  TEST( SetTcpSendTimeoutTest, NullTarget ) {
+    const struct stumpless_target *result;
+
+    result = stumpless_set_tcp_send_timeout( NULL, 100 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST( SetTcpSendTimeoutTest, UdpTarget ) {
+    struct stumpless_target *target;
+    const struct stumpless_target *result;
+
+    target = stumpless_new_udp4_target( "udp-timeout-test" );
+    ASSERT_NOT_NULL( target );
+
+    result = stumpless_set_tcp_send_timeout( target, 100 );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_TARGET_INCOMPATIBLE );
+
+    stumpless_close_network_target( target );
+  }
 }
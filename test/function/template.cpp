@@ -0,0 +1,213 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <cstddef>
+#include <cstdlib>
+#include <string>
+#include <gmock/gmock.h>
+#include <gtest/gtest.h>
+#include <stumpless.h>
+#include "test/helper/assert.hpp"
+#include "test/helper/fixture.hpp"
+
+using::testing::HasSubstr;
+using::testing::Not;
+
+namespace {
+
+  class TemplateTest : public::testing::Test {
+
+    protected:
+      char buffer[2048];
+      struct stumpless_target *target;
+      struct stumpless_entry *prototype;
+      struct stumpless_entry_template *tmpl;
+
+      virtual void
+      SetUp( void ) {
+        target = stumpless_open_buffer_target( "template-test",
+                                               buffer,
+                                               sizeof( buffer ) );
+        prototype = create_entry(  );
+        stumpless_set_entry_hostname( prototype, "template-host" );
+        stumpless_set_entry_procid( prototype, "1234" );
+        tmpl = stumpless_new_entry_template( prototype );
+      }
+
+      virtual void
+      TearDown( void ) {
+        stumpless_destroy_entry_template( tmpl );
+        stumpless_destroy_entry_and_contents( prototype );
+        stumpless_close_buffer_target( target );
+        stumpless_free_all(  );
+      }
+
+      std::string
+      AddAndRead( const struct stumpless_entry *entry ) {
+        char read_buffer[1024];
+        int result;
+        size_t read_result;
+
+        result = stumpless_add_entry( target, entry );
+        EXPECT_NO_ERROR;
+        EXPECT_GE( result, 0 );
+
+        read_result = stumpless_read_buffer( target,
+                                             read_buffer,
+                                             sizeof( read_buffer ) );
+        EXPECT_GT( read_result, 0 );
+
+        return std::string( read_buffer );
+      }
+  };
+
+  TEST_F( TemplateTest, BorrowsValues ) {
+    struct stumpless_entry *entry;
+    const struct stumpless_param *param;
+    const struct stumpless_param *other_param;
+    struct stumpless_entry *other;
+
+    ASSERT_NOT_NULL( tmpl );
+
+    entry = stumpless_new_entry_from_template( tmpl );
+    ASSERT_NOT_NULL( entry );
+    EXPECT_NO_ERROR;
+
+    other = stumpless_new_entry_from_template( tmpl );
+    ASSERT_NOT_NULL( other );
+
+    EXPECT_TRUE( entry->message_borrowed );
+    EXPECT_EQ( entry->message, other->message );
+
+    param = stumpless_get_entry_param_by_index( entry, 0, 1 );
+    ASSERT_NOT_NULL( param );
+    other_param = stumpless_get_entry_param_by_index( other, 0, 1 );
+    ASSERT_NOT_NULL( other_param );
+    EXPECT_NE( param, other_param );
+    EXPECT_TRUE( param->value_borrowed );
+    EXPECT_EQ( param->value, other_param->value );
+
+    stumpless_destroy_entry_and_contents( other );
+    stumpless_destroy_entry_and_contents( entry );
+  }
+
+  TEST_F( TemplateTest, Layout ) {
+    struct stumpless_entry *entry;
+    const char *value;
+    const char *message;
+
+    ASSERT_NOT_NULL( tmpl );
+
+    entry = stumpless_new_entry_from_template( tmpl );
+    ASSERT_NOT_NULL( entry );
+    EXPECT_NO_ERROR;
+
+    EXPECT_EQ( stumpless_get_entry_prival( entry ),
+               stumpless_get_entry_prival( prototype ) );
+    EXPECT_STREQ( entry->app_name, "fixture-app-name" );
+    EXPECT_STREQ( entry->msgid, "fixture-msgid" );
+    EXPECT_STREQ( entry->hostname, "template-host" );
+    EXPECT_STREQ( entry->procid, "1234" );
+    EXPECT_EQ( stumpless_get_element_count( entry ), 1 );
+
+    value = stumpless_get_entry_param_value_by_name( entry,
+                                                     "fixture-element",
+                                                     "fixture-param-2" );
+    EXPECT_STREQ( value, "fixture-value-2" );
+    free( ( void * ) value );
+
+    message = stumpless_get_entry_message( entry );
+    EXPECT_STREQ( message, "fixture message" );
+    free( ( void * ) message );
+
+    stumpless_destroy_entry_and_contents( entry );
+  }
+
+  TEST_F( TemplateTest, NullPrototype ) {
+    const struct stumpless_entry_template *result;
+
+    result = stumpless_new_entry_template( NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST_F( TemplateTest, NullTemplate ) {
+    const struct stumpless_entry *result;
+
+    result = stumpless_new_entry_from_template( NULL );
+    EXPECT_NULL( result );
+    EXPECT_ERROR_ID_EQ( STUMPLESS_ARGUMENT_EMPTY );
+  }
+
+  TEST_F( TemplateTest, Override ) {
+    struct stumpless_entry *entry;
+    struct stumpless_entry *other;
+    const struct stumpless_entry *result;
+    std::string message;
+
+    ASSERT_NOT_NULL( tmpl );
+
+    entry = stumpless_new_entry_from_template( tmpl );
+    ASSERT_NOT_NULL( entry );
+    other = stumpless_new_entry_from_template( tmpl );
+    ASSERT_NOT_NULL( other );
+
+    result = stumpless_set_entry_param_value_by_index( entry,
+                                                       0,
+                                                       0,
+                                                       "override-value" );
+    EXPECT_EQ( result, entry );
+    result = stumpless_set_entry_message_str( entry, "override message" );
+    EXPECT_EQ( result, entry );
+
+    message = AddAndRead( entry );
+    EXPECT_THAT( message, HasSubstr( "[fixture-element "
+                                     "fixture-param-1=\"override-value\" "
+                                     "fixture-param-2=\"fixture-value-2\"]" ) );
+    EXPECT_THAT( message, HasSubstr( "override message" ) );
+
+    message = AddAndRead( other );
+    EXPECT_THAT( message, HasSubstr( "[fixture-element "
+                                     "fixture-param-1=\"fixture-value-1\" "
+                                     "fixture-param-2=\"fixture-value-2\"]" ) );
+    EXPECT_THAT( message, HasSubstr( "fixture message" ) );
+
+    stumpless_destroy_entry_and_contents( other );
+    stumpless_destroy_entry_and_contents( entry );
+  }
+
+  TEST_F( TemplateTest, PrototypeChanged ) {
+    struct stumpless_entry *entry;
+    std::string message;
+
+    ASSERT_NOT_NULL( tmpl );
+
+    stumpless_set_entry_message_str( prototype, "changed message" );
+    stumpless_set_entry_param_value_by_index( prototype, 0, 0, "changed" );
+
+    entry = stumpless_new_entry_from_template( tmpl );
+    ASSERT_NOT_NULL( entry );
+
+    message = AddAndRead( entry );
+    EXPECT_THAT( message, HasSubstr( "fixture-param-1=\"fixture-value-1\"" ) );
+    EXPECT_THAT( message, HasSubstr( "fixture message" ) );
+    EXPECT_THAT( message, Not( HasSubstr( "changed" ) ) );
+
+    stumpless_destroy_entry_and_contents( entry );
+  }
+}
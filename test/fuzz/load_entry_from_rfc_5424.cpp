@@ -0,0 +1,24 @@
+#include <cstddef>
+#include <cstdint>
+#include <stumpless.h>
+
+extern "C"
+int
+LLVMFuzzerTestOneInput( const uint8_t *data, size_t size ) {
+  // the same entry is reused, as a relay would do
+  static struct stumpless_entry *entry = stumpless_new_entry_str(
+    STUMPLESS_FACILITY_USER,
+    STUMPLESS_SEVERITY_INFO,
+    NULL,
+    NULL,
+    NULL
+  );
+
+  stumpless_load_entry_from_rfc_5424( entry,
+                                      ( const char * ) data,
+                                      size,
+                                      NULL,
+                                      NULL );
+
+  return 0;
+}
@@ -0,0 +1,113 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <algorithm>
+#include <benchmark/benchmark.h>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <cstdlib>
+#include <stumpless.h>
+#include <vector>
+#include "test/helper/fixture.hpp"
+#include "test/helper/scaling.hpp"
+
+using namespace std;
+
+static thread_local size_t thread_alloc_count = 0;
+
+static
+void *
+counting_malloc( size_t size ) {
+  thread_alloc_count++;
+  return malloc( size );
+}
+
+static
+void *
+counting_realloc( void *mem, size_t size ) {
+  thread_alloc_count++;
+  return realloc( mem, size );
+}
+
+static
+double
+get_percentile( const vector<uint64_t> &sorted, size_t percentile ) {
+  if( sorted.empty(  ) ) {
+    return 0;
+  }
+
+  return ( double ) sorted[( sorted.size(  ) - 1 ) * percentile / 100];
+}
+
+void
+add_entries_and_measure( benchmark::State &state,
+                         struct stumpless_target *target ) {
+  struct stumpless_entry *entry;
+  vector<uint64_t> latencies;
+  chrono::steady_clock::time_point start;
+  chrono::steady_clock::time_point end;
+  size_t alloc_start;
+
+  entry = create_entry(  );
+  if( !target || !entry ) {
+    state.SkipWithError( "could not create the target or entry" );
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_thread(  );
+    return;
+  }
+
+  latencies.reserve( 1024 * 1024 );
+  alloc_start = thread_alloc_count;
+
+  for( auto _ : state ) {
+    start = chrono::steady_clock::now(  );
+    if( stumpless_add_entry( target, entry ) < 0 ) {
+      state.SkipWithError( "could not send an entry" );
+      break;
+    }
+    end = chrono::steady_clock::now(  );
+
+    latencies.push_back( chrono::duration_cast<chrono::nanoseconds>( end - start ).count(  ) );
+  }
+
+  sort( latencies.begin(  ), latencies.end(  ) );
+
+  state.SetItemsProcessed( state.iterations(  ) );
+  state.counters["p50LatencyNs"] = benchmark::Counter( get_percentile( latencies, 50 ),
+                                                       benchmark::Counter::kAvgThreads );
+  state.counters["p99LatencyNs"] = benchmark::Counter( get_percentile( latencies, 99 ),
+                                                       benchmark::Counter::kAvgThreads );
+  state.counters["AllocsPerEntry"] = benchmark::Counter( ( double ) ( thread_alloc_count - alloc_start ),
+                                                         benchmark::Counter::kAvgIterations );
+
+  stumpless_destroy_entry_and_contents( entry );
+  stumpless_free_thread(  );
+}
+
+void
+finalize_scaling_memory_counter( void ) {
+  stumpless_set_malloc( malloc );
+  stumpless_set_realloc( realloc );
+}
+
+void
+init_scaling_memory_counter( void ) {
+  stumpless_set_malloc( counting_malloc );
+  stumpless_set_realloc( counting_realloc );
+}
@@ -21,15 +21,42 @@
 #include "test/helper/fixture.hpp"
 #include "test/helper/memory_counter.hpp"
 
+NEW_MEMORY_COUNTER( copy_entry )
+NEW_MEMORY_COUNTER( new_entry_from_template )
 NEW_MEMORY_COUNTER( vload_entry )
 NEW_MEMORY_COUNTER( load_entry_str )
 NEW_MEMORY_COUNTER( vnew_entry )
 NEW_MEMORY_COUNTER( new_entry_str )
+NEW_MEMORY_COUNTER( new_entry_str_with_param )
+NEW_MEMORY_COUNTER( new_pooled_entry_str )
 NEW_MEMORY_COUNTER( set_app_name )
 NEW_MEMORY_COUNTER( set_hostname )
 NEW_MEMORY_COUNTER( set_msgid )
 NEW_MEMORY_COUNTER( set_procid )
 
+static void CopyEntry( benchmark::State &state ) {
+  struct stumpless_entry *entry;
+  struct stumpless_entry *result;
+
+  INIT_MEMORY_COUNTER( copy_entry );
+
+  entry = create_entry(  );
+
+  for(auto _ : state){
+    result = stumpless_copy_entry( entry );
+    if( !result ) {
+      state.SkipWithError( "the entry copy failed" );
+    } else {
+      stumpless_destroy_entry_and_contents( result );
+    }
+  }
+
+  stumpless_destroy_entry_and_contents( entry );
+  stumpless_free_all(  );
+
+  SET_STATE_COUNTERS( state, copy_entry );
+}
+
 static void LoadEntry( benchmark::State &state ) {
   struct stumpless_entry entry;
   const struct stumpless_entry *result;
@@ -80,6 +107,32 @@ static void LoadEntryStr( benchmark::State &state ) {
   SET_STATE_COUNTERS( state, load_entry_str );
 }
 
+static void NewEntryFromTemplate( benchmark::State &state ) {
+  struct stumpless_entry *entry;
+  struct stumpless_entry_template *tmpl;
+  struct stumpless_entry *result;
+
+  INIT_MEMORY_COUNTER( new_entry_from_template );
+
+  entry = create_entry(  );
+  tmpl = stumpless_new_entry_template( entry );
+
+  for(auto _ : state){
+    result = stumpless_new_entry_from_template( tmpl );
+    if( !result ) {
+      state.SkipWithError( "the entry creation failed" );
+    } else {
+      stumpless_destroy_entry_and_contents( result );
+    }
+  }
+
+  stumpless_destroy_entry_template( tmpl );
+  stumpless_destroy_entry_and_contents( entry );
+  stumpless_free_all(  );
+
+  SET_STATE_COUNTERS( state, new_entry_from_template );
+}
+
 static void NewEntry(benchmark::State &state){
   const struct stumpless_entry *result;
 
@@ -127,6 +180,60 @@ static void NewEntryStr(benchmark::State &state){
   SET_STATE_COUNTERS( state, new_entry_str );
 }
 
+static void NewPooledEntryStr( benchmark::State &state ) {
+  struct stumpless_entry *result;
+
+  INIT_MEMORY_COUNTER( new_pooled_entry_str );
+
+  for(auto _ : state){
+    result = stumpless_new_pooled_entry_str( STUMPLESS_FACILITY_USER,
+                                             STUMPLESS_SEVERITY_INFO,
+                                             "entry-perf-test",
+                                             "new-entry-test",
+                                             "stumpless_new_entry iteration" );
+    if( !result ) {
+      state.SkipWithError( "the entry creation failed" );
+    } else {
+      stumpless_add_new_param_to_entry( result,
+                                        "perf-element",
+                                        "perf-param",
+                                        "perf-value" );
+      stumpless_release_pooled_entry( result );
+    }
+  }
+
+  stumpless_free_all(  );
+
+  SET_STATE_COUNTERS( state, new_pooled_entry_str );
+}
+
+static void NewEntryStrWithParam( benchmark::State &state ) {
+  struct stumpless_entry *result;
+
+  INIT_MEMORY_COUNTER( new_entry_str_with_param );
+
+  for(auto _ : state){
+    result = stumpless_new_entry_str( STUMPLESS_FACILITY_USER,
+                                      STUMPLESS_SEVERITY_INFO,
+                                      "entry-perf-test",
+                                      "new-entry-test",
+                                      "stumpless_new_entry iteration" );
+    if( !result ) {
+      state.SkipWithError( "the entry creation failed" );
+    } else {
+      stumpless_add_new_param_to_entry( result,
+                                        "perf-element",
+                                        "perf-param",
+                                        "perf-value" );
+      stumpless_destroy_entry_and_contents( result );
+    }
+  }
+
+  stumpless_free_all(  );
+
+  SET_STATE_COUNTERS( state, new_entry_str_with_param );
+}
+
 static void SetAppName(benchmark::State& state){
   struct stumpless_entry *entry;
   const char *app_name = "new-app-name";
@@ -215,10 +322,14 @@ static void SetProcid(benchmark::State& state){
   SET_STATE_COUNTERS( state, set_procid );
 }
 
+BENCHMARK( CopyEntry );
 BENCHMARK( LoadEntry );
 BENCHMARK( LoadEntryStr );
 BENCHMARK( NewEntry );
+BENCHMARK( NewEntryFromTemplate );
 BENCHMARK( NewEntryStr );
+BENCHMARK( NewEntryStrWithParam );
+BENCHMARK( NewPooledEntryStr );
 BENCHMARK( SetAppName );
 BENCHMARK( SetHostname );
 BENCHMARK( SetMsgid );
@@ -0,0 +1,96 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2021-2023 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <stumpless.h>
+#include "test/helper/fixture.hpp"
+#include "test/helper/memory_counter.hpp"
+
+NEW_MEMORY_COUNTER( format );
+
+class FormatFixture : public::benchmark::Fixture {
+protected:
+  char buffer[8192];
+  struct stumpless_target *target;
+  struct stumpless_entry *entry;
+
+  void
+  AddEntries( benchmark::State &state, enum stumpless_format entry_format ) {
+    struct stumpless_target_stats stats;
+
+    stumpless_set_target_format( target, entry_format );
+    stumpless_reset_target_stats( target );
+
+    for( auto _ : state ) {
+      if( stumpless_add_entry( target, entry ) <= 0 ) {
+        state.SkipWithError( "could not send an entry" );
+      }
+    }
+
+    stumpless_get_target_stats( target, &stats );
+    if( stats.entries_sent > 0 ) {
+      state.counters["BytesPerEntry"] = ( double ) stats.bytes_written
+                                          / stats.entries_sent;
+    }
+
+    SET_STATE_COUNTERS( state, format );
+  }
+
+public:
+  void SetUp( const ::benchmark::State &state ) {
+    target = stumpless_open_buffer_target( "format-perf",
+                                           buffer,
+                                           sizeof( buffer ) );
+    entry = create_entry(  );
+    INIT_MEMORY_COUNTER( format );
+  }
+
+  void TearDown( const ::benchmark::State &state ) {
+    FINALIZE_MEMORY_COUNTER( format );
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_close_buffer_target( target );
+    stumpless_free_all(  );
+  }
+};
+
+BENCHMARK_F( FormatFixture, Rfc5424 )( benchmark::State &state ) {
+  AddEntries( state, STUMPLESS_FORMAT_RFC_5424 );
+}
+
+BENCHMARK_F( FormatFixture, Rfc3164 )( benchmark::State &state ) {
+  AddEntries( state, STUMPLESS_FORMAT_RFC_3164 );
+}
+
+BENCHMARK_F( FormatFixture, JsonLines )( benchmark::State &state ) {
+  AddEntries( state, STUMPLESS_FORMAT_JSON_LINES );
+}
+
+BENCHMARK_F( FormatFixture, JsonLinesEscapedMessage )( benchmark::State &state ) {
+  stumpless_set_entry_message_str( entry,
+                                   "a \"quoted\" path C:\\logs\\app\n"
+                                   "\tand a second line" );
+  AddEntries( state, STUMPLESS_FORMAT_JSON_LINES );
+}
+
+BENCHMARK_F( FormatFixture, Logfmt )( benchmark::State &state ) {
+  AddEntries( state, STUMPLESS_FORMAT_LOGFMT );
+}
+
+BENCHMARK_F( FormatFixture, Binary )( benchmark::State &state ) {
+  AddEntries( state, STUMPLESS_FORMAT_BINARY );
+}
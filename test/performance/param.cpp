@@ -17,6 +17,7 @@
  */
 
 #include <benchmark/benchmark.h>
+#include <string>
 #include <stumpless.h>
 #include "test/helper/memory_counter.hpp"
 
@@ -24,6 +25,9 @@ NEW_MEMORY_COUNTER( copy_param )
 NEW_MEMORY_COUNTER( load_param )
 NEW_MEMORY_COUNTER( new_param )
 NEW_MEMORY_COUNTER( set_param_name )
+NEW_MEMORY_COUNTER( set_param_value )
+NEW_MEMORY_COUNTER( set_param_value_buf )
+NEW_MEMORY_COUNTER( set_param_value_borrowed )
 NEW_MEMORY_COUNTER( from_string )
 NEW_MEMORY_COUNTER( param_to_string )
 
@@ -131,6 +135,76 @@ static void SetParamName(benchmark::State& state){
   SET_STATE_COUNTERS( state, set_param_name );
 }
 
+static void SetParamValue(benchmark::State& state){
+  struct stumpless_param *param;
+  std::string value( 4096, 'v' );
+  const struct stumpless_param *result;
+
+  INIT_MEMORY_COUNTER( set_param_value );
+
+  param = stumpless_new_param( "original-name", "original-value" );
+
+  for(auto _ : state){
+    result = stumpless_set_param_value( param, value.c_str(  ) );
+    if( !result ) {
+      state.SkipWithError( "could not set the param value" );
+    }
+  }
+
+  stumpless_destroy_param( param );
+  stumpless_free_all(  );
+
+  SET_STATE_COUNTERS( state, set_param_value );
+}
+
+static void SetParamValueBuf(benchmark::State& state){
+  struct stumpless_param *param;
+  std::string value( 4096, 'v' );
+  const struct stumpless_param *result;
+
+  INIT_MEMORY_COUNTER( set_param_value_buf );
+
+  param = stumpless_new_param( "original-name", "original-value" );
+
+  for(auto _ : state){
+    result = stumpless_set_param_value_buf( param,
+                                            value.data(  ),
+                                            value.size(  ) );
+    if( !result ) {
+      state.SkipWithError( "could not set the param value" );
+    }
+  }
+
+  stumpless_destroy_param( param );
+  stumpless_free_all(  );
+
+  SET_STATE_COUNTERS( state, set_param_value_buf );
+}
+
+static void SetParamValueBorrowed(benchmark::State& state){
+  struct stumpless_param *param;
+  std::string value( 4096, 'v' );
+  const struct stumpless_param *result;
+
+  INIT_MEMORY_COUNTER( set_param_value_borrowed );
+
+  param = stumpless_new_param( "original-name", "original-value" );
+
+  for(auto _ : state){
+    result = stumpless_set_param_value_borrowed( param,
+                                                 value.data(  ),
+                                                 value.size(  ) );
+    if( !result ) {
+      state.SkipWithError( "could not set the param value" );
+    }
+  }
+
+  stumpless_destroy_param( param );
+  stumpless_free_all(  );
+
+  SET_STATE_COUNTERS( state, set_param_value_borrowed );
+}
+
 static void ParamToString(benchmark::State& state){
   struct stumpless_param *param;
   const char *result;
@@ -159,5 +233,8 @@ BENCHMARK(CopyParam);
 BENCHMARK(LoadParam);
 BENCHMARK(NewParam);
 BENCHMARK(SetParamName);
+BENCHMARK(SetParamValue);
+BENCHMARK(SetParamValueBuf);
+BENCHMARK(SetParamValueBorrowed);
 BENCHMARK(FromString);
 BENCHMARK(ParamToString);
@@ -0,0 +1,82 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstddef>
+#include <cstring>
+#include <stumpless.h>
+#include "test/helper/memory_counter.hpp"
+
+NEW_MEMORY_COUNTER( load_full_line )
+NEW_MEMORY_COUNTER( load_nil_line )
+
+static
+void
+LoadLine( benchmark::State &state, const char *line ) {
+  struct stumpless_entry *entry;
+  const struct stumpless_entry *result;
+  size_t line_length;
+
+  entry = stumpless_new_entry_str( STUMPLESS_FACILITY_USER,
+                                   STUMPLESS_SEVERITY_INFO,
+                                   NULL,
+                                   NULL,
+                                   NULL );
+  line_length = strlen( line );
+
+  for( auto _ : state ) {
+    result = stumpless_load_entry_from_rfc_5424( entry,
+                                                 line,
+                                                 line_length,
+                                                 NULL,
+                                                 NULL );
+    if( !result ) {
+      state.SkipWithError( "could not parse the line" );
+    }
+  }
+
+  state.counters["Lines"] = benchmark::Counter( state.iterations(  ),
+                                                benchmark::Counter::kIsRate );
+  state.SetBytesProcessed( state.iterations(  ) * line_length );
+
+  stumpless_destroy_entry_and_contents( entry );
+}
+
+static void LoadFullLine(benchmark::State& state) {
+  INIT_MEMORY_COUNTER( load_full_line );
+
+  LoadLine( state,
+            "<165>1 2003-10-11T22:14:15.003Z mymachine.example.com evntslog "
+            "1234 ID47 [exampleSDID@32473 iut=\"3\" "
+            "eventSource=\"Application\" eventID=\"1011\"]"
+            "[examplePriority@32473 class=\"high\" note=\"an \\\"escaped\\\" "
+            "value\"] An application event log entry..." );
+
+  SET_STATE_COUNTERS( state, load_full_line );
+}
+
+static void LoadNilLine(benchmark::State& state) {
+  INIT_MEMORY_COUNTER( load_nil_line );
+
+  LoadLine( state, "<14>1 - - - - - - a message with only a header" );
+
+  SET_STATE_COUNTERS( state, load_nil_line );
+}
+
+BENCHMARK(LoadFullLine);
+BENCHMARK(LoadNilLine);
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <stumpless.h>
+#include "test/helper/scaling.hpp"
+
+static char buffer[1024 * 1024];
+static struct stumpless_target *target;
+
+static void
+SetUpBuffer( const benchmark::State &state ) {
+  target = stumpless_open_buffer_target( "buffer-scaling",
+                                         buffer,
+                                         sizeof( buffer ) );
+  init_scaling_memory_counter(  );
+}
+
+static void
+TearDownBuffer( const benchmark::State &state ) {
+  finalize_scaling_memory_counter(  );
+  stumpless_close_buffer_target( target );
+}
+
+static void
+AddEntryToBuffer( benchmark::State &state ) {
+  add_entries_and_measure( state, target );
+}
+
+SCALING_BENCHMARK( AddEntryToBuffer, SetUpBuffer, TearDownBuffer );
@@ -0,0 +1,49 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <stumpless.h>
+#include "test/helper/scaling.hpp"
+
+static char buffer[1024 * 1024];
+static struct stumpless_target *target;
+
+static void
+SetUpChain( const benchmark::State &state ) {
+  struct stumpless_target *sub_target;
+
+  target = stumpless_new_chain( "chain-scaling" );
+  sub_target = stumpless_open_buffer_target( "chain-scaling-sub",
+                                             buffer,
+                                             sizeof( buffer ) );
+  stumpless_add_target_to_chain( target, sub_target );
+  init_scaling_memory_counter(  );
+}
+
+static void
+TearDownChain( const benchmark::State &state ) {
+  finalize_scaling_memory_counter(  );
+  stumpless_close_chain_and_contents( target );
+}
+
+static void
+AddEntryToChain( benchmark::State &state ) {
+  add_entries_and_measure( state, target );
+}
+
+SCALING_BENCHMARK( AddEntryToChain, SetUpChain, TearDownChain );
@@ -0,0 +1,45 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <stumpless.h>
+#include "test/helper/scaling.hpp"
+
+static const char *filename = "file-scaling.log";
+static struct stumpless_target *target;
+
+static void
+SetUpFile( const benchmark::State &state ) {
+  target = stumpless_open_file_target( filename );
+  init_scaling_memory_counter(  );
+}
+
+static void
+TearDownFile( const benchmark::State &state ) {
+  finalize_scaling_memory_counter(  );
+  stumpless_close_file_target( target );
+  remove( filename );
+}
+
+static void
+AddEntryToFile( benchmark::State &state ) {
+  add_entries_and_measure( state, target );
+}
+
+SCALING_BENCHMARK( AddEntryToFile, SetUpFile, TearDownFile );
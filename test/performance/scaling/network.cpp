@@ -0,0 +1,127 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#ifdef _WIN32
+#  include <winsock2.h>
+#else
+#  include <sys/socket.h>
+#  include <sys/time.h>
+#endif
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <stumpless.h>
+#include <thread>
+#include "test/helper/scaling.hpp"
+#include "test/helper/server.hpp"
+
+static struct stumpless_target *target;
+static socket_handle_t handle;
+static socket_handle_t accepted;
+static std::thread *sink_thread;
+static std::atomic_bool stop_sink;
+
+static void
+set_receive_timeout( socket_handle_t sink ) {
+#ifdef _WIN32
+  DWORD timeout = 100;
+#else
+  struct timeval timeout;
+
+  timeout.tv_sec = 0;
+  timeout.tv_usec = 100000;
+#endif
+
+  setsockopt( sink,
+              SOL_SOCKET,
+              SO_RCVTIMEO,
+              ( const char * ) &timeout,
+              sizeof( timeout ) );
+}
+
+static void
+drain_sink( socket_handle_t sink ) {
+  char buffer[2048];
+
+  while( !stop_sink ) {
+    if( recv( sink, buffer, sizeof( buffer ), 0 ) == 0 ) {
+      break;
+    }
+  }
+}
+
+static void
+start_sink( socket_handle_t sink ) {
+  stop_sink = false;
+  set_receive_timeout( sink );
+  sink_thread = new std::thread( drain_sink, sink );
+}
+
+static void
+stop_sink_thread( void ) {
+  stop_sink = true;
+  sink_thread->join(  );
+  delete sink_thread;
+}
+
+static void
+SetUpTcp4( const benchmark::State &state ) {
+  handle = open_tcp_server_socket( AF_INET, "127.0.0.1", "514" );
+  target = stumpless_open_tcp4_target( "tcp4-scaling", "127.0.0.1" );
+  accepted = accept_tcp_connection( handle );
+  start_sink( accepted );
+  init_scaling_memory_counter(  );
+}
+
+static void
+TearDownTcp4( const benchmark::State &state ) {
+  finalize_scaling_memory_counter(  );
+  stumpless_close_network_target( target );
+  stop_sink_thread(  );
+  close_server_socket( accepted );
+  close_server_socket( handle );
+}
+
+static void
+AddEntryToTcp4( benchmark::State &state ) {
+  add_entries_and_measure( state, target );
+}
+
+static void
+SetUpUdp4( const benchmark::State &state ) {
+  handle = open_udp_server_socket( AF_INET, "127.0.0.1", "514" );
+  start_sink( handle );
+  target = stumpless_open_udp4_target( "udp4-scaling", "127.0.0.1" );
+  init_scaling_memory_counter(  );
+}
+
+static void
+TearDownUdp4( const benchmark::State &state ) {
+  finalize_scaling_memory_counter(  );
+  stumpless_close_network_target( target );
+  stop_sink_thread(  );
+  close_server_socket( handle );
+}
+
+static void
+AddEntryToUdp4( benchmark::State &state ) {
+  add_entries_and_measure( state, target );
+}
+
+SCALING_BENCHMARK( AddEntryToTcp4, SetUpTcp4, TearDownTcp4 );
+SCALING_BENCHMARK( AddEntryToUdp4, SetUpUdp4, TearDownUdp4 );
@@ -0,0 +1,85 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <atomic>
+#include <benchmark/benchmark.h>
+#include <cstring>
+#include <stumpless.h>
+#include <sys/socket.h>
+#include <sys/time.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <thread>
+#include <unistd.h>
+#include "test/helper/scaling.hpp"
+
+static const char *socket_name = "socket-scaling-sink";
+static struct stumpless_target *target;
+static int sink;
+static std::thread *sink_thread;
+static std::atomic_bool stop_sink;
+
+static void
+drain_sink( void ) {
+  char buffer[2048];
+
+  while( !stop_sink ) {
+    recv( sink, buffer, sizeof( buffer ), 0 );
+  }
+}
+
+static void
+SetUpSocket( const benchmark::State &state ) {
+  struct sockaddr_un sink_addr;
+  struct timeval timeout;
+
+  sink_addr.sun_family = AF_UNIX;
+  memcpy( &sink_addr.sun_path, socket_name, strlen( socket_name ) + 1 );
+  sink = socket( sink_addr.sun_family, SOCK_DGRAM, 0 );
+
+  timeout.tv_sec = 0;
+  timeout.tv_usec = 100000;
+  setsockopt( sink, SOL_SOCKET, SO_RCVTIMEO, &timeout, sizeof( timeout ) );
+  bind( sink, ( struct sockaddr * ) &sink_addr, sizeof( sink_addr ) );
+
+  stop_sink = false;
+  sink_thread = new std::thread( drain_sink );
+
+  target = stumpless_open_socket_target( socket_name, NULL );
+  init_scaling_memory_counter(  );
+}
+
+static void
+TearDownSocket( const benchmark::State &state ) {
+  finalize_scaling_memory_counter(  );
+  stumpless_close_socket_target( target );
+
+  stop_sink = true;
+  sink_thread->join(  );
+  delete sink_thread;
+
+  close( sink );
+  unlink( socket_name );
+}
+
+static void
+AddEntryToSocket( benchmark::State &state ) {
+  add_entries_and_measure( state, target );
+}
+
+SCALING_BENCHMARK( AddEntryToSocket, SetUpSocket, TearDownSocket );
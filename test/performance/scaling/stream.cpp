@@ -0,0 +1,46 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <stumpless.h>
+#include "test/helper/scaling.hpp"
+
+static FILE *stream;
+static struct stumpless_target *target;
+
+static void
+SetUpStream( const benchmark::State &state ) {
+  stream = tmpfile(  );
+  target = stumpless_open_stream_target( "stream-scaling", stream );
+  init_scaling_memory_counter(  );
+}
+
+static void
+TearDownStream( const benchmark::State &state ) {
+  finalize_scaling_memory_counter(  );
+  stumpless_close_stream_target( target );
+  fclose( stream );
+}
+
+static void
+AddEntryToStream( benchmark::State &state ) {
+  add_entries_and_measure( state, target );
+}
+
+SCALING_BENCHMARK( AddEntryToStream, SetUpStream, TearDownStream );
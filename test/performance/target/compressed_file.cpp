@@ -0,0 +1,101 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <stumpless.h>
+#include "test/helper/fixture.hpp"
+#include "test/helper/memory_counter.hpp"
+
+NEW_MEMORY_COUNTER( add_compressed_entry );
+NEW_MEMORY_COUNTER( add_plain_entry );
+
+static const char *compressed_filename = "compressed-perf.log.gz";
+static const char *plain_filename = "plain-perf.log";
+
+class CompressedFileFixture : public::benchmark::Fixture {
+protected:
+  struct stumpless_entry *entry;
+
+  /**
+   * Adds entries to a target, reporting the number of bytes written to the
+   * file for each entry.
+   */
+  void
+  AddEntries( benchmark::State &state,
+              struct stumpless_target *target,
+              const char *filename ) {
+    FILE *file;
+    long file_size;
+
+    for( auto _ : state ) {
+      if( stumpless_add_entry( target, entry ) <= 0 ) {
+        state.SkipWithError( "could not send an entry to the target" );
+      }
+    }
+
+    stumpless_close_file_target( target );
+
+    file = fopen( filename, "rb" );
+    if( file ) {
+      fseek( file, 0, SEEK_END );
+      file_size = ftell( file );
+      fclose( file );
+      state.counters["FileBytesPerEntry"] = ( double ) file_size
+                                              / state.iterations(  );
+    }
+  }
+
+public:
+  void SetUp( const ::benchmark::State &state ) {
+    remove( compressed_filename );
+    remove( plain_filename );
+    entry = create_entry(  );
+  }
+
+  void TearDown( const ::benchmark::State &state ) {
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_free_all(  );
+    remove( compressed_filename );
+    remove( plain_filename );
+  }
+};
+
+BENCHMARK_F( CompressedFileFixture, AddCompressedEntry )( benchmark::State &state ) {
+  struct stumpless_target *target;
+
+  INIT_MEMORY_COUNTER( add_compressed_entry );
+
+  target = stumpless_open_compressed_file_target( compressed_filename, 1 );
+  AddEntries( state, target, compressed_filename );
+
+  FINALIZE_MEMORY_COUNTER( add_compressed_entry );
+  SET_STATE_COUNTERS( state, add_compressed_entry );
+}
+
+BENCHMARK_F( CompressedFileFixture, AddPlainEntry )( benchmark::State &state ) {
+  struct stumpless_target *target;
+
+  INIT_MEMORY_COUNTER( add_plain_entry );
+
+  target = stumpless_open_file_target( plain_filename );
+  AddEntries( state, target, plain_filename );
+
+  FINALIZE_MEMORY_COUNTER( add_plain_entry );
+  SET_STATE_COUNTERS( state, add_plain_entry );
+}
@@ -0,0 +1,79 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <benchmark/benchmark.h>
+#include <cstdio>
+#include <stumpless.h>
+#include "test/helper/fixture.hpp"
+#include "test/helper/memory_counter.hpp"
+
+NEW_MEMORY_COUNTER( add_colored_entry );
+NEW_MEMORY_COUNTER( add_plain_entry );
+
+class StreamFixture : public::benchmark::Fixture {
+protected:
+  FILE *stream;
+  struct stumpless_target *target;
+  struct stumpless_entry *entry;
+
+public:
+  void SetUp( const ::benchmark::State &state ) {
+    stream = tmpfile(  );
+    target = stumpless_open_stream_target( "stream-perf", stream );
+    entry = create_entry(  );
+  }
+
+  void TearDown( const ::benchmark::State &state ) {
+    stumpless_destroy_entry_and_contents( entry );
+    stumpless_close_stream_target( target );
+    fclose( stream );
+    stumpless_free_all(  );
+  }
+};
+
+BENCHMARK_F( StreamFixture, AddColoredEntry )( benchmark::State &state ) {
+  stumpless_set_severity_color( target,
+                                stumpless_get_entry_severity( entry ),
+                                STUMPLESS_SEVERITY_INFO_DEFAULT_COLOR );
+
+  INIT_MEMORY_COUNTER( add_colored_entry );
+
+  for( auto _ : state ) {
+    if( stumpless_add_entry( target, entry ) <= 0 ) {
+      state.SkipWithError( "could not send an entry to the target" );
+    }
+    rewind( stream );
+  }
+
+  FINALIZE_MEMORY_COUNTER( add_colored_entry );
+  SET_STATE_COUNTERS( state, add_colored_entry );
+}
+
+BENCHMARK_F( StreamFixture, AddPlainEntry )( benchmark::State &state ) {
+  INIT_MEMORY_COUNTER( add_plain_entry );
+
+  for( auto _ : state ) {
+    if( stumpless_add_entry( target, entry ) <= 0 ) {
+      state.SkipWithError( "could not send an entry to the target" );
+    }
+    rewind( stream );
+  }
+
+  FINALIZE_MEMORY_COUNTER( add_plain_entry );
+  SET_STATE_COUNTERS( state, add_plain_entry );
+}
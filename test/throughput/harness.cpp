@@ -0,0 +1,546 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * An end-to-end throughput harness for network and socket targets.
+ *
+ * The harness forks a sink process that listens on a local TCP port, UDP port,
+ * or Unix socket, and then sends entries to it through a stumpless target at a
+ * controlled rate. Each message carries the time it was sent and a sequence
+ * number, so that the sink can measure the latency from the call to
+ * stumpless_add_entry until the message was received, as well as how many
+ * messages never arrived.
+ *
+ * Run with --help for the available options.
+ */
+
+#include <algorithm>
+#include <cerrno>
+#include <chrono>
+#include <csignal>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <poll.h>
+#include <string>
+#include <stumpless.h>
+#include <sys/socket.h>
+#include <sys/types.h>
+#include <sys/un.h>
+#include <sys/wait.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+#include "test/helper/server.hpp"
+
+using namespace std;
+
+/** How long the sink waits for more messages once sending is done. */
+#define SINK_IDLE_TIMEOUT_MS 1000
+
+/** The largest message the sink can receive. */
+#define SINK_BUFFER_SIZE 65536
+
+/** The Unix socket that the sink listens on. */
+#define SINK_SOCKET_NAME "throughput-harness-sink"
+
+struct harness_options {
+  string transport = "tcp";
+  string port = "5514";
+  unsigned long long rate = 10000;
+  double duration = 5;
+  size_t message_size = 128;
+  size_t param_count = 2;
+};
+
+struct sink_results {
+  unsigned long long received;
+  unsigned long long out_of_order;
+  unsigned long long first_ns;
+  unsigned long long last_ns;
+  unsigned long long latency_p50_ns;
+  unsigned long long latency_p99_ns;
+  unsigned long long latency_max_ns;
+};
+
+static
+unsigned long long
+get_now_ns( void ) {
+  // steady_clock is CLOCK_MONOTONIC, which is shared by both processes
+  return chrono::duration_cast<chrono::nanoseconds>(
+    chrono::steady_clock::now(  ).time_since_epoch(  ) ).count(  );
+}
+
+static
+void
+print_usage( const char *name ) {
+  printf( "usage: %s [options]\n"
+          "  --transport tcp|udp|socket  where to send entries (default tcp)\n"
+          "  --port PORT                 local port of the sink (default 5514)\n"
+          "  --rate N                    entries per second, 0 for as fast as\n"
+          "                              possible (default 10000)\n"
+          "  --duration SECONDS          how long to send for (default 5)\n"
+          "  --message-size BYTES        size of the message (default 128)\n"
+          "  --param-count N             params in the entry (default 2)\n",
+          name );
+}
+
+static
+bool
+parse_options( int argc, char **argv, struct harness_options *options ) {
+  int i;
+
+  for( i = 1; i < argc; i++ ) {
+    if( strcmp( argv[i], "--help" ) == 0 || i + 1 >= argc ) {
+      return false;
+    }
+
+    if( strcmp( argv[i], "--transport" ) == 0 ) {
+      options->transport = argv[++i];
+    } else if( strcmp( argv[i], "--port" ) == 0 ) {
+      options->port = argv[++i];
+    } else if( strcmp( argv[i], "--rate" ) == 0 ) {
+      options->rate = strtoull( argv[++i], NULL, 10 );
+    } else if( strcmp( argv[i], "--duration" ) == 0 ) {
+      options->duration = strtod( argv[++i], NULL );
+    } else if( strcmp( argv[i], "--message-size" ) == 0 ) {
+      options->message_size = strtoul( argv[++i], NULL, 10 );
+    } else if( strcmp( argv[i], "--param-count" ) == 0 ) {
+      options->param_count = strtoul( argv[++i], NULL, 10 );
+    } else {
+      return false;
+    }
+  }
+
+  return options->transport == "tcp"
+         || options->transport == "udp"
+         || options->transport == "socket";
+}
+
+/*
+ * Sink process
+ */
+
+static
+void
+record_message( const char *msg,
+                size_t msg_length,
+                vector<unsigned long long> &latencies,
+                unsigned long long *last_sequence,
+                struct sink_results *results ) {
+  unsigned long long now;
+  unsigned long long sent;
+  unsigned long long sequence;
+  const char *marker;
+  string copy( msg, msg_length );
+
+  now = get_now_ns(  );
+  marker = strstr( copy.c_str(  ), "@sent=" );
+  if( !marker
+      || sscanf( marker, "@sent=%llu @seq=%llu", &sent, &sequence ) != 2 ) {
+    return;
+  }
+
+  if( results->received == 0 ) {
+    results->first_ns = now;
+  } else if( sequence <= *last_sequence ) {
+    results->out_of_order++;
+  }
+
+  results->received++;
+  results->last_ns = now;
+  *last_sequence = sequence;
+  latencies.push_back( now - sent );
+}
+
+/*
+ * TCP messages are framed with octet counting, as in RFC 6587. Complete frames
+ * are consumed from the front of the pending data.
+ */
+static
+void
+record_frames( string &pending,
+               vector<unsigned long long> &latencies,
+               unsigned long long *last_sequence,
+               struct sink_results *results ) {
+  size_t space;
+  size_t frame_length;
+
+  while( true ) {
+    space = pending.find( ' ' );
+    if( space == string::npos ) {
+      return;
+    }
+
+    frame_length = strtoul( pending.c_str(  ), NULL, 10 );
+    if( pending.size(  ) < space + 1 + frame_length ) {
+      return;
+    }
+
+    record_message( pending.data(  ) + space + 1,
+                    frame_length,
+                    latencies,
+                    last_sequence,
+                    results );
+    pending.erase( 0, space + 1 + frame_length );
+  }
+}
+
+static
+int
+open_sink_socket( const struct harness_options *options ) {
+  struct sockaddr_un addr;
+  int handle;
+
+  if( options->transport == "tcp" ) {
+    return open_tcp_server_socket( AF_INET, "127.0.0.1", options->port.c_str(  ) );
+  }
+
+  if( options->transport == "udp" ) {
+    return open_udp_server_socket( AF_INET, "127.0.0.1", options->port.c_str(  ) );
+  }
+
+  unlink( SINK_SOCKET_NAME );
+  handle = socket( AF_UNIX, SOCK_DGRAM, 0 );
+  if( handle == -1 ) {
+    return BAD_HANDLE;
+  }
+
+  addr.sun_family = AF_UNIX;
+  memcpy( addr.sun_path, SINK_SOCKET_NAME, sizeof( SINK_SOCKET_NAME ) );
+  if( bind( handle, ( struct sockaddr * ) &addr, sizeof( addr ) ) == -1 ) {
+    close( handle );
+    return BAD_HANDLE;
+  }
+
+  return handle;
+}
+
+/*
+ * Receives messages until the harness closes the control pipe and no message
+ * has been received for SINK_IDLE_TIMEOUT_MS, and then writes the results to
+ * the results pipe.
+ */
+static
+void
+run_sink( const struct harness_options *options,
+          int handle,
+          int control_fd,
+          int results_fd ) {
+  struct pollfd fds[2];
+  int connection = BAD_HANDLE;
+  bool sending_done = false;
+  vector<unsigned long long> latencies;
+  unsigned long long last_sequence = 0;
+  struct sink_results results;
+  string pending;
+  vector<char> buffer( SINK_BUFFER_SIZE );
+  ssize_t received;
+  int ready;
+  size_t count;
+
+  memset( &results, 0, sizeof( results ) );
+  latencies.reserve( ( size_t ) ( options->rate * options->duration ) + 1 );
+
+  while( true ) {
+    fds[0].fd = connection == BAD_HANDLE ? handle : connection;
+    fds[0].events = POLLIN;
+    fds[1].fd = control_fd;
+    fds[1].events = POLLIN;
+
+    ready = poll( fds, sending_done ? 1 : 2, SINK_IDLE_TIMEOUT_MS );
+    if( ready == -1 && errno == EINTR ) {
+      continue;
+    }
+
+    if( ready <= 0 ) {
+      if( sending_done ) {
+        break;
+      }
+
+      continue;
+    }
+
+    if( !sending_done && fds[1].revents != 0 ) {
+      sending_done = true;
+    }
+
+    if( fds[0].revents == 0 ) {
+      continue;
+    }
+
+    if( options->transport == "tcp" && connection == BAD_HANDLE ) {
+      connection = accept_tcp_connection( handle );
+      continue;
+    }
+
+    received = recv( fds[0].fd, buffer.data(  ), buffer.size(  ), 0 );
+    if( received <= 0 ) {
+      if( sending_done ) {
+        break;
+      }
+
+      continue;
+    }
+
+    if( options->transport == "tcp" ) {
+      pending.append( buffer.data(  ), received );
+      record_frames( pending, latencies, &last_sequence, &results );
+    } else {
+      record_message( buffer.data(  ),
+                      received,
+                      latencies,
+                      &last_sequence,
+                      &results );
+    }
+  }
+
+  count = latencies.size(  );
+  if( count > 0 ) {
+    sort( latencies.begin(  ), latencies.end(  ) );
+    results.latency_p50_ns = latencies[( count - 1 ) * 50 / 100];
+    results.latency_p99_ns = latencies[( count - 1 ) * 99 / 100];
+    results.latency_max_ns = latencies[count - 1];
+  }
+
+  if( write( results_fd, &results, sizeof( results ) ) != sizeof( results ) ) {
+    perror( "could not write the sink results" );
+  }
+
+  if( connection != BAD_HANDLE ) {
+    close_server_socket( connection );
+  }
+}
+
+/*
+ * Harness process
+ */
+
+static
+struct stumpless_target *
+open_harness_target( const struct harness_options *options ) {
+  struct stumpless_target *target;
+
+  if( options->transport == "socket" ) {
+    return stumpless_open_socket_target( SINK_SOCKET_NAME, NULL );
+  }
+
+  if( options->transport == "tcp" ) {
+    target = stumpless_new_tcp4_target( "throughput-harness" );
+  } else {
+    target = stumpless_new_udp4_target( "throughput-harness" );
+  }
+
+  stumpless_set_destination( target, "127.0.0.1" );
+  stumpless_set_transport_port( target, options->port.c_str(  ) );
+  if( options->transport == "udp" ) {
+    stumpless_set_udp_max_message_size( target, SINK_BUFFER_SIZE );
+  }
+
+  return stumpless_open_target( target );
+}
+
+static
+struct stumpless_entry *
+new_harness_entry( const struct harness_options *options ) {
+  struct stumpless_entry *entry;
+  struct stumpless_element *element;
+  char name[32];
+  char value[32];
+  size_t i;
+
+  entry = stumpless_new_entry_str( STUMPLESS_FACILITY_USER,
+                                   STUMPLESS_SEVERITY_INFO,
+                                   "throughput",
+                                   "harness",
+                                   "" );
+  if( !entry || options->param_count == 0 ) {
+    return entry;
+  }
+
+  element = stumpless_new_element( "throughput" );
+  for( i = 0; i < options->param_count; i++ ) {
+    snprintf( name, sizeof( name ), "param-%zu", i );
+    snprintf( value, sizeof( value ), "value-%zu", i );
+    stumpless_add_new_param( element, name, value );
+  }
+  stumpless_add_element( entry, element );
+
+  return entry;
+}
+
+static
+void
+send_entries( const struct harness_options *options,
+              struct stumpless_target *target,
+              struct stumpless_entry *entry,
+              unsigned long long *sent,
+              unsigned long long *failed,
+              double *elapsed ) {
+  string message;
+  char prefix[64];
+  int prefix_length;
+  unsigned long long start;
+  unsigned long long end;
+  unsigned long long next;
+  unsigned long long interval;
+  unsigned long long now;
+  unsigned long long sequence = 0;
+
+  interval = options->rate == 0 ? 0 : 1000000000ULL / options->rate;
+  start = get_now_ns(  );
+  end = start + ( unsigned long long ) ( options->duration * 1e9 );
+  next = start;
+
+  while( ( now = get_now_ns(  ) ) < end ) {
+    // scheduling from the start keeps the rate steady if a send runs long
+    if( now < next ) {
+      this_thread::sleep_for( chrono::nanoseconds( next - now ) );
+    }
+    next += interval;
+
+    prefix_length = snprintf( prefix,
+                              sizeof( prefix ),
+                              "@sent=%llu @seq=%llu ",
+                              get_now_ns(  ),
+                              sequence++ );
+    message.assign( prefix, prefix_length );
+    if( message.size(  ) < options->message_size ) {
+      message.append( options->message_size - message.size(  ), 'x' );
+    }
+
+    stumpless_set_entry_message_str( entry, message.c_str(  ) );
+    if( stumpless_add_entry( target, entry ) < 0 ) {
+      ( *failed )++;
+    } else {
+      ( *sent )++;
+    }
+  }
+
+  *elapsed = ( double ) ( get_now_ns(  ) - start ) / 1e9;
+}
+
+static
+void
+print_results( const struct harness_options *options,
+               unsigned long long sent,
+               unsigned long long failed,
+               double elapsed,
+               const struct sink_results *results ) {
+  double receive_seconds;
+
+  receive_seconds = ( double ) ( results->last_ns - results->first_ns ) / 1e9;
+
+  printf( "transport: %s\n", options->transport.c_str(  ) );
+  printf( "message size: %zu bytes\n", options->message_size );
+  printf( "param count: %zu\n", options->param_count );
+  printf( "target rate: %llu entries/s\n", options->rate );
+  printf( "sent: %llu\n", sent );
+  printf( "failed sends: %llu\n", failed );
+  printf( "received: %llu\n", results->received );
+  printf( "dropped: %llu\n",
+          sent > results->received ? sent - results->received : 0 );
+  printf( "out of order: %llu\n", results->out_of_order );
+  printf( "send rate: %.0f entries/s\n", elapsed > 0 ? sent / elapsed : 0 );
+  printf( "sustained throughput: %.0f entries/s\n",
+          receive_seconds > 0 ? results->received / receive_seconds : 0 );
+  printf( "latency p50: %llu ns\n", results->latency_p50_ns );
+  printf( "latency p99: %llu ns\n", results->latency_p99_ns );
+  printf( "latency max: %llu ns\n", results->latency_max_ns );
+}
+
+int
+main( int argc, char **argv ) {
+  struct harness_options options;
+  struct sink_results results;
+  struct stumpless_target *target;
+  struct stumpless_entry *entry;
+  int control_pipe[2];
+  int results_pipe[2];
+  int handle;
+  pid_t sink_pid;
+  unsigned long long sent = 0;
+  unsigned long long failed = 0;
+  double elapsed = 0;
+  int status;
+
+  if( !parse_options( argc, argv, &options ) ) {
+    print_usage( argv[0] );
+    return EXIT_FAILURE;
+  }
+
+  // the sink is bound before forking so that the target can connect at once
+  handle = open_sink_socket( &options );
+  if( handle == BAD_HANDLE ) {
+    fprintf( stderr, "could not open the sink socket\n" );
+    return EXIT_FAILURE;
+  }
+
+  if( pipe( control_pipe ) == -1 || pipe( results_pipe ) == -1 ) {
+    perror( "could not create the sink pipes" );
+    return EXIT_FAILURE;
+  }
+
+  sink_pid = fork(  );
+  if( sink_pid == -1 ) {
+    perror( "could not start the sink" );
+    return EXIT_FAILURE;
+  }
+
+  if( sink_pid == 0 ) {
+    close( control_pipe[1] );
+    close( results_pipe[0] );
+    run_sink( &options, handle, control_pipe[0], results_pipe[1] );
+    close_server_socket( handle );
+    _exit( EXIT_SUCCESS );
+  }
+
+  close( control_pipe[0] );
+  close( results_pipe[1] );
+  close_server_socket( handle );
+
+  target = open_harness_target( &options );
+  entry = new_harness_entry( &options );
+  if( !target || !entry ) {
+    fprintf( stderr, "could not open the harness target\n" );
+    kill( sink_pid, SIGTERM );
+    return EXIT_FAILURE;
+  }
+
+  send_entries( &options, target, entry, &sent, &failed, &elapsed );
+
+  // closing the control pipe tells the sink that sending is done
+  close( control_pipe[1] );
+
+  memset( &results, 0, sizeof( results ) );
+  if( read( results_pipe[0], &results, sizeof( results ) ) != sizeof( results ) ) {
+    fprintf( stderr, "could not read the sink results\n" );
+  }
+  waitpid( sink_pid, &status, 0 );
+
+  print_results( &options, sent, failed, elapsed, &results );
+
+  stumpless_destroy_entry_and_contents( entry );
+  stumpless_close_target( target );
+  stumpless_free_all(  );
+  if( options.transport == "socket" ) {
+    unlink( SINK_SOCKET_NAME );
+  }
+
+  return EXIT_SUCCESS;
+}
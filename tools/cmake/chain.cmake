@@ -31,6 +31,13 @@ add_performance_test(chain
     $<TARGET_OBJECTS:test_helper_fixture>
 )
 
+add_performance_test(scaling_chain
+  SOURCES
+    "${PROJECT_SOURCE_DIR}/test/performance/scaling/chain.cpp"
+    $<TARGET_OBJECTS:test_helper_fixture>
+    $<TARGET_OBJECTS:test_helper_scaling>
+)
+
 add_example(chain
   "${PROJECT_SOURCE_DIR}/docs/examples/chain/chain_example.c"
 )
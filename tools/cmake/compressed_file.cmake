@@ -0,0 +1,17 @@
+list(APPEND STUMPLESS_SOURCES "${PROJECT_SOURCE_DIR}/src/config/have_zlib.c")
+list(APPEND STUMPLESS_LINK_LIBRARIES "z")
+
+add_function_test(compressed_file
+  SOURCES
+    "${PROJECT_SOURCE_DIR}/test/function/target/compressed_file.cpp"
+    $<TARGET_OBJECTS:test_helper_fixture>
+    $<TARGET_OBJECTS:test_helper_rfc5424>
+  LIBRARIES
+    z
+)
+
+add_performance_test(compressed_file
+  SOURCES
+    "${PROJECT_SOURCE_DIR}/test/performance/target/compressed_file.cpp"
+    $<TARGET_OBJECTS:test_helper_fixture>
+)
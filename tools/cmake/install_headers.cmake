@@ -5,21 +5,26 @@ install(
 
 install(
   FILES
+    "${PROJECT_SOURCE_DIR}/include/stumpless/binary.h"
     "${PROJECT_BINARY_DIR}/include/stumpless/config.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/element.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/entry.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/error.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/facility.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/filter.h"
+    "${PROJECT_SOURCE_DIR}/include/stumpless/format.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/generator.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/id.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/log.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/memory.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/option.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/param.h"
+    "${PROJECT_SOURCE_DIR}/include/stumpless/parse.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/prival.h"
+    "${PROJECT_SOURCE_DIR}/include/stumpless/probe.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/severity.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/target.h"
+    "${PROJECT_SOURCE_DIR}/include/stumpless/template.h"
     "${PROJECT_SOURCE_DIR}/include/stumpless/version.h"
   DESTINATION
     "${CMAKE_INSTALL_INCLUDEDIR}/stumpless"
@@ -7,6 +7,12 @@ install(FILES
   DESTINATION ${CMAKE_INSTALL_MANDIR}/man3
 )
 
+install(FILES
+  ${MANPAGE_BUILD_DIR}/binary.h.3
+  RENAME stumpless_binary.h.3
+  DESTINATION ${CMAKE_INSTALL_MANDIR}/man3
+)
+
 install(FILES
   ${MANPAGE_BUILD_DIR}/config.h.3
   RENAME stumpless_config.h.3
@@ -43,6 +49,12 @@ install(FILES
   DESTINATION ${CMAKE_INSTALL_MANDIR}/man3
 )
 
+install(FILES
+  ${MANPAGE_BUILD_DIR}/format.h.3
+  RENAME stumpless_format.h.3
+  DESTINATION ${CMAKE_INSTALL_MANDIR}/man3
+)
+
 install(FILES
   ${MANPAGE_BUILD_DIR}/generator.h.3
   RENAME stumpless_generator.h.3
@@ -79,6 +91,18 @@ install(FILES
   DESTINATION ${CMAKE_INSTALL_MANDIR}/man3
 )
 
+install(FILES
+  ${MANPAGE_BUILD_DIR}/parse.h.3
+  RENAME stumpless_parse.h.3
+  DESTINATION ${CMAKE_INSTALL_MANDIR}/man3
+)
+
+install(FILES
+  ${MANPAGE_BUILD_DIR}/probe.h.3
+  RENAME stumpless_probe.h.3
+  DESTINATION ${CMAKE_INSTALL_MANDIR}/man3
+)
+
 install(FILES
   ${MANPAGE_BUILD_DIR}/severity.h.3
   RENAME stumpless_severity.h.3
@@ -91,6 +115,12 @@ install(FILES
   DESTINATION ${CMAKE_INSTALL_MANDIR}/man3
 )
 
+install(FILES
+  ${MANPAGE_BUILD_DIR}/template.h.3
+  RENAME stumpless_template.h.3
+  DESTINATION ${CMAKE_INSTALL_MANDIR}/man3
+)
+
 install(FILES
   ${MANPAGE_BUILD_DIR}/version.h.3
   RENAME stumpless_version.h.3
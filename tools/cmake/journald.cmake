@@ -1,5 +1,8 @@
 list(APPEND STUMPLESS_SOURCES ${PROJECT_SOURCE_DIR}/src/target/journald.c)
 list(APPEND STUMPLESS_SOURCES ${PROJECT_SOURCE_DIR}/src/config/journald_supported.c)
+if(STUMPLESS_JOURNALD_NATIVE_PROTOCOL_SUPPORTED)
+  list(APPEND STUMPLESS_SOURCES ${PROJECT_SOURCE_DIR}/src/config/journald_native.c)
+endif()
 list(APPEND WRAPTURE_SPECS ${PROJECT_SOURCE_DIR}/tools/wrapture/journald_target.yml)
 
 if(INSTALL_HEADERS)
@@ -31,22 +34,31 @@ if(INCLUDE_MANPAGES_IN_INSTALL)
   )
 endif()
 
-add_function_test(journald
-  SOURCES
-    ${PROJECT_SOURCE_DIR}/test/function/target/journald.cpp
-    $<TARGET_OBJECTS:test_helper_fixture>
-  LIBRARIES
-    systemd
-)
+# the libsystemd journal reading functions are used to verify entries
+if(HAVE_SYSTEMD_SD_JOURNAL_H AND LIBSYSTEMD_FOUND)
+  add_function_test(journald
+    SOURCES
+      ${PROJECT_SOURCE_DIR}/test/function/target/journald.cpp
+      $<TARGET_OBJECTS:test_helper_fixture>
+    LIBRARIES
+      systemd
+  )
+endif()
 
-list(APPEND STUMPLESS_LINK_LIBRARIES "systemd")
+if(STUMPLESS_JOURNALD_NATIVE_PROTOCOL_SUPPORTED)
+  add_function_test(journald_native
+    SOURCES
+      ${PROJECT_SOURCE_DIR}/test/function/config/journald_native.cpp
+      $<TARGET_OBJECTS:test_helper_fixture>
+  )
+else()
+  list(APPEND STUMPLESS_LINK_LIBRARIES "systemd")
+endif()
 
 add_function_test(journald_supported
   SOURCES
     ${PROJECT_SOURCE_DIR}/test/function/config/journald_supported.cpp
     $<TARGET_OBJECTS:test_helper_fixture>
-  LIBRARIES
-    systemd
 )
 
 add_performance_test(journald
@@ -59,7 +71,7 @@ add_example(journald
   ${PROJECT_SOURCE_DIR}/docs/examples/journald/journald_example.c
 )
 
-if(STUMPLESS_THREAD_SAFETY_SUPPORTED)
+if(STUMPLESS_THREAD_SAFETY_SUPPORTED AND HAVE_SYSTEMD_SD_JOURNAL_H AND LIBSYSTEMD_FOUND)
   add_thread_safety_test(journald
     SOURCES
       ${PROJECT_SOURCE_DIR}/test/thread_safety/target/journald.cpp
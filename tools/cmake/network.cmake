@@ -35,6 +35,9 @@ endif()
 
 if(WIN32)
   set(network_libraries Ws2_32)
+else()
+  # the tcp4 tests read from a separate thread to simulate a slow receiver
+  set(tcp_test_libraries pthread)
 endif(WIN32)
 
 add_function_test(network
@@ -51,7 +54,7 @@ add_function_test(tcp4
     $<TARGET_OBJECTS:test_helper_resolve>
     $<TARGET_OBJECTS:test_helper_rfc5424>
     $<TARGET_OBJECTS:test_helper_server>
-  LIBRARIES ${network_libraries}
+  LIBRARIES ${network_libraries} ${tcp_test_libraries}
 )
 
 add_function_test(tcp6
@@ -138,6 +141,15 @@ add_performance_test(network
   LIBRARIES ${network_libraries}
 )
 
+add_performance_test(scaling_network
+  SOURCES
+    test/performance/scaling/network.cpp
+    $<TARGET_OBJECTS:test_helper_fixture>
+    $<TARGET_OBJECTS:test_helper_scaling>
+    $<TARGET_OBJECTS:test_helper_server>
+  LIBRARIES ${network_libraries}
+)
+
 add_no_run_example(tcp
   ${PROJECT_SOURCE_DIR}/docs/examples/network/tcp_example.c
 )
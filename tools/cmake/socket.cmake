@@ -42,6 +42,13 @@ add_thread_safety_test(socket
     $<TARGET_OBJECTS:test_helper_rfc5424>
 )
 
+add_performance_test(scaling_socket
+  SOURCES
+    test/performance/scaling/socket.cpp
+    $<TARGET_OBJECTS:test_helper_fixture>
+    $<TARGET_OBJECTS:test_helper_scaling>
+)
+
 add_example(socket
   ${PROJECT_SOURCE_DIR}/docs/examples/socket/socket_example.c
 )
@@ -35,6 +35,13 @@ add_performance_test(sqlite3
     $<TARGET_OBJECTS:test_helper_fixture>
 )
 
+add_performance_test(scaling_sqlite3
+  SOURCES
+    "${PROJECT_SOURCE_DIR}/test/performance/scaling/sqlite3.cpp"
+    $<TARGET_OBJECTS:test_helper_fixture>
+    $<TARGET_OBJECTS:test_helper_scaling>
+)
+
 add_thread_safety_test(sqlite3
   SOURCES
     "${PROJECT_SOURCE_DIR}/test/thread_safety/target/sqlite3.cpp"
@@ -358,6 +358,24 @@ target_include_directories(test_helper_rfc5424
     ${PROJECT_BINARY_DIR}/include
 )
 
+add_library(test_helper_scaling
+  EXCLUDE_FROM_ALL
+  OBJECT ${PROJECT_SOURCE_DIR}/test/helper/scaling.cpp
+)
+
+set_target_properties(test_helper_scaling
+  PROPERTIES
+  COMPILE_FLAGS "${performance_test_compile_flags}"
+)
+
+add_dependencies(test_helper_scaling libbenchmark)
+
+target_include_directories(test_helper_scaling
+    PRIVATE
+    ${PROJECT_SOURCE_DIR}/include
+    ${PROJECT_BINARY_DIR}/include
+)
+
 add_library(test_helper_server
   EXCLUDE_FROM_ALL
   OBJECT ${PROJECT_SOURCE_DIR}/test/helper/server.cpp
@@ -0,0 +1,123 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Converts a file of binary records written by a target using
+ * STUMPLESS_FORMAT_BINARY back into RFC 5424 messages, one per line.
+ *
+ * Usage: stumpless-decode [file]
+ *
+ * If no file is given, records are read from standard input. Records that
+ * cannot be decoded are reported on standard error and skipped.
+ */
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stumpless.h>
+
+#define READ_SIZE 65536
+
+int
+main( int argc, char **argv ) {
+  FILE *input = stdin;
+  struct stumpless_binary_decoder *decoder;
+  char *data;
+  size_t capacity = READ_SIZE * 2;
+  size_t size = 0;
+  size_t position;
+  size_t consumed;
+  size_t read_count;
+  const char *message;
+  int result = EXIT_SUCCESS;
+
+  if( argc > 2 ) {
+    fprintf( stderr, "usage: %s [file]\n", argv[0] );
+    return EXIT_FAILURE;
+  }
+
+  if( argc == 2 ) {
+    input = fopen( argv[1], "rb" );
+    if( !input ) {
+      perror( argv[1] );
+      return EXIT_FAILURE;
+    }
+  }
+
+  decoder = stumpless_new_binary_decoder(  );
+  data = malloc( capacity );
+  if( !decoder || !data ) {
+    fprintf( stderr, "could not allocate the decoder\n" );
+    result = EXIT_FAILURE;
+    goto cleanup;
+  }
+
+  do {
+    if( capacity - size < READ_SIZE ) {
+      char *new_data = realloc( data, capacity * 2 );
+      if( !new_data ) {
+        fprintf( stderr, "could not allocate a record buffer\n" );
+        result = EXIT_FAILURE;
+        goto cleanup;
+      }
+
+      data = new_data;
+      capacity *= 2;
+    }
+
+    read_count = fread( data + size, 1, READ_SIZE, input );
+    size += read_count;
+
+    position = 0;
+    while( position < size ) {
+      message = stumpless_decode_binary_record( decoder,
+                                                data + position,
+                                                size - position,
+                                                &consumed );
+      if( message ) {
+        puts( message );
+      } else if( consumed > 0 ) {
+        stumpless_perror( "skipped a record" );
+        result = EXIT_FAILURE;
+      } else {
+        break;
+      }
+
+      position += consumed;
+    }
+
+    // keep the incomplete record at the end for the next read
+    memmove( data, data + position, size - position );
+    size -= position;
+  } while( read_count > 0 );
+
+  if( size > 0 ) {
+    fprintf( stderr, "%zu bytes of an incomplete record were ignored\n", size );
+    result = EXIT_FAILURE;
+  }
+
+cleanup:
+  free( data );
+  stumpless_destroy_binary_decoder( decoder );
+  stumpless_free_all(  );
+  if( input != stdin ) {
+    fclose( input );
+  }
+
+  return result;
+}
@@ -0,0 +1,175 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stumpless.h>
+#include "relay.h"
+
+int
+create_batch( struct relay *relay ) {
+  size_t i;
+
+  relay->entries = calloc( relay->batch_size, sizeof( *relay->entries ) );
+  if( !relay->entries ) {
+    return -1;
+  }
+
+  for( i = 0; i < relay->batch_size; i++ ) {
+    relay->entries[i] = stumpless_new_entry_str( STUMPLESS_FACILITY_USER,
+                                                 STUMPLESS_SEVERITY_INFO,
+                                                 NULL,
+                                                 NULL,
+                                                 NULL );
+    if( !relay->entries[i] ) {
+      return -1;
+    }
+  }
+
+  relay->batch_count = 0;
+  return 0;
+}
+
+void
+destroy_batch( struct relay *relay ) {
+  size_t i;
+
+  if( !relay->entries ) {
+    return;
+  }
+
+  for( i = 0; i < relay->batch_size; i++ ) {
+    if( relay->entries[i] ) {
+      stumpless_destroy_entry_and_contents( relay->entries[i] );
+    }
+  }
+
+  free( relay->entries );
+  relay->entries = NULL;
+}
+
+void
+handle_message( struct relay *relay, const char *message, size_t length ) {
+  struct stumpless_entry *entry;
+
+  // local senders often end messages with a newline or NULL character
+  while( length > 0
+         && ( message[length - 1] == '\n' || message[length - 1] == '\0' ) ) {
+    length--;
+  }
+
+  if( length == 0 ) {
+    return;
+  }
+
+  entry = relay->entries[relay->batch_count];
+  if( !stumpless_load_entry_from_rfc_5424( entry,
+                                           message,
+                                           length,
+                                           NULL,
+                                           NULL ) ) {
+    stumpless_perror( "dropped a message" );
+    return;
+  }
+
+  relay->batch_count++;
+  if( relay->batch_count == relay->batch_size ) {
+    send_batch( relay );
+  }
+}
+
+int
+read_frames( struct relay *relay, struct connection *connection ) {
+  char *start = connection->data;
+  char *end = connection->data + connection->size;
+  char *space;
+  char *newline;
+  size_t frame_length;
+
+  while( start < end ) {
+    if( *start >= '1' && *start <= '9' ) {
+      // octet counting
+      frame_length = 0;
+      space = start;
+      while( space < end && *space >= '0' && *space <= '9' ) {
+        frame_length = frame_length * 10 + ( *space - '0' );
+        if( frame_length > MAX_MESSAGE_SIZE ) {
+          return -1;
+        }
+        space++;
+      }
+
+      if( space == end ) {
+        break;
+      }
+
+      if( *space != ' ' ) {
+        return -1;
+      }
+
+      if( ( size_t ) ( end - space - 1 ) < frame_length ) {
+        break;
+      }
+
+      handle_message( relay, space + 1, frame_length );
+      start = space + 1 + frame_length;
+
+    } else {
+      // non-transparent framing with a trailing newline
+      newline = memchr( start, '\n', end - start );
+      if( !newline ) {
+        break;
+      }
+
+      handle_message( relay, start, newline - start );
+      start = newline + 1;
+    }
+  }
+
+  connection->size = end - start;
+  memmove( connection->data, start, connection->size );
+
+  // a frame that cannot fit in the buffer will never be complete
+  if( connection->size == MAX_FRAME_SIZE ) {
+    return -1;
+  }
+
+  return 0;
+}
+
+void
+send_batch( struct relay *relay ) {
+  size_t i;
+
+  if( relay->batch_count == 0 ) {
+    return;
+  }
+
+  for( i = 0; i < relay->target_count; i++ ) {
+    if( stumpless_add_entries( relay->targets[i],
+                               ( const struct stumpless_entry * const * )
+                                 relay->entries,
+                               relay->batch_count,
+                               NULL ) < 0 ) {
+      stumpless_perror( "could not forward messages" );
+    }
+  }
+
+  relay->batch_count = 0;
+}
@@ -0,0 +1,108 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * The batching and framing of received messages in stumpless-relay, kept
+ * apart from the sockets so that it can be tested.
+ */
+
+#ifndef __STUMPLESS_TOOLS_RELAY_H
+#  define __STUMPLESS_TOOLS_RELAY_H
+
+#  include <poll.h>
+#  include <stddef.h>
+#  include <stumpless.h>
+
+#  define DEFAULT_BATCH_SIZE 64
+#  define MAX_CONNECTIONS 64
+#  define MAX_LISTENERS 16
+#  define MAX_TARGETS 16
+#  define MAX_MESSAGE_SIZE 65536
+
+/**
+ * The largest octet counted frame: a message of MAX_MESSAGE_SIZE, its length
+ * of up to five digits, and the space after the length.
+ */
+#  define MAX_FRAME_SIZE ( MAX_MESSAGE_SIZE + 6 )
+
+#  ifdef __cplusplus
+extern "C" {
+#  endif
+
+enum listener_type {
+  DATAGRAM_LISTENER,
+  STREAM_LISTENER,
+  CONNECTION
+};
+
+struct connection {
+  char data[MAX_FRAME_SIZE];
+  size_t size;
+};
+
+struct relay {
+  struct pollfd fds[MAX_LISTENERS + MAX_CONNECTIONS];
+  enum listener_type types[MAX_LISTENERS + MAX_CONNECTIONS];
+  struct connection *connections[MAX_LISTENERS + MAX_CONNECTIONS];
+  size_t fd_count;
+  struct stumpless_target *targets[MAX_TARGETS];
+  size_t target_count;
+  struct stumpless_entry **entries;
+  size_t batch_size;
+  size_t batch_count;
+  const char *socket_paths[MAX_LISTENERS];
+  size_t socket_path_count;
+};
+
+/**
+ * Creates the entries that received messages are loaded into, returning -1 if
+ * they could not be created. The batch size must already be set.
+ */
+int
+create_batch( struct relay *relay );
+
+/**
+ * Destroys the entries created by create_batch.
+ */
+void
+destroy_batch( struct relay *relay );
+
+/**
+ * Loads a message into the next entry of the batch, sending the batch if it
+ * is full. Messages that are not valid are reported and dropped.
+ */
+void
+handle_message( struct relay *relay, const char *message, size_t length );
+
+/**
+ * Handles each complete frame in the connection buffer, returning -1 if the
+ * framing is invalid.
+ */
+int
+read_frames( struct relay *relay, struct connection *connection );
+
+/**
+ * Sends the waiting entries to each of the targets.
+ */
+void
+send_batch( struct relay *relay );
+
+#  ifdef __cplusplus
+}                               /* extern "C" */
+#  endif
+#endif                          /* __STUMPLESS_TOOLS_RELAY_H */
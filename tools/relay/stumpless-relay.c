@@ -0,0 +1,472 @@
+// SPDX-License-Identifier: Apache-2.0
+
+/*
+ * Copyright 2024 Joel E. Anderson
+ *
+ * Licensed under the Apache License, Version 2.0 (the "License");
+ * you may not use this file except in compliance with the License.
+ * You may obtain a copy of the License at
+ *
+ *     http://www.apache.org/licenses/LICENSE-2.0
+ *
+ * Unless required by applicable law or agreed to in writing, software
+ * distributed under the License is distributed on an "AS IS" BASIS,
+ * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied.
+ * See the License for the specific language governing permissions and
+ * limitations under the License.
+ */
+
+/*
+ * Receives RFC 5424 messages and forwards them to stumpless targets.
+ *
+ * Usage: stumpless-relay [options]
+ *
+ * Receiving options, at least one of which is required:
+ *   -u path   receive datagrams on a Unix domain socket at path
+ *   -d port   receive datagrams on a UDP port
+ *   -t port   accept TCP connections on a port, framed with either octet
+ *             counting or trailing newlines as described in RFC 6587
+ *
+ * Forwarding options, which may be repeated. Messages are written to standard
+ * output if none are given.
+ *   -f file   write to a file
+ *   -s path   send to a Unix domain socket
+ *   -r host   send to a server over UDP
+ *   -R host   send to a server over TCP
+ *   -p port   the port used by the -r and -R options after it
+ *
+ * Other options:
+ *   -b count  the most messages sent to the targets at once, default 64
+ *
+ * Each message is parsed into an entry, and all of the messages that are
+ * waiting when the relay wakes up are sent to each target in batches with
+ * stumpless_add_entries. Forwarded messages keep the timestamp that they were
+ * received with. Messages that are not valid RFC 5424 messages are reported on
+ * standard error and dropped.
+ *
+ * The relay runs until it is interrupted or terminated.
+ */
+
+#include <errno.h>
+#include <netdb.h>
+#include <poll.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <stumpless.h>
+#include <sys/socket.h>
+#include <sys/un.h>
+#include <unistd.h>
+#include "relay.h"
+
+static volatile sig_atomic_t running = 1;
+
+static
+void
+stop( int signal_number ) {
+  ( void ) signal_number;
+  running = 0;
+}
+
+static
+int
+add_fd( struct relay *relay, int fd, enum listener_type type ) {
+  size_t index = relay->fd_count;
+
+  if( index == MAX_LISTENERS + MAX_CONNECTIONS ) {
+    close( fd );
+    return -1;
+  }
+
+  relay->connections[index] = NULL;
+  if( type == CONNECTION ) {
+    relay->connections[index] = malloc( sizeof( struct connection ) );
+    if( !relay->connections[index] ) {
+      close( fd );
+      return -1;
+    }
+    relay->connections[index]->size = 0;
+  }
+
+  relay->fds[index].fd = fd;
+  relay->fds[index].events = POLLIN;
+  relay->fds[index].revents = 0;
+  relay->types[index] = type;
+  relay->fd_count++;
+
+  return 0;
+}
+
+static
+void
+remove_fd( struct relay *relay, size_t index ) {
+  size_t last = relay->fd_count - 1;
+
+  close( relay->fds[index].fd );
+  free( relay->connections[index] );
+
+  relay->fds[index] = relay->fds[last];
+  relay->types[index] = relay->types[last];
+  relay->connections[index] = relay->connections[last];
+  relay->fd_count--;
+}
+
+static
+int
+listen_unix( struct relay *relay, const char *path ) {
+  struct sockaddr_un address;
+  int fd;
+
+  if( relay->socket_path_count == MAX_LISTENERS ) {
+    fprintf( stderr, "at most %d sockets may be used\n", MAX_LISTENERS );
+    return -1;
+  }
+
+  if( strlen( path ) >= sizeof( address.sun_path ) ) {
+    fprintf( stderr, "the socket path %s is too long\n", path );
+    return -1;
+  }
+
+  fd = socket( AF_UNIX, SOCK_DGRAM, 0 );
+  if( fd == -1 ) {
+    perror( "socket" );
+    return -1;
+  }
+
+  memset( &address, 0, sizeof( address ) );
+  address.sun_family = AF_UNIX;
+  strcpy( address.sun_path, path );
+  unlink( path );
+
+  if( bind( fd, ( struct sockaddr * ) &address, sizeof( address ) ) == -1 ) {
+    perror( path );
+    close( fd );
+    return -1;
+  }
+
+  if( add_fd( relay, fd, DATAGRAM_LISTENER ) == -1 ) {
+    unlink( path );
+    return -1;
+  }
+
+  relay->socket_paths[relay->socket_path_count] = path;
+  relay->socket_path_count++;
+  return 0;
+}
+
+static
+int
+listen_inet( struct relay *relay, const char *port, int type ) {
+  struct addrinfo hints;
+  struct addrinfo *addresses;
+  struct addrinfo *address;
+  int fd = -1;
+  int reuse = 1;
+  int result;
+
+  memset( &hints, 0, sizeof( hints ) );
+  hints.ai_family = AF_UNSPEC;
+  hints.ai_socktype = type;
+  hints.ai_flags = AI_PASSIVE;
+
+  result = getaddrinfo( NULL, port, &hints, &addresses );
+  if( result != 0 ) {
+    fprintf( stderr, "port %s: %s\n", port, gai_strerror( result ) );
+    return -1;
+  }
+
+  for( address = addresses; address; address = address->ai_next ) {
+    fd = socket( address->ai_family,
+                 address->ai_socktype,
+                 address->ai_protocol );
+    if( fd == -1 ) {
+      continue;
+    }
+
+    setsockopt( fd, SOL_SOCKET, SO_REUSEADDR, &reuse, sizeof( reuse ) );
+    if( bind( fd, address->ai_addr, address->ai_addrlen ) == 0
+        && ( type == SOCK_DGRAM || listen( fd, SOMAXCONN ) == 0 ) ) {
+      break;
+    }
+
+    close( fd );
+    fd = -1;
+  }
+
+  freeaddrinfo( addresses );
+
+  if( fd == -1 ) {
+    fprintf( stderr, "could not listen on port %s\n", port );
+    return -1;
+  }
+
+  return add_fd( relay,
+                 fd,
+                 type == SOCK_DGRAM ? DATAGRAM_LISTENER : STREAM_LISTENER );
+}
+
+static
+void
+read_datagrams( struct relay *relay, int fd ) {
+  char buffer[MAX_MESSAGE_SIZE];
+  ssize_t received;
+  size_t i;
+
+  // read whatever is waiting, up to a batch, before going back to poll
+  for( i = 0; i < relay->batch_size; i++ ) {
+    received = recv( fd, buffer, sizeof( buffer ), MSG_DONTWAIT );
+    if( received < 0 ) {
+      return;
+    }
+
+    handle_message( relay, buffer, received );
+  }
+}
+
+static
+int
+read_connection( struct relay *relay, size_t index ) {
+  struct connection *connection = relay->connections[index];
+  ssize_t received;
+
+  received = recv( relay->fds[index].fd,
+                   connection->data + connection->size,
+                   MAX_FRAME_SIZE - connection->size,
+                   MSG_DONTWAIT );
+  if( received < 0 && ( errno == EAGAIN || errno == EINTR ) ) {
+    return 0;
+  }
+
+  if( received <= 0 ) {
+    return -1;
+  }
+
+  connection->size += received;
+  return read_frames( relay, connection );
+}
+
+static
+void
+accept_connection( struct relay *relay, int fd ) {
+  int connection_fd;
+
+  connection_fd = accept( fd, NULL, NULL );
+  if( connection_fd == -1 ) {
+    return;
+  }
+
+  if( add_fd( relay, connection_fd, CONNECTION ) == -1 ) {
+    fprintf( stderr, "refused a connection, as too many are open\n" );
+  }
+}
+
+static
+int
+add_target( struct relay *relay, struct stumpless_target *target ) {
+  if( !target ) {
+    stumpless_perror( "could not open a target" );
+    return -1;
+  }
+
+  if( relay->target_count == MAX_TARGETS ) {
+    fprintf( stderr, "at most %d targets may be used\n", MAX_TARGETS );
+    stumpless_close_target( target );
+    return -1;
+  }
+
+  /* forward the procid of received messages instead of dropping it */
+  stumpless_set_option( target, STUMPLESS_OPTION_PID );
+
+  relay->targets[relay->target_count] = target;
+  relay->target_count++;
+  return 0;
+}
+
+#ifdef STUMPLESS_NETWORK_TARGETS_SUPPORTED
+static
+int
+add_network_target( struct relay *relay,
+                    struct stumpless_target *target,
+                    const char *port ) {
+  if( target && port && !stumpless_set_transport_port( target, port ) ) {
+    stumpless_perror( "could not set the port of a target" );
+    stumpless_close_target( target );
+    return -1;
+  }
+
+  return add_target( relay, target );
+}
+#endif
+
+static
+void
+print_usage( const char *name ) {
+  fprintf( stderr,
+           "usage: %s [-u path] [-d port] [-t port] [-f file] [-s path]"
+           " [-p port] [-r host] [-R host] [-b count]\n",
+           name );
+}
+
+int
+main( int argc, char **argv ) {
+  struct relay relay;
+#ifdef STUMPLESS_NETWORK_TARGETS_SUPPORTED
+  const char *port = NULL;
+#endif
+  int option;
+  int ready;
+  size_t i;
+  int result = EXIT_FAILURE;
+
+  memset( &relay, 0, sizeof( relay ) );
+  relay.batch_size = DEFAULT_BATCH_SIZE;
+
+  while( ( option = getopt( argc, argv, "u:d:t:f:s:p:r:R:b:" ) ) != -1 ) {
+    switch( option ) {
+      case 'u':
+        if( listen_unix( &relay, optarg ) == -1 ) {
+          goto cleanup;
+        }
+        break;
+
+      case 'd':
+        if( listen_inet( &relay, optarg, SOCK_DGRAM ) == -1 ) {
+          goto cleanup;
+        }
+        break;
+
+      case 't':
+        if( listen_inet( &relay, optarg, SOCK_STREAM ) == -1 ) {
+          goto cleanup;
+        }
+        break;
+
+      case 'f':
+        if( add_target( &relay,
+                        stumpless_open_file_target( optarg ) ) == -1 ) {
+          goto cleanup;
+        }
+        break;
+
+#ifdef STUMPLESS_SOCKET_TARGETS_SUPPORTED
+      case 's':
+        if( add_target( &relay,
+                        stumpless_open_socket_target( optarg, NULL ) ) == -1 ) {
+          goto cleanup;
+        }
+        break;
+#endif
+
+#ifdef STUMPLESS_NETWORK_TARGETS_SUPPORTED
+      case 'p':
+        port = optarg;
+        break;
+
+      case 'r':
+        if( add_network_target( &relay,
+                                stumpless_open_udp4_target( optarg, optarg ),
+                                port ) == -1 ) {
+          goto cleanup;
+        }
+        break;
+
+      case 'R':
+        if( add_network_target( &relay,
+                                stumpless_open_tcp4_target( optarg, optarg ),
+                                port ) == -1 ) {
+          goto cleanup;
+        }
+        break;
+#endif
+
+      case 'b':
+        relay.batch_size = strtoul( optarg, NULL, 10 );
+        if( relay.batch_size == 0 ) {
+          fprintf( stderr, "the batch size must be a positive number\n" );
+          goto cleanup;
+        }
+        break;
+
+      default:
+        print_usage( argv[0] );
+        goto cleanup;
+    }
+  }
+
+  if( optind != argc || relay.fd_count == 0 ) {
+    print_usage( argv[0] );
+    goto cleanup;
+  }
+
+  if( relay.target_count == 0
+      && add_target( &relay, stumpless_open_stdout_target( "relay" ) ) == -1 ) {
+    goto cleanup;
+  }
+
+  if( create_batch( &relay ) == -1 ) {
+    stumpless_perror( "could not create the batch entries" );
+    goto cleanup;
+  }
+
+  signal( SIGINT, stop );
+  signal( SIGTERM, stop );
+  signal( SIGPIPE, SIG_IGN );
+
+  while( running ) {
+    ready = poll( relay.fds, relay.fd_count, -1 );
+    if( ready < 0 ) {
+      if( errno == EINTR ) {
+        continue;
+      }
+
+      perror( "poll" );
+      goto cleanup;
+    }
+
+    // go backwards so that removing a connection does not skip any
+    for( i = relay.fd_count; i > 0; i-- ) {
+      if( relay.fds[i - 1].revents == 0 ) {
+        continue;
+      }
+
+      switch( relay.types[i - 1] ) {
+        case DATAGRAM_LISTENER:
+          read_datagrams( &relay, relay.fds[i - 1].fd );
+          break;
+
+        case STREAM_LISTENER:
+          accept_connection( &relay, relay.fds[i - 1].fd );
+          break;
+
+        case CONNECTION:
+          if( read_connection( &relay, i - 1 ) == -1 ) {
+            remove_fd( &relay, i - 1 );
+          }
+          break;
+      }
+    }
+
+    send_batch( &relay );
+  }
+
+  result = EXIT_SUCCESS;
+
+cleanup:
+  destroy_batch( &relay );
+
+  while( relay.fd_count > 0 ) {
+    remove_fd( &relay, relay.fd_count - 1 );
+  }
+
+  for( i = 0; i < relay.socket_path_count; i++ ) {
+    unlink( relay.socket_paths[i] );
+  }
+
+  for( i = 0; i < relay.target_count; i++ ) {
+    stumpless_close_target( relay.targets[i] );
+  }
+
+  stumpless_free_all(  );
+  return result;
+}